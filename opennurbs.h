@@ -48,6 +48,7 @@
 #include "opennurbs_progress_reporter.h" // ON_ProgressReporter class
 #include "opennurbs_terminator.h"        // ON_Terminator class 
 #include "opennurbs_lock.h"              // simple atomic operation lock setter
+#include "opennurbs_parallel.h"          // ON_ParallelFor simple fork-join loop
 #include "opennurbs_fsp.h"            // fixed size memory pool
 #include "opennurbs_function_list.h"      /* list of functions to run */
 #include "opennurbs_std_string.h"     // std::string utilities
@@ -130,6 +131,11 @@
 #include "opennurbs_polycurve.h"      // polycurve (composite curve)
 #include "opennurbs_curveonsurface.h" // curve on surface (other kind of composite curve)
 #include "opennurbs_nurbssurface.h"   // NURBS surface
+#include "opennurbs_nurbs_span_cache.h" // cached Bezier span evaluation of NURBS curves and surfaces
+#include "opennurbs_curve_query.h"       // curve pieces and closest point queries
+#include "opennurbs_curve_intersect.h"   // curve-curve and curve-plane intersections
+#include "opennurbs_curve_tessellate.h"  // adaptive curve tessellation
+#include "opennurbs_curve_length.h"      // curve arc length tables
 #include "opennurbs_planesurface.h"   // plane surface
 #include "opennurbs_revsurface.h"     // surface of revolution
 #include "opennurbs_sumsurface.h"     // sum surface
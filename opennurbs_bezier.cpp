@@ -30,24 +30,272 @@
 
 ////////////////////////////////////////////////////////////////////////
 
+// Sub-patches are never split more than this many times.
+#define ON_INTERNAL_TIGHT_BBOX_MAX_DEPTH 30
+
+static void Internal_GrowBoxByCorners(
+  ON_BoundingBox& bbox,
+  const ON_4dPoint* net,
+  int order0,
+  int order1
+  )
+{
+  // Corners with zero weight are at infinity and are skipped.
+  const ON_4dPoint* corner[4] = { net, net + (order1 - 1), net + (order0 - 1) * order1, net + (order0 * order1 - 1) };
+  for (int i = 0; i < 4; i++)
+  {
+    if (0.0 != corner[i]->w)
+      bbox.Set(ON_3dPoint(*corner[i]), true);
+  }
+}
+
+static double Internal_BezierNetBend(
+  const ON_3dPoint* net,
+  int order0,
+  int order1,
+  int dir
+  )
+{
+  // largest second difference of the Euclidean control points in direction dir
+  const int n = dir ? order1 : order0;
+  const int m = dir ? order0 : order1;
+  const int step = dir ? 1 : order1;
+  const int seq_step = dir ? order1 : 1;
+  double bend = 0.0;
+  for (int s = 0; s < m; s++)
+  {
+    const ON_3dPoint* P = net + s * seq_step;
+    for (int i = 1; i + 1 < n; i++)
+    {
+      const ON_3dPoint& A = P[(i - 1) * step];
+      const ON_3dPoint& B = P[i * step];
+      const ON_3dPoint& C = P[(i + 1) * step];
+      const ON_3dVector dd(A.x - 2.0 * B.x + C.x, A.y - 2.0 * B.y + C.y, A.z - 2.0 * B.z + C.z);
+      bend = ON_Max(bend, dd.MaximumCoordinate());
+    }
+  }
+  return bend;
+}
+
+static bool Internal_GetEuclideanBezierNet(
+  const ON_4dPoint* net,
+  int cv_count,
+  ON_3dPoint* euclidean_net,
+  ON_BoundingBox& hull
+  )
+{
+  // Fails when a weight is zero or the weights have different signs.
+  // When all weights are negative, negating the net does not change the
+  // Euclidean control points, so those still bound the sub-patch.
+  const bool bNegative = (cv_count > 0 && net[0].w < 0.0);
+  for (int i = 0; i < cv_count; i++)
+  {
+    const ON_4dPoint& P = net[i];
+    if (!(bNegative ? (P.w < 0.0) : (P.w > 0.0)))
+      return false;
+    const double s = 1.0 / P.w;
+    ON_3dPoint& Q = euclidean_net[i];
+    Q.x = s * P.x;
+    Q.y = s * P.y;
+    Q.z = s * P.z;
+    if (0 == i)
+    {
+      hull.m_min = Q;
+      hull.m_max = Q;
+      continue;
+    }
+    if (Q.x < hull.m_min.x) hull.m_min.x = Q.x; else if (Q.x > hull.m_max.x) hull.m_max.x = Q.x;
+    if (Q.y < hull.m_min.y) hull.m_min.y = Q.y; else if (Q.y > hull.m_max.y) hull.m_max.y = Q.y;
+    if (Q.z < hull.m_min.z) hull.m_min.z = Q.z; else if (Q.z > hull.m_max.z) hull.m_max.z = Q.z;
+  }
+  return hull.IsValid();
+}
+
+static void Internal_SplitBezierNet(
+  ON_4dPoint* right,
+  ON_4dPoint* left,
+  int order0,
+  int order1,
+  int dir,
+  ON_4dPoint* work
+  )
+{
+  // On input right[] is the control net. On output left[] and right[] are the
+  // halves of the net split at the middle of direction dir.
+  const int n = dir ? order1 : order0;
+  const int m = dir ? order0 : order1;
+  const int step = dir ? 1 : order1;
+  const int seq_step = dir ? order1 : 1;
+  for (int s = 0; s < m; s++)
+  {
+    ON_4dPoint* R = right + s * seq_step;
+    ON_4dPoint* L = left + s * seq_step;
+    for (int i = 0; i < n; i++)
+      work[i] = R[i * step];
+    L[0] = work[0];
+    for (int r = 1; r < n; r++)
+    {
+      for (int i = 0; i < n - r; i++)
+      {
+        work[i].x = 0.5 * (work[i].x + work[i + 1].x);
+        work[i].y = 0.5 * (work[i].y + work[i + 1].y);
+        work[i].z = 0.5 * (work[i].z + work[i + 1].z);
+        work[i].w = 0.5 * (work[i].w + work[i + 1].w);
+      }
+      L[r * step] = work[0];
+      R[(n - 1 - r) * step] = work[n - 1 - r];
+    }
+  }
+}
+
+static bool Internal_GetBezierTightBoundingBox(
+  int dim,
+  bool is_rat,
+  int order0,
+  int order1,
+  int cv_stride0,
+  int cv_stride1,
+  const double* cv,
+  ON_BoundingBox& tight_bbox,
+  bool bGrowBox,
+  const ON_Xform* xform
+  )
+{
+  // Curves have order1 = 1. The corners of a Bezier control net are on the
+  // curve or surface and the Euclidean control points bound it. Sub-nets
+  // whose control point box sticks out of the box of known points are split
+  // until the excess is negligible. Sub-nets with zero or mixed sign weights
+  // have no such bound and are split until their weights have one sign.
+  // If that does not happen, the denominator has a zero and the curve or
+  // surface goes through infinity.
+  if (dim < 1 || order0 < 1 || order1 < 1 || nullptr == cv)
+    return false;
+  if (bGrowBox && !tight_bbox.IsValid())
+    bGrowBox = false;
+
+  const int cv_count = order0 * order1;
+  ON_SimpleArray<ON_4dPoint> net(4 * cv_count);
+  net.SetCount(cv_count);
+  for (int i = 0; i < order0; i++)
+  {
+    for (int j = 0; j < order1; j++)
+    {
+      const double* p = cv + i * cv_stride0 + j * cv_stride1;
+      ON_4dPoint P(p[0], (dim > 1) ? p[1] : 0.0, (dim > 2) ? p[2] : 0.0, is_rat ? p[dim] : 1.0);
+      if (nullptr != xform)
+        P = (*xform) * P;
+      net[i * order1 + j] = P;
+    }
+  }
+
+  ON_BoundingBox bbox = bGrowBox ? tight_bbox : ON_BoundingBox::EmptyBoundingBox;
+  Internal_GrowBoxByCorners(bbox, net.Array(), order0, order1);
+
+  // euclidean_net[] = Euclidean control points of the sub-patch being tested
+  ON_SimpleArray<ON_3dPoint> euclidean_net(cv_count);
+  euclidean_net.SetCount(cv_count);
+  ON_BoundingBox hull;
+  double tolerance
+    = Internal_GetEuclideanBezierNet(net.Array(), cv_count, euclidean_net.Array(), hull)
+    ? ON_SQRT_EPSILON * hull.Diagonal().Length()
+    : ON_UNSET_VALUE;
+
+  ON_SimpleArray<ON_4dPoint> work(ON_Max(order0, order1));
+  work.SetCount(ON_Max(order0, order1));
+  ON_SimpleArray<unsigned int> depth(32);
+  depth.Append(0);
+  while (depth.Count() > 0)
+  {
+    // The control net of the sub-patch at depth[k] is net[k*cv_count] ... net[(k+1)*cv_count-1].
+    const int k = depth.Count() - 1;
+    const ON_4dPoint* P = net.Array() + k * cv_count;
+    int dir;
+    if (Internal_GetEuclideanBezierNet(P, cv_count, euclidean_net.Array(), hull))
+    {
+      if (bbox.Includes(hull))
+      {
+        depth.Remove();
+        continue;
+      }
+      if (ON_UNSET_VALUE == tolerance)
+        tolerance = ON_SQRT_EPSILON * hull.Diagonal().Length();
+
+      double excess = 0.0;
+      for (int i = 0; i < 3; i++)
+        excess = ON_Max(excess, ON_Max(bbox.m_min[i] - hull.m_min[i], hull.m_max[i] - bbox.m_max[i]));
+      const double bend0 = Internal_BezierNetBend(euclidean_net.Array(), order0, order1, 0);
+      const double bend1 = (order1 > 2) ? Internal_BezierNetBend(euclidean_net.Array(), order0, order1, 1) : 0.0;
+      if (excess <= tolerance || depth[k] >= ON_INTERNAL_TIGHT_BBOX_MAX_DEPTH || !(bend0 > 0.0 || bend1 > 0.0))
+      {
+        bbox.Union(hull);
+        depth.Remove();
+        continue;
+      }
+      dir = (bend1 > bend0) ? 1 : 0;
+    }
+    else
+    {
+      // zero or mixed sign weights - the sub-net must be split, never dropped
+      if (depth[k] >= ON_INTERNAL_TIGHT_BBOX_MAX_DEPTH)
+        return false;
+      dir = (order1 > 1) ? (int)(depth[k] % 2) : 0;
+    }
+
+    if (net.Count() < (k + 2) * cv_count)
+    {
+      net.Reserve(2 * (k + 2) * cv_count);
+      net.SetCount((k + 2) * cv_count);
+    }
+    ON_4dPoint* right = net.Array() + k * cv_count;
+    ON_4dPoint* left = right + cv_count;
+    Internal_SplitBezierNet(right, left, order0, order1, dir, work.Array());
+    Internal_GrowBoxByCorners(bbox, right, order0, order1);
+    Internal_GrowBoxByCorners(bbox, left, order0, order1);
+    depth[k]++;
+    depth.Append(depth[k]);
+  }
+
+  tight_bbox = bbox;
+  return tight_bbox.IsValid();
+}
+
 bool ON_BezierCurve::GetTightBoundingBox( 
 		ON_BoundingBox& tight_bbox, 
     bool bGrowBox,
 		const ON_Xform* xform
     ) const
 {
-
-  // The result from ON_GetPointListBoundingBox() is good enough
-  // for file IO needs in the public souce code version.
-  return ON_GetPointListBoundingBox(
+  return Internal_GetBezierTightBoundingBox(
     m_dim,
-    m_is_rat, 
-    m_order, 
+    m_is_rat ? true : false,
+    m_order,
+    1,
     m_cv_stride,
+    0,
+    m_cv,
+    tight_bbox,
+    bGrowBox,
+    xform
+    );
+}
+
+bool ON_BezierSurface::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    bool bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  return Internal_GetBezierTightBoundingBox(
+    m_dim,
+    m_is_rat ? true : false,
+    m_order[0],
+    m_order[1],
+    m_cv_stride[0],
+    m_cv_stride[1],
     m_cv,
     tight_bbox,
     bGrowBox,
-    xform 
+    xform
     );
 }
 
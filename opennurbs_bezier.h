@@ -293,6 +293,11 @@ public:
 	Returns:
     True if the returned tight_bbox is set to a valid 
     bounding box.
+  Remarks:
+    The control polygon is split where its bounding box extends past
+    the points found so far. The returned box contains the curve and
+    is within ON_SQRT_EPSILON times the size of the control point box
+    of the tight box.
   */
 	bool GetTightBoundingBox( 
 			ON_BoundingBox& tight_bbox, 
@@ -1077,6 +1082,33 @@ public:
 
   ON_BoundingBox BoundingBox() const;
 
+  /*
+	Description:
+    Get tight bounding box of the bezier surface.
+	Parameters:
+		tight_bbox - [in/out] tight bounding box
+		bGrowBox -[in]	(default=false)			
+      If true and the input tight_bbox is valid, then returned
+      tight_bbox is the union of the input tight_bbox and the 
+      tight bounding box of the bezier surface.
+		xform -[in] (default=nullptr)
+      If not nullptr, the tight bounding box of the transformed
+      bezier is calculated.  The bezier surface is not modified.
+	Returns:
+    True if the returned tight_bbox is set to a valid 
+    bounding box.
+  Remarks:
+    The control net is split where its bounding box extends past
+    the corners found so far. The returned box contains the surface
+    and is within ON_SQRT_EPSILON times the size of the control point
+    box of the tight box.
+  */
+	bool GetTightBoundingBox( 
+			ON_BoundingBox& tight_bbox, 
+      bool bGrowBox = false,
+			const ON_Xform* xform = nullptr
+      ) const;
+
   bool Transform( 
          const ON_Xform&
          );
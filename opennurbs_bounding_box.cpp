@@ -2241,6 +2241,223 @@ double ON_BoundingBox::Area() const
   return 0.0;
 }
 
+/*
+Description:
+  3d point list min/max kernel.
+  The loops use branch free min/max with separate x, y, z accumulators
+  so the compiler can vectorize them.  A coordinate that is a nan never
+  replaces a min or max, which matches the comparisons in
+  ON_GetPointListBoundingBox().
+Returns:
+  Number of points in the box. Rational points with zero weight are skipped.
+*/
+template <class T>
+static size_t Internal_PointListMinMax(
+  bool is_rat,
+  size_t count,
+  size_t stride,
+  const T* p,
+  ON_BoundingBox& bbox,
+  bool& bZeroWeight
+)
+{
+  if (is_rat)
+  {
+    size_t n = 0;
+    double minx = 0.0, miny = 0.0, minz = 0.0, maxx = 0.0, maxy = 0.0, maxz = 0.0;
+    for (const T* p1 = p + count * stride; p < p1; p += stride)
+    {
+      const double w = p[3];
+      if (0.0 == w)
+      {
+        bZeroWeight = true;
+        continue;
+      }
+      const double s = 1.0 / w;
+      const double x = s * p[0], y = s * p[1], z = s * p[2];
+      if (0 == n++)
+      {
+        minx = maxx = x;
+        miny = maxy = y;
+        minz = maxz = z;
+        continue;
+      }
+      minx = (x < minx) ? x : minx;
+      miny = (y < miny) ? y : miny;
+      minz = (z < minz) ? z : minz;
+      maxx = (maxx < x) ? x : maxx;
+      maxy = (maxy < y) ? y : maxy;
+      maxz = (maxz < z) ? z : maxz;
+    }
+    if (n > 0)
+    {
+      bbox.m_min.Set(minx, miny, minz);
+      bbox.m_max.Set(maxx, maxy, maxz);
+    }
+    return n;
+  }
+
+  if (0 == count)
+    return 0;
+
+  T minx = p[0], miny = p[1], minz = p[2];
+  T maxx = minx, maxy = miny, maxz = minz;
+  for (size_t i = 1; i < count; i++)
+  {
+    const T* q = p + i * stride;
+    const T x = q[0], y = q[1], z = q[2];
+    minx = (x < minx) ? x : minx;
+    miny = (y < miny) ? y : miny;
+    minz = (z < minz) ? z : minz;
+    maxx = (maxx < x) ? x : maxx;
+    maxy = (maxy < y) ? y : maxy;
+    maxz = (maxz < z) ? z : maxz;
+  }
+  bbox.m_min.Set(minx, miny, minz);
+  bbox.m_max.Set(maxx, maxy, maxz);
+  return count;
+}
+
+template <class T>
+class Internal_PointListBoundingBoxContext
+{
+public:
+  bool m_is_rat = false;
+  size_t m_stride = 0;
+  const T* m_points = nullptr;
+
+  // one partial box per thread
+  ON_BoundingBox* m_bbox = nullptr;
+  size_t* m_bbox_point_count = nullptr;
+  std::atomic<bool> m_bZeroWeight{ false };
+
+  static void Range(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1)
+  {
+    Internal_PointListBoundingBoxContext<T>* ctx = (Internal_PointListBoundingBoxContext<T>*)context;
+    bool bZeroWeight = false;
+    ctx->m_bbox_point_count[thread_index] = Internal_PointListMinMax(
+      ctx->m_is_rat,
+      i1 - i0,
+      ctx->m_stride,
+      ctx->m_points + i0 * ctx->m_stride,
+      ctx->m_bbox[thread_index],
+      bZeroWeight
+    );
+    if (bZeroWeight)
+      ctx->m_bZeroWeight = true;
+  }
+};
+
+template <class T>
+static bool Internal_GetPointListBoundingBox(
+  bool is_rat,
+  size_t count,
+  size_t stride,
+  const T* points,
+  ON_BoundingBox& bbox,
+  bool bGrowBox,
+  bool bParallel
+)
+{
+  if (bGrowBox && false == bbox.IsValid())
+    bGrowBox = false;
+  if (false == bGrowBox)
+    bbox = ON_BoundingBox::EmptyBoundingBox;
+
+  if (0 == count)
+    return bGrowBox;
+  if (nullptr == points || (count > 1 && stride < (is_rat ? 4U : 3U)))
+    return false;
+
+  // A min/max test is a handful of instructions per point, so
+  // threads are only used for very large lists.
+  const size_t min_points_per_thread = 0x10000;
+  const unsigned int thread_count = bParallel ? ON_Parallel::ThreadCount(count, min_points_per_thread, 0) : 1U;
+
+  ON_BoundingBox local_bbox[1];
+  size_t local_point_count[1] = {};
+  ON_SimpleArray<ON_BoundingBox> partial_bbox;
+  ON_SimpleArray<size_t> partial_point_count;
+
+  Internal_PointListBoundingBoxContext<T> ctx;
+  ctx.m_is_rat = is_rat;
+  ctx.m_stride = stride;
+  ctx.m_points = points;
+  if (thread_count > 1)
+  {
+    partial_bbox.Reserve(thread_count);
+    partial_bbox.SetCount(thread_count);
+    partial_point_count.Reserve(thread_count);
+    partial_point_count.SetCount(thread_count);
+    ctx.m_bbox = partial_bbox.Array();
+    ctx.m_bbox_point_count = partial_point_count.Array();
+  }
+  else
+  {
+    ctx.m_bbox = local_bbox;
+    ctx.m_bbox_point_count = local_point_count;
+  }
+
+  ON_ParallelFor(count, min_points_per_thread, thread_count, Internal_PointListBoundingBoxContext<T>::Range, (ON__UINT_PTR)&ctx);
+
+  // Combine the partial boxes in thread order.
+  bool bHavePoints = false;
+  ON_BoundingBox points_bbox;
+  for (unsigned int i = 0; i < thread_count; i++)
+  {
+    if (0 == ctx.m_bbox_point_count[i])
+      continue;
+    const ON_BoundingBox& b = ctx.m_bbox[i];
+    if (false == bHavePoints)
+    {
+      points_bbox = b;
+      bHavePoints = true;
+      continue;
+    }
+    for (int j = 0; j < 3; j++)
+    {
+      if (b.m_min[j] < points_bbox.m_min[j])
+        points_bbox.m_min[j] = b.m_min[j];
+      if (points_bbox.m_max[j] < b.m_max[j])
+        points_bbox.m_max[j] = b.m_max[j];
+    }
+  }
+
+  if (false == bHavePoints)
+    return false;
+
+  if (bGrowBox)
+    bbox.Union(points_bbox);
+  else
+    bbox = points_bbox;
+
+  return (false == ctx.m_bZeroWeight);
+}
+
+bool ON_BoundingBox::SetFromPointList(
+  bool is_rat,
+  size_t point_count,
+  size_t point_stride,
+  const double* point_list,
+  bool bGrowBox,
+  bool bParallel
+)
+{
+  return Internal_GetPointListBoundingBox(is_rat, point_count, point_stride, point_list, *this, bGrowBox, bParallel);
+}
+
+bool ON_BoundingBox::SetFromPointList(
+  bool is_rat,
+  size_t point_count,
+  size_t point_stride,
+  const float* point_list,
+  bool bGrowBox,
+  bool bParallel
+)
+{
+  return Internal_GetPointListBoundingBox(is_rat, point_count, point_stride, point_list, *this, bGrowBox, bParallel);
+}
+
 bool ON_BoundingBox::Set(     
     int dim, bool is_rat, int count, int stride, 
     const double* points, 
@@ -2378,6 +2595,11 @@ bool ON_GetPointListBoundingBox(
     {
       xform = 0;
     }
+    if ( nullptr == xform && 3 == dim )
+    {
+      // common case - 3d points
+      return Internal_GetPointListBoundingBox( is_rat?true:false, (size_t)count, (size_t)stride, points, tight_bbox, bGrowBox?true:false, false );
+    }
     wi = dim;
     if ( dim > 3 )
     {
@@ -2540,6 +2762,11 @@ bool ON_GetPointListBoundingBox(
     {
       xform = 0;
     }
+    if ( nullptr == xform && 3 == dim )
+    {
+      // common case - 3d points
+      return Internal_GetPointListBoundingBox( is_rat?true:false, (size_t)count, (size_t)stride, points, tight_bbox, bGrowBox?true:false, false );
+    }
     wi = dim;
     if ( dim > 3 )
     {
@@ -2711,6 +2938,19 @@ OUTPUT:
       bGrowBox = false;
   }
 
+  if ( 3 == dim && count > 0 && points && (count == 1 || stride >= (is_rat?4:3)) )
+  {
+    // common case - 3d points
+    ON_BoundingBox bbox = bGrowBox ? ON_BoundingBox(ON_3dPoint(boxmin),ON_3dPoint(boxmax)) : ON_BoundingBox::EmptyBoundingBox;
+    rc = Internal_GetPointListBoundingBox( is_rat?true:false, (size_t)count, (size_t)stride, points, bbox, bGrowBox?true:false, false );
+    if ( bbox.IsNotEmpty() )
+    {
+      memcpy( boxmin, &bbox.m_min.x, 3*sizeof(*boxmin) );
+      memcpy( boxmax, &bbox.m_max.x, 3*sizeof(*boxmax) );
+    }
+    return rc;
+  }
+
   if ( count > 0 ) 
   {
     if ( is_rat )
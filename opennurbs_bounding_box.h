@@ -209,6 +209,48 @@ public:
   bool Set(     
     const ON_SimpleArray<ON_2fPoint>& point_array,
     int bGrowBox = false
+    );
+
+  /*
+  Description:
+    Set or expand this box to enclose a list of 3d points.
+    This is the fast path used by the Set() and ON_GetPointListBoundingBox()
+    functions for 3d point lists and it is intended for large lists like
+    mesh vertices and point cloud points.
+  Parameters:
+    is_rat - [in]
+      true if the points are homogeneous (x,y,z,w).
+      Points with w = 0 are ignored.
+    point_count - [in]
+    point_stride - [in]
+      >= 3 (>= 4 when is_rat is true)
+    point_list - [in]
+    bGrowBox - [in]
+      If true and this box is valid, the result is the union of
+      this box and the bounding box of the points.
+    bParallel - [in]
+      If true and point_count is large, the list is divided among threads
+      and the partial boxes are combined.
+  Returns:
+    True if successful.
+    False if the input is not valid or a rational point had a zero weight.
+  */
+  bool SetFromPointList(
+    bool is_rat,
+    size_t point_count,
+    size_t point_stride,
+    const double* point_list,
+    bool bGrowBox,
+    bool bParallel
+    );
+
+  bool SetFromPointList(
+    bool is_rat,
+    size_t point_count,
+    size_t point_stride,
+    const float* point_list,
+    bool bGrowBox,
+    bool bParallel
     );
 
 	bool IsPointIn(
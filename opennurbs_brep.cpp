@@ -1301,6 +1301,8 @@ void ON_Brep::Initialize()
   m_is_solid = 0;
   m_bbox.Destroy();
   m_region_topology = nullptr;
+  m_component_tree = nullptr;
+  m_shared_geometry = nullptr;
 }
 
 ON_Brep* ON_Brep::New() 
@@ -1366,9 +1368,13 @@ ON_Brep::ON_Brep(const ON_Brep& src) : ON_Geometry(src)
 ON_Brep::~ON_Brep()
 { 
   DestroyMesh(ON::any_mesh);
+  // shared geometry must be released before m_C2, m_C3 and m_S
+  // delete their curves and surfaces.
+  Internal_ReleaseSharedGeometry();
   // everything is in array classes that destroy themselves.
   delete m_region_topology;
   m_region_topology = 0;
+  DestroyComponentTree();
 }
 
 unsigned int ON_Brep::SizeOf() const
@@ -1532,6 +1538,9 @@ bool ON_Brep::Transform( const ON_Xform& xform )
   bool rc = true;
   
   DestroyRuntimeCache();
+  // Only 3d curves and surfaces are transformed. The 2d trimming
+  // curves in m_C2[] stay shared.
+  Internal_UnshareGeometry(false);
 
   int is_similarity = xform.IsSimilarity();
   const double det = xform.Determinant();
@@ -4625,21 +4634,17 @@ bool ON_Brep::IsCorrupt(
 }
 
 
-bool ON_Brep::IsValid( ON_TextLog* text_log ) const
+// Checks that the component arrays needed by the brep's faces and edges are not empty.
+static bool Internal_IsValidBrepComponentCounts(const ON_Brep& brep, ON_TextLog* text_log)
 {
-  if (IsCorrupt(false, true, text_log))
-    return false;
-
-  const int curve2d_count = m_C2.Count();
-  const int curve3d_count = m_C3.Count();
-  const int surface_count = m_S.Count();
-  const int vertex_count  = m_V.Count();
-  const int edge_count    = m_E.Count();
-  const int trim_count    = m_T.Count();
-  const int loop_count    = m_L.Count();
-  const int face_count    = m_F.Count();
-
-  int c2i, c3i, si, vi, ei, fi, ti, li;
+  const int curve2d_count = brep.m_C2.Count();
+  const int curve3d_count = brep.m_C3.Count();
+  const int surface_count = brep.m_S.Count();
+  const int vertex_count  = brep.m_V.Count();
+  const int edge_count    = brep.m_E.Count();
+  const int trim_count    = brep.m_T.Count();
+  const int loop_count    = brep.m_L.Count();
+  const int face_count    = brep.m_F.Count();
 
   if ( 0 == face_count && 0 == edge_count && 0 == vertex_count )
   {
@@ -4698,792 +4703,1037 @@ bool ON_Brep::IsValid( ON_TextLog* text_log ) const
     }
   }
 
-  // check element indices match array positions
-  for ( vi = 0; vi < vertex_count; vi++ ) 
-  {
-    if ( m_V[vi].m_vertex_index == -1 )
-    {
-      const ON_BrepVertex& vertex = m_V[vi];
-      if ( vertex.m_ei.Count() > 0 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_V[%d] is deleted (m_vertex_index = -1) but vertex.m_ei.Count() = %d.\n",
-                           vi, vertex.m_ei.Count() );
-        return ON_BrepIsNotValid();
-      }
-    }
-    else if ( m_V[vi].m_vertex_index != vi )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_V[%d].m_vertex_index = %d (should be %d)\n",
-                         vi, m_V[vi].m_vertex_index, vi );
-      return ON_BrepIsNotValid();
-    }
-  }
+  return true;
+}
 
-  for ( ei = 0; ei < edge_count; ei++ ) 
+// Checks that m_V[vi].m_vertex_index is vi or that a deleted vertex is not referenced.
+static bool Internal_IsValidBrepVertexIndex(const ON_Brep& brep, int vi, ON_TextLog* text_log)
+{
+  if ( brep.m_V[vi].m_vertex_index == -1 )
   {
-    if ( m_E[ei].m_edge_index == -1 )
-    {
-      const ON_BrepEdge& edge = m_E[ei];
-      if ( edge.m_ti.Count() > 0 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_ti.Count() = %d.\n",
-                           ei, edge.m_ti.Count() );
-        return ON_BrepIsNotValid();
-      }
-      if ( edge.m_c3i != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_c3i=%d (should be -1).\n",
-                           ei, edge.m_c3i );
-        return ON_BrepIsNotValid();
-      }
-      if ( edge.ProxyCurve() )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_curve is not nullptr.\n",
-                           ei );
-        return ON_BrepIsNotValid();
-      }
-      if ( edge.m_vi[0] != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_vi[0]=%d (should be -1).\n",
-                           ei, edge.m_vi[0] );
-        return ON_BrepIsNotValid();
-      }
-      if ( edge.m_vi[1] != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_vi[1]=%d (should be -1).\n",
-                           ei, edge.m_vi[1] );
-        return ON_BrepIsNotValid();
-      }
-    }
-    else if ( m_E[ei].m_edge_index != ei )
+    const ON_BrepVertex& vertex = brep.m_V[vi];
+    if ( vertex.m_ei.Count() > 0 )
     {
       if ( text_log )
-        text_log->Print( "ON_Brep.m_E[%d].m_edge_index = %d (should be %d)\n",
-                         ei, m_E[ei].m_edge_index, ei );
+        text_log->Print( "ON_Brep.m_V[%d] is deleted (m_vertex_index = -1) but vertex.m_ei.Count() = %d.\n",
+                         vi, vertex.m_ei.Count() );
       return ON_BrepIsNotValid();
     }
   }
-
-  for ( ti = 0; ti < trim_count; ti++ ) 
+  else if ( brep.m_V[vi].m_vertex_index != vi )
   {
-    if ( m_T[ti].m_trim_index == -1 )
-    {
-      const ON_BrepTrim& trim = m_T[ti];
-      if ( trim.m_ei != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_ei=%d (should be -1).\n",
-                           ti, trim.m_ei );
-        return ON_BrepIsNotValid();
-      }
-      if ( trim.m_li != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_li=%d (should be -1).\n",
-                           ti, trim.m_li );
-        return ON_BrepIsNotValid();
-      }
-      if ( trim.m_c2i != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_c2i=%d (should be -1).\n",
-                           ti, trim.m_c2i );
-        return ON_BrepIsNotValid();
-      }
-      if ( trim.m_vi[0] != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_vi[0]=%d (should be -1).\n",
-                           ti, trim.m_vi[0] );
-        return ON_BrepIsNotValid();
-      }
-      if ( trim.m_vi[1] != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_vi[1]=%d (should be -1).\n",
-                           ti, trim.m_vi[1] );
-        return ON_BrepIsNotValid();
-      }
-    }
-    else if ( m_T[ti].m_trim_index != ti  )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_T[%d].m_trim_index = %d (should be %d)\n",
-                         ti, m_T[ti].m_trim_index, ti );
-      return ON_BrepIsNotValid();
-    }
-    else if ( !m_T[ti].IsValid( text_log ) )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_T[%d] is not valid\n",ti );
-      return ON_BrepIsNotValid();
-    }
+    if ( text_log )
+      text_log->Print( "ON_Brep.m_V[%d].m_vertex_index = %d (should be %d)\n",
+                       vi, brep.m_V[vi].m_vertex_index, vi );
+    return ON_BrepIsNotValid();
   }
+  return true;
+}
 
-  for ( li = 0; li < loop_count; li++ ) 
+// Checks that m_E[ei].m_edge_index is ei or that a deleted edge is not referenced.
+static bool Internal_IsValidBrepEdgeIndex(const ON_Brep& brep, int ei, ON_TextLog* text_log)
+{
+  if ( brep.m_E[ei].m_edge_index == -1 )
   {
-    if ( m_L[li].m_loop_index == -1 )
-    {
-      const ON_BrepLoop& loop = m_L[li];
-      if ( loop.m_fi != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_L[%d] is deleted (m_loop_index = -1) but loop.m_fi=%d (should be -1).\n",
-                           li, loop.m_fi );
-        return ON_BrepIsNotValid();
-      }
-      if ( loop.m_ti.Count() > 0 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_L[%d] is deleted (m_loop_index = -1) but loop.m_ti.Count()=%d.\n",
-                           li, loop.m_ti.Count() );
-        return ON_BrepIsNotValid();
-      }
-    }
-    else if ( m_L[li].m_loop_index != li )
+    const ON_BrepEdge& edge = brep.m_E[ei];
+    if ( edge.m_ti.Count() > 0 )
     {
       if ( text_log )
-        text_log->Print( "ON_Brep.m_L[%d].m_loop_index = %d (should be %d)\n",
-                         li, m_L[li].m_loop_index, li );
+        text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_ti.Count() = %d.\n",
+                         ei, edge.m_ti.Count() );
       return ON_BrepIsNotValid();
     }
-  }
-
-  for ( fi = 0; fi < face_count; fi++ ) 
-  {
-    if ( m_F[fi].m_face_index == -1 )
-    {
-      const ON_BrepFace& face = m_F[fi];
-      if ( face.m_si != -1 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.m_si=%d (should be -1).\n",
-                           fi, face.m_si );
-        return ON_BrepIsNotValid();
-      }
-      if ( face.ProxySurface() )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.ProxySurface() is not nullptr.\n",
-                           fi );
-        return ON_BrepIsNotValid();
-      }
-      if ( face.m_li.Count() > 0 )
-      {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.m_li.Count()=%d.\n",
-                           fi, face.m_li.Count() );
-        return ON_BrepIsNotValid();
-      }
-    }
-    else if ( m_F[fi].m_face_index != fi )
+    if ( edge.m_c3i != -1 )
     {
       if ( text_log )
-        text_log->Print( "ON_Brep.m_F[%d].m_face_index = %d (should be %d)\n",
-                         fi, m_F[fi].m_face_index, fi );
+        text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_c3i=%d (should be -1).\n",
+                         ei, edge.m_c3i );
       return ON_BrepIsNotValid();
     }
-  }
-
-  // check 2d curve geometry
-  for ( c2i = 0; c2i < curve2d_count; c2i++ ) {
-    if ( !m_C2[c2i] )
-    {
-      continue;
-      // nullptr 2d curves are ok if they are not referenced
-      //if ( text_log )
-      //  text_log->Print("ON_Brep.m_C2[%d] is nullptr.\n",c2i);
-      //return ON_BrepIsNotValid();
-    }
-    if ( !m_C2[c2i]->IsValid(text_log) )
+    if ( edge.ProxyCurve() )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_C2[%d] is invalid.\n",c2i);
+        text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_curve is not nullptr.\n",
+                         ei );
       return ON_BrepIsNotValid();
     }
-    int c2_dim = m_C2[c2i]->Dimension();
-    if ( c2_dim != 2 )
+    if ( edge.m_vi[0] != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_C2[%d]->Dimension() = %d (should be 2).\n", c2i, c2_dim );
+        text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_vi[0]=%d (should be -1).\n",
+                         ei, edge.m_vi[0] );
       return ON_BrepIsNotValid();
     }
-    const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(m_C2[c2i]);
-    if ( polycurve && polycurve->IsNested() )
+    if ( edge.m_vi[1] != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_C2[%d] is a nested polycurve.\n", c2i );
+        text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_vi[1]=%d (should be -1).\n",
+                         ei, edge.m_vi[1] );
       return ON_BrepIsNotValid();
     }
   }
+  else if ( brep.m_E[ei].m_edge_index != ei )
+  {
+    if ( text_log )
+      text_log->Print( "ON_Brep.m_E[%d].m_edge_index = %d (should be %d)\n",
+                       ei, brep.m_E[ei].m_edge_index, ei );
+    return ON_BrepIsNotValid();
+  }
+  return true;
+}
 
-  // check 3d curve geometry
-  for ( c3i = 0; c3i < curve3d_count; c3i++ ) {
-    if ( !m_C3[c3i] )
-    {
-      continue;
-      // nullptr 3d curves are ok if they are not referenced
-      //if ( text_log )
-      //  text_log->Print("ON_Brep.m_C3[%d] is nullptr.\n",c3i);
-      //return ON_BrepIsNotValid();
-    }
-    if ( !m_C3[c3i]->IsValid(text_log) )
+// Checks that m_T[ti].m_trim_index is ti or that a deleted trim is not referenced.
+static bool Internal_IsValidBrepTrimIndex(const ON_Brep& brep, int ti, ON_TextLog* text_log)
+{
+  if ( brep.m_T[ti].m_trim_index == -1 )
+  {
+    const ON_BrepTrim& trim = brep.m_T[ti];
+    if ( trim.m_ei != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_C3[%d] is invalid.\n",c3i);
+        text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_ei=%d (should be -1).\n",
+                         ti, trim.m_ei );
       return ON_BrepIsNotValid();
     }
-    int c3_dim = m_C3[c3i]->Dimension();
-    if ( c3_dim != 3 )
+    if ( trim.m_li != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_C3[%d]->Dimension() = %d (should be 3).\n", c3i, c3_dim );
+        text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_li=%d (should be -1).\n",
+                         ti, trim.m_li );
       return ON_BrepIsNotValid();
     }
-    const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(m_C3[c3i]);
-    if ( polycurve && polycurve->IsNested() )
+    if ( trim.m_c2i != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_C3[%d] is a nested polycurve.\n", c3i );
+        text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_c2i=%d (should be -1).\n",
+                         ti, trim.m_c2i );
       return ON_BrepIsNotValid();
     }
-  }
-
-  // check 3d surface geometry
-  for ( si = 0; si < surface_count; si++ ) {
-    if ( !m_S[si] )
-    {
-      continue;
-      // nullptr 3d surfaces are ok if they are not referenced
-      //if ( text_log )
-      //  text_log->Print("ON_Brep.m_S[%d] is nullptr.\n",si);
-      //return ON_BrepIsNotValid();
-    }
-    if ( !m_S[si]->IsValid(text_log) )
+    if ( trim.m_vi[0] != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_S[%d] is invalid.\n",si);
+        text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_vi[0]=%d (should be -1).\n",
+                         ti, trim.m_vi[0] );
       return ON_BrepIsNotValid();
     }
-    int dim = m_S[si]->Dimension();
-    if ( dim != 3 )
+    if ( trim.m_vi[1] != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_S[%d]->Dimension() = %d (should be 3).\n", si, dim );
-      return ON_BrepIsNotValid();
-    }
-  }
-
-  // check vertices
-  for ( vi = 0; vi < vertex_count; vi++ ) {
-    if ( m_V[vi].m_vertex_index == -1 )
-      continue;
-    if ( !IsValidVertex( vi, text_log ) ) {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_V[%d] is invalid.\n",vi);
+        text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_vi[1]=%d (should be -1).\n",
+                         ti, trim.m_vi[1] );
       return ON_BrepIsNotValid();
     }
   }
-
-  // check edges
-  for ( ei = 0; ei < edge_count; ei++ ) 
+  else if ( brep.m_T[ti].m_trim_index != ti  )
   {
-    if ( m_E[ei].m_edge_index == -1 )
-      continue;
-    if ( !IsValidEdge( ei, text_log ) ) {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_E[%d] is invalid.\n",ei);
-      return ON_BrepIsNotValid();
-    }
+    if ( text_log )
+      text_log->Print( "ON_Brep.m_T[%d].m_trim_index = %d (should be %d)\n",
+                       ti, brep.m_T[ti].m_trim_index, ti );
+    return ON_BrepIsNotValid();
   }
-
-  // check faces
-  for ( fi = 0; fi < face_count; fi++ ) 
+  else if ( !brep.m_T[ti].IsValid( text_log ) )
   {
-    if ( m_F[fi].m_face_index == -1 )
-      continue;
-    if ( !IsValidFace( fi, text_log ) ) {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_F[%d] is invalid.\n",fi);
-      return ON_BrepIsNotValid();
-    }
+    if ( text_log )
+      text_log->Print( "ON_Brep.m_T[%d] is not valid\n",ti );
+    return ON_BrepIsNotValid();
   }
+  return true;
+}
 
-  // Check loops - this check is necessary at the brep level
-  // to make sure there are no orphaned loops.
-  // ON_Brep::IsValidLoop(), which is called by ON_Brep::IsValidFace(),
-  // performs loop-trim bookkeeping checks on all loops that are referenced
-  // by a face.
-  for ( li = 0; li < loop_count; li++ )
+// Checks that m_L[li].m_loop_index is li or that a deleted loop is not referenced.
+static bool Internal_IsValidBrepLoopIndex(const ON_Brep& brep, int li, ON_TextLog* text_log)
+{
+  if ( brep.m_L[li].m_loop_index == -1 )
   {
-    const ON_BrepLoop& loop = m_L[li];
-    if ( m_L[li].m_loop_index == -1 )
-      continue;
-    if ( loop.m_fi < 0 || loop.m_fi >= m_F.Count() )
+    const ON_BrepLoop& loop = brep.m_L[li];
+    if ( loop.m_fi != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_L[%d].m_fi = %d is not invalid.\n",li,loop.m_fi);
+        text_log->Print( "ON_Brep.m_L[%d] is deleted (m_loop_index = -1) but loop.m_fi=%d (should be -1).\n",
+                         li, loop.m_fi );
       return ON_BrepIsNotValid();
     }
-    if ( m_F[loop.m_fi].m_face_index != loop.m_fi )
+    if ( loop.m_ti.Count() > 0 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_L[%d].m_fi = %d is a deleted face.\n",li,loop.m_fi);
+        text_log->Print( "ON_Brep.m_L[%d] is deleted (m_loop_index = -1) but loop.m_ti.Count()=%d.\n",
+                         li, loop.m_ti.Count() );
       return ON_BrepIsNotValid();
     }
-
-    // This for() loop check is performed in IsValidLoop() which is 
-    // called by IsValidFace() in the "check faces" loop above.  
-    // I think it can be removed.  If anybody every sees this code
-    // find a flaw, please tell Dale Lear.
-    for ( int lti = 0; lti < loop.m_ti.Count(); lti++ )
-    {
-      ti = loop.m_ti[lti];
-      if ( ti < 0 || ti >= m_T.Count() )
-      {
-        if ( text_log )
-          text_log->Print("ON_Brep.m_L[%d].m_ti[%d] = %d is not invalid.\n",li,lti,ti);
-        return ON_BrepIsNotValid();
-      }
-      if ( m_T[ti].m_trim_index != ti )
-      {
-        if ( text_log )
-          text_log->Print("ON_Brep.m_L[%d].m_ti[%d] = %d is a deleted trim.\n",li,lti,ti);
-        return ON_BrepIsNotValid();
-      }
-    }
   }
-
-  // check trims - this check is necessary at the brep 
-  // level to make sure there are no orphan trims and 
-  // to test tolerances.  Most of these tests are duplicates 
-  // of ones in ON_Brep::IsValidTrim, which is called by 
-  // ON_Brep::IsValidLoop, which is called by ON_Brep::IsValidFace.
-  int seam_trim_count = 0;
-  for ( ti = 0; ti < trim_count; ti++ )
+  else if ( brep.m_L[li].m_loop_index != li )
   {
-    const ON_BrepTrim& trim = m_T[ti];
-    if ( trim.m_trim_index == -1 )
-      continue;
-
-    if ( trim.m_vi[0] < 0 || trim.m_vi[0] >= m_V.Count() )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_vi[0] = %d is not invalid.\n",ti,trim.m_vi[0]);
-      return ON_BrepIsNotValid();
-    }
-    if ( trim.m_vi[1] < 0 || trim.m_vi[1] >= m_V.Count() )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_vi[1] = %d is not invalid.\n",ti,trim.m_vi[1]);
-      return ON_BrepIsNotValid();
-    }
-
-    if ( m_V[trim.m_vi[0]].m_vertex_index != trim.m_vi[0] )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_vi[0] is deleted.\n",ti);
-      return ON_BrepIsNotValid();
-    }
-    if ( m_V[trim.m_vi[1]].m_vertex_index != trim.m_vi[1] )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_vi[1] is deleted.\n",ti);
-      return ON_BrepIsNotValid();
-    }
-
-    if ( trim.m_c2i < 0 || trim.m_c2i >= m_C2.Count() )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_c2i = %d is not valid.\n",ti,trim.m_c2i);
-      return ON_BrepIsNotValid();
-    }
+    if ( text_log )
+      text_log->Print( "ON_Brep.m_L[%d].m_loop_index = %d (should be %d)\n",
+                       li, brep.m_L[li].m_loop_index, li );
+    return ON_BrepIsNotValid();
+  }
+  return true;
+}
 
-    if ( 0 == m_C2[trim.m_c2i] )
+// Checks that m_F[fi].m_face_index is fi or that a deleted face is not referenced.
+static bool Internal_IsValidBrepFaceIndex(const ON_Brep& brep, int fi, ON_TextLog* text_log)
+{
+  if ( brep.m_F[fi].m_face_index == -1 )
+  {
+    const ON_BrepFace& face = brep.m_F[fi];
+    if ( face.m_si != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_c2i = %d, but m_C2[%d] is nullptr.\n",ti,trim.m_c2i,trim.m_c2i);
+        text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.m_si=%d (should be -1).\n",
+                         fi, face.m_si );
       return ON_BrepIsNotValid();
     }
-
-    if ( trim.m_li < 0 || trim.m_li >= m_L.Count() )
+    if ( face.ProxySurface() )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_li = %d is not valid.\n",ti,trim.m_li);
+        text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.ProxySurface() is not nullptr.\n",
+                         fi );
       return ON_BrepIsNotValid();
     }
-
-    if ( m_L[trim.m_li].m_loop_index != trim.m_li )
+    if ( face.m_li.Count() > 0 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_li = %d is a deleted loop.\n",ti,trim.m_li);
+        text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.m_li.Count()=%d.\n",
+                         fi, face.m_li.Count() );
       return ON_BrepIsNotValid();
     }
+  }
+  else if ( brep.m_F[fi].m_face_index != fi )
+  {
+    if ( text_log )
+      text_log->Print( "ON_Brep.m_F[%d].m_face_index = %d (should be %d)\n",
+                       fi, brep.m_F[fi].m_face_index, fi );
+    return ON_BrepIsNotValid();
+  }
+  return true;
+}
 
-    {
-      const ON_Curve* c2 = m_C2[trim.m_c2i];
-      const ON_Surface* srf = m_S[m_F[m_L[trim.m_li].m_fi].m_si];
-      if ( srf )
-      {
-        ON_Interval PD = trim.ProxyCurveDomain();
-        ON_Surface::ISO iso = srf->IsIsoparametric(*c2, &PD);
-        if ( trim.m_iso != iso )
-        {
-          if ( text_log )
-            text_log->Print("ON_Brep.m_T[%d].m_iso = %d and it should be %d\n",ti,trim.m_iso,iso);
-          return ON_BrepIsNotValid();
-        }
-      }
-    }
+// Checks brep.m_C2[c2i]. nullptr curves are ok if they are not referenced.
+static bool Internal_IsValidBrepCurve2d(const ON_Brep& brep, int c2i, ON_TextLog* text_log)
+{
+  if ( !brep.m_C2[c2i] )
+  {
+    return true;
+    // nullptr 2d curves are ok if they are not referenced
+    //if ( text_log )
+    //  text_log->Print("ON_Brep.m_C2[%d] is nullptr.\n",c2i);
+    //return ON_BrepIsNotValid();
+  }
+  if ( !brep.m_C2[c2i]->IsValid(text_log) )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_C2[%d] is invalid.\n",c2i);
+    return ON_BrepIsNotValid();
+  }
+  int c2_dim = brep.m_C2[c2i]->Dimension();
+  if ( c2_dim != 2 )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_C2[%d]->Dimension() = %d (should be 2).\n", c2i, c2_dim );
+    return ON_BrepIsNotValid();
+  }
+  const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(brep.m_C2[c2i]);
+  if ( polycurve && polycurve->IsNested() )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_C2[%d] is a nested polycurve.\n", c2i );
+    return ON_BrepIsNotValid();
+  }
+  return true;
+}
 
-    if ( trim.m_type == ON_BrepTrim::singular )
-    {
-      if ( trim.m_ei != -1 )
-      {
-        if ( text_log )
-          text_log->Print("ON_Brep.m_T[%d].m_type = singular, but m_ei = %d (should be -1).\n",ti,trim.m_ei);
-        return ON_BrepIsNotValid();
-      }
-      continue;
-    }
+// Checks brep.m_C3[c3i]. nullptr curves are ok if they are not referenced.
+static bool Internal_IsValidBrepCurve3d(const ON_Brep& brep, int c3i, ON_TextLog* text_log)
+{
+  if ( !brep.m_C3[c3i] )
+  {
+    return true;
+    // nullptr 3d curves are ok if they are not referenced
+    //if ( text_log )
+    //  text_log->Print("ON_Brep.m_C3[%d] is nullptr.\n",c3i);
+    //return ON_BrepIsNotValid();
+  }
+  if ( !brep.m_C3[c3i]->IsValid(text_log) )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_C3[%d] is invalid.\n",c3i);
+    return ON_BrepIsNotValid();
+  }
+  int c3_dim = brep.m_C3[c3i]->Dimension();
+  if ( c3_dim != 3 )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_C3[%d]->Dimension() = %d (should be 3).\n", c3i, c3_dim );
+    return ON_BrepIsNotValid();
+  }
+  const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(brep.m_C3[c3i]);
+  if ( polycurve && polycurve->IsNested() )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_C3[%d] is a nested polycurve.\n", c3i );
+    return ON_BrepIsNotValid();
+  }
+  return true;
+}
 
-    if ( trim.m_ei < 0 || trim.m_ei >= m_E.Count() )
+// Checks brep.m_S[si]. nullptr surfaces are ok if they are not referenced.
+static bool Internal_IsValidBrepSurface(const ON_Brep& brep, int si, ON_TextLog* text_log)
+{
+  if ( !brep.m_S[si] )
+  {
+    return true;
+    // nullptr 3d surfaces are ok if they are not referenced
+    //if ( text_log )
+    //  text_log->Print("ON_Brep.m_S[%d] is nullptr.\n",si);
+    //return ON_BrepIsNotValid();
+  }
+  if ( !brep.m_S[si]->IsValid(text_log) )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_S[%d] is invalid.\n",si);
+    return ON_BrepIsNotValid();
+  }
+  int dim = brep.m_S[si]->Dimension();
+  if ( dim != 3 )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_S[%d]->Dimension() = %d (should be 3).\n", si, dim );
+    return ON_BrepIsNotValid();
+  }
+  return true;
+}
+
+// Check loops - this check is necessary at the brep level
+// to make sure there are no orphaned loops.
+// ON_Brep::IsValidLoop(), which is called by ON_Brep::IsValidFace(),
+// performs loop-trim bookkeeping checks on all loops that are referenced
+// by a face.
+static bool Internal_IsValidBrepLoopFace(const ON_Brep& brep, int li, ON_TextLog* text_log)
+{
+  const ON_BrepLoop& loop = brep.m_L[li];
+  if ( brep.m_L[li].m_loop_index == -1 )
+    return true;
+  if ( loop.m_fi < 0 || loop.m_fi >= brep.m_F.Count() )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_L[%d].m_fi = %d is not invalid.\n",li,loop.m_fi);
+    return ON_BrepIsNotValid();
+  }
+  if ( brep.m_F[loop.m_fi].m_face_index != loop.m_fi )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_L[%d].m_fi = %d is a deleted face.\n",li,loop.m_fi);
+    return ON_BrepIsNotValid();
+  }
+
+  // This for() loop check is performed in IsValidLoop() which is 
+  // called by IsValidFace() in the "check faces" loop above.  
+  // I think it can be removed.  If anybody every sees this code
+  // find a flaw, please tell Dale Lear.
+  for ( int lti = 0; lti < loop.m_ti.Count(); lti++ )
+  {
+    const int ti = loop.m_ti[lti];
+    if ( ti < 0 || ti >= brep.m_T.Count() )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_ei = %d is not invalid.\n",ti,trim.m_ei);
+        text_log->Print("ON_Brep.m_L[%d].m_ti[%d] = %d is not invalid.\n",li,lti,ti);
       return ON_BrepIsNotValid();
     }
-    
-    const ON_BrepEdge& edge = m_E[trim.m_ei];
-    if ( edge.m_edge_index != trim.m_ei )
+    if ( brep.m_T[ti].m_trim_index != ti )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_ei is deleted.\n",ti);
+        text_log->Print("ON_Brep.m_L[%d].m_ti[%d] = %d is a deleted trim.\n",li,lti,ti);
       return ON_BrepIsNotValid();
     }
+  }
+  return true;
+}
+
+static bool Internal_IsValidBrepTrimInBrep(const ON_Brep& brep, int ti, ON_TextLog* text_log)
+{
+  const ON_BrepTrim& trim = brep.m_T[ti];
+  if ( trim.m_trim_index == -1 )
+    return true;
+
+  if ( trim.m_vi[0] < 0 || trim.m_vi[0] >= brep.m_V.Count() )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_vi[0] = %d is not invalid.\n",ti,trim.m_vi[0]);
+    return ON_BrepIsNotValid();
+  }
+  if ( trim.m_vi[1] < 0 || trim.m_vi[1] >= brep.m_V.Count() )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_vi[1] = %d is not invalid.\n",ti,trim.m_vi[1]);
+    return ON_BrepIsNotValid();
+  }
+
+  if ( brep.m_V[trim.m_vi[0]].m_vertex_index != trim.m_vi[0] )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_vi[0] is deleted.\n",ti);
+    return ON_BrepIsNotValid();
+  }
+  if ( brep.m_V[trim.m_vi[1]].m_vertex_index != trim.m_vi[1] )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_vi[1] is deleted.\n",ti);
+    return ON_BrepIsNotValid();
+  }
+
+  if ( trim.m_c2i < 0 || trim.m_c2i >= brep.m_C2.Count() )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_c2i = %d is not valid.\n",ti,trim.m_c2i);
+    return ON_BrepIsNotValid();
+  }
+
+  if ( 0 == brep.m_C2[trim.m_c2i] )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_c2i = %d, but m_C2[%d] is nullptr.\n",ti,trim.m_c2i,trim.m_c2i);
+    return ON_BrepIsNotValid();
+  }
+
+  if ( trim.m_li < 0 || trim.m_li >= brep.m_L.Count() )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_li = %d is not valid.\n",ti,trim.m_li);
+    return ON_BrepIsNotValid();
+  }
+
+  if ( brep.m_L[trim.m_li].m_loop_index != trim.m_li )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_li = %d is a deleted loop.\n",ti,trim.m_li);
+    return ON_BrepIsNotValid();
+  }
 
-    const int evi0 = trim.m_bRev3d ? 1 : 0;
-    const int evi1 = trim.m_bRev3d ? 0 : 1;
-    if ( trim.m_vi[0] != edge.m_vi[evi0] )
+  {
+    const ON_Curve* c2 = brep.m_C2[trim.m_c2i];
+    const ON_Surface* srf = brep.m_S[brep.m_F[brep.m_L[trim.m_li].m_fi].m_si];
+    if ( srf )
     {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_bRev3d = %d, but m_vi[0] != m_E[m_ei].m_vi[%d].\n",ti,trim.m_bRev3d,evi0);
-      return ON_BrepIsNotValid();
+      ON_Interval PD = trim.ProxyCurveDomain();
+      ON_Surface::ISO iso = srf->IsIsoparametric(*c2, &PD);
+      if ( trim.m_iso != iso )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_T[%d].m_iso = %d and it should be %d\n",ti,trim.m_iso,iso);
+        return ON_BrepIsNotValid();
+      }
     }
-    if ( trim.m_vi[1] != edge.m_vi[evi1] )
+  }
+
+  if ( trim.m_type == ON_BrepTrim::singular )
+  {
+    if ( trim.m_ei != -1 )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_bRev3d = %d, but m_vi[0] != m_E[m_ei].m_vi[%d].\n",ti,trim.m_bRev3d,evi1);
+        text_log->Print("ON_Brep.m_T[%d].m_type = singular, but m_ei = %d (should be -1).\n",ti,trim.m_ei);
       return ON_BrepIsNotValid();
     }
+    return true;
+  }
 
-    // check tolerances and closed curve directions
-    {
-      ON_3dPoint trim_pt0, trim_pt1, srf_pt0, srf_pt1;
-      ON_3dVector trim_der0, trim_der1, srf_du0, srf_dv0, srf_du1, srf_dv1;
-      ON_Interval trim_domain = trim.Domain();
-      // trim_pt0 should be closed to trim_pt1 except when
-      // trim starts and ends on opposite sides of a surface 
-      // seam.  Even when the trim curve is closed, the 
-      // derivatives can be different when there is
-      // a kink at the start/end of a trim.
-      trim.Ev1Der( trim_domain[0], trim_pt0, trim_der0 );
-      trim.Ev1Der( trim_domain[1], trim_pt1, trim_der1 );
-
-      const ON_Surface* trim_srf = m_F[ m_L[trim.m_li].m_fi ].SurfaceOf();
-      trim_srf->Ev1Der( trim_pt0.x, trim_pt0.y, srf_pt0, srf_du0, srf_dv0 );
-      trim_srf->Ev1Der( trim_pt1.x, trim_pt1.y, srf_pt1, srf_du1, srf_dv1 );
-
-      // estimate 3d tolerances from 2d trim tolerances
-      double t0_tol = srf_du0.Length()*trim.m_tolerance[0] + srf_dv0.Length()*trim.m_tolerance[1];
-      double t1_tol = srf_du1.Length()*trim.m_tolerance[0] + srf_dv1.Length()*trim.m_tolerance[1];
-      ON_3dVector trim_tangent0 = trim_der0.x*srf_du0 + trim_der0.y*srf_dv0;
-      trim_tangent0.Unitize();
-      ON_3dVector trim_tangent1 = trim_der1.x*srf_du1 + trim_der1.y*srf_dv1;
-      trim_tangent1.Unitize();
-      ON_3dVector edge_tangent0 = edge.TangentAt( edge.Domain()[trim.m_bRev3d ? 1 : 0] );
-      ON_3dVector edge_tangent1 = edge.TangentAt( edge.Domain()[trim.m_bRev3d ? 0 : 1] );
-      double d0 = trim_tangent0*edge_tangent0;
-      double d1 = trim_tangent1*edge_tangent1;
-      if ( trim.m_bRev3d )
-      {
-        d0 = -d0;
-        d1 = -d1;
-      }
-      if (    trim.m_vi[0] == trim.m_vi[1] 
-           && edge.m_vi[0] == edge.m_vi[1] 
-           && trim.m_vi[0] == edge.m_vi[0] 
-           )
-      {
-        // For high quality models, d0 and d1 should be close to +1.
-        // If both are close to -1, the trim.m_bRev3d flag is most
-        // likely set opposite of what it should be.
-
-        // check start tangent to see if m_bRev3d is set correctly
-        if ( d0 < 0.0 || d1 < 0.0)
-        {
-          if ( text_log )
-          {
-            if ( trim.m_bRev3d )
-              text_log->Print("ON_Brep.m_T[%d].m_bRev3d = true, but closed curve directions are the same.\n",ti);
-            else
-              text_log->Print("ON_Brep.m_T[%d].m_bRev3d = false, but closed curve directions are opposite.\n",ti);
-          }
-          return ON_BrepIsNotValid();
-        }
-      }
+  if ( trim.m_ei < 0 || trim.m_ei >= brep.m_E.Count() )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_ei = %d is not invalid.\n",ti,trim.m_ei);
+    return ON_BrepIsNotValid();
+  }
+  
+  const ON_BrepEdge& edge = brep.m_E[trim.m_ei];
+  if ( edge.m_edge_index != trim.m_ei )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_ei is deleted.\n",ti);
+    return ON_BrepIsNotValid();
+  }
 
-      // Make sure edge and tolerances are realistic
-      ON_3dPoint EdgeEnd[2];
-      EdgeEnd[trim.m_bRev3d?1:0] = edge.PointAtStart();
-      EdgeEnd[trim.m_bRev3d?0:1] = edge.PointAtEnd();
-      d0 = EdgeEnd[0].DistanceTo(srf_pt0);
-      d1 = EdgeEnd[1].DistanceTo(srf_pt1);
-      double etol = edge.m_tolerance;
-      double dtol = 10.0*(etol + t0_tol + t1_tol);
-      if ( dtol < 0.01 )
-        dtol = 0.01;
-      if ( d0 > dtol  )
-      {
-        if ( text_log )
-        {
-          text_log->Print("Distance from start of ON_Brep.m_T[%d] to 3d edge is %g.  (edge tol = %g, trim tol ~ %g).\n",
-                          ti, d0, etol,t0_tol);
-        }
-        return ON_BrepIsNotValid();
-      }
-      if ( d1 > dtol )
+  const int evi0 = trim.m_bRev3d ? 1 : 0;
+  const int evi1 = trim.m_bRev3d ? 0 : 1;
+  if ( trim.m_vi[0] != edge.m_vi[evi0] )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_bRev3d = %d, but m_vi[0] != m_E[m_ei].m_vi[%d].\n",ti,trim.m_bRev3d,evi0);
+    return ON_BrepIsNotValid();
+  }
+  if ( trim.m_vi[1] != edge.m_vi[evi1] )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d].m_bRev3d = %d, but m_vi[0] != m_E[m_ei].m_vi[%d].\n",ti,trim.m_bRev3d,evi1);
+    return ON_BrepIsNotValid();
+  }
+
+  // check tolerances and closed curve directions
+  {
+    ON_3dPoint trim_pt0, trim_pt1, srf_pt0, srf_pt1;
+    ON_3dVector trim_der0, trim_der1, srf_du0, srf_dv0, srf_du1, srf_dv1;
+    ON_Interval trim_domain = trim.Domain();
+    // trim_pt0 should be closed to trim_pt1 except when
+    // trim starts and ends on opposite sides of a surface 
+    // seam.  Even when the trim curve is closed, the 
+    // derivatives can be different when there is
+    // a kink at the start/end of a trim.
+    trim.Ev1Der( trim_domain[0], trim_pt0, trim_der0 );
+    trim.Ev1Der( trim_domain[1], trim_pt1, trim_der1 );
+
+    const ON_Surface* trim_srf = brep.m_F[ brep.m_L[trim.m_li].m_fi ].SurfaceOf();
+    trim_srf->Ev1Der( trim_pt0.x, trim_pt0.y, srf_pt0, srf_du0, srf_dv0 );
+    trim_srf->Ev1Der( trim_pt1.x, trim_pt1.y, srf_pt1, srf_du1, srf_dv1 );
+
+    // estimate 3d tolerances from 2d trim tolerances
+    double t0_tol = srf_du0.Length()*trim.m_tolerance[0] + srf_dv0.Length()*trim.m_tolerance[1];
+    double t1_tol = srf_du1.Length()*trim.m_tolerance[0] + srf_dv1.Length()*trim.m_tolerance[1];
+    ON_3dVector trim_tangent0 = trim_der0.x*srf_du0 + trim_der0.y*srf_dv0;
+    trim_tangent0.Unitize();
+    ON_3dVector trim_tangent1 = trim_der1.x*srf_du1 + trim_der1.y*srf_dv1;
+    trim_tangent1.Unitize();
+    ON_3dVector edge_tangent0 = edge.TangentAt( edge.Domain()[trim.m_bRev3d ? 1 : 0] );
+    ON_3dVector edge_tangent1 = edge.TangentAt( edge.Domain()[trim.m_bRev3d ? 0 : 1] );
+    double d0 = trim_tangent0*edge_tangent0;
+    double d1 = trim_tangent1*edge_tangent1;
+    if ( trim.m_bRev3d )
+    {
+      d0 = -d0;
+      d1 = -d1;
+    }
+    if (    trim.m_vi[0] == trim.m_vi[1] 
+         && edge.m_vi[0] == edge.m_vi[1] 
+         && trim.m_vi[0] == edge.m_vi[0] 
+         )
+    {
+      // For high quality models, d0 and d1 should be close to +1.
+      // If both are close to -1, the trim.m_bRev3d flag is most
+      // likely set opposite of what it should be.
+
+      // check start tangent to see if m_bRev3d is set correctly
+      if ( d0 < 0.0 || d1 < 0.0)
       {
         if ( text_log )
         {
-          text_log->Print("Distance from end of ON_Brep.m_T[%d] to 3d edge is %g.  (edge tol = %g, trim tol ~ %g).\n",
-                          ti, d1, etol,t1_tol);
+          if ( trim.m_bRev3d )
+            text_log->Print("ON_Brep.m_T[%d].m_bRev3d = true, but closed curve directions are the same.\n",ti);
+          else
+            text_log->Print("ON_Brep.m_T[%d].m_bRev3d = false, but closed curve directions are opposite.\n",ti);
         }
         return ON_BrepIsNotValid();
       }
     }
 
-    // check trim's m_pbox
+    // Make sure edge and tolerances are realistic
+    ON_3dPoint EdgeEnd[2];
+    EdgeEnd[trim.m_bRev3d?1:0] = edge.PointAtStart();
+    EdgeEnd[trim.m_bRev3d?0:1] = edge.PointAtEnd();
+    d0 = EdgeEnd[0].DistanceTo(srf_pt0);
+    d1 = EdgeEnd[1].DistanceTo(srf_pt1);
+    double etol = edge.m_tolerance;
+    double dtol = 10.0*(etol + t0_tol + t1_tol);
+    if ( dtol < 0.01 )
+      dtol = 0.01;
+    if ( d0 > dtol  )
     {
-      if ( trim.m_pbox.m_min.z != 0.0 )
-      {
-        if ( text_log )
-           text_log->Print("ON_Brep.m_T[%d].m_pbox.m_min.z = %g (should be zero).\n",ti,trim.m_pbox.m_min.z);
-        return ON_BrepIsNotValid();
-      }
-      if ( trim.m_pbox.m_max.z != 0.0 )
+      if ( text_log )
       {
-        if ( text_log )
-           text_log->Print("ON_Brep.m_T[%d].m_pbox.m_max.z = %g (should be zero).\n",ti,trim.m_pbox.m_max.z);
-        return ON_BrepIsNotValid();
+        text_log->Print("Distance from start of ON_Brep.m_T[%d] to 3d edge is %g.  (edge tol = %g, trim tol ~ %g).\n",
+                        ti, d0, etol,t0_tol);
       }
-      
-      if ( !TestTrimPBox( trim, text_log ) )
-        return ON_BrepIsNotValid();
-
+      return ON_BrepIsNotValid();
     }
-
-    if ( ON_BrepTrim::seam == trim.m_type )
+    if ( d1 > dtol )
     {
-      // trim must be on a surface edge
-      switch ( trim.m_iso )
+      if ( text_log )
       {
-      case ON_Surface::S_iso:
-        break;
-      case ON_Surface::E_iso:
-        break;
-      case ON_Surface::N_iso:
-        break;
-      case ON_Surface::W_iso:
-        break;
-      default:
-        if ( text_log )
-          text_log->Print("ON_Brep.m_T[%d].m_type = ON_BrepTrim::seam but m_iso is not N/E/W/S_iso.\n",ti);
-        return ON_BrepIsNotValid();
+        text_log->Print("Distance from end of ON_Brep.m_T[%d] to 3d edge is %g.  (edge tol = %g, trim tol ~ %g).\n",
+                        ti, d1, etol,t1_tol);
       }
-      seam_trim_count++;
+      return ON_BrepIsNotValid();
     }
   }
 
-  // check loop m_pboxes
-  for ( li = 0; li < loop_count; li++ )
+  // check trim's m_pbox
   {
-    const ON_BrepLoop& loop = m_L[li];
-    if ( loop.m_loop_index != li )
-      continue;
-    if ( loop.m_pbox.m_min.z != 0.0 )
+    if ( trim.m_pbox.m_min.z != 0.0 )
     {
       if ( text_log )
-         text_log->Print("ON_Brep.m_L[%d].m_pbox.m_min.z = %g (should be zero).\n",li,loop.m_pbox.m_min.z);
+         text_log->Print("ON_Brep.m_T[%d].m_pbox.m_min.z = %g (should be zero).\n",ti,trim.m_pbox.m_min.z);
       return ON_BrepIsNotValid();
     }
-    if ( loop.m_pbox.m_max.z != 0.0 )
+    if ( trim.m_pbox.m_max.z != 0.0 )
     {
       if ( text_log )
-         text_log->Print("ON_Brep.m_L[%d].m_pbox.m_max.z = %g (should be zero).\n",li,loop.m_pbox.m_max.z);
+         text_log->Print("ON_Brep.m_T[%d].m_pbox.m_max.z = %g (should be zero).\n",ti,trim.m_pbox.m_max.z);
       return ON_BrepIsNotValid();
     }
-    int first_trim_ti = -4;
-    int first_trim_vi0 = -3;
-    int prev_trim_vi1 = -2;
-    int prev_trim_ti=-9;
-    int lti;
-    for ( lti = 0; lti < loop.m_ti.Count(); lti++ )
-    {
-      const ON_BrepTrim& trim = m_T[loop.m_ti[lti]];
-      if ( !loop.m_pbox.IsPointIn(trim.m_pbox.m_min) || !loop.m_pbox.IsPointIn(trim.m_pbox.m_max) )
-      {
-        if ( text_log )
-           text_log->Print("ON_Brep.m_L[%d].m_pbox does not contain m_T[loop.m_ti[%d]].m_pbox.\n",li,lti);
-        return ON_BrepIsNotValid();
-      }
-      if ( 0 == lti )
-      {
-        first_trim_ti = loop.m_ti[lti];
-        first_trim_vi0 = trim.m_vi[0];
-      }
-      else if ( prev_trim_vi1 != trim.m_vi[0] )
-      {
-        // 23 May 2003 Dale Lear
-        //     Added this test to make sure adjacent trims
-        //     in a loop shared vertices.
-        if ( text_log )
-           text_log->Print("ON_Brep.m_L[%d] loop has trim vertex mismatch:\n  m_T[loop.m_ti[%d]=%d].m_vi[1] = %d != m_T[loop.m_ti[%d]=%d].m_vi[0]=%d.\n",li,lti-1,prev_trim_ti,prev_trim_vi1,lti,loop.m_ti[lti],trim.m_vi[0]);
-        return ON_BrepIsNotValid();
-      }
-      prev_trim_ti = loop.m_ti[lti];
-      prev_trim_vi1 = trim.m_vi[1];
-    }
+    
+    if ( !TestTrimPBox( trim, text_log ) )
+      return ON_BrepIsNotValid();
+
+  }
 
-    if ( first_trim_ti >= 0 && first_trim_vi0 != prev_trim_vi1 )
+  if ( ON_BrepTrim::seam == trim.m_type )
+  {
+    // trim must be on a surface edge
+    switch ( trim.m_iso )
     {
-      // 23 May 2003 Dale Lear
-      //     Added this test to make sure adjacent trims
-      //     in a loop shared vertices.
+    case ON_Surface::S_iso:
+      break;
+    case ON_Surface::E_iso:
+      break;
+    case ON_Surface::N_iso:
+      break;
+    case ON_Surface::W_iso:
+      break;
+    default:
       if ( text_log )
-         text_log->Print("ON_Brep.m_L[%d] loop has trim vertex mismatch:\n  m_T[loop.m_ti[%d]=%d].m_vi[1] = %d != m_T[loop.m_ti[%d]=%d].m_vi[0]=%d.\n",
-                         li,lti-1,prev_trim_ti,prev_trim_vi1,0,first_trim_ti,first_trim_vi0);
+        text_log->Print("ON_Brep.m_T[%d].m_type = ON_BrepTrim::seam but m_iso is not N/E/W/S_iso.\n",ti);
       return ON_BrepIsNotValid();
     }
   }
+  return true;
+}
 
-  // 21 October 2003 Dale Lear - fix RR 11980 - check for split seams
-  // This block of code assumes the preceding checks have all passed.
-  // It looks for boundary trims on seams that should be joined as a seam trim.
-  ON_Interval srf_domain[2];
-  for ( fi = 0; fi < face_count; fi++ )
+// Checks the loop m_pbox and that adjacent trims in the loop share vertices.
+static bool Internal_IsValidBrepLoopTrims(const ON_Brep& brep, int li, ON_TextLog* text_log)
+{
+  const ON_BrepLoop& loop = brep.m_L[li];
+  if ( loop.m_loop_index != li )
+    return true;
+  if ( loop.m_pbox.m_min.z != 0.0 )
   {
-    const ON_BrepFace& face = m_F[fi];
-    if ( face.m_face_index < 0 )
-      continue;
-    const ON_Surface* srf = m_S[face.m_si];
-    if ( 0 == srf )
-      continue;
-
-    srf_domain[0] = srf->Domain(0);
-    srf_domain[1] = srf->Domain(1);
-    for ( int fli = 0; fli < face.m_li.Count(); fli++ )
-    {
-      int li_local = face.m_li[fli];
-      if ( li_local < 0 || li_local >= m_L.Count() )
-        continue;
-      if ( !CheckLoopOnSrfHelper(*this,srf_domain[0],srf_domain[1],m_L[li_local],text_log) )
-        return ON_BrepIsNotValid();
+    if ( text_log )
+       text_log->Print("ON_Brep.m_L[%d].m_pbox.m_min.z = %g (should be zero).\n",li,loop.m_pbox.m_min.z);
+    return ON_BrepIsNotValid();
+  }
+  if ( loop.m_pbox.m_max.z != 0.0 )
+  {
+    if ( text_log )
+       text_log->Print("ON_Brep.m_L[%d].m_pbox.m_max.z = %g (should be zero).\n",li,loop.m_pbox.m_max.z);
+    return ON_BrepIsNotValid();
+  }
+  int first_trim_ti = -4;
+  int first_trim_vi0 = -3;
+  int prev_trim_vi1 = -2;
+  int prev_trim_ti=-9;
+  int lti;
+  for ( lti = 0; lti < loop.m_ti.Count(); lti++ )
+  {
+    const ON_BrepTrim& trim = brep.m_T[loop.m_ti[lti]];
+    if ( !loop.m_pbox.IsPointIn(trim.m_pbox.m_min) || !loop.m_pbox.IsPointIn(trim.m_pbox.m_max) )
+    {
+      if ( text_log )
+         text_log->Print("ON_Brep.m_L[%d].m_pbox does not contain m_T[loop.m_ti[%d]].m_pbox.\n",li,lti);
+      return ON_BrepIsNotValid();
     }
+    if ( 0 == lti )
+    {
+      first_trim_ti = loop.m_ti[lti];
+      first_trim_vi0 = trim.m_vi[0];
+    }
+    else if ( prev_trim_vi1 != trim.m_vi[0] )
+    {
+      // 23 May 2003 Dale Lear
+      //     Added this test to make sure adjacent trims
+      //     in a loop shared vertices.
+      if ( text_log )
+         text_log->Print("ON_Brep.m_L[%d] loop has trim vertex mismatch:\n  m_T[loop.m_ti[%d]=%d].m_vi[1] = %d != m_T[loop.m_ti[%d]=%d].m_vi[0]=%d.\n",li,lti-1,prev_trim_ti,prev_trim_vi1,lti,loop.m_ti[lti],trim.m_vi[0]);
+      return ON_BrepIsNotValid();
+    }
+    prev_trim_ti = loop.m_ti[lti];
+    prev_trim_vi1 = trim.m_vi[1];
+  }
+
+  if ( first_trim_ti >= 0 && first_trim_vi0 != prev_trim_vi1 )
+  {
+    // 23 May 2003 Dale Lear
+    //     Added this test to make sure adjacent trims
+    //     in a loop shared vertices.
+    if ( text_log )
+       text_log->Print("ON_Brep.m_L[%d] loop has trim vertex mismatch:\n  m_T[loop.m_ti[%d]=%d].m_vi[1] = %d != m_T[loop.m_ti[%d]=%d].m_vi[0]=%d.\n",
+                       li,lti-1,prev_trim_ti,prev_trim_vi1,0,first_trim_ti,first_trim_vi0);
+    return ON_BrepIsNotValid();
+  }
+  return true;
+}
+
+static bool Internal_IsValidBrepFaceSeams(const ON_Brep& brep, int fi, ON_TextLog* text_log)
+{
+  ON_Interval srf_domain[2];
+  const ON_BrepFace& face = brep.m_F[fi];
+  if ( face.m_face_index < 0 )
+    return true;
+  const ON_Surface* srf = brep.m_S[face.m_si];
+  if ( 0 == srf )
+    return true;
 
-    const ON_BrepLoop* outer_loop = face.OuterLoop();
-    if ( 0 == outer_loop )
+  srf_domain[0] = srf->Domain(0);
+  srf_domain[1] = srf->Domain(1);
+  for ( int fli = 0; fli < face.m_li.Count(); fli++ )
+  {
+    int li_local = face.m_li[fli];
+    if ( li_local < 0 || li_local >= brep.m_L.Count() )
       continue;
+    if ( !CheckLoopOnSrfHelper(brep,srf_domain[0],srf_domain[1],brep.m_L[li_local],text_log) )
+      return ON_BrepIsNotValid();
+  }
+
+  const ON_BrepLoop* outer_loop = face.OuterLoop();
+  if ( 0 == outer_loop )
+    return true;
+
+  bool bClosed[2];
+  bClosed[0] = srf->IsClosed(0);
+  bClosed[1] = srf->IsClosed(1);
+  if ( !bClosed[0] && !bClosed[1] )
+    return true;
+
+  const int outer_trim_count = outer_loop->m_ti.Count();
+  int lti, lti1;
+  int endpt_index = 0;
+  ON_Surface::ISO iso_type;
+  ON_Interval side_interval;
+  double s0, s1;
+  const double side_tol = 1.0e-4;
 
-    bool bClosed[2];
-    bClosed[0] = srf->IsClosed(0);
-    bClosed[1] = srf->IsClosed(1);
-    if ( !bClosed[0] && !bClosed[1] )
+  for ( lti = 0; lti < outer_trim_count; lti++ )
+  {
+    const ON_BrepTrim& trim = brep.m_T[outer_loop->m_ti[lti]];
+    if ( ON_BrepTrim::boundary !=  trim.m_type )
+      continue;
+    if ( ON_Surface::E_iso == trim.m_iso && bClosed[0] )
+    {
+      iso_type = ON_Surface::W_iso;
+      endpt_index = 1;
+    }
+    else if ( ON_Surface::W_iso == trim.m_iso && bClosed[0] )
+    {
+      iso_type = ON_Surface::E_iso;
+      endpt_index = 1;
+    }
+    else if( ON_Surface::S_iso == trim.m_iso && bClosed[1] )
+    {
+      iso_type = ON_Surface::N_iso;
+      endpt_index = 0;
+    }
+    else if( ON_Surface::N_iso == trim.m_iso && bClosed[1] )
+    {
+      iso_type = ON_Surface::S_iso;
+      endpt_index = 0;
+    }
+    else
       continue;
 
-    const int outer_trim_count = outer_loop->m_ti.Count();
-    int lti, lti1;
-    int endpt_index = 0;
-    ON_Surface::ISO iso_type;
-    ON_Interval side_interval;
-    double s0, s1;
-    const double side_tol = 1.0e-4;
+    side_interval.Set(trim.PointAtStart()[endpt_index],trim.PointAtEnd()[endpt_index]);
+    if ( ON_Surface::N_iso == iso_type || ON_Surface::W_iso == iso_type )
+    {
+      if ( !side_interval.IsIncreasing() )
+        continue;
+    }
+    else
+    {
+      if ( !side_interval.IsDecreasing() )
+        continue;
+    }
 
-    for ( lti = 0; lti < outer_trim_count; lti++ )
+    // search for seam
+    for ( lti1 = 0; lti1 < outer_trim_count; lti1++ )
     {
-      const ON_BrepTrim& trim = m_T[outer_loop->m_ti[lti]];
-      if ( ON_BrepTrim::boundary !=  trim.m_type )
+      if ( lti1 == lti )
         continue;
-      if ( ON_Surface::E_iso == trim.m_iso && bClosed[0] )
-      {
-        iso_type = ON_Surface::W_iso;
-        endpt_index = 1;
-      }
-      else if ( ON_Surface::W_iso == trim.m_iso && bClosed[0] )
-      {
-        iso_type = ON_Surface::E_iso;
-        endpt_index = 1;
-      }
-      else if( ON_Surface::S_iso == trim.m_iso && bClosed[1] )
-      {
-        iso_type = ON_Surface::N_iso;
-        endpt_index = 0;
-      }
-      else if( ON_Surface::N_iso == trim.m_iso && bClosed[1] )
-      {
-        iso_type = ON_Surface::S_iso;
-        endpt_index = 0;
-      }
-      else
+      const ON_BrepTrim& trim1 = brep.m_T[outer_loop->m_ti[lti1]];
+      if ( iso_type != trim1.m_iso )
+        continue;
+      if ( ON_BrepTrim::boundary != trim1.m_type )
+        continue;
+      
+      s1 = side_interval.NormalizedParameterAt(trim1.PointAtStart()[endpt_index]);
+      if ( fabs(s1-1.0) > side_tol )
+        continue;
+      s0 = side_interval.NormalizedParameterAt(trim1.PointAtEnd()[endpt_index]);
+      if ( fabs(s0) > side_tol )
         continue;
 
-      side_interval.Set(trim.PointAtStart()[endpt_index],trim.PointAtEnd()[endpt_index]);
-      if ( ON_Surface::N_iso == iso_type || ON_Surface::W_iso == iso_type )
+      if ( text_log )
       {
-        if ( !side_interval.IsIncreasing() )
-          continue;
+       text_log->Print("ON_Brep.m_F[%d] is on a closed surface. Outer loop m_L[%d] contains boundary trims %d and %d.  They should be seam trims connected to the same edge.\n",
+                       face.m_face_index,outer_loop->m_loop_index,
+                       trim.m_trim_index,trim1.m_trim_index
+                       );
       }
-      else
+      return ON_BrepIsNotValid();                
+    }
+  }
+  return true;
+}
+
+// Checks that the seam trim brep.m_T[ti] has a matching seam trim in the same loop.
+static bool Internal_IsValidBrepSeamTrim(const ON_Brep& brep, int ti, ON_TextLog* text_log)
+{
+  const int edge_count = brep.m_E.Count();
+  const int trim_count = brep.m_T.Count();
+  const ON_BrepTrim& trim = brep.m_T[ti];
+  if ( trim.m_trim_index == -1 )
+    return true;
+  if ( ON_BrepTrim::seam != trim.m_type )
+    return true;
+  if ( trim.m_ei < 0 || trim.m_ei >= edge_count )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d] is a seam trim with an invalid m_ei.\n",ti);
+    return ON_BrepIsNotValid();
+  }
+
+  const ON_BrepEdge& edge = brep.m_E[trim.m_ei];
+  int trim1_index = -1;
+  for ( int eti = 0; eti < edge.m_ti.Count(); eti++ )
+  {
+    const int ti1 = edge.m_ti[eti];
+    if ( ti1 == ti 
+         || ti1 < 0
+         || ti1 >= trim_count 
+       )
+    {
+      continue;
+    }
+    const ON_BrepTrim& trim1 = brep.m_T[ti1];
+    if ( trim1.m_trim_index == -1 )
+      continue;
+    if ( ON_BrepTrim::seam != trim1.m_type )
+      continue;
+    if ( trim1.m_li != trim.m_li )
+      continue;
+    if ( -1 == trim1_index )
+    {
+      trim1_index = ti1;
+      continue;
+    }
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d,%d,%d] are three seam trims with the same edge in the same loop.\n",ti,trim1_index,ti1);
+    return ON_BrepIsNotValid();
+  }
+
+  if ( trim1_index < 0 || trim1_index >= trim_count )
+  {
+    if ( text_log )
+      text_log->Print("ON_Brep.m_T[%d] is a seam trim with no matching seam trim in the same loop.\n",ti);
+    return ON_BrepIsNotValid();
+  }
+
+  // previous validation step insures trim.m_iso = N/S/E/W_iso
+  switch(trim.m_iso)
+  {
+  case ON_Surface::S_iso:
+    if ( ON_Surface::N_iso != brep.m_T[trim1_index].m_iso )
+    {
+      if (text_log )
+        text_log->Print("Seam trim ON_Brep.m_T[%d].m_iso = S_iso but matching seam ON_Brep.m_T[%d].m_iso != N_iso.\n",ti,trim1_index);
+      return ON_BrepIsNotValid();
+    }
+    break;
+
+  case ON_Surface::E_iso:
+    if ( ON_Surface::W_iso != brep.m_T[trim1_index].m_iso )
+    {
+      if (text_log )
+        text_log->Print("Seam trim ON_Brep.m_T[%d].m_iso = E_iso but matching seam ON_Brep.m_T[%d].m_iso != W_iso.\n",ti,trim1_index);
+      return ON_BrepIsNotValid();
+    }
+    break;
+
+  case ON_Surface::N_iso:
+    if ( ON_Surface::S_iso != brep.m_T[trim1_index].m_iso )
+    {
+      if (text_log )
+        text_log->Print("Seam trim ON_Brep.m_T[%d].m_iso = N_iso but matching seam ON_Brep.m_T[%d].m_iso != S_iso.\n",ti,trim1_index);
+      return ON_BrepIsNotValid();
+    }
+    break;
+
+  case ON_Surface::W_iso:
+    if ( ON_Surface::E_iso != brep.m_T[trim1_index].m_iso )
+    {
+      if (text_log )
+        text_log->Print("Seam trim ON_Brep.m_T[%d].m_iso = W_iso but matching seam ON_Brep.m_T[%d].m_iso != E_iso.\n",ti,trim1_index);
+      return ON_BrepIsNotValid();
+    }
+    break;
+
+  case ON_Surface::not_iso:
+  case ON_Surface::x_iso:
+  case ON_Surface::y_iso:
+  case ON_Surface::iso_count:
+    break; // keep gcc quiet
+  }
+
+
+  return true;
+}
+
+
+void ON_Brep::Internal_CheckCachedBoundingBox(
+  ON_TextLog* text_log
+) const
+{
+  if (m_bbox.IsNotEmpty())
+  {
+    // new_brep_bbox is calculated from scratch WITHOUT changing existing values on ON_BrepFace.m_bbox and ON_Brep.m_bbox.
+    const ON_BoundingBox new_brep_bbox = this->InternalBrepBoundingBox(false, false);
+    if (new_brep_bbox.IsNotEmpty())
+    {
+      ON_BoundingBox triple_size_new_brep_bbox = new_brep_bbox;
+      triple_size_new_brep_bbox.Expand(new_brep_bbox.Diagonal() + ON_3dVector(1.0, 1.0, 1.0));
+      const ON_BoundingBox cached_brep_bbox = m_bbox;
+      if (false == triple_size_new_brep_bbox.Includes(cached_brep_bbox, false))
       {
-        if ( !side_interval.IsDecreasing() )
-          continue;
+        if (nullptr != text_log)
+          text_log->Print("WARNING: The cached ON_Brep.m_bbox is much larger than one cacluated from current ON_BrepFace extents.\n");
+        ON_WARNING("The cached ON_Brep.m_bbox is much larger than one cacluated from current ON_BrepFace extents. This might effect make2d performance.");
+        // DO NOT RETURN FALSE HERE!
       }
+    }
+  }
+}
+
+bool ON_Brep::IsValid( ON_TextLog* text_log ) const
+{
+  if (IsCorrupt(false, true, text_log))
+    return false;
+
+  const int curve2d_count = m_C2.Count();
+  const int curve3d_count = m_C3.Count();
+  const int surface_count = m_S.Count();
+  const int vertex_count  = m_V.Count();
+  const int edge_count    = m_E.Count();
+  const int trim_count    = m_T.Count();
+  const int loop_count    = m_L.Count();
+  const int face_count    = m_F.Count();
+
+  int c2i, c3i, si, vi, ei, fi, ti, li;
+
+  if ( !Internal_IsValidBrepComponentCounts( *this, text_log ) )
+    return ON_BrepIsNotValid();
+
+  // check element indices match array positions
+  for ( vi = 0; vi < vertex_count; vi++ ) 
+  {
+    if ( !Internal_IsValidBrepVertexIndex( *this, vi, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  for ( ei = 0; ei < edge_count; ei++ ) 
+  {
+    if ( !Internal_IsValidBrepEdgeIndex( *this, ei, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  for ( ti = 0; ti < trim_count; ti++ ) 
+  {
+    if ( !Internal_IsValidBrepTrimIndex( *this, ti, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  for ( li = 0; li < loop_count; li++ ) 
+  {
+    if ( !Internal_IsValidBrepLoopIndex( *this, li, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  for ( fi = 0; fi < face_count; fi++ ) 
+  {
+    if ( !Internal_IsValidBrepFaceIndex( *this, fi, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  // check 2d curve geometry
+  for ( c2i = 0; c2i < curve2d_count; c2i++ )
+  {
+    if ( !Internal_IsValidBrepCurve2d( *this, c2i, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  // check 3d curve geometry
+  for ( c3i = 0; c3i < curve3d_count; c3i++ )
+  {
+    if ( !Internal_IsValidBrepCurve3d( *this, c3i, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  // check 3d surface geometry
+  for ( si = 0; si < surface_count; si++ )
+  {
+    if ( !Internal_IsValidBrepSurface( *this, si, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  // check vertices
+  for ( vi = 0; vi < vertex_count; vi++ ) {
+    if ( m_V[vi].m_vertex_index == -1 )
+      continue;
+    if ( !IsValidVertex( vi, text_log ) ) {
+      if ( text_log )
+        text_log->Print("ON_Brep.m_V[%d] is invalid.\n",vi);
+      return ON_BrepIsNotValid();
+    }
+  }
+
+  // check edges
+  for ( ei = 0; ei < edge_count; ei++ ) 
+  {
+    if ( m_E[ei].m_edge_index == -1 )
+      continue;
+    if ( !IsValidEdge( ei, text_log ) ) {
+      if ( text_log )
+        text_log->Print("ON_Brep.m_E[%d] is invalid.\n",ei);
+      return ON_BrepIsNotValid();
+    }
+  }
+
+  // check faces
+  for ( fi = 0; fi < face_count; fi++ ) 
+  {
+    if ( m_F[fi].m_face_index == -1 )
+      continue;
+    if ( !IsValidFace( fi, text_log ) ) {
+      if ( text_log )
+        text_log->Print("ON_Brep.m_F[%d] is invalid.\n",fi);
+      return ON_BrepIsNotValid();
+    }
+  }
+
+  // Check loops - this check is necessary at the brep level
+  // to make sure there are no orphaned loops.
+  for ( li = 0; li < loop_count; li++ )
+  {
+    if ( !Internal_IsValidBrepLoopFace( *this, li, text_log ) )
+      return ON_BrepIsNotValid();
+  }
+
+  // check trims - this check is necessary at the brep 
+  // level to make sure there are no orphan trims and 
+  // to test tolerances.
+  int seam_trim_count = 0;
+  for ( ti = 0; ti < trim_count; ti++ )
+  {
+    if ( !Internal_IsValidBrepTrimInBrep( *this, ti, text_log ) )
+      return ON_BrepIsNotValid();
+    if ( m_T[ti].m_trim_index == ti && ON_BrepTrim::seam == m_T[ti].m_type )
+      seam_trim_count++;
+  }
 
-      // search for seam
-      for ( lti1 = 0; lti1 < outer_trim_count; lti1++ )
-      {
-        if ( lti1 == lti )
-          continue;
-        const ON_BrepTrim& trim1 = m_T[outer_loop->m_ti[lti1]];
-        if ( iso_type != trim1.m_iso )
-          continue;
-        if ( ON_BrepTrim::boundary != trim1.m_type )
-          continue;
-        
-        s1 = side_interval.NormalizedParameterAt(trim1.PointAtStart()[endpt_index]);
-        if ( fabs(s1-1.0) > side_tol )
-          continue;
-        s0 = side_interval.NormalizedParameterAt(trim1.PointAtEnd()[endpt_index]);
-        if ( fabs(s0) > side_tol )
-          continue;
+  // check loop m_pboxes
+  for ( li = 0; li < loop_count; li++ )
+  {
+    if ( !Internal_IsValidBrepLoopTrims( *this, li, text_log ) )
+      return ON_BrepIsNotValid();
+  }
 
-        if ( text_log )
-        {
-         text_log->Print("ON_Brep.m_F[%d] is on a closed surface. Outer loop m_L[%d] contains boundary trims %d and %d.  They should be seam trims connected to the same edge.\n",
-                         face.m_face_index,outer_loop->m_loop_index,
-                         trim.m_trim_index,trim1.m_trim_index
-                         );
-        }
-        return ON_BrepIsNotValid();                
-      }
-    }
+  // check for split seams
+  for ( fi = 0; fi < face_count; fi++ )
+  {
+    if ( !Internal_IsValidBrepFaceSeams( *this, fi, text_log ) )
+      return ON_BrepIsNotValid();
   }
 
   // make sure seam trims are properly matched.
@@ -5495,96 +5745,8 @@ bool ON_Brep::IsValid( ON_TextLog* text_log ) const
     if ( ON_BrepTrim::seam != trim.m_type )
       continue;
     seam_trim_count--;
-    if ( trim.m_ei < 0 || trim.m_ei >= edge_count )
-    {
-      if ( text_log )
-      {
-        text_log->Print("ON_Brep.m_T[%d] is a seam trim with an invalid m_ei.\n",ti);
-        return ON_BrepIsNotValid();
-      }
-    }
-
-    const ON_BrepEdge& edge = m_E[trim.m_ei];
-    int trim1_index = -1;
-    for ( int eti = 0; eti < edge.m_ti.Count(); eti++ )
-    {
-      const int ti1 = edge.m_ti[eti];
-      if ( ti1 == ti 
-           || ti < 0
-           || ti >= trim_count 
-         )
-      {
-        continue;
-      }
-      const ON_BrepTrim& trim1 = m_T[ti1];
-      if ( trim1.m_trim_index == -1 )
-        continue;
-      if ( ON_BrepTrim::seam != trim1.m_type )
-        continue;
-      if ( trim1.m_li != trim.m_li )
-        continue;
-      if ( -1 == trim1_index )
-      {
-        trim1_index = ti1;
-        continue;
-      }
-      text_log->Print("ON_Brep.m_T[%d,%d,%d] are three seam trims with the same edge in the same loop.\n",ti,trim1_index,ti1);
+    if ( !Internal_IsValidBrepSeamTrim( *this, ti, text_log ) )
       return ON_BrepIsNotValid();
-    }
-
-    if ( trim1_index < 0 || trim1_index >= trim_count )
-    {
-      text_log->Print("ON_Brep.m_T[%d] is a seam trim with no matching seam trim in the same loop.\n",ti);
-      return ON_BrepIsNotValid();
-    }
-
-    // previous validation step insures trim.m_iso = N/S/E/W_iso
-    switch(trim.m_iso)
-    {
-    case ON_Surface::S_iso:
-      if ( ON_Surface::N_iso != m_T[trim1_index].m_iso )
-      {
-        if (text_log )
-          text_log->Print("Seam trim ON_Brep.m_T[%d].m_iso = S_iso but matching seam ON_Brep.m_T[%d].m_iso != N_iso.\n",ti,trim1_index);
-        return ON_BrepIsNotValid();
-      }
-      break;
-
-    case ON_Surface::E_iso:
-      if ( ON_Surface::W_iso != m_T[trim1_index].m_iso )
-      {
-        if (text_log )
-          text_log->Print("Seam trim ON_Brep.m_T[%d].m_iso = E_iso but matching seam ON_Brep.m_T[%d].m_iso != W_iso.\n",ti,trim1_index);
-        return ON_BrepIsNotValid();
-      }
-      break;
-
-    case ON_Surface::N_iso:
-      if ( ON_Surface::S_iso != m_T[trim1_index].m_iso )
-      {
-        if (text_log )
-          text_log->Print("Seam trim ON_Brep.m_T[%d].m_iso = N_iso but matching seam ON_Brep.m_T[%d].m_iso != S_iso.\n",ti,trim1_index);
-        return ON_BrepIsNotValid();
-      }
-      break;
-
-    case ON_Surface::W_iso:
-      if ( ON_Surface::E_iso != m_T[trim1_index].m_iso )
-      {
-        if (text_log )
-          text_log->Print("Seam trim ON_Brep.m_T[%d].m_iso = W_iso but matching seam ON_Brep.m_T[%d].m_iso != E_iso.\n",ti,trim1_index);
-        return ON_BrepIsNotValid();
-      }
-      break;
-
-    case ON_Surface::not_iso:
-    case ON_Surface::x_iso:
-    case ON_Surface::y_iso:
-    case ON_Surface::iso_count:
-      break; // keep gcc quiet
-    }
-
-
   }
 
   // Dale Lear Fix https://mcneel.myjetbrains.com/youtrack/issue/RH-64277
@@ -5635,25 +5797,7 @@ bool ON_Brep::IsValid( ON_TextLog* text_log ) const
   //////  }
   //////}
 
-  if (m_bbox.IsNotEmpty())
-  {
-
-    // new_brep_bbox is calculated from scratch WITHOUT changing existing values on ON_BrepFace.m_bbox and ON_Brep.m_bbox.
-    const ON_BoundingBox new_brep_bbox = this->InternalBrepBoundingBox(false, false);
-    if (new_brep_bbox.IsNotEmpty())
-    {
-      ON_BoundingBox triple_size_new_brep_bbox = new_brep_bbox;
-      triple_size_new_brep_bbox.Expand(new_brep_bbox.Diagonal() + ON_3dVector(1.0, 1.0, 1.0));
-      const ON_BoundingBox cached_brep_bbox = m_bbox;
-      if (false == triple_size_new_brep_bbox.Includes(cached_brep_bbox, false))
-      {
-        if (nullptr != text_log)
-          text_log->Print("WARNING: The cached ON_Brep.m_bbox is much larger than one cacluated from current ON_BrepFace extents.\n");
-        ON_WARNING("The cached ON_Brep.m_bbox is much larger than one cacluated from current ON_BrepFace extents. This might effect make2d performance.");
-        // DO NOT RETURN FALSE HERE!
-      }
-    }
-  }
+  Internal_CheckCachedBoundingBox(text_log);
 
 
 #if 0
@@ -5703,64 +5847,489 @@ bool ON_Brep::IsValid( ON_TextLog* text_log ) const
       }
     }
 
-    if (    ON_UNSET_VALUE == trim.m_pline[0].e 
-         && ON_UNSET_VALUE == trim.m_pline[pline_count-1].e 
-       )
+    if (    ON_UNSET_VALUE == trim.m_pline[0].e 
+         && ON_UNSET_VALUE == trim.m_pline[pline_count-1].e 
+       )
+    {
+      // the "e" values are not set.
+      // This is permitted. The are set when extensive
+      // trim-edge parameter correspondence is needed.
+      // Meshing is an example of a calculation that sets
+      // the "e" paramters.
+      continue;
+    }
+
+    if ( trim.m_ei < 0 || trim.m_ei >= m_E.Count() )
+    {
+      if (text_log )
+        text_log->Print("ON_Brep.m_T[%d].m_pline has e parameters but trim.m_ei is not valid.\n",ti);
+      return ON_BrepIsNotValid();
+    }
+    const ON_BrepEdge& edge = m_E[trim.m_ei];
+    const ON_Interval edge_domain = edge.Domain();
+    const int i0 = trim.m_bRev3d ? pline_count-1 : 0;
+    const int i1 = trim.m_bRev3d ? 0 : pline_count-1;
+    const int di = trim.m_bRev3d ? -1 : 1;
+    if ( !(trim.m_pline[i0].e == edge_domain[0]) )
+    {
+      if (text_log )
+        text_log->Print("ON_Brep.m_T[%d].m_pline[%d].e != start of edge domain.\n",ti,i0);
+      return ON_BrepIsNotValid();
+    }
+    if ( !(trim.m_pline[i1].e == edge_domain[1]) )
+    {
+      if (text_log )
+        text_log->Print("ON_Brep.m_T[%d].m_pline[%d].e != end of edge domain.\n",ti,i1);
+      return ON_BrepIsNotValid();
+    }
+    int prev_valid_i = i0;
+    for ( int i = i0+di; i >= 0 && i < pline_count && i-di >= 0 && i-di < pline_count; i += di )
+    {
+      if ( !ON_IsValid(trim.m_pline[i].e) )
+      {
+        // internal "e" may be invalid when the setter
+        // had troubles.  This is a symptom of a 
+        // bad trim or edge curve, but is not conclusive
+        // proof.
+        continue;
+      }
+      if ( !(trim.m_pline[prev_valid_i].e < trim.m_pline[i].e) )
+      {
+        if (text_log )
+          text_log->Print("ON_Brep.m_T[%d].m_pline[%d].t must be < m_pline[%d].t.\n",ti,prev_valid_i,i);
+        return ON_BrepIsNotValid();
+      }
+      prev_valid_i = i;
+    }
+  }
+#endif
+
+  return true;
+}
+
+ON_COMPONENT_INDEX ON_BrepValidationError::ComponentIndex() const
+{
+  switch (m_component)
+  {
+  case ON_BrepValidationError::Component::Vertex:
+    return ON_COMPONENT_INDEX(ON_COMPONENT_INDEX::brep_vertex, m_index);
+  case ON_BrepValidationError::Component::Edge:
+    return ON_COMPONENT_INDEX(ON_COMPONENT_INDEX::brep_edge, m_index);
+  case ON_BrepValidationError::Component::Trim:
+    return ON_COMPONENT_INDEX(ON_COMPONENT_INDEX::brep_trim, m_index);
+  case ON_BrepValidationError::Component::Loop:
+    return ON_COMPONENT_INDEX(ON_COMPONENT_INDEX::brep_loop, m_index);
+  case ON_BrepValidationError::Component::Face:
+    return ON_COMPONENT_INDEX(ON_COMPONENT_INDEX::brep_face, m_index);
+  default:
+    break;
+  }
+  return ON_COMPONENT_INDEX::UnsetComponentIndex;
+}
+
+void ON_BrepValidationReport::Clear()
+{
+  m_errors.Destroy();
+}
+
+bool ON_BrepValidationReport::IsValid() const
+{
+  return 0 == m_errors.Count();
+}
+
+unsigned int ON_BrepValidationReport::ErrorCount() const
+{
+  return m_errors.UnsignedCount();
+}
+
+unsigned int ON_BrepValidationReport::ErrorCount(
+  ON_BrepValidationError::Component component
+) const
+{
+  unsigned int count = 0;
+  for (int i = 0; i < m_errors.Count(); i++)
+  {
+    if (component == m_errors[i].m_component)
+      count++;
+  }
+  return count;
+}
+
+void ON_BrepValidationReport::Dump(
+  ON_TextLog& text_log
+) const
+{
+  static const char* component_name[10] =
+  {
+    "unset", "brep", "m_V", "m_E", "m_T", "m_L", "m_F", "m_C2", "m_C3", "m_S"
+  };
+  if (0 == m_errors.Count())
+  {
+    text_log.Print("ON_Brep is valid.\n");
+    return;
+  }
+  text_log.Print("ON_Brep has %d errors.\n", m_errors.Count());
+  for (int i = 0; i < m_errors.Count(); i++)
+  {
+    const ON_BrepValidationError& e = m_errors[i];
+    const unsigned int c = static_cast<unsigned int>(e.m_component);
+    if (ON_BrepValidationError::Component::Brep == e.m_component || c >= 10)
+      text_log.Print("%s:\n", component_name[c < 10 ? c : 0]);
+    else
+      text_log.Print("%s[%d]:\n", component_name[c], e.m_index);
+    text_log.PushIndent();
+    text_log.PrintString(e.m_description);
+    text_log.PopIndent();
+  }
+}
+
+class ON_Internal_BrepValidator
+{
+public:
+  ON_Internal_BrepValidator(const ON_Brep& brep)
+    : m_brep(brep)
+  {}
+  ~ON_Internal_BrepValidator() = default;
+
+private:
+  ON_Internal_BrepValidator(const ON_Internal_BrepValidator&) = delete;
+  ON_Internal_BrepValidator& operator=(const ON_Internal_BrepValidator&) = delete;
+
+public:
+  const ON_Brep& m_brep;
+
+  // 1 = component geometry and indices, 2 = trim, loop and face cross checks
+  unsigned int m_pass = 0;
+
+  // The pass's tasks are the concatenation of the component arrays in m_task_component[].
+  unsigned int m_task_component_count = 0;
+  ON_BrepValidationError::Component m_task_component[8] = {};
+  int m_task_offset[9] = {};
+
+  // m_ok[c][i] is true if component i of type c passed the first pass.
+  ON_SimpleArray<bool> m_ok[10];
+
+  // m_ok2[ti] is true if m_T[ti] passed the second pass.
+  ON_SimpleArray<bool> m_ok2;
+
+  // Errors found by each thread. Thread blocks are ordered by thread_index,
+  // so concatenating these arrays gives a thread count independent order.
+  ON_ClassArray< ON_ClassArray<ON_BrepValidationError> > m_thread_errors;
+
+  static int ComponentCount(const ON_Brep& brep, ON_BrepValidationError::Component c)
+  {
+    switch (c)
+    {
+    case ON_BrepValidationError::Component::Vertex: return brep.m_V.Count();
+    case ON_BrepValidationError::Component::Edge: return brep.m_E.Count();
+    case ON_BrepValidationError::Component::Trim: return brep.m_T.Count();
+    case ON_BrepValidationError::Component::Loop: return brep.m_L.Count();
+    case ON_BrepValidationError::Component::Face: return brep.m_F.Count();
+    case ON_BrepValidationError::Component::Curve2d: return brep.m_C2.Count();
+    case ON_BrepValidationError::Component::Curve3d: return brep.m_C3.Count();
+    case ON_BrepValidationError::Component::Surface: return brep.m_S.Count();
+    default: break;
+    }
+    return 0;
+  }
+
+  bool Passed(ON_BrepValidationError::Component c, int index) const
+  {
+    // Invalid indices are reported by the check that uses them.
+    const ON_SimpleArray<bool>& ok = m_ok[static_cast<unsigned int>(c)];
+    return (index < 0 || index >= ok.Count() || ok[index]);
+  }
+
+  void AddError(
+    unsigned int thread_index,
+    ON_BrepValidationError::Component c,
+    int index,
+    const ON_wString& description
+  )
+  {
+    ON_BrepValidationError& e = m_thread_errors[thread_index].AppendNew();
+    e.m_component = c;
+    e.m_index = index;
+    e.m_description = description;
+  }
+
+  bool RunPass(
+    unsigned int pass,
+    unsigned int component_count,
+    const ON_BrepValidationError::Component* components,
+    unsigned int max_thread_count,
+    ON_BrepValidationReport& report
+  );
+
+  bool Check1(ON_BrepValidationError::Component c, int i, ON_TextLog* text_log) const;
+  bool CanCheck2(ON_BrepValidationError::Component c, int i) const;
+  bool Check2(ON_BrepValidationError::Component c, int i, ON_TextLog* text_log) const;
+
+  // Runs the check for the current pass. Most components are valid, so
+  // the check runs without a text log and is repeated with one to get
+  // the description of a failure.
+  bool Check(unsigned int thread_index, ON_BrepValidationError::Component c, int i)
+  {
+    if (2 == m_pass && false == CanCheck2(c, i))
+      return false;
+    if (1 == m_pass ? Check1(c, i, nullptr) : Check2(c, i, nullptr))
+      return true;
+    ON_wString description;
+    ON_TextLog text_log(description);
+    if (1 == m_pass ? Check1(c, i, &text_log) : Check2(c, i, &text_log))
+      return true;
+    AddError(thread_index, c, i, description);
+    return false;
+  }
+};
+
+static void Internal_BrepValidationRange(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1)
+{
+  ON_Internal_BrepValidator* v = (ON_Internal_BrepValidator*)context;
+  unsigned int k = 0;
+  for (size_t task = i0; task < i1; task++)
+  {
+    const int t = (int)task;
+    while (t >= v->m_task_offset[k + 1])
+      k++;
+    const ON_BrepValidationError::Component c = v->m_task_component[k];
+    const int i = t - v->m_task_offset[k];
+    const bool rc = v->Check(thread_index, c, i);
+    if (1 == v->m_pass)
+      v->m_ok[static_cast<unsigned int>(c)][i] = rc;
+    else if (ON_BrepValidationError::Component::Trim == c)
+      v->m_ok2[i] = rc;
+  }
+}
+
+bool ON_Internal_BrepValidator::RunPass(
+  unsigned int pass,
+  unsigned int component_count,
+  const ON_BrepValidationError::Component* components,
+  unsigned int max_thread_count,
+  ON_BrepValidationReport& report
+)
+{
+  m_pass = pass;
+  m_task_component_count = component_count;
+  m_task_offset[0] = 0;
+  for (unsigned int k = 0; k < component_count; k++)
+  {
+    m_task_component[k] = components[k];
+    m_task_offset[k + 1] = m_task_offset[k] + ComponentCount(m_brep, components[k]);
+  }
+  const size_t task_count = (size_t)m_task_offset[component_count];
+  if (0 == task_count)
+    return true;
+
+  // Checking a single component is cheap compared to starting a thread.
+  const size_t min_tasks_per_thread = 0x40;
+  const unsigned int thread_count = ON_Parallel::ThreadCount(task_count, min_tasks_per_thread, max_thread_count);
+  m_thread_errors.Destroy();
+  m_thread_errors.Reserve(thread_count);
+  for (unsigned int i = 0; i < thread_count; i++)
+    m_thread_errors.AppendNew();
+
+  if (0 == ON_ParallelFor(task_count, min_tasks_per_thread, max_thread_count, Internal_BrepValidationRange, (ON__UINT_PTR)this))
+    return false;
+
+  for (unsigned int i = 0; i < thread_count; i++)
+  {
+    const ON_ClassArray<ON_BrepValidationError>& errors = m_thread_errors[i];
+    for (int j = 0; j < errors.Count(); j++)
+      report.m_errors.Append(errors[j]);
+  }
+  m_thread_errors.Destroy();
+  return true;
+}
+
+bool ON_Internal_BrepValidator::Check1(ON_BrepValidationError::Component c, int i, ON_TextLog* text_log) const
+{
+  const ON_Brep& brep = m_brep;
+  bool rc = false;
+  switch (c)
+  {
+  case ON_BrepValidationError::Component::Curve2d:
+    rc = Internal_IsValidBrepCurve2d(brep, i, text_log);
+    break;
+
+  case ON_BrepValidationError::Component::Curve3d:
+    rc = Internal_IsValidBrepCurve3d(brep, i, text_log);
+    break;
+
+  case ON_BrepValidationError::Component::Surface:
+    rc = Internal_IsValidBrepSurface(brep, i, text_log);
+    break;
+
+  case ON_BrepValidationError::Component::Vertex:
+    rc = Internal_IsValidBrepVertexIndex(brep, i, text_log);
+    if (rc && -1 != brep.m_V[i].m_vertex_index && false == brep.IsValidVertex(i, text_log))
     {
-      // the "e" values are not set.
-      // This is permitted. The are set when extensive
-      // trim-edge parameter correspondence is needed.
-      // Meshing is an example of a calculation that sets
-      // the "e" paramters.
-      continue;
+      if (text_log)
+        text_log->Print("ON_Brep.m_V[%d] is invalid.\n", i);
+      rc = false;
     }
+    break;
 
-    if ( trim.m_ei < 0 || trim.m_ei >= m_E.Count() )
+  case ON_BrepValidationError::Component::Edge:
+    rc = Internal_IsValidBrepEdgeIndex(brep, i, text_log);
+    if (rc && -1 != brep.m_E[i].m_edge_index && false == brep.IsValidEdge(i, text_log))
     {
-      if (text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_pline has e parameters but trim.m_ei is not valid.\n",ti);
-      return ON_BrepIsNotValid();
+      if (text_log)
+        text_log->Print("ON_Brep.m_E[%d] is invalid.\n", i);
+      rc = false;
     }
-    const ON_BrepEdge& edge = m_E[trim.m_ei];
-    const ON_Interval edge_domain = edge.Domain();
-    const int i0 = trim.m_bRev3d ? pline_count-1 : 0;
-    const int i1 = trim.m_bRev3d ? 0 : pline_count-1;
-    const int di = trim.m_bRev3d ? -1 : 1;
-    if ( !(trim.m_pline[i0].e == edge_domain[0]) )
+    break;
+
+  case ON_BrepValidationError::Component::Trim:
+    rc = Internal_IsValidBrepTrimIndex(brep, i, text_log);
+    break;
+
+  case ON_BrepValidationError::Component::Loop:
+    rc = Internal_IsValidBrepLoopIndex(brep, i, text_log)
+      && Internal_IsValidBrepLoopFace(brep, i, text_log);
+    break;
+
+  case ON_BrepValidationError::Component::Face:
+    rc = Internal_IsValidBrepFaceIndex(brep, i, text_log);
+    if (rc && -1 != brep.m_F[i].m_face_index && false == brep.IsValidFace(i, text_log))
     {
-      if (text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_pline[%d].e != start of edge domain.\n",ti,i0);
-      return ON_BrepIsNotValid();
+      if (text_log)
+        text_log->Print("ON_Brep.m_F[%d] is invalid.\n", i);
+      rc = false;
     }
-    if ( !(trim.m_pline[i1].e == edge_domain[1]) )
+    break;
+
+  default:
+    break;
+  }
+  return rc;
+}
+
+bool ON_Internal_BrepValidator::CanCheck2(ON_BrepValidationError::Component c, int i) const
+{
+  // The second pass checks are only performed when the components they
+  // depend on passed the first pass. Otherwise the problem has already
+  // been reported and the check could dereference bad data.
+  if (false == Passed(c, i))
+    return false;
+  if (ON_BrepValidationError::Component::Trim != c)
+    return true;
+  const ON_BrepTrim& trim = m_brep.m_T[i];
+  if (-1 == trim.m_trim_index)
+    return true;
+  if (false == Passed(ON_BrepValidationError::Component::Loop, trim.m_li))
+    return false;
+  if (trim.m_li >= 0 && trim.m_li < m_brep.m_L.Count()
+    && false == Passed(ON_BrepValidationError::Component::Face, m_brep.m_L[trim.m_li].m_fi))
+    return false;
+  return Passed(ON_BrepValidationError::Component::Edge, trim.m_ei)
+    && Passed(ON_BrepValidationError::Component::Curve2d, trim.m_c2i)
+    && Passed(ON_BrepValidationError::Component::Vertex, trim.m_vi[0])
+    && Passed(ON_BrepValidationError::Component::Vertex, trim.m_vi[1]);
+}
+
+bool ON_Internal_BrepValidator::Check2(ON_BrepValidationError::Component c, int i, ON_TextLog* text_log) const
+{
+  switch (c)
+  {
+  case ON_BrepValidationError::Component::Trim:
+    return Internal_IsValidBrepTrimInBrep(m_brep, i, text_log);
+  case ON_BrepValidationError::Component::Loop:
+    return Internal_IsValidBrepLoopTrims(m_brep, i, text_log);
+  case ON_BrepValidationError::Component::Face:
+    return Internal_IsValidBrepFaceSeams(m_brep, i, text_log);
+  default:
+    break;
+  }
+  return true;
+}
+
+bool ON_Brep::Validate(
+  ON_BrepValidationReport& report,
+  bool bParallel
+) const
+{
+  report.Clear();
+
+  {
+    ON_wString description;
+    ON_TextLog text_log(description);
+    bool bBrepIsValid = true;
+    if (IsCorrupt(false, true, &text_log))
+      bBrepIsValid = false;
+    else if (false == Internal_IsValidBrepComponentCounts(*this, &text_log))
+      bBrepIsValid = false;
+    if (false == bBrepIsValid)
     {
-      if (text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_pline[%d].e != end of edge domain.\n",ti,i1);
+      ON_BrepValidationError& e = report.m_errors.AppendNew();
+      e.m_component = ON_BrepValidationError::Component::Brep;
+      e.m_index = -1;
+      e.m_description = description;
       return ON_BrepIsNotValid();
     }
-    int prev_valid_i = i0;
-    for ( int i = i0+di; i >= 0 && i < pline_count && i-di >= 0 && i-di < pline_count; i += di )
+  }
+
+  const unsigned int max_thread_count = bParallel ? 0U : 1U;
+  ON_Internal_BrepValidator validator(*this);
+  for (unsigned int c = 0; c < 10; c++)
+  {
+    const int count = ON_Internal_BrepValidator::ComponentCount(*this, static_cast<ON_BrepValidationError::Component>(c));
+    validator.m_ok[c].Reserve(count);
+    validator.m_ok[c].SetCount(count);
+    validator.m_ok[c].Zero();
+  }
+  validator.m_ok2.Reserve(m_T.Count());
+  validator.m_ok2.SetCount(m_T.Count());
+  validator.m_ok2.Zero();
+
+  // Pass 1: component indices and geometry. 
+  // The expensive per-component geometry checks are all in this pass.
+  const ON_BrepValidationError::Component pass1[8] =
+  {
+    ON_BrepValidationError::Component::Curve2d,
+    ON_BrepValidationError::Component::Curve3d,
+    ON_BrepValidationError::Component::Surface,
+    ON_BrepValidationError::Component::Vertex,
+    ON_BrepValidationError::Component::Edge,
+    ON_BrepValidationError::Component::Trim,
+    ON_BrepValidationError::Component::Loop,
+    ON_BrepValidationError::Component::Face
+  };
+  if (false == validator.RunPass(1, 8, pass1, max_thread_count, report))
+    return ON_BrepIsNotValid();
+
+  // Pass 2: trim tolerances and the loop and face cross checks.
+  const ON_BrepValidationError::Component pass2[3] =
+  {
+    ON_BrepValidationError::Component::Trim,
+    ON_BrepValidationError::Component::Loop,
+    ON_BrepValidationError::Component::Face
+  };
+  if (false == validator.RunPass(2, 3, pass2, max_thread_count, report))
+    return ON_BrepIsNotValid();
+
+  // Pass 3: seam trim pairs. This is cheap and runs on the calling thread.
+  for (int ti = 0; ti < m_T.Count(); ti++)
+  {
+    const ON_BrepTrim& trim = m_T[ti];
+    if (false == validator.m_ok2[ti] || ON_BrepTrim::seam != trim.m_type)
+      continue;
+    ON_wString description;
+    ON_TextLog text_log(description);
+    if (false == Internal_IsValidBrepSeamTrim(*this, ti, &text_log))
     {
-      if ( !ON_IsValid(trim.m_pline[i].e) )
-      {
-        // internal "e" may be invalid when the setter
-        // had troubles.  This is a symptom of a 
-        // bad trim or edge curve, but is not conclusive
-        // proof.
-        continue;
-      }
-      if ( !(trim.m_pline[prev_valid_i].e < trim.m_pline[i].e) )
-      {
-        if (text_log )
-          text_log->Print("ON_Brep.m_T[%d].m_pline[%d].t must be < m_pline[%d].t.\n",ti,prev_valid_i,i);
-        return ON_BrepIsNotValid();
-      }
-      prev_valid_i = i;
+      ON_BrepValidationError& e = report.m_errors.AppendNew();
+      e.m_component = ON_BrepValidationError::Component::Trim;
+      e.m_index = ti;
+      e.m_description = description;
     }
   }
-#endif
 
-  return true;
+  // Same warning as IsValid(). It does not make the brep invalid.
+  Internal_CheckCachedBoundingBox(nullptr);
+
+  return report.IsValid() ? true : ON_BrepIsNotValid();
 }
 
 
@@ -6567,6 +7136,7 @@ bool ON_Brep::GetTightBoundingBox(ON_BoundingBox& tight_bbox, bool bGrowBox, con
 void ON_Brep::ClearBoundingBox()
 {
   m_bbox.Destroy();
+  DestroyComponentTree();
 }
 
 void ON_BrepFace::ClearBoundingBox()
@@ -6770,6 +7340,7 @@ bool ON_Brep::GetBBox(
 bool
 ON_Brep::SwapCoordinates( int i, int j )
 {
+  UnshareGeometry();
   bool rc = false;
   // swap surface coordinates
   const int srf_count = m_S.Count();
@@ -6818,6 +7389,7 @@ ON_Brep::SwapTrimParameters(
   // helper for SwapLoopParameters
   if ( trim_index < 0 || trim_index >= m_T.Count() )
     return false;
+  UnshareGeometry();
   ON_BrepTrim& trim = m_T[trim_index];
 
   StandardizeTrimCurve(trim_index);
@@ -7313,6 +7885,7 @@ bool ON_BrepFace::Reverse(int dir)
 {
   if ( dir < 0 || dir > 1 || 0 == m_brep )
     return false;
+  m_brep->UnshareGeometry();
   ON_Surface* srf = const_cast<ON_Surface*>(SurfaceOf());
   if ( !srf )
     return false;
@@ -7388,6 +7961,7 @@ bool ON_BrepFace::Transpose()
 {
   if ( 0 == m_brep )
     return false;
+  m_brep->UnshareGeometry();
 
   ON_Surface* srf = const_cast<ON_Surface*>(SurfaceOf());
   if ( 0 == srf )
@@ -7474,6 +8048,7 @@ bool ON_BrepFace::SetDomain(
 {
   if ( 0 == m_brep )
     return false;
+  m_brep->UnshareGeometry();
   if ( !u_dom.IsIncreasing() )
     return false;
   if ( !v_dom.IsIncreasing() )
@@ -9656,6 +10231,7 @@ ON_Brep* ON_Brep::ExtractFace( int face_index )
 
 void ON_Brep::DeleteSurface(int si)
 {
+  UnshareGeometry();
   if ( si >= 0 && si < m_S.Count() ) {
     delete m_S[si];
     m_S[si] = 0;
@@ -9664,6 +10240,7 @@ void ON_Brep::DeleteSurface(int si)
 
 void ON_Brep::Delete2dCurve(int c2i)
 {
+  UnshareGeometry();
   if ( c2i >= 0 && c2i < m_C2.Count() ) {
     delete m_C2[c2i];
     m_C2[c2i] = 0;
@@ -9672,6 +10249,7 @@ void ON_Brep::Delete2dCurve(int c2i)
 
 void ON_Brep::Delete3dCurve(int c3i)
 {
+  UnshareGeometry();
   if ( c3i >= 0 && c3i < m_C3.Count() ) {
     delete m_C3[c3i];
     m_C3[c3i] = 0;
@@ -9740,6 +10318,7 @@ bool ON_Brep::CullUnusedFaces()
 
 bool ON_Brep::CullUnusedSurfaces()
 {
+  UnshareGeometry();
   // remove unused surfaces
   bool rc = true;
   const int fcount = m_F.Count();
@@ -9808,6 +10387,7 @@ bool ON_Brep::CullUnusedSurfaces()
 
 bool ON_Brep::CullUnused3dCurves()
 {
+  UnshareGeometry();
   // remove unused surfaces
   bool rc = true;
   const int ecount = m_E.Count();
@@ -9877,6 +10457,7 @@ bool ON_Brep::CullUnused3dCurves()
 
 bool ON_Brep::CullUnused2dCurves()
 {
+  UnshareGeometry();
   // remove unused surfaces
   bool rc = true;
   const int tcount = m_T.Count();
@@ -10462,122 +11043,364 @@ bool ON_Brep::Compact()
 }
 
 
-ON_Brep& ON_Brep::operator=(const ON_Brep& src)
+class ON_Internal_BrepSharedGeometry
 {
-  if ( this != &src ) 
+public:
+  ON_Internal_BrepSharedGeometry() = default;
+  ~ON_Internal_BrepSharedGeometry()
   {
-    Destroy();
-    ON_Geometry::operator=(src);
-
-    m_V.SetCapacity(src.m_V.Count());
-    m_E.SetCapacity(src.m_E.Count());
-    m_F.SetCapacity(src.m_F.Count());
-    m_T.SetCapacity(src.m_T.Count());
-    m_L.SetCapacity(src.m_L.Count());
-
-    m_V.SetCount(src.m_V.Count());
-    m_E.SetCount(src.m_E.Count());
-    m_F.SetCount(src.m_F.Count());
-    m_T.SetCount(src.m_T.Count());
-    m_L.SetCount(src.m_L.Count());
+    for (int i = 0; i < m_C2.Count(); i++)
+      delete m_C2[i];
+    for (int i = 0; i < m_C3.Count(); i++)
+      delete m_C3[i];
+    for (int i = 0; i < m_S.Count(); i++)
+      delete m_S[i];
+  }
 
-    src.m_C2.Duplicate( m_C2 );
-    src.m_C3.Duplicate( m_C3 );
-    src.m_S.Duplicate( m_S );
+private:
+  ON_Internal_BrepSharedGeometry(const ON_Internal_BrepSharedGeometry&) = delete;
+  ON_Internal_BrepSharedGeometry& operator=(const ON_Internal_BrepSharedGeometry&) = delete;
 
-    const int C2_count = m_C2.Count();
-    const int C3_count = m_C3.Count();
-    const int S_count = m_S.Count();
+public:
+  // number of breps that reference this geometry
+  std::atomic<int> m_ref_count{ 0 };
+
+  // The shared curves and surfaces. A brep's m_C2[i] is shared when
+  // it is the same pointer as m_C2[i] here. The same is true for
+  // m_C3[] and m_S[].
+  ON_SimpleArray<ON_Curve*> m_C2;
+  ON_SimpleArray<ON_Curve*> m_C3;
+  ON_SimpleArray<ON_Surface*> m_S;
+
+  template <class T> static bool IsShared(
+    const ON_SimpleArray<T*>& shared,
+    const ON_SimpleArray<T*>& a,
+    int i
+  )
+  {
+    return (i < shared.Count() && nullptr != a[i] && a[i] == shared[i]);
+  }
 
-    int i, count = m_V.Count();
-    for ( i = 0; i < count; i++ ) 
+  /*
+  Description:
+    Sets dst.m_C2[], dst.m_C3[] and dst.m_S[] to reference the
+    geometry in src. The topology is not copied.
+  */
+  static void Share(const ON_Brep& src, ON_Brep& dst)
+  {
+    ON_Internal_BrepSharedGeometry* shared = src.m_shared_geometry;
+    if (nullptr == shared)
     {
-      m_V[i] = src.m_V[i];
+      // src.m_C2[], src.m_C3[] and src.m_S[] become shared.
+      shared = new ON_Internal_BrepSharedGeometry();
+      shared->m_C2 = src.m_C2;
+      shared->m_C3 = src.m_C3;
+      shared->m_S = src.m_S;
+      shared->m_ref_count = 1;
+      src.m_shared_geometry = shared;
     }
+    shared->m_ref_count++;
+    dst.m_shared_geometry = shared;
 
-    count = m_E.Count();
-    for ( i = 0; i < count; i++ ) 
+    // Curves and surfaces src added or replaced after it began sharing
+    // belong to src and are duplicated.
+    dst.m_C2.SetCapacity(src.m_C2.Count());
+    for (int i = 0; i < src.m_C2.Count(); i++)
+    {
+      const ON_Curve* c2 = src.m_C2[i];
+      dst.m_C2.Append((IsShared(shared->m_C2, src.m_C2, i) || nullptr == c2) ? src.m_C2[i] : c2->DuplicateCurve());
+    }
+    dst.m_C3.SetCapacity(src.m_C3.Count());
+    for (int i = 0; i < src.m_C3.Count(); i++)
     {
-      m_E[i] = src.m_E[i];
-      ON_BrepEdge& e = m_E[i];
-      e.m_brep = this;
+      const ON_Curve* c3 = src.m_C3[i];
+      dst.m_C3.Append((IsShared(shared->m_C3, src.m_C3, i) || nullptr == c3) ? src.m_C3[i] : c3->DuplicateCurve());
+    }
+    dst.m_S.SetCapacity(src.m_S.Count());
+    for (int i = 0; i < src.m_S.Count(); i++)
+    {
+      const ON_Surface* srf = src.m_S[i];
+      dst.m_S.Append((IsShared(shared->m_S, src.m_S, i) || nullptr == srf) ? src.m_S[i] : srf->DuplicateSurface());
+    }
+  }
+};
 
-      if (e.m_c3i >= C3_count)
-      {
-        ON_ERROR("src brep has invalid ON_BrepEdge.m_c3i value.");
-        e.m_c3i = -1;
-      }
+static void Internal_SetProxyCurve(ON_CurveProxy& proxy, const ON_Curve* curve)
+{
+  // same as the proxy curve update in ON_Brep::operator=
+  const ON_Interval proxy_curve_domain = proxy.ProxyCurveDomain();
+  const ON_Interval domain = proxy.Domain();
+  const bool bReversed = proxy.ProxyCurveIsReversed();
+  proxy.SetProxyCurve(curve, proxy_curve_domain);
+  if (bReversed)
+    proxy.ON_CurveProxy::Reverse();
+  proxy.SetDomain(domain);
+}
 
-      // update curve proxy info to point at 3d curve in this brep
-      e.SetProxyCurve( ( e.m_c3i >= 0 ) ? m_C3[e.m_c3i] : 0, 
-                       src.m_E[i].ProxyCurveDomain()
-                       );
-      if ( src.m_E[i].ProxyCurveIsReversed() )
-        e.ON_CurveProxy::Reverse();
-      e.SetDomain( src.m_E[i].Domain() );
-    }
+bool ON_Brep::CopyWithSharedGeometry(const ON_Brep& src)
+{
+  if (this != &src)
+    Internal_CopyFrom(src, true);
+  return true;
+}
+
+bool ON_Brep::HasSharedGeometry() const
+{
+  return (nullptr != m_shared_geometry && m_shared_geometry->m_ref_count > 1);
+}
+
+bool ON_Brep::UnshareGeometry()
+{
+  return Internal_UnshareGeometry(true);
+}
 
-    count = m_L.Count();
-    for ( i = 0; i < count; i++ ) 
+bool ON_Brep::Internal_UnshareGeometry(bool bUnshare2dCurves)
+{
+  ON_Internal_BrepSharedGeometry* shared = m_shared_geometry;
+  if (nullptr == shared)
+    return true;
+
+  bool rc = true;
+  if (1 == shared->m_ref_count)
+  {
+    // This brep is the only one left that references the shared
+    // geometry. It takes ownership and nothing is duplicated.
+    for (int i = 0; i < m_C2.Count() && bUnshare2dCurves; i++)
     {
-      m_L[i].m_brep = this;
+      if (ON_Internal_BrepSharedGeometry::IsShared(shared->m_C2, m_C2, i))
+        shared->m_C2[i] = nullptr;
     }
-
-    count = m_F.Count();
-    for ( i = 0; i < count; i++ ) 
+    for (int i = 0; i < m_C3.Count(); i++)
+    {
+      if (ON_Internal_BrepSharedGeometry::IsShared(shared->m_C3, m_C3, i))
+        shared->m_C3[i] = nullptr;
+    }
+    for (int i = 0; i < m_S.Count(); i++)
+    {
+      if (ON_Internal_BrepSharedGeometry::IsShared(shared->m_S, m_S, i))
+        shared->m_S[i] = nullptr;
+    }
+  }
+  else
+  {
+    for (int i = 0; i < m_C2.Count() && bUnshare2dCurves; i++)
+    {
+      if (false == ON_Internal_BrepSharedGeometry::IsShared(shared->m_C2, m_C2, i))
+        continue;
+      m_C2[i] = m_C2[i]->DuplicateCurve();
+      if (nullptr == m_C2[i])
+        rc = false;
+    }
+    for (int i = 0; i < m_C3.Count(); i++)
+    {
+      if (false == ON_Internal_BrepSharedGeometry::IsShared(shared->m_C3, m_C3, i))
+        continue;
+      m_C3[i] = m_C3[i]->DuplicateCurve();
+      if (nullptr == m_C3[i])
+        rc = false;
+    }
+    for (int i = 0; i < m_S.Count(); i++)
     {
-      m_F[i] = src.m_F[i];
-      ON_BrepFace& f = m_F[i];
-      f.m_brep = this;
+      if (false == ON_Internal_BrepSharedGeometry::IsShared(shared->m_S, m_S, i))
+        continue;
+      m_S[i] = m_S[i]->DuplicateSurface();
+      if (nullptr == m_S[i])
+        rc = false;
+    }
 
-      if (f.m_si >= S_count)
+    // update the proxies that reference the shared geometry
+    for (int ti = 0; ti < m_T.Count() && bUnshare2dCurves; ti++)
+    {
+      ON_BrepTrim& trim = m_T[ti];
+      const int c2i = trim.m_c2i;
+      if (c2i >= 0 && c2i < shared->m_C2.Count() && c2i < m_C2.Count() && trim.ProxyCurve() == shared->m_C2[c2i])
+        Internal_SetProxyCurve(trim, m_C2[c2i]);
+    }
+    for (int ei = 0; ei < m_E.Count(); ei++)
+    {
+      ON_BrepEdge& edge = m_E[ei];
+      const int c3i = edge.m_c3i;
+      if (c3i >= 0 && c3i < shared->m_C3.Count() && c3i < m_C3.Count() && edge.ProxyCurve() == shared->m_C3[c3i])
+        Internal_SetProxyCurve(edge, m_C3[c3i]);
+    }
+    for (int fi = 0; fi < m_F.Count(); fi++)
+    {
+      ON_BrepFace& face = m_F[fi];
+      const int si = face.m_si;
+      if (si >= 0 && si < shared->m_S.Count() && si < m_S.Count() && face.ProxySurface() == shared->m_S[si])
       {
-        ON_ERROR("src brep has invalid ON_BrepFace.m_si value.");
-        f.m_si = -1;
+        const ON_BoundingBox bbox = face.m_bbox;
+        const bool bTransposed = face.ProxySurfaceIsTransposed();
+        face.SetProxySurface(m_S[si]);
+        if (bTransposed)
+          face.ON_SurfaceProxy::Transpose();
+        face.m_bbox = bbox; // because SetProxySurface destroys it
       }
-
-      // update surface proxy info to point at 3d surface in this brep
-      f.SetProxySurface(( f.m_si >= 0 ) ? m_S[f.m_si] : 0);
-      f.m_bbox = src.m_F[i].m_bbox; // because SetProxySurface destroys it
     }
+  }
 
-    count = m_T.Count();
-    for ( i = 0; i < count; i++ ) 
-    {
-      m_T[i] = src.m_T[i];
-      ON_BrepTrim& trim = m_T[i];
-      trim.m_brep = this;
+  // When bUnshare2dCurves is false, this brep keeps its reference
+  // so the 2d curves it still shares are not deleted.
+  if (bUnshare2dCurves)
+    Internal_ReleaseSharedGeometry();
+  return rc;
+}
 
-      if (trim.m_c2i >= C2_count)
-      {
-        ON_ERROR("src brep has invalid ON_BrepTrim.m_c2i value.");
-        trim.m_c2i = -1;
-      }
+void ON_Brep::Internal_ReleaseSharedGeometry()
+{
+  ON_Internal_BrepSharedGeometry* shared = m_shared_geometry;
+  if (nullptr == shared)
+    return;
+  m_shared_geometry = nullptr;
+
+  // Shared curves and surfaces are removed from the arrays so
+  // Destroy() and ~ON_Brep() do not delete them.
+  for (int i = 0; i < m_C2.Count(); i++)
+  {
+    if (ON_Internal_BrepSharedGeometry::IsShared(shared->m_C2, m_C2, i))
+      m_C2[i] = nullptr;
+  }
+  for (int i = 0; i < m_C3.Count(); i++)
+  {
+    if (ON_Internal_BrepSharedGeometry::IsShared(shared->m_C3, m_C3, i))
+      m_C3[i] = nullptr;
+  }
+  for (int i = 0; i < m_S.Count(); i++)
+  {
+    if (ON_Internal_BrepSharedGeometry::IsShared(shared->m_S, m_S, i))
+      m_S[i] = nullptr;
+  }
+
+  if (0 == --shared->m_ref_count)
+    delete shared;
+}
+
+ON_Brep& ON_Brep::operator=(const ON_Brep& src)
+{
+  if ( this != &src ) 
+    Internal_CopyFrom(src, false);
+  return *this;
+}
+
+void ON_Brep::Internal_CopyFrom(const ON_Brep& src, bool bShareGeometry)
+{
+  Destroy();
+  ON_Geometry::operator=(src);
+
+  m_V.SetCapacity(src.m_V.Count());
+  m_E.SetCapacity(src.m_E.Count());
+  m_F.SetCapacity(src.m_F.Count());
+  m_T.SetCapacity(src.m_T.Count());
+  m_L.SetCapacity(src.m_L.Count());
+
+  m_V.SetCount(src.m_V.Count());
+  m_E.SetCount(src.m_E.Count());
+  m_F.SetCount(src.m_F.Count());
+  m_T.SetCount(src.m_T.Count());
+  m_L.SetCount(src.m_L.Count());
+
+  if (bShareGeometry)
+  {
+    ON_Internal_BrepSharedGeometry::Share(src, *this);
+  }
+  else
+  {
+    src.m_C2.Duplicate( m_C2 );
+    src.m_C3.Duplicate( m_C3 );
+    src.m_S.Duplicate( m_S );
+  }
+
+  const int C2_count = m_C2.Count();
+  const int C3_count = m_C3.Count();
+  const int S_count = m_S.Count();
+
+  int i, count = m_V.Count();
+  for ( i = 0; i < count; i++ ) 
+  {
+    m_V[i] = src.m_V[i];
+  }
+
+  count = m_E.Count();
+  for ( i = 0; i < count; i++ ) 
+  {
+    m_E[i] = src.m_E[i];
+    ON_BrepEdge& e = m_E[i];
+    e.m_brep = this;
 
-      // update curve proxy info to point at 2d curve in this brep
-      trim.SetProxyCurve( ( trim.m_c2i >= 0 ) ? m_C2[trim.m_c2i] : 0, 
-                          src.m_T[i].ProxyCurveDomain()
-                         );
-      if ( src.m_T[i].ProxyCurveIsReversed() )
-        trim.ON_CurveProxy::Reverse();
-      trim.SetDomain( src.m_T[i].Domain() );
+    if (e.m_c3i >= C3_count)
+    {
+      ON_ERROR("src brep has invalid ON_BrepEdge.m_c3i value.");
+      e.m_c3i = -1;
     }
 
-    count = m_L.Count();
-    for ( i = 0; i < count; i++ ) 
+    // update curve proxy info to point at 3d curve in this brep
+    e.SetProxyCurve( ( e.m_c3i >= 0 ) ? m_C3[e.m_c3i] : 0, 
+                     src.m_E[i].ProxyCurveDomain()
+                     );
+    if ( src.m_E[i].ProxyCurveIsReversed() )
+      e.ON_CurveProxy::Reverse();
+    e.SetDomain( src.m_E[i].Domain() );
+  }
+
+  count = m_L.Count();
+  for ( i = 0; i < count; i++ ) 
+  {
+    m_L[i].m_brep = this;
+  }
+
+  count = m_F.Count();
+  for ( i = 0; i < count; i++ ) 
+  {
+    m_F[i] = src.m_F[i];
+    ON_BrepFace& f = m_F[i];
+    f.m_brep = this;
+
+    if (f.m_si >= S_count)
     {
-      m_L[i] = src.m_L[i];
+      ON_ERROR("src brep has invalid ON_BrepFace.m_si value.");
+      f.m_si = -1;
     }
 
-    m_bbox = src.m_bbox;
-    m_is_solid = src.m_is_solid;
+    // update surface proxy info to point at 3d surface in this brep
+    f.SetProxySurface(( f.m_si >= 0 ) ? m_S[f.m_si] : 0);
+    f.m_bbox = src.m_F[i].m_bbox; // because SetProxySurface destroys it
+  }
+
+  count = m_T.Count();
+  for ( i = 0; i < count; i++ ) 
+  {
+    m_T[i] = src.m_T[i];
+    ON_BrepTrim& trim = m_T[i];
+    trim.m_brep = this;
 
-    if (nullptr != src.m_region_topology){
-      m_region_topology = new ON_BrepRegionTopology(*src.m_region_topology);
-      m_region_topology->m_brep = this;
+    if (trim.m_c2i >= C2_count)
+    {
+      ON_ERROR("src brep has invalid ON_BrepTrim.m_c2i value.");
+      trim.m_c2i = -1;
     }
+
+    // update curve proxy info to point at 2d curve in this brep
+    trim.SetProxyCurve( ( trim.m_c2i >= 0 ) ? m_C2[trim.m_c2i] : 0, 
+                        src.m_T[i].ProxyCurveDomain()
+                       );
+    if ( src.m_T[i].ProxyCurveIsReversed() )
+      trim.ON_CurveProxy::Reverse();
+    trim.SetDomain( src.m_T[i].Domain() );
+  }
+
+  count = m_L.Count();
+  for ( i = 0; i < count; i++ ) 
+  {
+    m_L[i] = src.m_L[i];
+  }
+
+  m_bbox = src.m_bbox;
+  m_is_solid = src.m_is_solid;
+
+  if (nullptr != src.m_region_topology){
+    m_region_topology = new ON_BrepRegionTopology(*src.m_region_topology);
+    m_region_topology->m_brep = this;
   }
-  return *this;
 }
 
 void ON_Brep::Destroy()
@@ -10590,6 +11413,9 @@ void ON_Brep::Destroy()
     m_region_topology = nullptr;
   }
 
+  DestroyComponentTree();
+  Internal_ReleaseSharedGeometry();
+
   m_V.Empty();
   m_E.Empty();
   m_F.Empty();
@@ -10640,6 +11466,8 @@ void ON_Brep::EmergencyDestroy()
   m_bbox.Destroy();
   m_is_solid = 0;
   m_region_topology = nullptr;
+  m_component_tree = nullptr;
+  m_shared_geometry = nullptr;
 }
 
 bool ON_Brep::CombineCoincidentVertices(ON_BrepVertex& vertex0, ON_BrepVertex& vertex1)
@@ -11994,6 +12822,7 @@ bool ON_Brep::StandardizeEdgeCurve( int edge_index, bool bAdjustEnds )
 
 bool ON_Brep::StandardizeEdgeCurve( int edge_index, bool bAdjustEnds, int EdgeCurveUse )
 {
+  UnshareGeometry();
   bool rc = false;
   ON_BrepEdge* edge = Edge(edge_index);
   if ( 0 != edge && edge->m_edge_index >= 0 )
@@ -12136,6 +12965,7 @@ void ON_Brep::StandardizeEdgeCurves( bool bAdjustEnds)
 
 bool ON_Brep::StandardizeTrimCurve( int trim_index )
 {
+  UnshareGeometry();
   bool rc = false;
   ON_BrepTrim* trim = Trim(trim_index);
   if ( 0 != trim && trim->m_trim_index >= 0 )
@@ -12217,6 +13047,7 @@ void ON_Brep::StandardizeTrimCurves()
 
 bool ON_Brep::StandardizeFaceSurface( int face_index )
 {
+  UnshareGeometry();
   bool rc = false;
   ON_BrepFace* face = Face(face_index);
   if ( 0 != face && face->m_face_index >= 0 )
@@ -12280,6 +13111,7 @@ void ON_Brep::Standardize()
 
 bool ON_Brep::ShrinkSurface( ON_BrepFace& face, int DisableMask )
 {
+  UnshareGeometry();
   ON_Surface* srf = const_cast<ON_Surface*>(face.SurfaceOf());
   if ( !srf )
     return false;
@@ -13145,6 +13977,7 @@ bool ON_BrepTrim::TransformTrim( const ON_Xform& xform )
 
   if ( !m_brep )
     return false;
+  m_brep->UnshareGeometry();
 
   // make sure only one trim uses the 2d curve
   if ( !m_brep->StandardizeTrimCurve( m_trim_index ) )
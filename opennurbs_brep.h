@@ -1667,6 +1667,243 @@ private:
   const ON_Brep* m_brep = nullptr;
 };
 
+/*
+Description:
+  One problem found by ON_Brep::Validate().
+*/
+class ON_CLASS ON_BrepValidationError
+{
+public:
+  ON_BrepValidationError() = default;
+  ~ON_BrepValidationError() = default;
+  ON_BrepValidationError(const ON_BrepValidationError&) = default;
+  ON_BrepValidationError& operator=(const ON_BrepValidationError&) = default;
+
+  enum class Component : unsigned char
+  {
+    Unset = 0,
+    // The problem is with the brep as a whole (empty arrays, corrupt indices).
+    Brep = 1,
+    Vertex = 2,   // m_index is an index into ON_Brep.m_V[]
+    Edge = 3,     // m_index is an index into ON_Brep.m_E[]
+    Trim = 4,     // m_index is an index into ON_Brep.m_T[]
+    Loop = 5,     // m_index is an index into ON_Brep.m_L[]
+    Face = 6,     // m_index is an index into ON_Brep.m_F[]
+    Curve2d = 7,  // m_index is an index into ON_Brep.m_C2[]
+    Curve3d = 8,  // m_index is an index into ON_Brep.m_C3[]
+    Surface = 9   // m_index is an index into ON_Brep.m_S[]
+  };
+
+  /*
+  Returns:
+    The ON_COMPONENT_INDEX of the vertex, edge, trim, loop or face.
+    ON_COMPONENT_INDEX::UnsetComponentIndex for other errors.
+  */
+  ON_COMPONENT_INDEX ComponentIndex() const;
+
+  ON_BrepValidationError::Component m_component = ON_BrepValidationError::Component::Unset;
+
+  // Index of the component in the array identified by m_component.
+  // -1 when m_component is Brep.
+  int m_index = -1;
+
+  // The same text ON_Brep::IsValid(text_log) prints for this problem.
+  ON_wString m_description;
+};
+
+#if defined(ON_DLL_TEMPLATE)
+ON_DLL_TEMPLATE template class ON_CLASS ON_ClassArray<ON_BrepValidationError>;
+#endif
+
+/*
+Description:
+  ON_BrepValidationReport collects every problem found by
+  ON_Brep::Validate(). Unlike ON_Brep::IsValid(), validation
+  does not stop at the first failure.
+*/
+class ON_CLASS ON_BrepValidationReport
+{
+public:
+  ON_BrepValidationReport() = default;
+  ~ON_BrepValidationReport() = default;
+  ON_BrepValidationReport(const ON_BrepValidationReport&) = default;
+  ON_BrepValidationReport& operator=(const ON_BrepValidationReport&) = default;
+
+  void Clear();
+
+  /*
+  Returns:
+    True if the report contains no errors.
+  */
+  bool IsValid() const;
+
+  unsigned int ErrorCount() const;
+
+  /*
+  Returns:
+    Number of errors for the specified type of component.
+  */
+  unsigned int ErrorCount(
+    ON_BrepValidationError::Component component
+  ) const;
+
+  void Dump(
+    class ON_TextLog& text_log
+  ) const;
+
+  // Errors are sorted by validation pass and then by component.
+  // The order does not depend on the number of threads used.
+  ON_ClassArray<ON_BrepValidationError> m_errors;
+};
+
+/*
+Description:
+  ON_BrepComponentTree is a spatial index of the bounding boxes
+  of the faces, edges and vertices of a brep. Searches report
+  ON_COMPONENT_INDEX values. Use ON_Brep::ComponentTree() to get
+  a cached tree that is created when it is first needed.
+*/
+class ON_CLASS ON_BrepComponentTree
+{
+public:
+  ON_BrepComponentTree() = default;
+  ~ON_BrepComponentTree();
+
+private:
+  ON_BrepComponentTree(const ON_BrepComponentTree&) = delete;
+  ON_BrepComponentTree& operator=(const ON_BrepComponentTree&) = delete;
+
+public:
+  /*
+  Description:
+    Create the tree. Face, edge and vertex bounding boxes are
+    expanded by the edge and vertex tolerances.
+  Parameters:
+    brep - [in]
+      The brep must exist and must not be modified while the
+      tree is in use.
+  Returns:
+    True if successful.
+  */
+  bool Create(
+    const class ON_Brep& brep
+  );
+
+  void Destroy();
+
+  /*
+  Returns:
+    The brep passed to Create() or nullptr.
+  */
+  const class ON_Brep* Brep() const;
+
+  /*
+  Returns:
+    True if the tree was created from brep and brep has the same
+    number of components and the same bounding box it had when
+    the tree was created.
+  */
+  bool IsCurrent(
+    const class ON_Brep& brep
+  ) const;
+
+  /*
+  Description:
+    Find components whose bounding boxes intersect a box, a sphere
+    or a capsule.
+  Parameters:
+    bbox - [in]
+    center - [in]
+    radius - [in]
+      sphere or capsule radius
+    segment - [in]
+      capsule axis
+    component_type - [in]
+      ON_COMPONENT_INDEX::brep_face, ON_COMPONENT_INDEX::brep_edge,
+      ON_COMPONENT_INDEX::brep_vertex or 
+      ON_COMPONENT_INDEX::invalid_type to search all three.
+    components - [out]
+      Components are appended to this array. Faces are appended
+      first, then edges and then vertices.
+  Returns:
+    Number of components appended to components[].
+  */
+  unsigned int Search(
+    const ON_BoundingBox& bbox,
+    ON_COMPONENT_INDEX::TYPE component_type,
+    ON_SimpleArray<ON_COMPONENT_INDEX>& components
+  ) const;
+
+  unsigned int Search(
+    ON_3dPoint center,
+    double radius,
+    ON_COMPONENT_INDEX::TYPE component_type,
+    ON_SimpleArray<ON_COMPONENT_INDEX>& components
+  ) const;
+
+  unsigned int Search(
+    const ON_Line& segment,
+    double radius,
+    ON_COMPONENT_INDEX::TYPE component_type,
+    ON_SimpleArray<ON_COMPONENT_INDEX>& components
+  ) const;
+
+  /*
+  Description:
+    Find the component closest to a point.
+  Parameters:
+    point - [in]
+    component_type - [in]
+      ON_COMPONENT_INDEX::brep_face, ON_COMPONENT_INDEX::brep_edge,
+      ON_COMPONENT_INDEX::brep_vertex or 
+      ON_COMPONENT_INDEX::invalid_type to search all three.
+    maximum_distance - [in]
+      If > 0, components farther than maximum_distance are ignored.
+    closest_point - [out]
+      If not nullptr, the closest point on the component is returned here.
+    distance - [out]
+      If not nullptr, the distance from point to the component is returned here.
+  Returns:
+    The closest component or ON_COMPONENT_INDEX::UnsetComponentIndex
+    if none was found.
+  Remarks:
+    Vertex distances are exact and edge distances are found by
+    sampling and refining on the edge curve. Face distances use
+    the cached face mesh (see ON_BrepFace::Mesh(ON::any_mesh)). Faces
+    without a cached mesh are sampled inside their trimming loops and
+    refined on the surface, and their edges are checked because the
+    closest point may be on the boundary.
+    When a vertex, edge and face are equally close, the vertex is
+    returned and when an edge and a face are equally close, the edge
+    is returned.
+  */
+  ON_COMPONENT_INDEX NearestComponent(
+    ON_3dPoint point,
+    ON_COMPONENT_INDEX::TYPE component_type,
+    double maximum_distance,
+    ON_3dPoint* closest_point,
+    double* distance
+  ) const;
+
+  size_t SizeOf() const;
+
+private:
+  friend class ON_Brep;
+  const class ON_Brep* m_brep = nullptr;
+  int m_vertex_count = 0;
+  int m_edge_count = 0;
+  int m_face_count = 0;
+  // brep bounding box when the tree was created
+  ON_BoundingBox m_brep_bbox = ON_BoundingBox::EmptyBoundingBox;
+  // The out of date tree this tree replaced in ON_Brep::ComponentTree().
+  // Other threads may still be using it, so it is deleted with this tree.
+  ON_BrepComponentTree* m_replaced_tree = nullptr;
+  // element ids are indices of the components
+  ON_RTree m_face_tree;
+  ON_RTree m_edge_tree;
+  ON_RTree m_vertex_tree;
+};
+
 class ON_CLASS ON_Brep : public ON_Geometry 
 {
   ON_OBJECT_DECLARE(ON_Brep);
@@ -1797,7 +2034,61 @@ public:
   void Destroy(); 
 
   // call if memory pool used by b-rep members becomes invalid
-  void EmergencyDestroy(); 
+  void EmergencyDestroy();
+
+  /*
+  Description:
+    Copies src to this brep. The topology is copied the same way
+    operator= copies it, but the surfaces and curves in src.m_S[],
+    src.m_C2[] and src.m_C3[] are shared with src instead of being
+    duplicated, so the copy costs about as much as copying the
+    topology.
+  Parameters:
+    src - [in]
+  Returns:
+    True if successful.
+  Remarks:
+    Shared geometry is copied on write. ON_Brep functions that modify
+    or delete surfaces and curves in place, like SwapCoordinates(),
+    Compact(), the Standardize...() functions and ON_BrepFace::Reverse(),
+    call UnshareGeometry() before they make changes. Code that modifies
+    the curves and surfaces directly through the m_S[], m_C2[] or m_C3[]
+    pointers of a brep created this way must call UnshareGeometry() first.
+    operator= and Duplicate() always duplicate the geometry.
+    Limitation: a brep does not store a transformation for its shared
+    geometry. Transform() duplicates every shared surface and 3d curve
+    before it transforms them, and only the 2d curves in m_C2[] stay
+    shared. Many transformed copies of one brep therefore use almost
+    as much memory as copies made with operator=. Use ON_InstanceRef
+    when many copies of a brep are placed with different transformations.
+    After the first call, src keeps a reference to the shared geometry.
+    The first call with a given src is not thread safe. Later calls
+    with the same src may be made from more than one thread.
+  */
+  bool CopyWithSharedGeometry(
+    const ON_Brep& src
+    );
+
+  /*
+  Returns:
+    True if some of the surfaces and curves in m_S[], m_C2[] and m_C3[]
+    are shared with another brep.
+  See Also:
+    ON_Brep::CopyWithSharedGeometry()
+  */
+  bool HasSharedGeometry() const;
+
+  /*
+  Description:
+    Duplicates any surfaces and curves this brep shares with other
+    breps and updates the faces, edges and trims to use the copies.
+    After this call, this brep owns all of its geometry.
+  Returns:
+    True if successful.
+  See Also:
+    ON_Brep::CopyWithSharedGeometry()
+  */
+  bool UnshareGeometry();
 
   /*
   Description:
@@ -1809,14 +2100,38 @@ public:
     mesh_list - [out] meshes are appended to this array.
   Returns:
     Number of meshes appended to mesh_list[] array.
-  Note:
-    This function is not thread safe.  
+    This is always m_F.Count(). If a face cannot be meshed,
+    the corresponding element of mesh_list[] is nullptr.
+  Remarks:
+    The edges are sampled once and adjacent faces use the same
+    3d points along shared edges, so the face meshes join into
+    a watertight mesh. The faces are meshed in parallel.
+    The caller is responsible for deleting the meshes.
   */
   int CreateMesh( 
     const ON_MeshParameters& mp,
     ON_SimpleArray<ON_Mesh*>& mesh_list
     ) const;
 
+  /*
+  Description:
+    Calculates the face meshes using ON_Brep::CreateMesh() and
+    saves them as the cached meshes on the faces.
+  Parameters:
+    mesh_type - [in] type of cached mesh to set
+    mp - [in] meshing parameters
+  Returns:
+    Number of faces that have a cached mesh.
+  See Also:
+    ON_Brep::CreateMesh
+    ON_Brep::GetMesh
+    ON_BrepFace::SetMesh
+  */
+  int CreateAndSetMesh(
+    ON::mesh_type mesh_type,
+    const ON_MeshParameters& mp
+    );
+
   /*
   Description:
     Destroy meshes used to render and analyze brep.
@@ -1936,6 +2251,34 @@ public:
 
   bool IsValid( class ON_TextLog* text_log = nullptr ) const override;
 
+  /*
+  Description:
+    Performs the same tests as ON_Brep::IsValid() but does not stop
+    at the first failure. Every problem is added to report with the
+    index of the component that failed.
+  Parameters:
+    report - [out]
+      The report is cleared before validation begins.
+    bParallel - [in]
+      If true, the geometry of the curves, surfaces, vertices, edges,
+      trims and faces is checked on multiple threads. The topological
+      cross checks that depend on those results run afterwards.
+      The report is the same for serial and parallel validation.
+  Returns:
+    True if the brep is valid.
+  Remarks:
+    When the brep has corrupt indices or empty component arrays,
+    validation stops after reporting those problems because the
+    remaining tests cannot be performed safely.
+    Like IsValid(), Validate() calls ON_WARNING when the cached m_bbox
+    is much larger than the faces. That test does not add an error.
+    The brep must not be modified while Validate() is running.
+  */
+  bool Validate(
+    ON_BrepValidationReport& report,
+    bool bParallel
+  ) const;
+
   /*
   Description:
     Tests the brep to see if its topology information is
@@ -3310,6 +3653,30 @@ public:
   */
   void DestroyRegionTopology();
 
+  /*
+  Description:
+    Get a spatial index of the faces, edges and vertices.
+  Returns:
+    A cached ON_BrepComponentTree. It is created when it is first
+    needed and created again when the number of components or the
+    bounding box of the brep has changed.
+  Remarks:
+    Transform(), DestroyRuntimeCache() and ClearBoundingBox() destroy
+    the cached tree. Deleted components are not reported by searches.
+    If you move components by changing brep geometry directly, call
+    DestroyComponentTree() or ClearBoundingBox().
+    ComponentTree() may be called from more than one thread. When
+    threads create a tree at the same time, one tree is kept and the
+    others are deleted. An out of date tree is not deleted until
+    DestroyComponentTree() is called or the brep is destroyed, because
+    other threads may still be using it.
+  */
+  const ON_BrepComponentTree& ComponentTree() const;
+
+  bool HasComponentTree() const;
+
+  void DestroyComponentTree();
+
   // Description:
   //   Duplicate a single brep face.
   // Parameters:
@@ -4073,8 +4440,20 @@ protected:
   friend class ON_BrepRegion;
   friend class ON_BrepFaceSide;
   friend class ON_V5_BrepRegionTopologyUserData;
+  friend class ON_Internal_BrepValidator;
+  friend class ON_Internal_BrepSharedGeometry;
   ON_BoundingBox m_bbox;
   mutable class ON_BrepRegionTopology* m_region_topology = nullptr;
+  mutable std::atomic<class ON_BrepComponentTree*> m_component_tree{ nullptr };
+  mutable class ON_Internal_BrepSharedGeometry* m_shared_geometry = nullptr;
+  void Internal_CopyFrom(
+    const ON_Brep& src,
+    bool bShareGeometry
+    );
+  void Internal_ReleaseSharedGeometry();
+  bool Internal_UnshareGeometry(
+    bool bUnshare2dCurves
+    );
   static class ON_BrepRegionTopology* Internal_RegionTopologyPointer(
     const ON_Brep* brep,
     bool bValidateFaceCount 
@@ -4201,6 +4580,13 @@ private:
       so future lazy evaluations can use the value.
   */
   const ON_BoundingBox InternalBrepBoundingBox(bool bLazy, bool bUpdateCachedBBox) const;
+
+  /*
+  Description:
+    Used by IsValid() and Validate(). Calls ON_WARNING when the cached m_bbox
+    is much larger than the box calculated from the faces. This is not an error.
+  */
+  void Internal_CheckCachedBoundingBox(class ON_TextLog* text_log) const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -783,6 +783,7 @@ bool ON_BrepExtrude(
 
   brep.DestroyMesh(ON::any_mesh);
   brep.DestroyRegionTopology();
+  brep.UnshareGeometry();
 
   const ON_3dPoint PathStart = path_curve.PointAtStart();
   ON_3dPoint P = path_curve.PointAtEnd();
@@ -0,0 +1,1826 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+/*
+How breps are meshed:
+
+  1) Every edge is sampled once. The samples satisfy the tolerance,
+     angle and edge length settings in 3d and the end samples are the
+     brep vertex locations. Faces that share an edge use the same 3d
+     points, so the meshes of adjacent faces have identical boundary
+     vertices and the joined mesh is watertight.
+
+  2) Each face is meshed independently. The edge samples are mapped to
+     trim parameters and the trim loops become constraint polygons in
+     a scaled (u,v) plane. Points from a grid sized by the mesh
+     parameters are added inside the trimmed region and the points are
+     triangulated with a constrained Delaunay triangulation.
+
+  3) Triangles that do not satisfy the tolerance, angle or edge length
+     settings are split at their centroid until they do or they are
+     shorter than the minimum edge length.
+
+Steps 1 and 2 run in parallel over edges and faces.
+*/
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// 2d constrained Delaunay triangulation
+//
+
+class ON_Internal_CDT
+{
+public:
+  ON_Internal_CDT() = default;
+  ~ON_Internal_CDT() = default;
+
+private:
+  ON_Internal_CDT(const ON_Internal_CDT&) = delete;
+  ON_Internal_CDT& operator=(const ON_Internal_CDT&) = delete;
+
+public:
+  class Triangle
+  {
+  public:
+    // Counterclockwise vertices.
+    int m_v[3];
+    // m_n[i] is the triangle on the other side of edge (m_v[i],m_v[(i+1)%3]) or -1.
+    int m_n[3];
+    // bit i is set when edge i is a constraint.
+    unsigned char m_constraint;
+    // 1 = inside the constraint loops
+    unsigned char m_inside;
+  };
+
+  // The first 3 points are the vertices of a triangle that contains all other points.
+  ON_SimpleArray<ON_2dPoint> m_P;
+  ON_SimpleArray<Triangle> m_T;
+  // m_VT[i] = a triangle that uses point i
+  ON_SimpleArray<int> m_VT;
+
+  // Points closer than m_duplicate_tolerance are the same point.
+  double m_duplicate_tolerance = 0.0;
+  // Scale used to decide when orientation and incircle values are zero.
+  double m_scale = 1.0;
+
+  int m_last_triangle = 0;
+
+  bool Create(ON_BoundingBox bbox, int point_capacity);
+
+  /*
+  Returns:
+    Index of the point in m_P[] or -1 if p is outside the triangulation.
+    If p is a duplicate of an existing point, the existing point's index
+    is returned and *bDuplicate is set to true.
+  */
+  int InsertPoint(ON_2dPoint p, int start_triangle, bool* bDuplicate);
+
+  /*
+  Description:
+    Make the segment from point a to point b an edge of the triangulation
+    and mark it as a constraint.
+  */
+  bool InsertConstraint(int a, int b, int depth);
+
+  /*
+  Description:
+    Set Triangle.m_inside using the parity of the number of constraint
+    edges crossed to reach each triangle from the bounding triangle.
+  */
+  void ClassifyInside();
+
+  /*
+  Description:
+    Replace edge i of triangle t with the other diagonal of the
+    quadrilateral formed by t and its neighbor. After the flip, edge 1
+    of triangle t is the new diagonal.
+  Returns:
+    True if the quadrilateral is convex and the edge was flipped.
+  */
+  bool Flip(int t, int i);
+
+private:
+  double Orient(int a, int b, int c) const
+  {
+    const ON_2dPoint& A = m_P[a];
+    const ON_2dPoint& B = m_P[b];
+    const ON_2dPoint& C = m_P[c];
+    return (B.x - A.x) * (C.y - A.y) - (B.y - A.y) * (C.x - A.x);
+  }
+
+  double Orient(int a, int b, const ON_2dPoint& C) const
+  {
+    const ON_2dPoint& A = m_P[a];
+    const ON_2dPoint& B = m_P[b];
+    return (B.x - A.x) * (C.y - A.y) - (B.y - A.y) * (C.x - A.x);
+  }
+
+  double OrientTolerance(int a, int b) const
+  {
+    return 1.0e-12 * m_scale * (m_scale + m_P[a].DistanceTo(m_P[b]));
+  }
+
+  // Returns true if d is strictly inside the circumcircle of the counterclockwise triangle a,b,c.
+  bool InCircle(int a, int b, int c, int d) const;
+
+  int Locate(const ON_2dPoint& p, int start_triangle) const;
+  int EdgeIndex(int t, int a, int b) const;
+  void SetNeighbor(int t, int old_neighbor, int new_neighbor);
+  void UpdateVT(int t);
+  bool FindEdge(int a, int b, int* t, int* ei) const;
+  void Legalize(ON_SimpleArray<int>& stack);
+  int SplitTriangle(int t, const ON_2dPoint& p, ON_SimpleArray<int>& stack);
+  int SplitEdge(int t, int i, const ON_2dPoint& p, ON_SimpleArray<int>& stack);
+  bool SegmentsCross(int a, int b, int c, int d) const;
+};
+
+bool ON_Internal_CDT::Create(ON_BoundingBox bbox, int point_capacity)
+{
+  m_P.SetCount(0);
+  m_T.SetCount(0);
+  m_VT.SetCount(0);
+  if (false == bbox.IsValid())
+    return false;
+  const ON_2dPoint C(0.5 * (bbox.m_min.x + bbox.m_max.x), 0.5 * (bbox.m_min.y + bbox.m_max.y));
+  double r = 0.5 * ON_2dVector(bbox.m_max.x - bbox.m_min.x, bbox.m_max.y - bbox.m_min.y).Length();
+  if (!(r > 0.0))
+    return false;
+  m_scale = r;
+  m_duplicate_tolerance = 1.0e-10 * r;
+  r *= 100.0;
+
+  m_P.Reserve(point_capacity + 3);
+  m_T.Reserve(2 * point_capacity + 8);
+  m_VT.Reserve(point_capacity + 3);
+  m_P.Append(ON_2dPoint(C.x - 2.0 * r, C.y - r));
+  m_P.Append(ON_2dPoint(C.x + 2.0 * r, C.y - r));
+  m_P.Append(ON_2dPoint(C.x, C.y + 2.0 * r));
+  Triangle& T = m_T.AppendNew();
+  T.m_v[0] = 0; T.m_v[1] = 1; T.m_v[2] = 2;
+  T.m_n[0] = T.m_n[1] = T.m_n[2] = -1;
+  T.m_constraint = 0;
+  T.m_inside = 0;
+  m_VT.Append(0);
+  m_VT.Append(0);
+  m_VT.Append(0);
+  m_last_triangle = 0;
+  return true;
+}
+
+bool ON_Internal_CDT::InCircle(int a, int b, int c, int d) const
+{
+  const ON_2dPoint& D = m_P[d];
+  const double ax = m_P[a].x - D.x, ay = m_P[a].y - D.y;
+  const double bx = m_P[b].x - D.x, by = m_P[b].y - D.y;
+  const double cx = m_P[c].x - D.x, cy = m_P[c].y - D.y;
+  const double a2 = ax * ax + ay * ay;
+  const double b2 = bx * bx + by * by;
+  const double c2 = cx * cx + cy * cy;
+  const double det = ax * (by * c2 - b2 * cy) - ay * (bx * c2 - b2 * cx) + a2 * (bx * cy - by * cx);
+  // The tolerance keeps cocircular points, like the ones in a grid, from flipping back and forth.
+  const double tol = 1.0e-10 * (fabs(ax * (by * c2)) + fabs(ax * (b2 * cy)) + fabs(ay * (bx * c2)) + fabs(ay * (b2 * cx)) + fabs(a2 * (bx * cy)) + fabs(a2 * (by * cx)));
+  return det > tol;
+}
+
+int ON_Internal_CDT::Locate(const ON_2dPoint& p, int start_triangle) const
+{
+  const int triangle_count = m_T.Count();
+  int t = (start_triangle >= 0 && start_triangle < triangle_count) ? start_triangle : m_last_triangle;
+  // Walk toward p. The step limit protects against cycles in degenerate cases.
+  for (int step = 0; step < triangle_count + 16; step++)
+  {
+    const Triangle& T = m_T[t];
+    int next = -1;
+    for (int k = 0; k < 3; k++)
+    {
+      const int i = (k + step) % 3;
+      if (Orient(T.m_v[i], T.m_v[(i + 1) % 3], p) < -OrientTolerance(T.m_v[i], T.m_v[(i + 1) % 3]))
+      {
+        next = T.m_n[i];
+        break;
+      }
+    }
+    if (next < 0)
+    {
+      // either p is in t or p is outside the bounding triangle
+      for (int i = 0; i < 3; i++)
+      {
+        if (Orient(T.m_v[i], T.m_v[(i + 1) % 3], p) < -OrientTolerance(T.m_v[i], T.m_v[(i + 1) % 3]))
+          return -1;
+      }
+      return t;
+    }
+    t = next;
+  }
+
+  for (t = 0; t < triangle_count; t++)
+  {
+    const Triangle& T = m_T[t];
+    int i;
+    for (i = 0; i < 3; i++)
+    {
+      if (Orient(T.m_v[i], T.m_v[(i + 1) % 3], p) < -OrientTolerance(T.m_v[i], T.m_v[(i + 1) % 3]))
+        break;
+    }
+    if (3 == i)
+      return t;
+  }
+  return -1;
+}
+
+int ON_Internal_CDT::EdgeIndex(int t, int a, int b) const
+{
+  const Triangle& T = m_T[t];
+  for (int i = 0; i < 3; i++)
+  {
+    if (a == T.m_v[i] && b == T.m_v[(i + 1) % 3])
+      return i;
+  }
+  return -1;
+}
+
+void ON_Internal_CDT::SetNeighbor(int t, int old_neighbor, int new_neighbor)
+{
+  if (t < 0)
+    return;
+  Triangle& T = m_T[t];
+  for (int i = 0; i < 3; i++)
+  {
+    if (old_neighbor == T.m_n[i])
+    {
+      T.m_n[i] = new_neighbor;
+      return;
+    }
+  }
+}
+
+void ON_Internal_CDT::UpdateVT(int t)
+{
+  const Triangle& T = m_T[t];
+  m_VT[T.m_v[0]] = t;
+  m_VT[T.m_v[1]] = t;
+  m_VT[T.m_v[2]] = t;
+}
+
+int ON_Internal_CDT::SplitTriangle(int t, const ON_2dPoint& p, ON_SimpleArray<int>& stack)
+{
+  const int pi = m_P.Count();
+  m_P.Append(p);
+  m_VT.Append(t);
+
+  const Triangle T = m_T[t];
+  const int t1 = m_T.Count();
+  const int t2 = t1 + 1;
+  m_T.AppendNew();
+  m_T.AppendNew();
+
+  Triangle& T0 = m_T[t];
+  T0.m_v[0] = T.m_v[0]; T0.m_v[1] = T.m_v[1]; T0.m_v[2] = pi;
+  T0.m_n[0] = T.m_n[0]; T0.m_n[1] = t1; T0.m_n[2] = t2;
+  T0.m_constraint = (T.m_constraint & 1);
+  T0.m_inside = T.m_inside;
+
+  Triangle& T1 = m_T[t1];
+  T1.m_v[0] = T.m_v[1]; T1.m_v[1] = T.m_v[2]; T1.m_v[2] = pi;
+  T1.m_n[0] = T.m_n[1]; T1.m_n[1] = t2; T1.m_n[2] = t;
+  T1.m_constraint = ((T.m_constraint & 2) ? 1 : 0);
+  T1.m_inside = T.m_inside;
+
+  Triangle& T2 = m_T[t2];
+  T2.m_v[0] = T.m_v[2]; T2.m_v[1] = T.m_v[0]; T2.m_v[2] = pi;
+  T2.m_n[0] = T.m_n[2]; T2.m_n[1] = t; T2.m_n[2] = t1;
+  T2.m_constraint = ((T.m_constraint & 4) ? 1 : 0);
+  T2.m_inside = T.m_inside;
+
+  SetNeighbor(T.m_n[1], t, t1);
+  SetNeighbor(T.m_n[2], t, t2);
+  UpdateVT(t);
+  UpdateVT(t1);
+  UpdateVT(t2);
+
+  stack.Append(t); stack.Append(0);
+  stack.Append(t1); stack.Append(0);
+  stack.Append(t2); stack.Append(0);
+  return pi;
+}
+
+int ON_Internal_CDT::SplitEdge(int t, int i, const ON_2dPoint& p, ON_SimpleArray<int>& stack)
+{
+  const int pi = m_P.Count();
+  m_P.Append(p);
+  m_VT.Append(t);
+
+  const Triangle T = m_T[t];
+  const int a = T.m_v[i];
+  const int b = T.m_v[(i + 1) % 3];
+  const int c = T.m_v[(i + 2) % 3];
+  const int na = T.m_n[(i + 1) % 3]; // across b-c
+  const int nb = T.m_n[(i + 2) % 3]; // across c-a
+  const unsigned char cab = (T.m_constraint & (1 << i)) ? 1 : 0;
+  const unsigned char cbc = (T.m_constraint & (1 << ((i + 1) % 3))) ? 1 : 0;
+  const unsigned char cca = (T.m_constraint & (1 << ((i + 2) % 3))) ? 1 : 0;
+
+  const int u = T.m_n[i];
+  const int t2 = m_T.Count();
+  m_T.AppendNew();
+
+  // T1 = (a,p,c) reuses t, T2 = (p,b,c)
+  {
+    Triangle& T1 = m_T[t];
+    T1.m_v[0] = a; T1.m_v[1] = pi; T1.m_v[2] = c;
+    T1.m_n[1] = t2; T1.m_n[2] = nb;
+    T1.m_constraint = (unsigned char)(cab | (cca << 2));
+    T1.m_inside = T.m_inside;
+    Triangle& T2 = m_T[t2];
+    T2.m_v[0] = pi; T2.m_v[1] = b; T2.m_v[2] = c;
+    T2.m_n[1] = na; T2.m_n[2] = t;
+    T2.m_constraint = (unsigned char)(cab | (cbc << 1));
+    T2.m_inside = T.m_inside;
+  }
+  SetNeighbor(na, t, t2);
+
+  if (u >= 0)
+  {
+    const Triangle U = m_T[u];
+    const int j = EdgeIndex(u, b, a);
+    const int d = U.m_v[(j + 2) % 3];
+    const int nc = U.m_n[(j + 1) % 3]; // across a-d
+    const int nd = U.m_n[(j + 2) % 3]; // across d-b
+    const unsigned char cad = (U.m_constraint & (1 << ((j + 1) % 3))) ? 1 : 0;
+    const unsigned char cdb = (U.m_constraint & (1 << ((j + 2) % 3))) ? 1 : 0;
+    const int t4 = m_T.Count();
+    m_T.AppendNew();
+
+    // T3 = (b,p,d) reuses u, T4 = (p,a,d)
+    Triangle& T3 = m_T[u];
+    T3.m_v[0] = b; T3.m_v[1] = pi; T3.m_v[2] = d;
+    T3.m_n[0] = t2; T3.m_n[1] = t4; T3.m_n[2] = nd;
+    T3.m_constraint = (unsigned char)(cab | (cdb << 2));
+    T3.m_inside = U.m_inside;
+    Triangle& T4 = m_T[t4];
+    T4.m_v[0] = pi; T4.m_v[1] = a; T4.m_v[2] = d;
+    T4.m_n[0] = t; T4.m_n[1] = nc; T4.m_n[2] = u;
+    T4.m_constraint = (unsigned char)(cab | (cad << 1));
+    T4.m_inside = U.m_inside;
+    SetNeighbor(nc, u, t4);
+
+    m_T[t].m_n[0] = t4;
+    m_T[t2].m_n[0] = u;
+    UpdateVT(u);
+    UpdateVT(t4);
+    stack.Append(u); stack.Append(2);
+    stack.Append(t4); stack.Append(1);
+  }
+  else
+  {
+    m_T[t].m_n[0] = -1;
+    m_T[t2].m_n[0] = -1;
+  }
+  UpdateVT(t);
+  UpdateVT(t2);
+  stack.Append(t); stack.Append(2);
+  stack.Append(t2); stack.Append(1);
+  return pi;
+}
+
+bool ON_Internal_CDT::Flip(int t, int i)
+{
+  const int u = m_T[t].m_n[i];
+  if (u < 0)
+    return false;
+  const Triangle T = m_T[t];
+  const int a = T.m_v[i];
+  const int b = T.m_v[(i + 1) % 3];
+  const int c = T.m_v[(i + 2) % 3];
+  const int j = EdgeIndex(u, b, a);
+  if (j < 0)
+    return false;
+  const Triangle U = m_T[u];
+  const int d = U.m_v[(j + 2) % 3];
+
+  // the quadrilateral a,d,b,c must be strictly convex
+  if (!(Orient(a, d, c) > OrientTolerance(a, c)) || !(Orient(d, b, c) > OrientTolerance(b, c)))
+    return false;
+
+  const int ta = T.m_n[(i + 2) % 3];
+  const int tb = T.m_n[(i + 1) % 3];
+  const int ua = U.m_n[(j + 1) % 3];
+  const int ub = U.m_n[(j + 2) % 3];
+  const unsigned char cta = (T.m_constraint & (1 << ((i + 2) % 3))) ? 1 : 0;
+  const unsigned char ctb = (T.m_constraint & (1 << ((i + 1) % 3))) ? 1 : 0;
+  const unsigned char cua = (U.m_constraint & (1 << ((j + 1) % 3))) ? 1 : 0;
+  const unsigned char cub = (U.m_constraint & (1 << ((j + 2) % 3))) ? 1 : 0;
+
+  Triangle& T1 = m_T[t];
+  T1.m_v[0] = a; T1.m_v[1] = d; T1.m_v[2] = c;
+  T1.m_n[0] = ua; T1.m_n[1] = u; T1.m_n[2] = ta;
+  T1.m_constraint = (unsigned char)(cua | (cta << 2));
+
+  Triangle& T2 = m_T[u];
+  T2.m_v[0] = d; T2.m_v[1] = b; T2.m_v[2] = c;
+  T2.m_n[0] = ub; T2.m_n[1] = tb; T2.m_n[2] = t;
+  T2.m_constraint = (unsigned char)(cub | (ctb << 1));
+
+  SetNeighbor(ua, u, t);
+  SetNeighbor(tb, t, u);
+  UpdateVT(t);
+  UpdateVT(u);
+  return true;
+}
+
+void ON_Internal_CDT::Legalize(ON_SimpleArray<int>& stack)
+{
+  // stack[] contains (triangle, edge) pairs. The point opposite the edge
+  // was just inserted.
+  int guard = 0;
+  while (stack.Count() >= 2 && guard++ < 1000000)
+  {
+    const int i = *stack.Last();
+    stack.Remove();
+    const int t = *stack.Last();
+    stack.Remove();
+    const Triangle& T = m_T[t];
+    if (0 != (T.m_constraint & (1 << i)))
+      continue;
+    const int u = T.m_n[i];
+    if (u < 0)
+      continue;
+    const int a = T.m_v[i];
+    const int b = T.m_v[(i + 1) % 3];
+    const int c = T.m_v[(i + 2) % 3];
+    const int j = EdgeIndex(u, b, a);
+    if (j < 0)
+      continue;
+    const int d = m_T[u].m_v[(j + 2) % 3];
+    if (false == InCircle(a, b, c, d))
+      continue;
+    if (Flip(t, i))
+    {
+      // t = (a,d,c), u = (d,b,c). Check the edges opposite c.
+      stack.Append(t); stack.Append(0);
+      stack.Append(u); stack.Append(0);
+    }
+  }
+  stack.SetCount(0);
+}
+
+int ON_Internal_CDT::InsertPoint(ON_2dPoint p, int start_triangle, bool* bDuplicate)
+{
+  if (bDuplicate)
+    *bDuplicate = false;
+  const int t = Locate(p, start_triangle);
+  if (t < 0)
+    return -1;
+  const Triangle& T = m_T[t];
+  for (int i = 0; i < 3; i++)
+  {
+    if (p.DistanceTo(m_P[T.m_v[i]]) <= m_duplicate_tolerance)
+    {
+      if (bDuplicate)
+        *bDuplicate = true;
+      return T.m_v[i];
+    }
+  }
+
+  ON_SimpleArray<int> stack(32);
+  int pi = -1;
+  for (int i = 0; i < 3; i++)
+  {
+    const int a = T.m_v[i];
+    const int b = T.m_v[(i + 1) % 3];
+    if (fabs(Orient(a, b, p)) <= OrientTolerance(a, b))
+    {
+      pi = SplitEdge(t, i, p, stack);
+      break;
+    }
+  }
+  if (pi < 0)
+    pi = SplitTriangle(t, p, stack);
+  Legalize(stack);
+  m_last_triangle = m_VT[pi];
+  return pi;
+}
+
+bool ON_Internal_CDT::FindEdge(int a, int b, int* t, int* ei) const
+{
+  // rotate around a
+  const int t0 = m_VT[a];
+  int s = t0;
+  for (int guard = 0; guard < 10000 && s >= 0; guard++)
+  {
+    const Triangle& S = m_T[s];
+    int k = (a == S.m_v[0]) ? 0 : ((a == S.m_v[1]) ? 1 : ((a == S.m_v[2]) ? 2 : -1));
+    if (k < 0)
+      break;
+    if (b == S.m_v[(k + 1) % 3])
+    {
+      *t = s;
+      *ei = k;
+      return true;
+    }
+    // next triangle counterclockwise around a shares edge (m_v[k+2],a)
+    s = S.m_n[(k + 2) % 3];
+    if (s == t0)
+      break;
+  }
+  // clockwise, in case a is on the boundary of the triangulation
+  s = t0;
+  for (int guard = 0; guard < 10000 && s >= 0; guard++)
+  {
+    const Triangle& S = m_T[s];
+    int k = (a == S.m_v[0]) ? 0 : ((a == S.m_v[1]) ? 1 : ((a == S.m_v[2]) ? 2 : -1));
+    if (k < 0)
+      break;
+    if (b == S.m_v[(k + 1) % 3])
+    {
+      *t = s;
+      *ei = k;
+      return true;
+    }
+    s = S.m_n[k];
+    if (s == t0)
+      break;
+  }
+  return false;
+}
+
+bool ON_Internal_CDT::SegmentsCross(int a, int b, int c, int d) const
+{
+  // true if the open segments a-b and c-d intersect at a single interior point
+  if (a == c || a == d || b == c || b == d)
+    return false;
+  const double o1 = Orient(a, b, c);
+  const double o2 = Orient(a, b, d);
+  const double o3 = Orient(c, d, a);
+  const double o4 = Orient(c, d, b);
+  const double tol1 = OrientTolerance(a, b);
+  const double tol2 = OrientTolerance(c, d);
+  return ((o1 > tol1 && o2 < -tol1) || (o1 < -tol1 && o2 > tol1))
+    && ((o3 > tol2 && o4 < -tol2) || (o3 < -tol2 && o4 > tol2));
+}
+
+bool ON_Internal_CDT::InsertConstraint(int a, int b, int depth)
+{
+  if (a == b || depth > 64)
+    return false;
+
+  int t = -1, ei = -1;
+  if (FindEdge(a, b, &t, &ei) || FindEdge(b, a, &t, &ei))
+  {
+    m_T[t].m_constraint |= (unsigned char)(1 << ei);
+    const int u = m_T[t].m_n[ei];
+    if (u >= 0)
+    {
+      const Triangle& T = m_T[t];
+      const int j = EdgeIndex(u, T.m_v[(ei + 1) % 3], T.m_v[ei]);
+      if (j >= 0)
+        m_T[u].m_constraint |= (unsigned char)(1 << j);
+    }
+    return true;
+  }
+
+  // Find the triangle around a that the segment a-b leaves through.
+  const double tol_ab = OrientTolerance(a, b);
+  int x = -1, y = -1;
+  {
+    const int t0 = m_VT[a];
+    int s = t0;
+    for (int guard = 0; guard < 10000 && s >= 0; guard++)
+    {
+      const Triangle& S = m_T[s];
+      const int k = (a == S.m_v[0]) ? 0 : ((a == S.m_v[1]) ? 1 : ((a == S.m_v[2]) ? 2 : -1));
+      if (k < 0)
+        return false;
+      const int sx = S.m_v[(k + 1) % 3];
+      const int sy = S.m_v[(k + 2) % 3];
+      const double ox = Orient(a, b, sx);
+      const double oy = Orient(a, b, sy);
+      // a point on the segment splits the constraint
+      const ON_2dVector ab = m_P[b] - m_P[a];
+      if (fabs(ox) <= tol_ab && ab * (m_P[sx] - m_P[a]) > 0.0)
+        return InsertConstraint(a, sx, depth + 1) && InsertConstraint(sx, b, depth + 1);
+      if (fabs(oy) <= tol_ab && ab * (m_P[sy] - m_P[a]) > 0.0)
+        return InsertConstraint(a, sy, depth + 1) && InsertConstraint(sy, b, depth + 1);
+      if (ox < 0.0 && oy > 0.0)
+      {
+        x = sx;
+        y = sy;
+        t = s;
+        break;
+      }
+      s = S.m_n[(k + 2) % 3];
+      if (s == t0)
+        break;
+    }
+  }
+  if (x < 0)
+    return false;
+
+  // Collect the edges that cross a-b.
+  ON_SimpleArray<int> crossing(64);
+  for (int guard = 0; guard < 100000; guard++)
+  {
+    crossing.Append(x);
+    crossing.Append(y);
+    const int i = EdgeIndex(t, x, y);
+    if (i < 0)
+      return false;
+    const int u = m_T[t].m_n[i];
+    if (u < 0)
+      return false;
+    const int j = EdgeIndex(u, y, x);
+    if (j < 0)
+      return false;
+    const int w = m_T[u].m_v[(j + 2) % 3];
+    if (w == b)
+      break;
+    const double ow = Orient(a, b, w);
+    if (fabs(ow) <= tol_ab)
+      return InsertConstraint(a, w, depth + 1) && InsertConstraint(w, b, depth + 1);
+    if (ow > 0.0)
+      y = w;
+    else
+      x = w;
+    t = u;
+  }
+
+  // Flip the crossing edges until a-b is an edge.
+  const int max_iterations = 64 + 16 * crossing.Count() * crossing.Count();
+  int head = 0;
+  for (int iteration = 0; head < crossing.Count(); iteration++)
+  {
+    if (iteration > max_iterations)
+      return false;
+    const int c = crossing[head];
+    const int d = crossing[head + 1];
+    head += 2;
+    int tc = -1, ic = -1;
+    if (false == FindEdge(c, d, &tc, &ic))
+      continue; // already flipped away
+    const int u = m_T[tc].m_n[ic];
+    if (u < 0)
+      return false;
+    if (0 != (m_T[tc].m_constraint & (1 << ic)))
+      return false; // two constraints cross
+    if (Flip(tc, ic))
+    {
+      // the new edge is t.m_v[1] - t.m_v[2] = (d',c')
+      const int e0 = m_T[tc].m_v[1];
+      const int e1 = m_T[tc].m_v[2];
+      if (SegmentsCross(a, b, e0, e1))
+      {
+        crossing.Append(e0);
+        crossing.Append(e1);
+      }
+    }
+    else
+    {
+      crossing.Append(c);
+      crossing.Append(d);
+    }
+    // compact the queue now and then
+    if (head > 4096 && 2 * head > crossing.Count())
+    {
+      const int n = crossing.Count() - head;
+      memmove(crossing.Array(), crossing.Array() + head, n * sizeof(int));
+      crossing.SetCount(n);
+      head = 0;
+    }
+  }
+
+  return InsertConstraint(a, b, depth + 1);
+}
+
+void ON_Internal_CDT::ClassifyInside()
+{
+  const int triangle_count = m_T.Count();
+  ON_SimpleArray<int> depth(triangle_count);
+  depth.SetCount(triangle_count);
+  for (int i = 0; i < triangle_count; i++)
+    depth[i] = -1;
+
+  // breadth first search that visits all triangles at depth d before depth d+1
+  ON_SimpleArray<int> current(triangle_count);
+  ON_SimpleArray<int> next(64);
+  for (int t = 0; t < triangle_count; t++)
+  {
+    const Triangle& T = m_T[t];
+    if (T.m_v[0] < 3 || T.m_v[1] < 3 || T.m_v[2] < 3)
+    {
+      depth[t] = 0;
+      current.Append(t);
+    }
+  }
+  for (int d = 0; current.Count() > 0; d++)
+  {
+    for (int k = 0; k < current.Count(); k++)
+    {
+      const int t = current[k];
+      const Triangle& T = m_T[t];
+      for (int i = 0; i < 3; i++)
+      {
+        const int u = T.m_n[i];
+        if (u < 0 || depth[u] >= 0)
+          continue;
+        if (0 != (T.m_constraint & (1 << i)))
+        {
+          next.Append(u);
+        }
+        else
+        {
+          depth[u] = d;
+          current.Append(u);
+        }
+      }
+    }
+    current.SetCount(0);
+    for (int k = 0; k < next.Count(); k++)
+    {
+      const int u = next[k];
+      if (depth[u] < 0)
+      {
+        depth[u] = d + 1;
+        current.Append(u);
+      }
+    }
+    next.SetCount(0);
+  }
+
+  for (int t = 0; t < triangle_count; t++)
+    m_T[t].m_inside = (1 == (depth[t] % 2)) ? 1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Brep meshing
+//
+
+class ON_Internal_BrepMeshSettings
+{
+public:
+  ON_Internal_BrepMeshSettings(const ON_Brep& brep, const ON_MeshParameters& mp);
+
+  const ON_MeshParameters& m_mp;
+
+  // 3d distance tolerance. 0 = no distance test.
+  double m_tolerance = 0.0;
+  // Maximum angle between adjacent normals or tangents. 0 = no angle test.
+  double m_angle = 0.0;
+  double m_cos_angle = -1.0;
+  // 0 = no maximum edge length.
+  double m_max_edge = 0.0;
+  double m_min_edge = 0.0;
+
+  bool SplitSegment(
+    const ON_3dPoint& P0,
+    const ON_3dPoint& P1,
+    const ON_3dPoint& M,
+    const ON_3dVector& T0,
+    const ON_3dVector& T1
+  ) const;
+};
+
+ON_Internal_BrepMeshSettings::ON_Internal_BrepMeshSettings(const ON_Brep& brep, const ON_MeshParameters& mp)
+  : m_mp(mp)
+{
+  const ON_BoundingBox bbox = brep.BoundingBox();
+  const double size = bbox.IsValid() ? bbox.Diagonal().Length() : 0.0;
+
+  double tol = mp.Tolerance();
+  if (!(tol > 0.0))
+    tol = 0.0;
+  const double relative_tol = ON_MeshParameters::ToleranceFromObjectSize(mp.RelativeTolerance(), size);
+  if (relative_tol > 0.0 && (0.0 == tol || relative_tol < tol))
+    tol = relative_tol;
+  if (tol > 0.0 && mp.MinimumTolerance() > tol)
+    tol = mp.MinimumTolerance();
+  m_tolerance = tol;
+
+  double angle = mp.Refine() ? mp.RefineAngleRadians() : 0.0;
+  if (!(angle > 0.0 && angle < ON_PI))
+    angle = 0.0;
+
+  m_max_edge = (mp.MaximumEdgeLength() > 0.0) ? mp.MaximumEdgeLength() : 0.0;
+
+  if (0.0 == angle && 0.0 == m_tolerance && 0.0 == m_max_edge)
+  {
+    // Nothing limits the mesh density. Use the default angle so curved faces get some facets.
+    angle = ON_MeshParameters::DefaultMesh.RefineAngleRadians();
+  }
+  m_angle = angle;
+  m_cos_angle = (angle > 0.0) ? cos(angle) : -1.0;
+
+  m_min_edge = mp.MinimumEdgeLength();
+  if (!(m_min_edge > 0.0))
+    m_min_edge = ON_MeshParameters::MinimumEdgeLengthFromTolerance(m_max_edge, m_tolerance);
+  if (!(m_min_edge > 0.0))
+    m_min_edge = 1.0e-8 * size;
+}
+
+bool ON_Internal_BrepMeshSettings::SplitSegment(
+  const ON_3dPoint& P0,
+  const ON_3dPoint& P1,
+  const ON_3dPoint& M,
+  const ON_3dVector& T0,
+  const ON_3dVector& T1
+) const
+{
+  const double length = P0.DistanceTo(M) + M.DistanceTo(P1);
+  if (!(length > m_min_edge))
+    return false;
+  if (m_max_edge > 0.0 && length > m_max_edge)
+    return true;
+  if (m_tolerance > 0.0 && ON_Line(P0, P1).DistanceTo(M) > m_tolerance)
+    return true;
+  if (m_angle > 0.0 && T0 * T1 < m_cos_angle)
+    return true;
+  return false;
+}
+
+class ON_Internal_BrepMeshEdgeSamples
+{
+public:
+  // increasing edge parameters
+  ON_SimpleArray<double> m_t;
+  // 3d points. The first and last points are the edge's vertex locations.
+  ON_SimpleArray<ON_3dPoint> m_P;
+};
+
+static void Internal_BrepMeshSplitEdgeSegment(
+  const ON_BrepEdge& edge,
+  const ON_Internal_BrepMeshSettings& settings,
+  double t0, const ON_3dPoint& P0, const ON_3dVector& T0,
+  double t1, const ON_3dPoint& P1, const ON_3dVector& T1,
+  int depth,
+  ON_Internal_BrepMeshEdgeSamples& samples
+)
+{
+  // appends the samples after t0 up to and including t1
+  const double tm = 0.5 * (t0 + t1);
+  ON_3dPoint M;
+  ON_3dVector TM;
+  if (depth < 16 && tm > t0 && tm < t1 && edge.EvTangent(tm, M, TM) && settings.SplitSegment(P0, P1, M, T0, T1))
+  {
+    Internal_BrepMeshSplitEdgeSegment(edge, settings, t0, P0, T0, tm, M, TM, depth + 1, samples);
+    Internal_BrepMeshSplitEdgeSegment(edge, settings, tm, M, TM, t1, P1, T1, depth + 1, samples);
+    return;
+  }
+  samples.m_t.Append(t1);
+  samples.m_P.Append(P1);
+}
+
+static void Internal_BrepMeshSampleEdge(
+  const ON_Brep& brep,
+  int edge_index,
+  const ON_Internal_BrepMeshSettings& settings,
+  ON_Internal_BrepMeshEdgeSamples& samples
+)
+{
+  samples.m_t.SetCount(0);
+  samples.m_P.SetCount(0);
+  const ON_BrepEdge& edge = brep.m_E[edge_index];
+  if (edge.m_edge_index < 0 || nullptr == edge.ProxyCurve())
+    return;
+  const ON_Interval domain = edge.Domain();
+  if (false == domain.IsIncreasing())
+    return;
+
+  // Initial segments end at span boundaries. Closed edges get at least
+  // 4 segments so the polyline has area.
+  ON_SimpleArray<double> t(16);
+  const int span_count = edge.SpanCount();
+  if (span_count > 0)
+  {
+    t.Reserve(span_count + 1);
+    t.SetCount(span_count + 1);
+    if (false == edge.GetSpanVector(t.Array()))
+      t.SetCount(0);
+  }
+  if (t.Count() < 2)
+  {
+    t.SetCount(0);
+    t.Append(domain[0]);
+    t.Append(domain[1]);
+  }
+  const bool bClosed = (edge.m_vi[0] == edge.m_vi[1]);
+  while (bClosed && t.Count() < 5)
+  {
+    ON_SimpleArray<double> s(2 * t.Count());
+    for (int i = 0; i + 1 < t.Count(); i++)
+    {
+      s.Append(t[i]);
+      s.Append(0.5 * (t[i] + t[i + 1]));
+    }
+    s.Append(*t.Last());
+    t = s;
+  }
+  t[0] = domain[0];
+  *t.Last() = domain[1];
+
+  const ON_3dPoint V0 = (edge.m_vi[0] >= 0 && edge.m_vi[0] < brep.m_V.Count()) ? brep.m_V[edge.m_vi[0]].point : edge.PointAtStart();
+  const ON_3dPoint V1 = (edge.m_vi[1] >= 0 && edge.m_vi[1] < brep.m_V.Count()) ? brep.m_V[edge.m_vi[1]].point : edge.PointAtEnd();
+
+  samples.m_t.Reserve(4 * t.Count());
+  samples.m_P.Reserve(4 * t.Count());
+  ON_3dPoint P0, P1;
+  ON_3dVector T0, T1;
+  edge.EvTangent(t[0], P0, T0);
+  P0 = V0;
+  samples.m_t.Append(t[0]);
+  samples.m_P.Append(P0);
+  for (int i = 1; i < t.Count(); i++)
+  {
+    if (!(t[i] > t[i - 1]))
+      continue;
+    edge.EvTangent(t[i], P1, T1);
+    if (i + 1 == t.Count())
+      P1 = V1;
+    Internal_BrepMeshSplitEdgeSegment(edge, settings, t[i - 1], P0, T0, t[i], P1, T1, 0, samples);
+    P0 = P1;
+    T0 = T1;
+  }
+}
+
+class ON_Internal_BrepFaceMesher
+{
+public:
+  ON_Internal_BrepFaceMesher(
+    const ON_Brep& brep,
+    const ON_BrepFace& face,
+    const ON_Internal_BrepMeshSettings& settings,
+    const ON_ClassArray<ON_Internal_BrepMeshEdgeSamples>& edge_samples
+  );
+
+  ON_Mesh* CreateMesh();
+
+private:
+  ON_Internal_BrepFaceMesher(const ON_Internal_BrepFaceMesher&) = delete;
+  ON_Internal_BrepFaceMesher& operator=(const ON_Internal_BrepFaceMesher&) = delete;
+
+  const ON_Brep& m_brep;
+  const ON_BrepFace& m_face;
+  const ON_Surface* m_srf = nullptr;
+  const ON_Internal_BrepMeshSettings& m_settings;
+  const ON_ClassArray<ON_Internal_BrepMeshEdgeSamples>& m_edge_samples;
+
+  ON_Interval m_domain[2];
+  // 2d points are (m_scale[0]*(u-u0), m_scale[1]*(v-v0)) so 2d and 3d
+  // distances are roughly the same.
+  double m_scale[2] = {1.0, 1.0};
+  // approximate 3d lengths of the isocurves
+  double m_length[2] = {0.0, 0.0};
+  // total normal turning along the u and v isocurves
+  double m_turning[2] = {0.0, 0.0};
+  int m_grid_count[2] = {1, 1};
+  bool m_bSimplePlane = false;
+
+  ON_Internal_CDT m_cdt;
+
+  // Information for each point in m_cdt.m_P[]
+  ON_SimpleArray<ON_2dPoint> m_uv;
+  ON_SimpleArray<ON_3dPoint> m_P;
+  ON_SimpleArray<ON_3dVector> m_N;
+  // brep vertex index for points at the ends of trims and on singular trims, -1 otherwise
+  ON_SimpleArray<int> m_brep_vertex;
+  // Singular trims of this face
+  class SingularTrim
+  {
+  public:
+    int m_vi; // brep vertex index
+    int m_dir; // 0 = the trim is a u isocurve, 1 = the trim is a v isocurve
+    double m_c; // constant parameter of the isocurve
+  };
+  ON_SimpleArray<SingularTrim> m_singular_trim;
+
+  // Returns the index in m_singular_trim[] of the singular trim point pi is on or -1.
+  int SingularTrimIndex(int pi) const
+  {
+    const int vi = m_brep_vertex[pi];
+    if (vi >= 0)
+    {
+      for (int i = 0; i < m_singular_trim.Count(); i++)
+      {
+        if (vi == m_singular_trim[i].m_vi)
+          return i;
+      }
+    }
+    return -1;
+  }
+
+  // Boundary polygons before triangulation
+  ON_SimpleArray<ON_2dPoint> m_boundary_uv;
+  ON_SimpleArray<ON_3dPoint> m_boundary_P;
+  ON_SimpleArray<int> m_boundary_brep_vertex;
+  // m_boundary_loop[i] = index of first point in loop i; the last element is m_boundary_uv.Count()
+  ON_SimpleArray<int> m_boundary_loop;
+
+  ON_2dPoint To2d(const ON_2dPoint& uv) const
+  {
+    return ON_2dPoint(m_scale[0] * (uv.x - m_domain[0][0]), m_scale[1] * (uv.y - m_domain[1][0]));
+  }
+
+  ON_2dPoint ToUV(const ON_2dPoint& p) const
+  {
+    return ON_2dPoint(m_domain[0][0] + p.x / m_scale[0], m_domain[1][0] + p.y / m_scale[1]);
+  }
+
+  void GetSurfaceSize();
+  void GetGridCounts();
+  bool GetBoundary();
+  void AppendTrimSamples(const ON_BrepTrim& trim);
+  int AddPoint(const ON_2dPoint& uv, const ON_3dPoint& P, int brep_vertex, int start_triangle);
+  void AddGridPoints();
+  void Refine();
+  bool IsFolded(int t) const;
+  void RepairFolds();
+  ON_Mesh* ToMesh() const;
+};
+
+ON_Internal_BrepFaceMesher::ON_Internal_BrepFaceMesher(
+  const ON_Brep& brep,
+  const ON_BrepFace& face,
+  const ON_Internal_BrepMeshSettings& settings,
+  const ON_ClassArray<ON_Internal_BrepMeshEdgeSamples>& edge_samples
+)
+  : m_brep(brep)
+  , m_face(face)
+  , m_settings(settings)
+  , m_edge_samples(edge_samples)
+{
+  m_srf = face.SurfaceOf();
+}
+
+void ON_Internal_BrepFaceMesher::GetSurfaceSize()
+{
+  // Sample the surface on a 9x9 grid to estimate the 3d size and normal turning.
+  const int n = 9;
+  ON_3dVector N[n][n];
+  double su = 0.0, sv = 0.0;
+  int su_count = 0, sv_count = 0;
+  for (int i = 0; i < n; i++)
+  {
+    const double u = m_domain[0].ParameterAt(i / (n - 1.0));
+    for (int j = 0; j < n; j++)
+    {
+      const double v = m_domain[1].ParameterAt(j / (n - 1.0));
+      ON_3dPoint P;
+      ON_3dVector Du, Dv;
+      N[i][j] = ON_3dVector::ZeroVector;
+      if (false == m_srf->Ev1Der(u, v, P, Du, Dv))
+        continue;
+      const double lu = Du.Length();
+      const double lv = Dv.Length();
+      if (lu > 0.0)
+      {
+        su += lu;
+        su_count++;
+      }
+      if (lv > 0.0)
+      {
+        sv += lv;
+        sv_count++;
+      }
+      ON_3dVector normal;
+      if (m_srf->EvNormal(u, v, normal) && normal.IsUnitVector())
+        N[i][j] = normal;
+    }
+  }
+  m_scale[0] = (su_count > 0 && su > 0.0) ? su / su_count : 1.0;
+  m_scale[1] = (sv_count > 0 && sv > 0.0) ? sv / sv_count : 1.0;
+  m_length[0] = m_scale[0] * m_domain[0].Length();
+  m_length[1] = m_scale[1] * m_domain[1].Length();
+
+  m_turning[0] = m_turning[1] = 0.0;
+  for (int k = 0; k < n; k++)
+  {
+    double a = 0.0, b = 0.0;
+    for (int m = 0; m + 1 < n; m++)
+    {
+      if (N[m][k].IsNotZero() && N[m + 1][k].IsNotZero())
+        a += acos(ON_Max(-1.0, ON_Min(1.0, N[m][k] * N[m + 1][k])));
+      if (N[k][m].IsNotZero() && N[k][m + 1].IsNotZero())
+        b += acos(ON_Max(-1.0, ON_Min(1.0, N[k][m] * N[k][m + 1])));
+    }
+    if (a > m_turning[0])
+      m_turning[0] = a;
+    if (b > m_turning[1])
+      m_turning[1] = b;
+  }
+}
+
+void ON_Internal_BrepFaceMesher::GetGridCounts()
+{
+  const ON_MeshParameters& mp = m_settings.m_mp;
+  m_grid_count[0] = m_grid_count[1] = 1;
+  if (m_bSimplePlane)
+    return;
+
+  double angle = mp.GridAngleRadians();
+  if (!(angle > 0.0 && angle < ON_PI))
+    angle = m_settings.m_angle;
+
+  double n[2];
+  for (int dir = 0; dir < 2; dir++)
+  {
+    n[dir] = 1.0;
+    if (angle > 0.0)
+      n[dir] = ON_Max(n[dir], ceil(m_turning[dir] / angle));
+    if (m_settings.m_max_edge > 0.0)
+      n[dir] = ON_Max(n[dir], ceil(m_length[dir] / m_settings.m_max_edge));
+    const int span_count = m_srf->SpanCount(dir);
+    if (span_count > 1)
+      n[dir] = ON_Max(n[dir], (double)span_count);
+  }
+
+  const double aspect = mp.GridAspectRatio();
+  if (aspect > 0.0 && m_length[0] > 0.0 && m_length[1] > 0.0)
+  {
+    const double cell_u = m_length[0] / n[0];
+    const double cell_v = m_length[1] / n[1];
+    if (cell_u > aspect * cell_v)
+      n[0] = ceil(m_length[0] / (aspect * cell_v));
+    else if (cell_v > aspect * cell_u)
+      n[1] = ceil(m_length[1] / (aspect * cell_u));
+  }
+
+  const int min_count = mp.GridMinCount();
+  if (min_count > 0 && n[0] * n[1] < min_count)
+  {
+    const double f = sqrt(min_count / (n[0] * n[1]));
+    n[0] = ceil(f * n[0]);
+    n[1] = ceil(f * n[1]);
+  }
+
+  const double amplification = mp.GridAmplification();
+  if (amplification > 0.0 && 1.0 != amplification)
+  {
+    n[0] = ceil(amplification * n[0]);
+    n[1] = ceil(amplification * n[1]);
+  }
+
+  const int max_count = mp.GridMaxCount();
+  if (max_count > 0 && n[0] * n[1] > max_count)
+  {
+    const double f = sqrt(max_count / (n[0] * n[1]));
+    n[0] = floor(f * n[0]);
+    n[1] = floor(f * n[1]);
+  }
+
+  for (int dir = 0; dir < 2; dir++)
+    m_grid_count[dir] = (n[dir] < 1.0) ? 1 : ((n[dir] > 1024.0) ? 1024 : (int)n[dir]);
+}
+
+void ON_Internal_BrepFaceMesher::AppendTrimSamples(const ON_BrepTrim& trim)
+{
+  // Appends the trim's samples except the last one, which is the first sample of the next trim.
+  const ON_Interval trim_domain = trim.Domain();
+  if (false == trim_domain.IsIncreasing())
+    return;
+
+  if (trim.m_ei < 0 || trim.m_ei >= m_edge_samples.Count())
+  {
+    // Singular trims get the number of samples the grid has in the trim's
+    // direction. All the samples are at the vertex location.
+    const int vi = trim.m_vi[0];
+    if (vi < 0 || vi >= m_brep.m_V.Count())
+      return;
+    const ON_3dPoint P = m_brep.m_V[vi].point;
+    const int dir = (ON_Surface::N_iso == trim.m_iso || ON_Surface::S_iso == trim.m_iso) ? 0 : 1;
+    SingularTrim& singular_trim = m_singular_trim.AppendNew();
+    singular_trim.m_vi = vi;
+    singular_trim.m_dir = dir;
+    singular_trim.m_c = trim.PointAtStart()[1 - dir];
+    const int n = ON_Max(2, m_grid_count[dir]);
+    for (int i = 0; i < n; i++)
+    {
+      const ON_3dPoint uv = trim.PointAt(trim_domain.ParameterAt(((double)i) / n));
+      m_boundary_uv.Append(ON_2dPoint(uv));
+      m_boundary_P.Append(P);
+      m_boundary_brep_vertex.Append(vi);
+    }
+    return;
+  }
+
+  const ON_BrepEdge& edge = m_brep.m_E[trim.m_ei];
+  const ON_Internal_BrepMeshEdgeSamples& samples = m_edge_samples[trim.m_ei];
+  const int n = samples.m_t.Count();
+  if (n < 2)
+    return;
+  const ON_Interval edge_domain = edge.Domain();
+  const bool bRev = trim.m_bRev3d;
+
+  // Trim parameters are found by mapping edge parameters proportionally
+  // and then moving them so the surface point matches the edge point.
+  ON_SimpleArray<double> t(n);
+  t.SetCount(n);
+  for (int i = 0; i < n; i++)
+  {
+    const double s = edge_domain.NormalizedParameterAt(samples.m_t[bRev ? (n - 1 - i) : i]);
+    t[i] = trim_domain.ParameterAt(bRev ? (1.0 - s) : s);
+  }
+  t[0] = trim_domain[0];
+  t[n - 1] = trim_domain[1];
+
+  for (int i = 0; i + 1 < n; i++)
+  {
+    const ON_3dPoint& P = samples.m_P[bRev ? (n - 1 - i) : i];
+    double ti = t[i];
+    if (i > 0)
+    {
+      const double t0 = 0.5 * (t[i - 1] + ti);
+      const double t1 = 0.5 * (ti + t[i + 1]);
+      for (int iteration = 0; iteration < 4; iteration++)
+      {
+        ON_3dPoint uv;
+        ON_3dVector duv;
+        ON_3dPoint Q;
+        ON_3dVector Su, Sv;
+        if (false == trim.Ev1Der(ti, uv, duv))
+          break;
+        if (false == m_srf->Ev1Der(uv.x, uv.y, Q, Su, Sv))
+          break;
+        const ON_3dVector D = duv.x * Su + duv.y * Sv;
+        const double dd = D * D;
+        if (!(dd > 0.0))
+          break;
+        double next_t = ti - ((Q - P) * D) / dd;
+        if (next_t < t0)
+          next_t = t0;
+        else if (next_t > t1)
+          next_t = t1;
+        const bool bDone = fabs(next_t - ti) <= ON_EPSILON * trim_domain.Length();
+        ti = next_t;
+        if (bDone)
+          break;
+      }
+    }
+    const ON_3dPoint uv = trim.PointAt(ti);
+    m_boundary_uv.Append(ON_2dPoint(uv));
+    m_boundary_P.Append(P);
+    m_boundary_brep_vertex.Append((0 == i) ? trim.m_vi[0] : -1);
+  }
+}
+
+bool ON_Internal_BrepFaceMesher::GetBoundary()
+{
+  m_boundary_loop.SetCount(0);
+  for (int fli = 0; fli < m_face.m_li.Count(); fli++)
+  {
+    const int li = m_face.m_li[fli];
+    if (li < 0 || li >= m_brep.m_L.Count())
+      continue;
+    const ON_BrepLoop& loop = m_brep.m_L[li];
+    const int loop_start = m_boundary_uv.Count();
+    for (int lti = 0; lti < loop.m_ti.Count(); lti++)
+    {
+      const int ti = loop.m_ti[lti];
+      if (ti < 0 || ti >= m_brep.m_T.Count())
+        continue;
+      AppendTrimSamples(m_brep.m_T[ti]);
+    }
+    if (m_boundary_uv.Count() - loop_start < 3)
+    {
+      m_boundary_uv.SetCount(loop_start);
+      m_boundary_P.SetCount(loop_start);
+      m_boundary_brep_vertex.SetCount(loop_start);
+      continue;
+    }
+    m_boundary_loop.Append(loop_start);
+  }
+  if (m_boundary_loop.Count() < 1)
+    return false;
+  m_boundary_loop.Append(m_boundary_uv.Count());
+  return true;
+}
+
+int ON_Internal_BrepFaceMesher::AddPoint(const ON_2dPoint& uv, const ON_3dPoint& P, int brep_vertex, int start_triangle)
+{
+  bool bDuplicate = false;
+  const int pi = m_cdt.InsertPoint(To2d(uv), start_triangle, &bDuplicate);
+  if (pi < 0 || bDuplicate)
+    return pi;
+  ON_3dVector N = ON_3dVector::ZeroVector;
+  if (false == m_srf->EvNormal(uv.x, uv.y, N) || false == N.IsUnitVector())
+    N = ON_3dVector::ZeroVector;
+  m_uv.Append(uv);
+  m_P.Append(P);
+  m_N.Append(N);
+  m_brep_vertex.Append(brep_vertex);
+  return pi;
+}
+
+void ON_Internal_BrepFaceMesher::AddGridPoints()
+{
+  const int nu = m_grid_count[0];
+  const int nv = m_grid_count[1];
+  if (nu < 2 && nv < 2)
+    return;
+
+  const double dx = m_length[0] / nu;
+  const double dy = m_length[1] / nv;
+  if (!(dx > 0.0 && dy > 0.0))
+    return;
+  // Grid points closer than r to the boundary are not used.
+  const double r = 0.25 * ON_Min(dx, dy);
+
+  const int point_count = m_boundary_uv.Count();
+  ON_SimpleArray<ON_2dPoint> p(point_count);
+  for (int i = 0; i < point_count; i++)
+    p.Append(To2d(m_boundary_uv[i]));
+
+  // segment i goes from p[i] to p[segment_end[i]]
+  ON_SimpleArray<int> segment_end(point_count);
+  segment_end.SetCount(point_count);
+  for (int li = 0; li + 1 < m_boundary_loop.Count(); li++)
+  {
+    const int i0 = m_boundary_loop[li];
+    const int i1 = m_boundary_loop[li + 1];
+    for (int i = i0; i < i1; i++)
+      segment_end[i] = (i + 1 < i1) ? (i + 1) : i0;
+  }
+
+  // rows[j] = segments that are within r of the grid line y = j*dy
+  ON_ClassArray< ON_SimpleArray<int> > rows(nv + 1);
+  rows.SetCount(nv + 1);
+  for (int i = 0; i < point_count; i++)
+  {
+    const ON_2dPoint& a = p[i];
+    const ON_2dPoint& b = p[segment_end[i]];
+    int j0 = (int)ceil((ON_Min(a.y, b.y) - r) / dy);
+    int j1 = (int)floor((ON_Max(a.y, b.y) + r) / dy);
+    if (j0 < 1)
+      j0 = 1;
+    if (j1 > nv - 1)
+      j1 = nv - 1;
+    for (int j = j0; j <= j1; j++)
+      rows[j].Append(i);
+  }
+
+  ON_SimpleArray<double> x(64);
+  for (int j = 1; j < nv; j++)
+  {
+    const ON_SimpleArray<int>& row = rows[j];
+    if (row.Count() < 2)
+      continue;
+    const double y = j * dy;
+
+    // x coordinates where the boundary crosses the grid line
+    x.SetCount(0);
+    for (int k = 0; k < row.Count(); k++)
+    {
+      const ON_2dPoint& a = p[row[k]];
+      const ON_2dPoint& b = p[segment_end[row[k]]];
+      if ((a.y > y) != (b.y > y))
+        x.Append(a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y));
+    }
+    if (x.Count() < 2)
+      continue;
+    x.QuickSort(ON_CompareIncreasing<double>);
+
+    int crossing_count = 0;
+    for (int i = 1; i < nu; i++)
+    {
+      const ON_2dPoint g(i * dx, y);
+      while (crossing_count < x.Count() && x[crossing_count] < g.x)
+        crossing_count++;
+      if (0 == (crossing_count % 2))
+        continue;
+
+      bool bNearBoundary = false;
+      for (int k = 0; k < row.Count() && false == bNearBoundary; k++)
+      {
+        const ON_2dPoint& a = p[row[k]];
+        const ON_2dPoint& b = p[segment_end[row[k]]];
+        const ON_2dVector ab = b - a;
+        const double ab2 = ab * ab;
+        double s = (ab2 > 0.0) ? ((g - a) * ab) / ab2 : 0.0;
+        if (s < 0.0)
+          s = 0.0;
+        else if (s > 1.0)
+          s = 1.0;
+        bNearBoundary = (g.DistanceTo(a + s * ab) < r);
+      }
+      if (bNearBoundary)
+        continue;
+
+      const ON_2dPoint uv = ToUV(g);
+      const ON_3dPoint P = m_srf->PointAt(uv.x, uv.y);
+      AddPoint(uv, P, -1, -1);
+    }
+  }
+}
+
+void ON_Internal_BrepFaceMesher::Refine()
+{
+  const double tol = m_settings.m_tolerance;
+  const double max_edge = m_settings.m_max_edge;
+  const double min_edge = m_settings.m_min_edge;
+  const double cos_angle = m_settings.m_cos_angle;
+  const bool bAngle = (m_settings.m_angle > 0.0);
+  const int max_point_count = ON_Max(1000000, 4 * m_cdt.m_P.Count());
+
+  for (int round = 0; round < 12; round++)
+  {
+    int insert_count = 0;
+    const int triangle_count = m_cdt.m_T.Count();
+    for (int t = 0; t < triangle_count && m_cdt.m_P.Count() < max_point_count; t++)
+    {
+      const ON_Internal_CDT::Triangle T = m_cdt.m_T[t];
+      if (0 == T.m_inside || T.m_v[0] < 3 || T.m_v[1] < 3 || T.m_v[2] < 3)
+        continue;
+      const ON_3dPoint& A = m_P[T.m_v[0]];
+      const ON_3dPoint& B = m_P[T.m_v[1]];
+      const ON_3dPoint& C = m_P[T.m_v[2]];
+      const double edge_length = ON_Max(A.DistanceTo(B), ON_Max(B.DistanceTo(C), C.DistanceTo(A)));
+      if (!(edge_length > min_edge))
+        continue;
+
+      // skip slivers; their centroids are too close to an edge
+      const ON_2dPoint& a = m_cdt.m_P[T.m_v[0]];
+      const ON_2dPoint& b = m_cdt.m_P[T.m_v[1]];
+      const ON_2dPoint& c = m_cdt.m_P[T.m_v[2]];
+      const double area2 = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+      const double d2 = ON_Max((b - a).LengthSquared(), ON_Max((c - b).LengthSquared(), (a - c).LengthSquared()));
+      if (!(area2 > 1.0e-6 * d2))
+        continue;
+
+      bool bSplit = (max_edge > 0.0 && edge_length > max_edge);
+      if (false == bSplit && bAngle)
+      {
+        const ON_3dVector& NA = m_N[T.m_v[0]];
+        const ON_3dVector& NB = m_N[T.m_v[1]];
+        const ON_3dVector& NC = m_N[T.m_v[2]];
+        bSplit
+          = (NA.IsNotZero() && NB.IsNotZero() && NA * NB < cos_angle)
+          || (NB.IsNotZero() && NC.IsNotZero() && NB * NC < cos_angle)
+          || (NC.IsNotZero() && NA.IsNotZero() && NC * NA < cos_angle);
+      }
+
+      const ON_2dPoint centroid((a.x + b.x + c.x) / 3.0, (a.y + b.y + c.y) / 3.0);
+      const ON_2dPoint uv = ToUV(centroid);
+      const ON_3dPoint P = m_srf->PointAt(uv.x, uv.y);
+      if (false == bSplit && tol > 0.0)
+        bSplit = P.DistanceTo((A + B + C) / 3.0) > tol;
+      if (false == bSplit)
+        continue;
+
+      const int point_count = m_cdt.m_P.Count();
+      if (AddPoint(uv, P, -1, t) == point_count)
+        insert_count++;
+    }
+    if (0 == insert_count)
+      break;
+  }
+}
+
+bool ON_Internal_BrepFaceMesher::IsFolded(int t) const
+{
+  // Returns true if the 3d triangle and the surface normals point in opposite directions.
+  const ON_Internal_CDT::Triangle& T = m_cdt.m_T[t];
+  if (T.m_v[0] < 3 || T.m_v[1] < 3 || T.m_v[2] < 3)
+    return false;
+  const ON_3dPoint& A = m_P[T.m_v[0]];
+  const ON_3dPoint& B = m_P[T.m_v[1]];
+  const ON_3dPoint& C = m_P[T.m_v[2]];
+  ON_3dVector N = ON_3dVector::ZeroVector;
+  for (int k = 0; k < 3; k++)
+  {
+    // normals at singular points are not reliable
+    if (SingularTrimIndex(T.m_v[k]) < 0)
+      N += m_N[T.m_v[k]];
+  }
+  return ON_CrossProduct(B - A, C - A) * N < 0.0;
+}
+
+void ON_Internal_BrepFaceMesher::RepairFolds()
+{
+  // Near singular trims, triangles that are Delaunay in (u,v) can be
+  // folded over in 3d. Flip an edge of a folded triangle when that
+  // removes the fold.
+  if (m_singular_trim.Count() <= 0)
+    return;
+  for (int t = 0; t < m_cdt.m_T.Count(); t++)
+  {
+    if (0 == m_cdt.m_T[t].m_inside || false == IsFolded(t))
+      continue;
+    for (int i = 0; i < 3; i++)
+    {
+      const ON_Internal_CDT::Triangle& T = m_cdt.m_T[t];
+      const int u = T.m_n[i];
+      if (u < 0 || 0 != (T.m_constraint & (1 << i)) || 0 == m_cdt.m_T[u].m_inside)
+        continue;
+      if (false == m_cdt.Flip(t, i))
+        continue;
+      if (false == IsFolded(t) && false == IsFolded(u))
+        break;
+      m_cdt.Flip(t, 1);
+    }
+  }
+}
+
+ON_Mesh* ON_Internal_BrepFaceMesher::ToMesh() const
+{
+  const ON_MeshParameters& mp = m_settings.m_mp;
+  const int point_count = m_cdt.m_P.Count();
+  const bool bRev = m_face.m_bRev;
+
+  // mesh vertex index for each triangulation point
+  ON_SimpleArray<int> vertex_index(point_count);
+  vertex_index.SetCount(point_count);
+  for (int i = 0; i < point_count; i++)
+    vertex_index[i] = -1;
+  // Points at the brep vertex of a singular trim are a single mesh vertex.
+  ON_SimpleArray<ON_2dex> singular_vertex(8);
+
+  ON_SimpleArray<int> used_point(point_count);
+  ON_SimpleArray<ON_3dex> triangles(m_cdt.m_T.Count());
+  for (int t = 0; t < m_cdt.m_T.Count(); t++)
+  {
+    const ON_Internal_CDT::Triangle& T = m_cdt.m_T[t];
+    if (0 == T.m_inside || T.m_v[0] < 3 || T.m_v[1] < 3 || T.m_v[2] < 3)
+      continue;
+    int vi[3];
+    for (int k = 0; k < 3; k++)
+    {
+      const int pi = T.m_v[k];
+      if (vertex_index[pi] < 0)
+      {
+        const int brep_vi = (SingularTrimIndex(pi) >= 0) ? m_brep_vertex[pi] : -1;
+        if (brep_vi >= 0)
+        {
+          for (int s = 0; s < singular_vertex.Count(); s++)
+          {
+            if (brep_vi == singular_vertex[s].i)
+            {
+              vertex_index[pi] = singular_vertex[s].j;
+              break;
+            }
+          }
+        }
+        if (vertex_index[pi] < 0)
+        {
+          vertex_index[pi] = used_point.Count();
+          used_point.Append(pi);
+          if (brep_vi >= 0)
+            singular_vertex.Append(ON_2dex(brep_vi, vertex_index[pi]));
+        }
+      }
+      vi[k] = vertex_index[pi];
+    }
+    if (vi[0] == vi[1] || vi[1] == vi[2] || vi[2] == vi[0])
+      continue;
+    triangles.Append(bRev ? ON_3dex(vi[0], vi[2], vi[1]) : ON_3dex(vi[0], vi[1], vi[2]));
+  }
+  if (triangles.Count() < 1)
+    return nullptr;
+
+  const int vertex_count = used_point.Count();
+  ON_Mesh* mesh = new ON_Mesh(triangles.Count(), vertex_count, true, true);
+  const bool bDoublePrecision = mp.DoublePrecision();
+  if (bDoublePrecision)
+    mesh->m_dV.Reserve(vertex_count);
+  else
+    mesh->m_V.Reserve(vertex_count);
+  mesh->m_N.Reserve(vertex_count);
+  mesh->m_S.Reserve(vertex_count);
+  mesh->m_T.Reserve(vertex_count);
+
+  bool bMissingNormals = false;
+  for (int i = 0; i < vertex_count; i++)
+  {
+    const int pi = used_point[i];
+    const ON_2dPoint& uv = m_uv[pi];
+    if (bDoublePrecision)
+      mesh->m_dV.Append(m_P[pi]);
+    else
+      mesh->m_V.Append(ON_3fPoint(m_P[pi]));
+    const ON_3dVector N = bRev ? -m_N[pi] : m_N[pi];
+    if (N.IsZero())
+      bMissingNormals = true;
+    mesh->m_N.Append(ON_3fVector(N));
+    mesh->m_S.Append(uv);
+    mesh->m_T.Append(ON_2fPoint((float)m_domain[0].NormalizedParameterAt(uv.x), (float)m_domain[1].NormalizedParameterAt(uv.y)));
+  }
+  if (bDoublePrecision)
+    mesh->UpdateSinglePrecisionVertices();
+
+  mesh->m_F.Reserve(triangles.Count());
+  for (int i = 0; i < triangles.Count(); i++)
+    mesh->SetTriangle(i, triangles[i].i, triangles[i].j, triangles[i].k);
+
+  mesh->m_srf_domain[0] = m_domain[0];
+  mesh->m_srf_domain[1] = m_domain[1];
+  mesh->m_srf_scale[0] = m_length[0];
+  mesh->m_srf_scale[1] = m_length[1];
+
+  if (mp.ComputeCurvature())
+  {
+    mesh->m_K.Reserve(vertex_count);
+    for (int i = 0; i < vertex_count; i++)
+    {
+      const ON_2dPoint& uv = m_uv[used_point[i]];
+      ON_3dPoint P;
+      ON_3dVector Du, Dv, Duu, Duv, Dvv, K1, K2;
+      const ON_3dVector& N = m_N[used_point[i]];
+      double gauss = 0.0, mean = 0.0, k1 = 0.0, k2 = 0.0;
+      if (N.IsNotZero()
+        && m_srf->Ev2Der(uv.x, uv.y, P, Du, Dv, Duu, Duv, Dvv)
+        && ON_EvPrincipalCurvatures(Du, Dv, Duu, Duv, Dvv, N, &gauss, &mean, &k1, &k2, K1, K2))
+      {
+        mesh->m_K.Append(bRev ? ON_SurfaceCurvature::CreateFromPrincipalCurvatures(-k1, -k2) : ON_SurfaceCurvature::CreateFromPrincipalCurvatures(k1, k2));
+      }
+      else
+        mesh->m_K.Append(ON_SurfaceCurvature::Zero);
+    }
+  }
+
+  mesh->ComputeFaceNormals();
+  if (bMissingNormals)
+  {
+    // Use the average of the adjacent face normals where the surface normal is not defined.
+    ON_SimpleArray<ON_3dVector> N(vertex_count);
+    N.SetCount(vertex_count);
+    N.Zero();
+    for (int fi = 0; fi < mesh->m_F.Count(); fi++)
+    {
+      const ON_MeshFace& f = mesh->m_F[fi];
+      const ON_3dVector FN(mesh->m_FN[fi]);
+      for (int k = 0; k < 3; k++)
+        N[f.vi[k]] += FN;
+    }
+    for (int i = 0; i < vertex_count; i++)
+    {
+      if (mesh->m_N[i].IsZero() && N[i].Unitize())
+        mesh->m_N[i] = ON_3fVector(N[i]);
+    }
+  }
+
+  mesh->SetMeshParameters(mp);
+  return mesh;
+}
+
+ON_Mesh* ON_Internal_BrepFaceMesher::CreateMesh()
+{
+  if (nullptr == m_srf)
+    return nullptr;
+  m_domain[0] = m_srf->Domain(0);
+  m_domain[1] = m_srf->Domain(1);
+  if (false == m_domain[0].IsIncreasing() || false == m_domain[1].IsIncreasing())
+    return nullptr;
+
+  GetSurfaceSize();
+  m_bSimplePlane = m_settings.m_mp.SimplePlanes() && m_srf->IsPlanar(nullptr, ON_ZERO_TOLERANCE);
+  GetGridCounts();
+  if (false == GetBoundary())
+    return nullptr;
+
+  ON_BoundingBox bbox;
+  bbox.Set(2, false, m_boundary_uv.Count(), 2, &m_boundary_uv[0].x, false);
+  bbox.m_min = To2d(ON_2dPoint(bbox.m_min));
+  bbox.m_max = To2d(ON_2dPoint(bbox.m_max));
+  bbox.m_min.z = bbox.m_max.z = 0.0;
+  const int point_capacity = m_boundary_uv.Count() + (m_grid_count[0] + 1) * (m_grid_count[1] + 1);
+  if (false == m_cdt.Create(bbox, point_capacity))
+    return nullptr;
+  m_uv.Reserve(point_capacity + 3);
+  m_P.Reserve(point_capacity + 3);
+  m_N.Reserve(point_capacity + 3);
+  m_brep_vertex.Reserve(point_capacity + 3);
+  for (int i = 0; i < 3; i++)
+  {
+    m_uv.Append(ON_2dPoint::NanPoint);
+    m_P.Append(ON_3dPoint::NanPoint);
+    m_N.Append(ON_3dVector::ZeroVector);
+    m_brep_vertex.Append(-1);
+  }
+
+  ON_SimpleArray<int> boundary_point(m_boundary_uv.Count());
+  for (int i = 0; i < m_boundary_uv.Count(); i++)
+    boundary_point.Append(AddPoint(m_boundary_uv[i], m_boundary_P[i], m_boundary_brep_vertex[i], -1));
+
+  AddGridPoints();
+
+  for (int li = 0; li + 1 < m_boundary_loop.Count(); li++)
+  {
+    const int i0 = m_boundary_loop[li];
+    const int i1 = m_boundary_loop[li + 1];
+    for (int i = i0; i < i1; i++)
+    {
+      const int a = boundary_point[i];
+      const int b = boundary_point[(i + 1 < i1) ? (i + 1) : i0];
+      if (a >= 3 && b >= 3 && a != b)
+        m_cdt.InsertConstraint(a, b, 0);
+    }
+  }
+  m_cdt.ClassifyInside();
+
+  if (false == m_bSimplePlane)
+  {
+    Refine();
+    RepairFolds();
+  }
+
+  return ToMesh();
+}
+
+class ON_Internal_BrepMeshContext
+{
+public:
+  const ON_Brep* m_brep = nullptr;
+  const ON_Internal_BrepMeshSettings* m_settings = nullptr;
+  ON_ClassArray<ON_Internal_BrepMeshEdgeSamples>* m_edge_samples = nullptr;
+  ON_Mesh** m_meshes = nullptr;
+};
+
+static void Internal_BrepMeshEdgeTask(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1)
+{
+  const ON_Internal_BrepMeshContext* ctx = (const ON_Internal_BrepMeshContext*)context;
+  for (size_t i = i0; i < i1; i++)
+    Internal_BrepMeshSampleEdge(*ctx->m_brep, (int)i, *ctx->m_settings, (*ctx->m_edge_samples)[(int)i]);
+}
+
+static void Internal_BrepMeshFaceTask(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1)
+{
+  const ON_Internal_BrepMeshContext* ctx = (const ON_Internal_BrepMeshContext*)context;
+  for (size_t i = i0; i < i1; i++)
+  {
+    const ON_BrepFace& face = ctx->m_brep->m_F[(int)i];
+    ctx->m_meshes[i] = nullptr;
+    if (face.m_face_index < 0)
+      continue;
+    ON_Internal_BrepFaceMesher mesher(*ctx->m_brep, face, *ctx->m_settings, *ctx->m_edge_samples);
+    ctx->m_meshes[i] = mesher.CreateMesh();
+  }
+}
+
+int ON_Brep::CreateMesh(
+  const ON_MeshParameters& mp,
+  ON_SimpleArray<ON_Mesh*>& mesh_list
+) const
+{
+  const int face_count = m_F.Count();
+  if (face_count <= 0)
+    return 0;
+
+  const ON_Internal_BrepMeshSettings settings(*this, mp);
+  ON_ClassArray<ON_Internal_BrepMeshEdgeSamples> edge_samples(m_E.Count());
+  edge_samples.SetCount(m_E.Count());
+
+  const int mesh_list_count0 = mesh_list.Count();
+  mesh_list.Reserve(mesh_list_count0 + face_count);
+  mesh_list.SetCount(mesh_list_count0 + face_count);
+  ON_Internal_BrepMeshContext ctx;
+  ctx.m_brep = this;
+  ctx.m_settings = &settings;
+  ctx.m_edge_samples = &edge_samples;
+  ctx.m_meshes = mesh_list.Array() + mesh_list_count0;
+
+  // Every edge is sampled once so adjacent faces have the same boundary vertices.
+  ON_ParallelFor(m_E.Count(), 16, 0, Internal_BrepMeshEdgeTask, (ON__UINT_PTR)&ctx);
+  ON_ParallelFor(face_count, 1, 0, Internal_BrepMeshFaceTask, (ON__UINT_PTR)&ctx);
+
+  return face_count;
+}
+
+int ON_Brep::CreateAndSetMesh(
+  ON::mesh_type mesh_type,
+  const ON_MeshParameters& mp
+)
+{
+  ON_SimpleArray<ON_Mesh*> meshes(m_F.Count());
+  CreateMesh(mp, meshes);
+  int mesh_count = 0;
+  for (int fi = 0; fi < m_F.Count() && fi < meshes.Count(); fi++)
+  {
+    if (nullptr == meshes[fi])
+    {
+      m_F[fi].DestroyMesh(mesh_type);
+      continue;
+    }
+    if (m_F[fi].SetMesh(mesh_type, meshes[fi]))
+      mesh_count++;
+    else
+      delete meshes[fi];
+  }
+  return mesh_count;
+}
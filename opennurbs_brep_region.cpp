@@ -1040,6 +1040,12 @@ void ON_Brep::MemoryRelocate()
   {
     m_region_topology->m_brep = this;
   }
+
+  ON_BrepComponentTree* component_tree = m_component_tree;
+  if ( component_tree )
+  {
+    component_tree->m_brep = this;
+  }
 }
 
 ON_Brep* ON_Brep::SubBrep( 
@@ -2613,6 +2613,7 @@ bool ON_Brep::MatchTrimEnds()
 ON_NurbsCurve* ON_Brep::MakeTrimCurveNurb(ON_BrepTrim& T)
 
 {
+  UnshareGeometry();
   // 11 Nov 2002 Dale Lear: I added the check to make sure we need to 
   // make a new NURBS curve
   ON_NurbsCurve* nc = 0;
@@ -3319,6 +3320,25 @@ bool ON_Brep::RemoveNesting(
   int i, count;
   ON_PolyCurve* polycurve;
 
+  // The curves are changed in place, so curves shared with other
+  // breps must be duplicated first.
+  if ( HasSharedGeometry() )
+  {
+    bool bNested = false;
+    for ( i = 0; bEdges && !bNested && i < m_C3.Count(); i++ )
+    {
+      polycurve = ON_PolyCurve::Cast(m_C3[i]);
+      bNested = ( 0 != polycurve && polycurve->IsNested() );
+    }
+    for ( i = 0; bTrimCurves && !bNested && i < m_C2.Count(); i++ )
+    {
+      polycurve = ON_PolyCurve::Cast(m_C2[i]);
+      bNested = ( 0 != polycurve && polycurve->IsNested() );
+    }
+    if ( bNested )
+      UnshareGeometry();
+  }
+
   if ( bEdges )
   {
     count = m_C3.Count();
@@ -0,0 +1,734 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+class ON_Internal_BrepComponentBoxes
+{
+public:
+  const ON_Brep* m_brep = nullptr;
+  ON_BoundingBox* m_face_bbox = nullptr;
+  ON_BoundingBox* m_edge_bbox = nullptr;
+};
+
+static double Internal_BrepComponentTolerance(double tolerance)
+{
+  return (ON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+}
+
+static void Internal_GetBrepFaceBoxes(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1)
+{
+  const ON_Internal_BrepComponentBoxes* boxes = (const ON_Internal_BrepComponentBoxes*)context;
+  for (size_t i = i0; i < i1; i++)
+  {
+    const ON_BrepFace& face = boxes->m_brep->m_F[(int)i];
+    boxes->m_face_bbox[i] = (face.m_face_index >= 0) ? face.BoundingBox() : ON_BoundingBox::EmptyBoundingBox;
+  }
+}
+
+static void Internal_GetBrepEdgeBoxes(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1)
+{
+  const ON_Internal_BrepComponentBoxes* boxes = (const ON_Internal_BrepComponentBoxes*)context;
+  for (size_t i = i0; i < i1; i++)
+  {
+    const ON_BrepEdge& edge = boxes->m_brep->m_E[(int)i];
+    ON_BoundingBox bbox = ON_BoundingBox::EmptyBoundingBox;
+    if (edge.m_edge_index >= 0 && nullptr != edge.ProxyCurve())
+    {
+      bbox = edge.BoundingBox();
+      const double tol = Internal_BrepComponentTolerance(edge.m_tolerance);
+      if (tol > 0.0 && bbox.IsValid())
+      {
+        bbox.m_min -= ON_3dVector(tol, tol, tol);
+        bbox.m_max += ON_3dVector(tol, tol, tol);
+      }
+    }
+    boxes->m_edge_bbox[i] = bbox;
+  }
+}
+
+bool ON_BrepComponentTree::Create(const ON_Brep& brep)
+{
+  Destroy();
+
+  const int face_count = brep.m_F.Count();
+  const int edge_count = brep.m_E.Count();
+  const int vertex_count = brep.m_V.Count();
+
+  // The component boxes are calculated in parallel. The tree is
+  // built serially because ON_RTree::Insert() is not thread safe.
+  ON_SimpleArray<ON_BoundingBox> face_bbox(face_count);
+  face_bbox.SetCount(face_count);
+  ON_SimpleArray<ON_BoundingBox> edge_bbox(edge_count);
+  edge_bbox.SetCount(edge_count);
+  ON_Internal_BrepComponentBoxes boxes;
+  boxes.m_brep = &brep;
+  boxes.m_face_bbox = face_bbox.Array();
+  boxes.m_edge_bbox = edge_bbox.Array();
+  ON_ParallelFor(face_count, 16, 0, Internal_GetBrepFaceBoxes, (ON__UINT_PTR)&boxes);
+  ON_ParallelFor(edge_count, 16, 0, Internal_GetBrepEdgeBoxes, (ON__UINT_PTR)&boxes);
+
+  bool rc = true;
+  for (int fi = 0; fi < face_count; fi++)
+  {
+    const ON_BoundingBox& bbox = face_bbox[fi];
+    if (bbox.IsValid() && false == m_face_tree.Insert(&bbox.m_min.x, &bbox.m_max.x, fi))
+      rc = false;
+  }
+  for (int ei = 0; ei < edge_count; ei++)
+  {
+    const ON_BoundingBox& bbox = edge_bbox[ei];
+    if (bbox.IsValid() && false == m_edge_tree.Insert(&bbox.m_min.x, &bbox.m_max.x, ei))
+      rc = false;
+  }
+  for (int vi = 0; vi < vertex_count; vi++)
+  {
+    const ON_BrepVertex& vertex = brep.m_V[vi];
+    if (vertex.m_vertex_index < 0 || false == vertex.point.IsValid())
+      continue;
+    const double tol = Internal_BrepComponentTolerance(vertex.m_tolerance);
+    const ON_3dPoint P0 = vertex.point - ON_3dVector(tol, tol, tol);
+    const ON_3dPoint P1 = vertex.point + ON_3dVector(tol, tol, tol);
+    if (false == m_vertex_tree.Insert(&P0.x, &P1.x, vi))
+      rc = false;
+  }
+
+  m_brep = &brep;
+  m_face_count = face_count;
+  m_edge_count = edge_count;
+  m_vertex_count = vertex_count;
+  m_brep_bbox = brep.BoundingBox();
+  return rc;
+}
+
+ON_BrepComponentTree::~ON_BrepComponentTree()
+{
+  delete m_replaced_tree;
+}
+
+void ON_BrepComponentTree::Destroy()
+{
+  m_face_tree.RemoveAll();
+  m_edge_tree.RemoveAll();
+  m_vertex_tree.RemoveAll();
+  m_brep = nullptr;
+  m_face_count = 0;
+  m_edge_count = 0;
+  m_vertex_count = 0;
+  m_brep_bbox = ON_BoundingBox::EmptyBoundingBox;
+}
+
+const ON_Brep* ON_BrepComponentTree::Brep() const
+{
+  return m_brep;
+}
+
+bool ON_BrepComponentTree::IsCurrent(const ON_Brep& brep) const
+{
+  if (&brep != m_brep)
+    return false;
+  if (m_face_count != brep.m_F.Count() || m_edge_count != brep.m_E.Count() || m_vertex_count != brep.m_V.Count())
+    return false;
+  const ON_BoundingBox bbox = brep.BoundingBox();
+  return (bbox.m_min == m_brep_bbox.m_min && bbox.m_max == m_brep_bbox.m_max);
+}
+
+size_t ON_BrepComponentTree::SizeOf() const
+{
+  return sizeof(*this)
+    + m_face_tree.SizeOf() - sizeof(m_face_tree)
+    + m_edge_tree.SizeOf() - sizeof(m_edge_tree)
+    + m_vertex_tree.SizeOf() - sizeof(m_vertex_tree);
+}
+
+class ON_Internal_BrepComponentSearch
+{
+public:
+  const ON_Brep* m_brep = nullptr;
+  ON_COMPONENT_INDEX::TYPE m_type = ON_COMPONENT_INDEX::invalid_type;
+  ON_SimpleArray<ON_COMPONENT_INDEX>* m_components = nullptr;
+
+  static bool ON_CALLBACK_CDECL Callback(void* context, ON__INT_PTR id)
+  {
+    const ON_Internal_BrepComponentSearch* search = (const ON_Internal_BrepComponentSearch*)context;
+    const int i = (int)id;
+    const ON_Brep* brep = search->m_brep;
+    bool bDeleted = false;
+    switch (search->m_type)
+    {
+    case ON_COMPONENT_INDEX::brep_face:
+      bDeleted = (i >= brep->m_F.Count() || brep->m_F[i].m_face_index < 0);
+      break;
+    case ON_COMPONENT_INDEX::brep_edge:
+      bDeleted = (i >= brep->m_E.Count() || brep->m_E[i].m_edge_index < 0);
+      break;
+    case ON_COMPONENT_INDEX::brep_vertex:
+      bDeleted = (i >= brep->m_V.Count() || brep->m_V[i].m_vertex_index < 0);
+      break;
+    default:
+      break;
+    }
+    if (false == bDeleted)
+      search->m_components->Append(ON_COMPONENT_INDEX(search->m_type, i));
+    return true;
+  }
+};
+
+static bool Internal_SearchBrepComponentType(
+  ON_COMPONENT_INDEX::TYPE component_type,
+  ON_COMPONENT_INDEX::TYPE tree_type
+)
+{
+  return (ON_COMPONENT_INDEX::invalid_type == component_type || tree_type == component_type);
+}
+
+unsigned int ON_BrepComponentTree::Search(
+  const ON_BoundingBox& bbox,
+  ON_COMPONENT_INDEX::TYPE component_type,
+  ON_SimpleArray<ON_COMPONENT_INDEX>& components
+) const
+{
+  const unsigned int count0 = components.UnsignedCount();
+  if (nullptr == m_brep || false == bbox.IsValid())
+    return 0;
+  ON_Internal_BrepComponentSearch search;
+  search.m_brep = m_brep;
+  search.m_components = &components;
+  const ON_RTree* trees[3] = { &m_face_tree, &m_edge_tree, &m_vertex_tree };
+  const ON_COMPONENT_INDEX::TYPE types[3] = { ON_COMPONENT_INDEX::brep_face, ON_COMPONENT_INDEX::brep_edge, ON_COMPONENT_INDEX::brep_vertex };
+  for (int i = 0; i < 3; i++)
+  {
+    if (false == Internal_SearchBrepComponentType(component_type, types[i]))
+      continue;
+    search.m_type = types[i];
+    trees[i]->Search(&bbox.m_min.x, &bbox.m_max.x, ON_Internal_BrepComponentSearch::Callback, &search);
+  }
+  return components.UnsignedCount() - count0;
+}
+
+unsigned int ON_BrepComponentTree::Search(
+  ON_3dPoint center,
+  double radius,
+  ON_COMPONENT_INDEX::TYPE component_type,
+  ON_SimpleArray<ON_COMPONENT_INDEX>& components
+) const
+{
+  const unsigned int count0 = components.UnsignedCount();
+  if (nullptr == m_brep || false == center.IsValid() || !(radius >= 0.0))
+    return 0;
+  ON_Internal_BrepComponentSearch search;
+  search.m_brep = m_brep;
+  search.m_components = &components;
+  const ON_RTree* trees[3] = { &m_face_tree, &m_edge_tree, &m_vertex_tree };
+  const ON_COMPONENT_INDEX::TYPE types[3] = { ON_COMPONENT_INDEX::brep_face, ON_COMPONENT_INDEX::brep_edge, ON_COMPONENT_INDEX::brep_vertex };
+  for (int i = 0; i < 3; i++)
+  {
+    if (false == Internal_SearchBrepComponentType(component_type, types[i]))
+      continue;
+    search.m_type = types[i];
+    ON_RTreeSphere sphere;
+    sphere.m_point[0] = center.x;
+    sphere.m_point[1] = center.y;
+    sphere.m_point[2] = center.z;
+    sphere.m_radius = radius;
+    trees[i]->Search(&sphere, ON_Internal_BrepComponentSearch::Callback, &search);
+  }
+  return components.UnsignedCount() - count0;
+}
+
+unsigned int ON_BrepComponentTree::Search(
+  const ON_Line& segment,
+  double radius,
+  ON_COMPONENT_INDEX::TYPE component_type,
+  ON_SimpleArray<ON_COMPONENT_INDEX>& components
+) const
+{
+  const unsigned int count0 = components.UnsignedCount();
+  if (nullptr == m_brep || false == segment.IsValid() || !(radius >= 0.0))
+    return 0;
+  ON_Internal_BrepComponentSearch search;
+  search.m_brep = m_brep;
+  search.m_components = &components;
+  const ON_RTree* trees[3] = { &m_face_tree, &m_edge_tree, &m_vertex_tree };
+  const ON_COMPONENT_INDEX::TYPE types[3] = { ON_COMPONENT_INDEX::brep_face, ON_COMPONENT_INDEX::brep_edge, ON_COMPONENT_INDEX::brep_vertex };
+  for (int i = 0; i < 3; i++)
+  {
+    if (false == Internal_SearchBrepComponentType(component_type, types[i]))
+      continue;
+    search.m_type = types[i];
+    ON_RTreeCapsule capsule;
+    for (int k = 0; k < 3; k++)
+    {
+      capsule.m_point[0][k] = segment.from[k];
+      capsule.m_point[1][k] = segment.to[k];
+    }
+    capsule.m_radius = radius;
+    capsule.m_domain[0] = 0.0;
+    capsule.m_domain[1] = 1.0;
+    trees[i]->Search(&capsule, ON_Internal_BrepComponentSearch::Callback, &search);
+  }
+  return components.UnsignedCount() - count0;
+}
+
+static bool Internal_BrepEdgeClosestPoint(
+  const ON_BrepEdge& edge,
+  ON_3dPoint P,
+  ON_3dPoint& closest_point
+)
+{
+  const ON_Interval domain = edge.Domain();
+  if (false == domain.IsIncreasing())
+    return false;
+
+  // Sample the edge, then use Newton's method on (C(t) - P) o C'(t) = 0
+  // starting at the closest sample.
+  int span_count = edge.SpanCount();
+  if (span_count < 1)
+    span_count = 1;
+  const int n = (span_count > 32) ? 256 : 8 * span_count;
+  double best_t = domain[0];
+  double best_d = ON_DBL_MAX;
+  for (int i = 0; i <= n; i++)
+  {
+    const double t = domain.ParameterAt(((double)i) / n);
+    const double d = P.DistanceTo(edge.PointAt(t));
+    if (d < best_d)
+    {
+      best_d = d;
+      best_t = t;
+    }
+  }
+  if (!(best_d < ON_DBL_MAX))
+    return false;
+
+  const double dt = domain.Length() / n;
+  const double t0 = ON_Max(domain[0], best_t - dt);
+  const double t1 = ON_Min(domain[1], best_t + dt);
+  double t = best_t;
+  for (int iteration = 0; iteration < 8; iteration++)
+  {
+    ON_3dPoint C;
+    ON_3dVector D1, D2;
+    if (false == edge.Ev2Der(t, C, D1, D2))
+      break;
+    const ON_3dVector V = C - P;
+    const double f = V * D1;
+    const double df = D1 * D1 + V * D2;
+    if (!(df > 0.0))
+      break;
+    double next_t = t - f / df;
+    if (next_t < t0)
+      next_t = t0;
+    else if (next_t > t1)
+      next_t = t1;
+    const bool bDone = fabs(next_t - t) <= ON_EPSILON * domain.Length();
+    t = next_t;
+    if (bDone)
+      break;
+  }
+  const ON_3dPoint C = edge.PointAt(t);
+  const double d = P.DistanceTo(C);
+  if (d <= best_d)
+  {
+    closest_point = C;
+  }
+  else
+  {
+    closest_point = edge.PointAt(best_t);
+  }
+  return true;
+}
+
+static bool Internal_BrepFaceMeshClosestPoint(
+  const ON_Mesh& mesh,
+  ON_3dPoint P,
+  ON_3dPoint& closest_point
+)
+{
+  const int vertex_count = mesh.VertexCount();
+  const bool bDoublePrecision = mesh.HasSynchronizedDoubleAndSinglePrecisionVertices();
+  double best_d = ON_DBL_MAX;
+  for (int fi = 0; fi < mesh.m_F.Count(); fi++)
+  {
+    const ON_MeshFace& f = mesh.m_F[fi];
+    if (false == f.IsValid(vertex_count))
+      continue;
+    for (int k = 0; k < (f.IsQuad() ? 2 : 1); k++)
+    {
+      const int vi[3] = { f.vi[0], f.vi[1 + k], f.vi[2 + k] };
+      ON_Triangle triangle;
+      for (int j = 0; j < 3; j++)
+        triangle[j] = bDoublePrecision ? mesh.m_dV[vi[j]] : ON_3dPoint(mesh.m_V[vi[j]]);
+      const ON_3dPoint Q = triangle.ClosestPointTo(P);
+      const double d = P.DistanceTo(Q);
+      if (d < best_d)
+      {
+        best_d = d;
+        closest_point = Q;
+      }
+    }
+  }
+  return (best_d < ON_DBL_MAX);
+}
+
+static void Internal_GetBrepFaceBoundary(
+  const ON_BrepFace& face,
+  ON_SimpleArray<ON_2dPoint>& boundary,
+  ON_SimpleArray<int>& loop_end
+)
+{
+  // Parameter space polygons of the face's loops. Polygon i ends at
+  // boundary[loop_end[i]-1].
+  const ON_Brep* brep = face.Brep();
+  for (int fli = 0; fli < face.m_li.Count(); fli++)
+  {
+    const int li = face.m_li[fli];
+    if (li < 0 || li >= brep->m_L.Count())
+      continue;
+    const ON_BrepLoop& loop = brep->m_L[li];
+    const int count0 = boundary.Count();
+    for (int lti = 0; lti < loop.m_ti.Count(); lti++)
+    {
+      const int ti = loop.m_ti[lti];
+      if (ti < 0 || ti >= brep->m_T.Count() || nullptr == brep->m_T[ti].ProxyCurve())
+        continue;
+      const ON_BrepTrim& trim = brep->m_T[ti];
+      const ON_Interval domain = trim.Domain();
+      int n = 8 * trim.SpanCount();
+      if (n < 8)
+        n = 8;
+      else if (n > 64)
+        n = 64;
+      for (int i = 0; i < n; i++)
+        boundary.Append(ON_2dPoint(trim.PointAt(domain.ParameterAt(((double)i) / n))));
+    }
+    if (boundary.Count() - count0 >= 3)
+      loop_end.Append(boundary.Count());
+    else
+      boundary.SetCount(count0);
+  }
+}
+
+static bool Internal_IsPointInBrepFaceBoundary(
+  const ON_2dPoint& uv,
+  const ON_SimpleArray<ON_2dPoint>& boundary,
+  const ON_SimpleArray<int>& loop_end
+)
+{
+  // An untrimmed face uses its entire surface.
+  if (0 == loop_end.Count())
+    return true;
+  // Even-odd rule so the orientation of the loops does not matter.
+  bool bInside = false;
+  int i0 = 0;
+  for (int li = 0; li < loop_end.Count(); li++)
+  {
+    const int i1 = loop_end[li];
+    for (int i = i0; i < i1; i++)
+    {
+      const ON_2dPoint& a = boundary[i];
+      const ON_2dPoint& b = boundary[(i + 1 < i1) ? (i + 1) : i0];
+      if ((a.y > uv.y) != (b.y > uv.y) && uv.x < a.x + (uv.y - a.y) * (b.x - a.x) / (b.y - a.y))
+        bInside = !bInside;
+    }
+    i0 = i1;
+  }
+  return bInside;
+}
+
+static bool Internal_BrepFaceClosestPoint(
+  const ON_BrepFace& face,
+  ON_3dPoint P,
+  ON_3dPoint& closest_point
+)
+{
+  // Used when the face does not have a cached mesh. The closest point
+  // is either a local minimum of the distance inside the trimming loops
+  // or a point on one of the face's edges.
+  const ON_Brep* brep = face.Brep();
+  if (nullptr == brep || nullptr == face.ProxySurface())
+    return false;
+  const ON_Interval domain[2] = { face.Domain(0), face.Domain(1) };
+  if (false == domain[0].IsIncreasing() || false == domain[1].IsIncreasing())
+    return false;
+
+  ON_SimpleArray<ON_2dPoint> boundary;
+  ON_SimpleArray<int> loop_end;
+  Internal_GetBrepFaceBoundary(face, boundary, loop_end);
+
+  double best_d = ON_DBL_MAX;
+
+  // Sample the surface inside the trimming loops, then use Newton's
+  // method on the gradient of |S(u,v) - P|^2 starting at the closest sample.
+  int n[2];
+  for (int dir = 0; dir < 2; dir++)
+  {
+    n[dir] = 4 * face.SpanCount(dir);
+    if (n[dir] < 8)
+      n[dir] = 8;
+    else if (n[dir] > 48)
+      n[dir] = 48;
+  }
+  ON_2dPoint best_uv = ON_2dPoint::NanPoint;
+  double best_sample_d = ON_DBL_MAX;
+  for (int i = 0; i <= n[0]; i++)
+  {
+    const double u = domain[0].ParameterAt(((double)i) / n[0]);
+    for (int j = 0; j <= n[1]; j++)
+    {
+      const double v = domain[1].ParameterAt(((double)j) / n[1]);
+      if (false == Internal_IsPointInBrepFaceBoundary(ON_2dPoint(u, v), boundary, loop_end))
+        continue;
+      const double d = P.DistanceTo(face.PointAt(u, v));
+      if (d < best_sample_d)
+      {
+        best_sample_d = d;
+        best_uv.Set(u, v);
+      }
+    }
+  }
+  if (best_sample_d < ON_DBL_MAX)
+  {
+    const double du = domain[0].Length() / n[0];
+    const double dv = domain[1].Length() / n[1];
+    const ON_Interval u_limits(ON_Max(domain[0][0], best_uv.x - du), ON_Min(domain[0][1], best_uv.x + du));
+    const ON_Interval v_limits(ON_Max(domain[1][0], best_uv.y - dv), ON_Min(domain[1][1], best_uv.y + dv));
+    ON_2dPoint uv = best_uv;
+    for (int iteration = 0; iteration < 10; iteration++)
+    {
+      ON_3dPoint S;
+      ON_3dVector Su, Sv, Suu, Suv, Svv;
+      if (false == face.Ev2Der(uv.x, uv.y, S, Su, Sv, Suu, Suv, Svv))
+        break;
+      const ON_3dVector V = S - P;
+      const double gu = V * Su;
+      const double gv = V * Sv;
+      const double huu = Su * Su + V * Suu;
+      const double huv = Su * Sv + V * Suv;
+      const double hvv = Sv * Sv + V * Svv;
+      const double det = huu * hvv - huv * huv;
+      if (!(det > 0.0 && huu > 0.0))
+        break;
+      ON_2dPoint next_uv(uv.x - (hvv * gu - huv * gv) / det, uv.y - (huu * gv - huv * gu) / det);
+      next_uv.x = ON_Min(ON_Max(next_uv.x, u_limits[0]), u_limits[1]);
+      next_uv.y = ON_Min(ON_Max(next_uv.y, v_limits[0]), v_limits[1]);
+      const bool bDone = fabs(next_uv.x - uv.x) <= ON_EPSILON * domain[0].Length()
+        && fabs(next_uv.y - uv.y) <= ON_EPSILON * domain[1].Length();
+      uv = next_uv;
+      if (bDone)
+        break;
+    }
+    const ON_3dPoint Q = face.PointAt(uv.x, uv.y);
+    const double d = P.DistanceTo(Q);
+    if (d <= best_sample_d && Internal_IsPointInBrepFaceBoundary(uv, boundary, loop_end))
+    {
+      best_d = d;
+      closest_point = Q;
+    }
+    else
+    {
+      best_d = best_sample_d;
+      closest_point = face.PointAt(best_uv.x, best_uv.y);
+    }
+  }
+
+  // The closest point may be on the boundary of the face.
+  for (int fli = 0; fli < face.m_li.Count(); fli++)
+  {
+    const int li = face.m_li[fli];
+    if (li < 0 || li >= brep->m_L.Count())
+      continue;
+    const ON_BrepLoop& loop = brep->m_L[li];
+    for (int lti = 0; lti < loop.m_ti.Count(); lti++)
+    {
+      const int ti = loop.m_ti[lti];
+      if (ti < 0 || ti >= brep->m_T.Count())
+        continue;
+      const int ei = brep->m_T[ti].m_ei;
+      if (ei < 0 || ei >= brep->m_E.Count() || nullptr == brep->m_E[ei].ProxyCurve())
+        continue;
+      ON_3dPoint Q;
+      if (Internal_BrepEdgeClosestPoint(brep->m_E[ei], P, Q))
+      {
+        const double d = P.DistanceTo(Q);
+        if (d < best_d)
+        {
+          best_d = d;
+          closest_point = Q;
+        }
+      }
+    }
+  }
+
+  return (best_d < ON_DBL_MAX);
+}
+
+class ON_Internal_BrepNearestComponent
+{
+public:
+  const ON_Brep* m_brep = nullptr;
+  ON_3dPoint m_point = ON_3dPoint::NanPoint;
+  ON_RTreeSphere m_sphere;
+  ON_COMPONENT_INDEX::TYPE m_type = ON_COMPONENT_INDEX::invalid_type;
+
+  ON_COMPONENT_INDEX m_ci = ON_COMPONENT_INDEX::UnsetComponentIndex;
+  ON_3dPoint m_closest_point = ON_3dPoint::NanPoint;
+  double m_distance = ON_DBL_MAX;
+
+  static bool ON_CALLBACK_CDECL Callback(void* context, ON__INT_PTR id)
+  {
+    ON_Internal_BrepNearestComponent* nearest = (ON_Internal_BrepNearestComponent*)context;
+    const ON_Brep* brep = nearest->m_brep;
+    const ON_3dPoint& P = nearest->m_point;
+    const int i = (int)id;
+    ON_3dPoint Q = ON_3dPoint::NanPoint;
+    switch (nearest->m_type)
+    {
+    case ON_COMPONENT_INDEX::brep_vertex:
+      if (i < brep->m_V.Count() && brep->m_V[i].m_vertex_index >= 0)
+        Q = brep->m_V[i].point;
+      break;
+
+    case ON_COMPONENT_INDEX::brep_edge:
+      if (i < brep->m_E.Count() && brep->m_E[i].m_edge_index >= 0)
+        Internal_BrepEdgeClosestPoint(brep->m_E[i], P, Q);
+      break;
+
+    case ON_COMPONENT_INDEX::brep_face:
+      if (i < brep->m_F.Count() && brep->m_F[i].m_face_index >= 0)
+      {
+        const ON_BrepFace& face = brep->m_F[i];
+        const ON_Mesh* mesh = face.Mesh(ON::any_mesh);
+        if (nullptr == mesh || false == Internal_BrepFaceMeshClosestPoint(*mesh, P, Q))
+        {
+          // A face without a usable mesh gets a closest point from its
+          // surface. If that fails, the face is skipped. Its bounding box
+          // is only a lower bound on the distance and must not be used
+          // as a closest point.
+          if (false == Internal_BrepFaceClosestPoint(face, P, Q))
+            Q = ON_3dPoint::NanPoint;
+        }
+      }
+      break;
+
+    default:
+      break;
+    }
+    if (Q.IsValid())
+    {
+      const double d = P.DistanceTo(Q);
+      if (d < nearest->m_distance && d <= nearest->m_sphere.m_radius)
+      {
+        nearest->m_ci = ON_COMPONENT_INDEX(nearest->m_type, i);
+        nearest->m_closest_point = Q;
+        nearest->m_distance = d;
+        // Shrinking the sphere prunes the rest of the search.
+        nearest->m_sphere.m_radius = d;
+      }
+    }
+    return true;
+  }
+};
+
+ON_COMPONENT_INDEX ON_BrepComponentTree::NearestComponent(
+  ON_3dPoint point,
+  ON_COMPONENT_INDEX::TYPE component_type,
+  double maximum_distance,
+  ON_3dPoint* closest_point,
+  double* distance
+) const
+{
+  if (nullptr == m_brep || false == point.IsValid())
+    return ON_COMPONENT_INDEX::UnsetComponentIndex;
+
+  ON_Internal_BrepNearestComponent nearest;
+  nearest.m_brep = m_brep;
+  nearest.m_point = point;
+  nearest.m_sphere.m_point[0] = point.x;
+  nearest.m_sphere.m_point[1] = point.y;
+  nearest.m_sphere.m_point[2] = point.z;
+  if (maximum_distance > 0.0)
+  {
+    nearest.m_sphere.m_radius = maximum_distance;
+  }
+  else
+  {
+    // every component is inside this sphere
+    ON_BoundingBox bbox = m_face_tree.BoundingBox();
+    bbox.Union(m_edge_tree.BoundingBox());
+    bbox.Union(m_vertex_tree.BoundingBox());
+    if (false == bbox.IsValid())
+      return ON_COMPONENT_INDEX::UnsetComponentIndex;
+    const double r = bbox.MaximumDistanceTo(point);
+    nearest.m_sphere.m_radius = r + 1.0e-8 * (r + bbox.Diagonal().Length());
+  }
+
+  // Vertices and edges are searched first because their distances are
+  // cheaper to calculate and they shrink the search sphere.
+  const ON_RTree* trees[3] = { &m_vertex_tree, &m_edge_tree, &m_face_tree };
+  const ON_COMPONENT_INDEX::TYPE types[3] = { ON_COMPONENT_INDEX::brep_vertex, ON_COMPONENT_INDEX::brep_edge, ON_COMPONENT_INDEX::brep_face };
+  for (int i = 0; i < 3; i++)
+  {
+    if (false == Internal_SearchBrepComponentType(component_type, types[i]))
+      continue;
+    nearest.m_type = types[i];
+    trees[i]->Search(&nearest.m_sphere, ON_Internal_BrepNearestComponent::Callback, &nearest);
+  }
+
+  if (nearest.m_ci.IsSet())
+  {
+    if (nullptr != closest_point)
+      *closest_point = nearest.m_closest_point;
+    if (nullptr != distance)
+      *distance = nearest.m_distance;
+  }
+  return nearest.m_ci;
+}
+
+bool ON_Brep::HasComponentTree() const
+{
+  return (nullptr != m_component_tree.load());
+}
+
+const ON_BrepComponentTree& ON_Brep::ComponentTree() const
+{
+  ON_BrepComponentTree* tree = m_component_tree.load();
+  if (nullptr != tree && tree->IsCurrent(*this))
+    return *tree;
+
+  ON_BrepComponentTree* new_tree = new ON_BrepComponentTree();
+  new_tree->Create(*this);
+  // Other threads may be using the out of date tree, so new_tree
+  // owns it until new_tree is deleted.
+  new_tree->m_replaced_tree = tree;
+  if (m_component_tree.compare_exchange_strong(tree, new_tree))
+    return *new_tree;
+
+  // Another thread published a tree first. tree is now that tree.
+  new_tree->m_replaced_tree = nullptr;
+  delete new_tree;
+  return *tree;
+}
+
+void ON_Brep::DestroyComponentTree()
+{
+  delete m_component_tree.exchange(nullptr);
+}
@@ -151,9 +151,15 @@ bool ON_Curve::GetTightBoundingBox(
   }
 
 
-  ON_NurbsCurve N;
-  if ( 0 == GetNurbForm(N) )
-    return false;
+  ON_NurbsCurve nurbs_form;
+  const ON_NurbsCurve* nurbs_curve = ON_NurbsCurve::Cast(this);
+  if ( nullptr == nurbs_curve )
+  {
+    if ( 0 == GetNurbForm(nurbs_form) )
+      return false;
+    nurbs_curve = &nurbs_form;
+  }
+  const ON_NurbsCurve& N = *nurbs_curve;
   if ( N.m_order < 2 || N.m_cv_count < N.m_order )
     return false;
 
@@ -162,6 +168,11 @@ bool ON_Curve::GetTightBoundingBox(
   {
     if ( !(N.m_knot[span_index + N.m_order-2] < N.m_knot[span_index + N.m_order-1]) )
       continue;
+    // The span is inside the box of its control points.
+    ON_BoundingBox span_bbox;
+    if ( ON_GetPointListBoundingBox( N.m_dim, N.m_is_rat, N.m_order, N.m_cv_stride, N.CV(span_index), span_bbox, false, nullptr )
+         && ON_WorldBBoxIsInTightBBox( tight_bbox, span_bbox, xform ) )
+      continue;
     if ( !N.ConvertSpanToBezier( span_index, B ) )
       continue;
     if ( !B.GetTightBoundingBox(tight_bbox,bGrowBox,xform) )
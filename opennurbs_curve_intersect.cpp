@@ -0,0 +1,1321 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+bool ON_CurveIntersectionEvent::IsPoint() const
+{
+  return ON_CurveIntersectionEvent::Type::Point == m_type;
+}
+
+bool ON_CurveIntersectionEvent::IsOverlap() const
+{
+  return ON_CurveIntersectionEvent::Type::Overlap == m_type;
+}
+
+static void Internal_SetIntersectionTolerances(
+  double& intersection_tolerance,
+  double& overlap_tolerance
+  )
+{
+  if (!(intersection_tolerance > 0.0) || !ON_IsValid(intersection_tolerance))
+    intersection_tolerance = 0.001;
+  if (!(overlap_tolerance > 0.0) || !ON_IsValid(overlap_tolerance))
+    overlap_tolerance = 2.0 * intersection_tolerance;
+  else if (overlap_tolerance < intersection_tolerance)
+    overlap_tolerance = intersection_tolerance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Bezier spans used by the intersectors
+//
+
+enum : int
+{
+  // ON_NurbsCurveSpanCache::MaximumOrder limits the order of Bezier pieces
+  ON_Internal_XMaximumOrder = 16
+};
+
+/*
+Description:
+  A Bezier span of a curve piece. Lines are order 2 spans and arcs are
+  split into rational quadratic spans of at most 90 degrees.
+*/
+class ON_Internal_XSpan
+{
+public:
+  unsigned int m_piece_index = 0;
+  unsigned int m_cv_index = 0;
+  int m_order = 0;
+  bool m_is_rat = false;
+  bool m_bArc = false;
+  // piece parameters at span parameters 0 and 1 (angles for arc spans)
+  double m_s[2] = { 0.0, 1.0 };
+  ON_BoundingBox m_bbox = ON_BoundingBox::EmptyBoundingBox;
+};
+
+class ON_Internal_XCurve
+{
+public:
+  ON_Internal_XCurve() = default;
+  ~ON_Internal_XCurve() = default;
+
+private:
+  ON_Internal_XCurve(const ON_Internal_XCurve&) = delete;
+  ON_Internal_XCurve& operator=(const ON_Internal_XCurve&) = delete;
+
+public:
+  bool Create(const ON_Curve& curve);
+
+  const ON_CurvePieceList& Pieces() const
+  {
+    return m_query.Pieces();
+  }
+
+  const ON_4dPoint* SpanCV(const ON_Internal_XSpan& span) const
+  {
+    return m_cv.Array() + span.m_cv_index;
+  }
+
+  bool EvaluateSpan(const ON_Internal_XSpan& span, double u, int der_count, ON_3dVector* v) const
+  {
+    return ON_EvaluateBezier(3, span.m_is_rat, span.m_order, 4, &SpanCV(span)->x, 0.0, 1.0, der_count, u, 3, &v[0].x);
+  }
+
+  double CurveParameter(const ON_Internal_XSpan& span, double u) const;
+
+  ON_3dPoint PointAt(double t) const
+  {
+    return m_query.Pieces().PointAt(t);
+  }
+
+  ON_CurveClosestPointQuery m_query;
+  ON_SimpleArray<ON_Internal_XSpan> m_spans;
+  ON_SimpleArray<ON_4dPoint> m_cv;
+  ON_BoundingBox m_bbox = ON_BoundingBox::EmptyBoundingBox;
+  ON_Interval m_domain = ON_Interval::EmptyInterval;
+  bool m_bClosed = false;
+
+  // Span bounding boxes. Only used when there are many spans.
+  ON_RTree m_span_tree;
+  bool m_bSpanTree = false;
+};
+
+/*
+Returns:
+  False if a weight is not positive and the control points do not
+  bound the span.
+*/
+static bool Internal_HullBox(
+  int order,
+  bool bIsRational,
+  const ON_4dPoint* cv,
+  ON_BoundingBox& bbox
+  )
+{
+  bbox = ON_BoundingBox::EmptyBoundingBox;
+  for (int i = 0; i < order; i++)
+  {
+    if (bIsRational)
+    {
+      if (!(cv[i].w > 0.0))
+        return false;
+      bbox.Set(ON_3dPoint(cv[i].x / cv[i].w, cv[i].y / cv[i].w, cv[i].z / cv[i].w), 0 != i);
+    }
+    else
+      bbox.Set(ON_3dPoint(cv[i].x, cv[i].y, cv[i].z), 0 != i);
+  }
+  return true;
+}
+
+static ON_3dPoint Internal_XPoint(const ON_4dPoint& cv, bool bIsRational)
+{
+  return bIsRational ? ON_3dPoint(cv.x / cv.w, cv.y / cv.w, cv.z / cv.w) : ON_3dPoint(cv.x, cv.y, cv.z);
+}
+
+/*
+Description:
+  Split a homogeneous Bezier at its midpoint.
+*/
+static void Internal_XSplit(
+  int order,
+  const ON_4dPoint* cv,
+  ON_4dPoint* left,
+  ON_4dPoint* right
+  )
+{
+  memcpy(left, cv, order * sizeof(left[0]));
+  for (int j = 1; j < order; j++)
+  {
+    right[order - j] = left[order - 1];
+    for (int i = order - 1; i >= j; i--)
+    {
+      ON_4dPoint& Q = left[i];
+      const ON_4dPoint& R = left[i - 1];
+      Q.x = 0.5 * (Q.x + R.x);
+      Q.y = 0.5 * (Q.y + R.y);
+      Q.z = 0.5 * (Q.z + R.z);
+      Q.w = 0.5 * (Q.w + R.w);
+    }
+  }
+  right[0] = left[order - 1];
+}
+
+bool ON_Internal_XCurve::Create(
+  const ON_Curve& curve
+  )
+{
+  if (!m_query.Create(curve))
+    return false;
+  const ON_CurvePieceList& pieces = m_query.Pieces();
+  m_bbox = pieces.BoundingBox();
+  m_domain = pieces.Domain();
+  m_bClosed = curve.IsClosed();
+
+  const unsigned int piece_count = pieces.PieceCount();
+  m_spans.Reserve(piece_count);
+  for (unsigned int piece_index = 0; piece_index < piece_count; piece_index++)
+  {
+    const ON_CurvePiece& piece = pieces.Piece(piece_index);
+    switch (piece.m_type)
+    {
+    case ON_CurvePiece::Type::Line:
+      {
+        ON_Internal_XSpan& span = m_spans.AppendNew();
+        span.m_piece_index = piece_index;
+        span.m_cv_index = m_cv.UnsignedCount();
+        span.m_order = 2;
+        span.m_s[0] = piece.m_piece_domain.m_t[0];
+        span.m_s[1] = piece.m_piece_domain.m_t[1];
+        m_cv.Append(ON_4dPoint(piece.m_line.PointAt(span.m_s[0])));
+        m_cv.Append(ON_4dPoint(piece.m_line.PointAt(span.m_s[1])));
+      }
+      break;
+
+    case ON_CurvePiece::Type::Arc:
+      {
+        const ON_Interval angles = piece.m_piece_domain;
+        const int arc_span_count = ON_Max(1, (int)ceil(angles.Length() / (0.5 * ON_PI) - 1.0e-8));
+        const ON_3dPoint C = piece.m_arc.Center();
+        const ON_3dVector X = piece.m_arc.radius * piece.m_arc.plane.xaxis;
+        const ON_3dVector Y = piece.m_arc.radius * piece.m_arc.plane.yaxis;
+        for (int k = 0; k < arc_span_count; k++)
+        {
+          ON_Internal_XSpan& span = m_spans.AppendNew();
+          span.m_piece_index = piece_index;
+          span.m_cv_index = m_cv.UnsignedCount();
+          span.m_order = 3;
+          span.m_is_rat = true;
+          span.m_bArc = true;
+          span.m_s[0] = (0 == k) ? angles.m_t[0] : angles.ParameterAt(k / (double)arc_span_count);
+          span.m_s[1] = (k + 1 == arc_span_count) ? angles.m_t[1] : angles.ParameterAt((k + 1) / (double)arc_span_count);
+          const double half = 0.5 * (span.m_s[1] - span.m_s[0]);
+          const double mid = span.m_s[0] + half;
+          const double w = cos(half);
+          m_cv.Append(ON_4dPoint(C + cos(span.m_s[0]) * X + sin(span.m_s[0]) * Y));
+          const ON_3dPoint M = C + (cos(mid) / w) * X + (sin(mid) / w) * Y;
+          m_cv.Append(ON_4dPoint(w * M.x, w * M.y, w * M.z, w));
+          m_cv.Append(ON_4dPoint(C + cos(span.m_s[1]) * X + sin(span.m_s[1]) * Y));
+        }
+      }
+      break;
+
+    case ON_CurvePiece::Type::Bezier:
+      {
+        ON_Internal_XSpan& span = m_spans.AppendNew();
+        span.m_piece_index = piece_index;
+        span.m_cv_index = m_cv.UnsignedCount();
+        span.m_order = piece.m_order;
+        span.m_is_rat = (0 != piece.m_is_rat);
+        span.m_s[0] = 0.0;
+        span.m_s[1] = 1.0;
+        m_cv.Append(piece.m_order, pieces.BezierCV(piece_index));
+      }
+      break;
+
+    default:
+      return false;
+    }
+  }
+
+  const unsigned int span_count = m_spans.UnsignedCount();
+  for (unsigned int i = 0; i < span_count; i++)
+  {
+    ON_Internal_XSpan& span = m_spans[i];
+    if (span.m_order < 2 || span.m_order > ON_Internal_XMaximumOrder)
+      return false;
+    if (!Internal_HullBox(span.m_order, span.m_is_rat, SpanCV(span), span.m_bbox))
+      span.m_bbox = pieces.Piece(span.m_piece_index).m_bbox;
+  }
+
+  if (span_count > 8)
+  {
+    m_bSpanTree = true;
+    for (unsigned int i = 0; i < span_count && m_bSpanTree; i++)
+    {
+      const ON_BoundingBox& bbox = m_spans[i].m_bbox;
+      m_bSpanTree = m_span_tree.Insert(&bbox.m_min.x, &bbox.m_max.x, (ON__INT_PTR)i);
+    }
+    if (!m_bSpanTree)
+      m_span_tree.RemoveAll();
+  }
+
+  return true;
+}
+
+double ON_Internal_XCurve::CurveParameter(
+  const ON_Internal_XSpan& span,
+  double u
+  ) const
+{
+  const ON_CurvePiece& piece = m_query.Pieces().Piece(span.m_piece_index);
+  double s;
+  if (u <= 0.0)
+    s = span.m_s[0];
+  else if (u >= 1.0)
+    s = span.m_s[1];
+  else if (span.m_bArc)
+  {
+    // rational quadratic arc spans are not parameterized by angle
+    ON_3dVector v;
+    if (!EvaluateSpan(span, u, 0, &v))
+      return ON_UNSET_VALUE;
+    const ON_3dVector V = ON_3dPoint(v) - piece.m_arc.Center();
+    s = atan2(V * piece.m_arc.plane.yaxis, V * piece.m_arc.plane.xaxis);
+    const double mid = 0.5 * (span.m_s[0] + span.m_s[1]);
+    s += 2.0 * ON_PI * floor((mid - s) / (2.0 * ON_PI) + 0.5);
+    if (s < span.m_s[0])
+      s = span.m_s[0];
+    else if (s > span.m_s[1])
+      s = span.m_s[1];
+  }
+  else
+    s = span.m_s[0] + u * (span.m_s[1] - span.m_s[0]);
+  return piece.CurveParameter(s);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Curve-curve intersection
+//
+
+class ON_Internal_XCandidate
+{
+public:
+  double m_a;
+  double m_b;
+  double m_distance;
+};
+
+static int Internal_CompareXCandidate(const ON_Internal_XCandidate* x, const ON_Internal_XCandidate* y)
+{
+  if (x->m_a < y->m_a)
+    return -1;
+  if (x->m_a > y->m_a)
+    return 1;
+  if (x->m_b < y->m_b)
+    return -1;
+  if (x->m_b > y->m_b)
+    return 1;
+  return 0;
+}
+
+class ON_Internal_XNode
+{
+public:
+  ON_4dPoint m_a[ON_Internal_XMaximumOrder];
+  ON_4dPoint m_b[ON_Internal_XMaximumOrder];
+  double m_u[2];
+  double m_v[2];
+  int m_depth;
+};
+
+/*
+Returns:
+  True if the span is nearly straight. chord is set to the line from
+  the first to the last control point.
+*/
+static bool Internal_IsFlat(
+  int order,
+  bool bIsRational,
+  const ON_4dPoint* cv,
+  double tolerance,
+  ON_Line& chord
+  )
+{
+  chord.from = Internal_XPoint(cv[0], bIsRational);
+  chord.to = Internal_XPoint(cv[order - 1], bIsRational);
+  double polygon = 0.0;
+  ON_3dPoint P = chord.from;
+  for (int i = 1; i < order; i++)
+  {
+    const ON_3dPoint Q = Internal_XPoint(cv[i], bIsRational);
+    polygon += P.DistanceTo(Q);
+    P = Q;
+  }
+  return (polygon <= tolerance || polygon <= (1.0 + 1.0e-3) * chord.Length());
+}
+
+static double Internal_ChordParameter(const ON_Line& chord, const ON_3dPoint& P)
+{
+  double x = 0.5;
+  if (!chord.ClosestPointTo(P, &x) || !(x == x))
+    return 0.5;
+  return ON_Max(0.0, ON_Min(1.0, x));
+}
+
+/*
+Description:
+  Gauss-Newton iteration for a local minimum of |A(u) - B(v)| with (u,v)
+  clamped to [0,1]x[0,1].
+Returns:
+  The distance between A(u) and B(v).
+*/
+static double Internal_XNewton(
+  const ON_Internal_XCurve& A,
+  const ON_Internal_XSpan& sa,
+  const ON_Internal_XCurve& B,
+  const ON_Internal_XSpan& sb,
+  double* u,
+  double* v
+  )
+{
+  ON_3dVector a[2], b[2];
+  if (!A.EvaluateSpan(sa, *u, 1, a) || !B.EvaluateSpan(sb, *v, 1, b))
+    return ON_DBL_MAX;
+  ON_3dVector R = a[0] - b[0];
+  double distance = R.Length();
+
+  ON_3dVector a1[2], b1[2];
+  for (int iteration = 0; iteration < 32 && distance > 0.0; iteration++)
+  {
+    double a11 = a[1] * a[1];
+    const double a12 = -(a[1] * b[1]);
+    double a22 = b[1] * b[1];
+    const double damping = 1.0e-12 * (a11 + a22);
+    a11 += damping;
+    a22 += damping;
+    const double det = a11 * a22 - a12 * a12;
+    if (!(det > 0.0))
+      break;
+    const double r1 = -(a[1] * R);
+    const double r2 = b[1] * R;
+    double du = (r1 * a22 - a12 * r2) / det;
+    double dv = (a11 * r2 - a12 * r1) / det;
+
+    bool bImproved = false;
+    double u1 = *u, v1 = *v, distance1 = distance;
+    for (int halving = 0; halving < 8; halving++)
+    {
+      u1 = ON_Max(0.0, ON_Min(1.0, *u + du));
+      v1 = ON_Max(0.0, ON_Min(1.0, *v + dv));
+      if (u1 == *u && v1 == *v)
+        break;
+      if (!A.EvaluateSpan(sa, u1, 1, a1) || !B.EvaluateSpan(sb, v1, 1, b1))
+        return distance;
+      distance1 = (a1[0] - b1[0]).Length();
+      if (distance1 < distance)
+      {
+        bImproved = true;
+        break;
+      }
+      du *= 0.5;
+      dv *= 0.5;
+    }
+    if (!bImproved)
+      break;
+    const double step = fabs(u1 - *u) + fabs(v1 - *v);
+    *u = u1;
+    *v = v1;
+    distance = distance1;
+    a[0] = a1[0]; a[1] = a1[1];
+    b[0] = b1[0]; b[1] = b1[1];
+    R = a[0] - b[0];
+    if (step <= 8.0 * ON_EPSILON)
+      break;
+  }
+  return distance;
+}
+
+static void Internal_AddXCandidate(
+  const ON_Internal_XCurve& A,
+  const ON_Internal_XSpan& sa,
+  const ON_Internal_XCurve& B,
+  const ON_Internal_XSpan& sb,
+  double u,
+  double v,
+  double intersection_tolerance,
+  ON_SimpleArray<ON_Internal_XCandidate>& candidates
+  )
+{
+  const double distance = Internal_XNewton(A, sa, B, sb, &u, &v);
+  if (!(distance <= intersection_tolerance))
+    return;
+  ON_Internal_XCandidate& x = candidates.AppendNew();
+  x.m_a = A.CurveParameter(sa, u);
+  x.m_b = B.CurveParameter(sb, v);
+  x.m_distance = distance;
+}
+
+/*
+Description:
+  Find intersection candidates of two Bezier spans by subdivision.
+  Pairs of subspans whose control point boxes are farther apart than
+  the tolerance are culled. When both subspans are nearly straight,
+  the intersection of their chords seeds Internal_XNewton().
+*/
+static void Internal_IntersectXSpans(
+  const ON_Internal_XCurve& A,
+  const ON_Internal_XSpan& sa,
+  const ON_Internal_XCurve& B,
+  const ON_Internal_XSpan& sb,
+  double intersection_tolerance,
+  ON_SimpleArray<ON_Internal_XNode>& stack,
+  ON_SimpleArray<ON_Internal_XCandidate>& candidates
+  )
+{
+  const int max_depth = 40;
+  const int order_a = sa.m_order;
+  const int order_b = sb.m_order;
+
+  stack.SetCount(0);
+  ON_Internal_XNode& root = stack.AppendNew();
+  memcpy(root.m_a, A.SpanCV(sa), order_a * sizeof(root.m_a[0]));
+  memcpy(root.m_b, B.SpanCV(sb), order_b * sizeof(root.m_b[0]));
+  root.m_u[0] = 0.0;
+  root.m_u[1] = 1.0;
+  root.m_v[0] = 0.0;
+  root.m_v[1] = 1.0;
+  root.m_depth = 0;
+
+  ON_Internal_XNode node;
+  while (stack.Count() > 0)
+  {
+    node = *stack.Last();
+    stack.Remove();
+
+    ON_BoundingBox bbox_a, bbox_b;
+    const bool bHullA = Internal_HullBox(order_a, sa.m_is_rat, node.m_a, bbox_a);
+    const bool bHullB = Internal_HullBox(order_b, sb.m_is_rat, node.m_b, bbox_b);
+    if (bHullA && bHullB && bbox_a.MinimumDistanceTo(bbox_b) > intersection_tolerance)
+      continue;
+
+    ON_Line chord_a, chord_b;
+    const bool bFlatA = bHullA && Internal_IsFlat(order_a, sa.m_is_rat, node.m_a, intersection_tolerance, chord_a);
+    const bool bFlatB = bHullB && Internal_IsFlat(order_b, sb.m_is_rat, node.m_b, intersection_tolerance, chord_b);
+
+    if ((bFlatA && bFlatB) || node.m_depth >= max_depth)
+    {
+      if (!bFlatA || !bFlatB)
+      {
+        chord_a.from = Internal_XPoint(node.m_a[0], sa.m_is_rat);
+        chord_a.to = Internal_XPoint(node.m_a[order_a - 1], sa.m_is_rat);
+        chord_b.from = Internal_XPoint(node.m_b[0], sb.m_is_rat);
+        chord_b.to = Internal_XPoint(node.m_b[order_b - 1], sb.m_is_rat);
+      }
+      const double du = node.m_u[1] - node.m_u[0];
+      const double dv = node.m_v[1] - node.m_v[0];
+      double x = 0.5, y = 0.5;
+      bool bParallel = true;
+      if (ON_IntersectLineLine(chord_a, chord_b, &x, &y, 0.0, true))
+      {
+        Internal_AddXCandidate(A, sa, B, sb, node.m_u[0] + x * du, node.m_v[0] + y * dv, intersection_tolerance, candidates);
+        const ON_3dVector Ta = chord_a.Tangent();
+        const ON_3dVector Tb = chord_b.Tangent();
+        bParallel = (fabs(Ta * Tb) >= 0.999 || Ta.IsZero() || Tb.IsZero());
+      }
+      if (bParallel)
+      {
+        // Overlapping or tangent pieces: seed from the chord ends.
+        Internal_AddXCandidate(A, sa, B, sb, node.m_u[0], node.m_v[0] + Internal_ChordParameter(chord_b, chord_a.from) * dv, intersection_tolerance, candidates);
+        Internal_AddXCandidate(A, sa, B, sb, node.m_u[1], node.m_v[0] + Internal_ChordParameter(chord_b, chord_a.to) * dv, intersection_tolerance, candidates);
+        Internal_AddXCandidate(A, sa, B, sb, node.m_u[0] + Internal_ChordParameter(chord_a, chord_b.from) * du, node.m_v[0], intersection_tolerance, candidates);
+        Internal_AddXCandidate(A, sa, B, sb, node.m_u[0] + Internal_ChordParameter(chord_a, chord_b.to) * du, node.m_v[1], intersection_tolerance, candidates);
+      }
+      continue;
+    }
+
+    // split the subspan that is not flat, or the larger one
+    const bool bSplitA = !bFlatA && (bFlatB || !bHullA || !bHullB || bbox_a.Diagonal().Length() >= bbox_b.Diagonal().Length());
+    stack.AppendNew();
+    stack.AppendNew();
+    ON_Internal_XNode* children[2] = { &stack[stack.Count() - 2], &stack[stack.Count() - 1] };
+    for (int k = 0; k < 2; k++)
+    {
+      *children[k] = node;
+      children[k]->m_depth = node.m_depth + 1;
+    }
+    if (bSplitA)
+    {
+      Internal_XSplit(order_a, node.m_a, children[0]->m_a, children[1]->m_a);
+      const double um = 0.5 * (node.m_u[0] + node.m_u[1]);
+      children[0]->m_u[1] = um;
+      children[1]->m_u[0] = um;
+    }
+    else
+    {
+      Internal_XSplit(order_b, node.m_b, children[0]->m_b, children[1]->m_b);
+      const double vm = 0.5 * (node.m_v[0] + node.m_v[1]);
+      children[0]->m_v[1] = vm;
+      children[1]->m_v[0] = vm;
+    }
+  }
+}
+
+/*
+Returns:
+  True if curve B stays within tolerance of curve A between the
+  candidates x0 and x1.
+*/
+static bool Internal_IsXOverlap(
+  const ON_Internal_XCurve& A,
+  const ON_Internal_XCurve& B,
+  const ON_Internal_XCandidate& x0,
+  const ON_Internal_XCandidate& x1,
+  double overlap_tolerance,
+  double* b1
+  )
+{
+  if (!(x0.m_a < x1.m_a))
+    return false;
+
+  const int sample_count = 8;
+  // midpoint first
+  const int samples[sample_count - 1] = { 4, 2, 6, 1, 3, 5, 7 };
+  for (int i = 0; i < sample_count - 1; i++)
+  {
+    const double a = x0.m_a + (samples[i] / (double)sample_count) * (x1.m_a - x0.m_a);
+    double b;
+    if (!B.m_query.GetClosestPoint(A.PointAt(a), overlap_tolerance, &b))
+      return false;
+  }
+
+  // When B is closed the overlap may cross the seam of B.
+  double db = x1.m_b - x0.m_b;
+  const double period = B.m_domain.Length();
+  for (int pass = 0; pass < (B.m_bClosed ? 2 : 1); pass++)
+  {
+    if (1 == pass)
+      db = (db > 0.0) ? (db - period) : (db + period);
+    bool bOverlap = true;
+    for (int i = 0; i < sample_count - 1 && bOverlap; i++)
+    {
+      double b = x0.m_b + (samples[i] / (double)sample_count) * db;
+      if (b < B.m_domain.m_t[0])
+        b += period;
+      else if (b > B.m_domain.m_t[1])
+        b -= period;
+      double a;
+      bOverlap = A.m_query.GetClosestPoint(B.PointAt(b), overlap_tolerance, &a);
+    }
+    if (bOverlap)
+    {
+      *b1 = x1.m_b;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void Internal_AppendXEvent(
+  const ON_Internal_XCurve& A,
+  const ON_Internal_XCurve& B,
+  const ON_Internal_XCandidate& x0,
+  const ON_Internal_XCandidate& x1,
+  bool bOverlap,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  )
+{
+  ON_CurveIntersectionEvent e;
+  e.m_type = bOverlap ? ON_CurveIntersectionEvent::Type::Overlap : ON_CurveIntersectionEvent::Type::Point;
+  e.m_a[0] = x0.m_a;
+  e.m_a[1] = x1.m_a;
+  e.m_b[0] = x0.m_b;
+  e.m_b[1] = x1.m_b;
+  e.m_A[0] = A.PointAt(e.m_a[0]);
+  e.m_B[0] = B.PointAt(e.m_b[0]);
+  e.m_A[1] = bOverlap ? A.PointAt(e.m_a[1]) : e.m_A[0];
+  e.m_B[1] = bOverlap ? B.PointAt(e.m_b[1]) : e.m_B[0];
+  events.Append(e);
+}
+
+static unsigned int Internal_IntersectXCurves(
+  const ON_Internal_XCurve& A,
+  const ON_Internal_XCurve& B,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  )
+{
+  if (A.m_bbox.MinimumDistanceTo(B.m_bbox) > intersection_tolerance)
+    return 0;
+
+  // pairs of spans with nearby bounding boxes
+  ON_SimpleArray<ON_2dex> span_pairs;
+  if (A.m_bSpanTree && B.m_bSpanTree)
+  {
+    ON_RTree::Search(A.m_span_tree, B.m_span_tree, intersection_tolerance, span_pairs);
+    span_pairs.QuickSort(ON_Compare2dex);
+  }
+  else
+  {
+    for (int i = 0; i < A.m_spans.Count(); i++)
+    {
+      if (B.m_bbox.MinimumDistanceTo(A.m_spans[i].m_bbox) > intersection_tolerance)
+        continue;
+      for (int j = 0; j < B.m_spans.Count(); j++)
+      {
+        if (A.m_spans[i].m_bbox.MinimumDistanceTo(B.m_spans[j].m_bbox) <= intersection_tolerance)
+          span_pairs.Append(ON_2dex(i, j));
+      }
+    }
+  }
+
+  ON_SimpleArray<ON_Internal_XCandidate> candidates;
+  ON_SimpleArray<ON_Internal_XNode> stack;
+  for (int k = 0; k < span_pairs.Count(); k++)
+    Internal_IntersectXSpans(A, A.m_spans[span_pairs[k].i], B, B.m_spans[span_pairs[k].j], intersection_tolerance, stack, candidates);
+
+  // curve ends near the other curve
+  for (int end = 0; end < 2; end++)
+  {
+    double t, d;
+    const double a = A.m_domain.m_t[end];
+    if (B.m_query.GetClosestPoint(A.PointAt(a), intersection_tolerance, &t, nullptr, &d) && d <= intersection_tolerance)
+    {
+      ON_Internal_XCandidate& x = candidates.AppendNew();
+      x.m_a = a;
+      x.m_b = t;
+      x.m_distance = d;
+    }
+    const double b = B.m_domain.m_t[end];
+    if (A.m_query.GetClosestPoint(B.PointAt(b), intersection_tolerance, &t, nullptr, &d) && d <= intersection_tolerance)
+    {
+      ON_Internal_XCandidate& x = candidates.AppendNew();
+      x.m_a = t;
+      x.m_b = b;
+      x.m_distance = d;
+    }
+  }
+
+  if (candidates.Count() <= 0)
+    return 0;
+
+  // Sort along A and remove duplicates. Candidates that are at the same
+  // place on both curves are the same intersection.
+  candidates.QuickSort(Internal_CompareXCandidate);
+  int count = 1;
+  ON_3dPoint PA = A.PointAt(candidates[0].m_a);
+  ON_3dPoint PB = B.PointAt(candidates[0].m_b);
+  for (int i = 1; i < candidates.Count(); i++)
+  {
+    const ON_Internal_XCandidate& x = candidates[i];
+    const ON_3dPoint QA = A.PointAt(x.m_a);
+    const ON_3dPoint QB = B.PointAt(x.m_b);
+    if (PA.DistanceTo(QA) <= intersection_tolerance && PB.DistanceTo(QB) <= intersection_tolerance)
+    {
+      if (x.m_distance < candidates[count - 1].m_distance)
+      {
+        candidates[count - 1] = x;
+        PA = QA;
+        PB = QB;
+      }
+      continue;
+    }
+    candidates[count++] = x;
+    PA = QA;
+    PB = QB;
+  }
+  candidates.SetCount(count);
+
+  // Consecutive candidates with the curves within overlap_tolerance of
+  // each other between them are parts of an overlap.
+  const unsigned int event_count0 = events.UnsignedCount();
+  for (int i = 0; i < count; /*empty*/)
+  {
+    int j = i;
+    double b1;
+    while (j + 1 < count && Internal_IsXOverlap(A, B, candidates[j], candidates[j + 1], overlap_tolerance, &b1))
+      j++;
+    Internal_AppendXEvent(A, B, candidates[i], candidates[j], j > i, events);
+    i = j + 1;
+  }
+  return events.UnsignedCount() - event_count0;
+}
+
+unsigned int ON_IntersectCurveCurve(
+  const ON_Curve& curveA,
+  const ON_Curve& curveB,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  )
+{
+  Internal_SetIntersectionTolerances(intersection_tolerance, overlap_tolerance);
+  ON_Internal_XCurve A, B;
+  if (!A.Create(curveA) || !B.Create(curveB))
+    return 0;
+  return Internal_IntersectXCurves(A, B, intersection_tolerance, overlap_tolerance, events);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Curve-plane intersection
+//
+
+class ON_Internal_XPlaneNode
+{
+public:
+  // homogeneous signed distances and weights of the control points
+  double m_e[ON_Internal_XMaximumOrder];
+  double m_w[ON_Internal_XMaximumOrder];
+  double m_u[2];
+  int m_depth;
+};
+
+static void Internal_XPlaneSplit(
+  int order,
+  const double* e,
+  double* left,
+  double* right
+  )
+{
+  memcpy(left, e, order * sizeof(left[0]));
+  for (int j = 1; j < order; j++)
+  {
+    right[order - j] = left[order - 1];
+    for (int i = order - 1; i >= j; i--)
+      left[i] = 0.5 * (left[i - 1] + left[i]);
+  }
+  right[0] = left[order - 1];
+}
+
+/*
+Description:
+  Find the root of the polynomial with Bezier coefficients e[] in
+  (u0,u1) when e(u0) and e(u1) have opposite signs. Newton steps that
+  leave the bracket are replaced by bisection.
+*/
+static double Internal_XPlaneRoot(
+  int order,
+  const double* e,
+  double u0,
+  double u1
+  )
+{
+  double v[2];
+  ON_EvaluateBezier(1, false, order, 1, e, 0.0, 1.0, 0, u0, 1, v);
+  const double e0 = v[0];
+  double lo = u0, hi = u1;
+  const bool bIncreasing = (e0 < 0.0);
+  double u = 0.5 * (lo + hi);
+  for (int iteration = 0; iteration < 100; iteration++)
+  {
+    if (!ON_EvaluateBezier(1, false, order, 1, e, 0.0, 1.0, 1, u, 1, v))
+      break;
+    if (0.0 == v[0])
+      return u;
+    if ((v[0] < 0.0) == bIncreasing)
+      lo = u;
+    else
+      hi = u;
+    if (!(hi - lo > 2.0 * ON_EPSILON * (fabs(lo) + fabs(hi))))
+      break;
+    double next = (0.0 != v[1]) ? (u - v[0] / v[1]) : lo;
+    if (!(next > lo && next < hi))
+      next = 0.5 * (lo + hi);
+    if (next == u)
+      break;
+    u = next;
+  }
+  return u;
+}
+
+/*
+Description:
+  Newton iteration for a local minimum of the distance from the span
+  to the plane, with u clamped to [0,1].
+Returns:
+  The distance from the span at u to the plane.
+*/
+static double Internal_XPlaneNewton(
+  const ON_Internal_XCurve& C,
+  const ON_Internal_XSpan& span,
+  const ON_PlaneEquation& plane_equation,
+  double* u
+  )
+{
+  const ON_3dVector N(plane_equation.x, plane_equation.y, plane_equation.z);
+  ON_3dVector v[3];
+  if (!C.EvaluateSpan(span, *u, 2, v))
+    return ON_DBL_MAX;
+  double d = plane_equation.ValueAt(ON_3dPoint(v[0]));
+  for (int iteration = 0; iteration < 32 && 0.0 != d; iteration++)
+  {
+    // minimize d(u)^2
+    const double d1 = N * v[1];
+    const double d2 = N * v[2];
+    double h = d1 * d1 + d * d2;
+    if (!(h > 0.0))
+      h = d1 * d1;
+    if (!(h > 0.0))
+      break;
+    double du = -d * d1 / h;
+    bool bImproved = false;
+    double u1 = *u, e = d;
+    for (int halving = 0; halving < 8; halving++)
+    {
+      u1 = ON_Max(0.0, ON_Min(1.0, *u + du));
+      if (u1 == *u)
+        break;
+      if (!C.EvaluateSpan(span, u1, 2, v))
+        return fabs(d);
+      e = plane_equation.ValueAt(ON_3dPoint(v[0]));
+      if (fabs(e) < fabs(d))
+      {
+        bImproved = true;
+        break;
+      }
+      du *= 0.5;
+    }
+    if (!bImproved)
+      break;
+    const double step = fabs(u1 - *u);
+    *u = u1;
+    d = e;
+    if (step <= 4.0 * ON_EPSILON)
+      break;
+  }
+  return fabs(d);
+}
+
+static void Internal_AddXPlaneCandidate(
+  const ON_Internal_XCurve& C,
+  const ON_Internal_XSpan& span,
+  const ON_PlaneEquation& plane_equation,
+  double u,
+  double intersection_tolerance,
+  ON_SimpleArray<ON_Internal_XCandidate>& candidates
+  )
+{
+  const double distance = Internal_XPlaneNewton(C, span, plane_equation, &u);
+  if (!(distance <= intersection_tolerance))
+    return;
+  ON_Internal_XCandidate& x = candidates.AppendNew();
+  x.m_a = C.CurveParameter(span, u);
+  x.m_b = ON_UNSET_VALUE;
+  x.m_distance = distance;
+}
+
+static unsigned int Internal_IntersectXCurvePlane(
+  const ON_Internal_XCurve& C,
+  const ON_Plane& plane,
+  const ON_PlaneEquation& plane_equation,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  )
+{
+  if (C.m_bbox.MinimumDistanceTo(plane_equation) > intersection_tolerance)
+    return 0;
+
+  const int max_depth = 30;
+  ON_SimpleArray<ON_Internal_XCandidate> candidates;
+  ON_SimpleArray<ON_Internal_XPlaneNode> stack;
+  double root_e[ON_Internal_XMaximumOrder];
+
+  const int span_count = C.m_spans.Count();
+  for (int span_index = 0; span_index < span_count; span_index++)
+  {
+    const ON_Internal_XSpan& span = C.m_spans[span_index];
+    if (span.m_bbox.MinimumDistanceTo(plane_equation) > intersection_tolerance)
+      continue;
+    const int order = span.m_order;
+    const ON_4dPoint* cv = C.SpanCV(span);
+
+    stack.SetCount(0);
+    ON_Internal_XPlaneNode& root = stack.AppendNew();
+    for (int i = 0; i < order; i++)
+    {
+      root.m_e[i] = plane_equation.x * cv[i].x + plane_equation.y * cv[i].y + plane_equation.z * cv[i].z + plane_equation.d * cv[i].w;
+      root.m_w[i] = cv[i].w;
+      root_e[i] = root.m_e[i];
+    }
+    root.m_u[0] = 0.0;
+    root.m_u[1] = 1.0;
+    root.m_depth = 0;
+
+    ON_Internal_XPlaneNode node;
+    while (stack.Count() > 0)
+    {
+      node = *stack.Last();
+      stack.Remove();
+
+      // The distances from the span to the plane are convex combinations
+      // of the control point distances e[i]/w[i].
+      bool bHull = true;
+      bool bAbove = true, bBelow = true, bInside = true;
+      int sign_changes = 0;
+      int previous_sign = 0;
+      for (int i = 0; i < order; i++)
+      {
+        if (!(node.m_w[i] > 0.0))
+        {
+          bHull = false;
+          break;
+        }
+        const double d = node.m_e[i] / node.m_w[i];
+        if (!(d > intersection_tolerance))
+          bAbove = false;
+        if (!(d < -intersection_tolerance))
+          bBelow = false;
+        if (!(fabs(d) <= overlap_tolerance))
+          bInside = false;
+        const int sign = (node.m_e[i] > 0.0) ? 1 : ((node.m_e[i] < 0.0) ? -1 : 0);
+        if (0 != sign)
+        {
+          if (0 != previous_sign && sign != previous_sign)
+            sign_changes++;
+          previous_sign = sign;
+        }
+      }
+
+      if (bHull)
+      {
+        if (bAbove || bBelow)
+          continue;
+        if (bInside)
+        {
+          // The subspan is close to the plane. Local minima of the
+          // distance are candidates and the overlap test below decides
+          // if they are parts of an overlap.
+          Internal_AddXPlaneCandidate(C, span, plane_equation, node.m_u[0], intersection_tolerance, candidates);
+          Internal_AddXPlaneCandidate(C, span, plane_equation, 0.5 * (node.m_u[0] + node.m_u[1]), intersection_tolerance, candidates);
+          Internal_AddXPlaneCandidate(C, span, plane_equation, node.m_u[1], intersection_tolerance, candidates);
+          continue;
+        }
+        const double e0 = node.m_e[0];
+        const double e1 = node.m_e[order - 1];
+        if (sign_changes <= 1 && e0 * e1 < 0.0)
+        {
+          // exactly one transverse root
+          const double u = Internal_XPlaneRoot(order, root_e, node.m_u[0], node.m_u[1]);
+          ON_Internal_XCandidate& x = candidates.AppendNew();
+          x.m_a = C.CurveParameter(span, u);
+          x.m_b = ON_UNSET_VALUE;
+          x.m_distance = 0.0;
+          continue;
+        }
+        if (0 == sign_changes && (0.0 == e0 || 0.0 == e1))
+        {
+          // The span ends on the plane and the interior is on one side.
+          for (int end = 0; end < 2; end++)
+          {
+            if (0.0 != (end ? e1 : e0))
+              continue;
+            ON_Internal_XCandidate& x = candidates.AppendNew();
+            x.m_a = C.CurveParameter(span, node.m_u[end]);
+            x.m_b = ON_UNSET_VALUE;
+            x.m_distance = 0.0;
+          }
+          continue;
+        }
+      }
+      if (node.m_depth >= max_depth)
+      {
+        Internal_AddXPlaneCandidate(C, span, plane_equation, 0.5 * (node.m_u[0] + node.m_u[1]), intersection_tolerance, candidates);
+        continue;
+      }
+
+      stack.AppendNew();
+      stack.AppendNew();
+      ON_Internal_XPlaneNode* children[2] = { &stack[stack.Count() - 2], &stack[stack.Count() - 1] };
+      Internal_XPlaneSplit(order, node.m_e, children[0]->m_e, children[1]->m_e);
+      Internal_XPlaneSplit(order, node.m_w, children[0]->m_w, children[1]->m_w);
+      const double um = 0.5 * (node.m_u[0] + node.m_u[1]);
+      children[0]->m_u[0] = node.m_u[0];
+      children[0]->m_u[1] = um;
+      children[1]->m_u[0] = um;
+      children[1]->m_u[1] = node.m_u[1];
+      children[0]->m_depth = children[1]->m_depth = node.m_depth + 1;
+    }
+  }
+
+  if (candidates.Count() <= 0)
+    return 0;
+
+  // Sort along the curve and remove duplicates.
+  candidates.QuickSort(Internal_CompareXCandidate);
+  int count = 1;
+  ON_3dPoint P = C.PointAt(candidates[0].m_a);
+  for (int i = 1; i < candidates.Count(); i++)
+  {
+    const ON_Internal_XCandidate& x = candidates[i];
+    const ON_3dPoint Q = C.PointAt(x.m_a);
+    if (P.DistanceTo(Q) <= intersection_tolerance)
+    {
+      if (x.m_distance < candidates[count - 1].m_distance)
+      {
+        candidates[count - 1] = x;
+        P = Q;
+      }
+      continue;
+    }
+    candidates[count++] = x;
+    P = Q;
+  }
+  candidates.SetCount(count);
+
+  // Consecutive candidates with the curve within overlap_tolerance of the
+  // plane between them are parts of an overlap.
+  const unsigned int event_count0 = events.UnsignedCount();
+  for (int i = 0; i < count; /*empty*/)
+  {
+    int j = i;
+    while (j + 1 < count && candidates[j].m_a < candidates[j + 1].m_a)
+    {
+      const int sample_count = 8;
+      const int samples[sample_count - 1] = { 4, 2, 6, 1, 3, 5, 7 };
+      bool bOverlap = true;
+      for (int k = 0; k < sample_count - 1 && bOverlap; k++)
+      {
+        const double t = candidates[j].m_a + (samples[k] / (double)sample_count) * (candidates[j + 1].m_a - candidates[j].m_a);
+        bOverlap = fabs(plane_equation.ValueAt(C.PointAt(t))) <= overlap_tolerance;
+      }
+      if (!bOverlap)
+        break;
+      j++;
+    }
+    ON_CurveIntersectionEvent e;
+    e.m_type = (j > i) ? ON_CurveIntersectionEvent::Type::Overlap : ON_CurveIntersectionEvent::Type::Point;
+    e.m_a[0] = candidates[i].m_a;
+    e.m_a[1] = candidates[j].m_a;
+    e.m_A[0] = C.PointAt(e.m_a[0]);
+    e.m_A[1] = (j > i) ? C.PointAt(e.m_a[1]) : e.m_A[0];
+    e.m_B[0] = plane.ClosestPointTo(e.m_A[0]);
+    e.m_B[1] = plane.ClosestPointTo(e.m_A[1]);
+    events.Append(e);
+    i = j + 1;
+  }
+  return events.UnsignedCount() - event_count0;
+}
+
+unsigned int ON_IntersectCurvePlane(
+  const ON_Curve& curve,
+  const ON_Plane& plane,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  )
+{
+  Internal_SetIntersectionTolerances(intersection_tolerance, overlap_tolerance);
+  ON_PlaneEquation plane_equation;
+  if (!plane_equation.Create(plane.origin, plane.zaxis) || !plane_equation.IsValid())
+    return 0;
+  ON_Internal_XCurve C;
+  if (!C.Create(curve))
+    return 0;
+  return Internal_IntersectXCurvePlane(C, plane, plane_equation, intersection_tolerance, overlap_tolerance, events);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Batch intersectors
+//
+
+class ON_Internal_XBatchContext
+{
+public:
+  const ON_Curve* const* m_curves = nullptr;
+  ON_Internal_XCurve** m_xcurves = nullptr;
+  const ON_2dex* m_pairs = nullptr;
+  ON_SimpleArray<ON_CurveIntersectionEvent>* m_events = nullptr;
+  const ON_Plane* m_plane = nullptr;
+  ON_PlaneEquation m_plane_equation;
+  double m_intersection_tolerance = 0.0;
+  double m_overlap_tolerance = 0.0;
+};
+
+static void Internal_CreateXCurvesRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+  )
+{
+  const ON_Internal_XBatchContext* ctx = (const ON_Internal_XBatchContext*)context;
+  for (size_t i = i0; i < i1; i++)
+  {
+    if (nullptr == ctx->m_curves[i])
+      continue;
+    ON_Internal_XCurve* xcurve = new ON_Internal_XCurve();
+    if (xcurve->Create(*ctx->m_curves[i]))
+      ctx->m_xcurves[i] = xcurve;
+    else
+      delete xcurve;
+  }
+}
+
+static void Internal_IntersectXCurvePairsRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+  )
+{
+  const ON_Internal_XBatchContext* ctx = (const ON_Internal_XBatchContext*)context;
+  for (size_t k = i0; k < i1; k++)
+  {
+    const ON_2dex& pair = ctx->m_pairs[k];
+    ON_SimpleArray<ON_CurveIntersectionEvent>& events = ctx->m_events[k];
+    Internal_IntersectXCurves(*ctx->m_xcurves[pair.i], *ctx->m_xcurves[pair.j], ctx->m_intersection_tolerance, ctx->m_overlap_tolerance, events);
+    for (int i = 0; i < events.Count(); i++)
+    {
+      events[i].m_curve_index[0] = (unsigned int)pair.i;
+      events[i].m_curve_index[1] = (unsigned int)pair.j;
+    }
+  }
+}
+
+unsigned int ON_IntersectCurves(
+  size_t curve_count,
+  const ON_Curve* const* curves,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  bool bParallel,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  )
+{
+  if (curve_count < 2 || nullptr == curves || curve_count > (size_t)ON_UNSET_UINT_INDEX)
+    return 0;
+  Internal_SetIntersectionTolerances(intersection_tolerance, overlap_tolerance);
+
+  ON_SimpleArray<ON_Internal_XCurve*> xcurves((int)curve_count);
+  xcurves.SetCount((int)curve_count);
+  xcurves.Zero();
+
+  ON_Internal_XBatchContext ctx;
+  ctx.m_curves = curves;
+  ctx.m_xcurves = xcurves.Array();
+  ctx.m_intersection_tolerance = intersection_tolerance;
+  ctx.m_overlap_tolerance = overlap_tolerance;
+  ON_ParallelFor(curve_count, 0x10, bParallel ? 0U : 1U, Internal_CreateXCurvesRange, (ON__UINT_PTR)&ctx);
+
+  // pairs of curves with nearby bounding boxes
+  ON_RTree curve_tree;
+  for (size_t i = 0; i < curve_count; i++)
+  {
+    if (nullptr != xcurves[(int)i])
+    {
+      const ON_BoundingBox& bbox = xcurves[(int)i]->m_bbox;
+      curve_tree.Insert(&bbox.m_min.x, &bbox.m_max.x, (ON__INT_PTR)i);
+    }
+  }
+  ON_SimpleArray<ON_2dex> pairs;
+  curve_tree.Search(intersection_tolerance, pairs);
+  for (int k = 0; k < pairs.Count(); k++)
+  {
+    if (pairs[k].i > pairs[k].j)
+    {
+      const int i = pairs[k].i;
+      pairs[k].i = pairs[k].j;
+      pairs[k].j = i;
+    }
+  }
+  pairs.QuickSort(ON_Compare2dex);
+
+  unsigned int event_count = 0;
+  if (pairs.Count() > 0)
+  {
+    ON_ClassArray< ON_SimpleArray<ON_CurveIntersectionEvent> > pair_events(pairs.Count());
+    pair_events.SetCount(pairs.Count());
+    ctx.m_pairs = pairs.Array();
+    ctx.m_events = pair_events.Array();
+    ON_ParallelFor(pairs.UnsignedCount(), 4, bParallel ? 0U : 1U, Internal_IntersectXCurvePairsRange, (ON__UINT_PTR)&ctx);
+    for (int k = 0; k < pair_events.Count(); k++)
+    {
+      events.Append(pair_events[k].Count(), pair_events[k].Array());
+      event_count += pair_events[k].UnsignedCount();
+    }
+  }
+
+  for (size_t i = 0; i < curve_count; i++)
+    delete xcurves[(int)i];
+  return event_count;
+}
+
+static void Internal_IntersectXCurvesPlaneRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+  )
+{
+  const ON_Internal_XBatchContext* ctx = (const ON_Internal_XBatchContext*)context;
+  for (size_t i = i0; i < i1; i++)
+  {
+    if (nullptr == ctx->m_curves[i])
+      continue;
+    ON_Internal_XCurve C;
+    if (!C.Create(*ctx->m_curves[i]))
+      continue;
+    ON_SimpleArray<ON_CurveIntersectionEvent>& events = ctx->m_events[i];
+    Internal_IntersectXCurvePlane(C, *ctx->m_plane, ctx->m_plane_equation, ctx->m_intersection_tolerance, ctx->m_overlap_tolerance, events);
+    for (int k = 0; k < events.Count(); k++)
+      events[k].m_curve_index[0] = (unsigned int)i;
+  }
+}
+
+unsigned int ON_IntersectCurvesPlane(
+  size_t curve_count,
+  const ON_Curve* const* curves,
+  const ON_Plane& plane,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  bool bParallel,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  )
+{
+  if (0 == curve_count || nullptr == curves || curve_count > (size_t)ON_UNSET_UINT_INDEX)
+    return 0;
+  Internal_SetIntersectionTolerances(intersection_tolerance, overlap_tolerance);
+
+  ON_Internal_XBatchContext ctx;
+  if (!ctx.m_plane_equation.Create(plane.origin, plane.zaxis) || !ctx.m_plane_equation.IsValid())
+    return 0;
+  ON_ClassArray< ON_SimpleArray<ON_CurveIntersectionEvent> > curve_events((int)curve_count);
+  curve_events.SetCount((int)curve_count);
+  ctx.m_curves = curves;
+  ctx.m_plane = &plane;
+  ctx.m_events = curve_events.Array();
+  ctx.m_intersection_tolerance = intersection_tolerance;
+  ctx.m_overlap_tolerance = overlap_tolerance;
+  ON_ParallelFor(curve_count, 0x10, bParallel ? 0U : 1U, Internal_IntersectXCurvesPlaneRange, (ON__UINT_PTR)&ctx);
+
+  unsigned int event_count = 0;
+  for (int i = 0; i < curve_events.Count(); i++)
+  {
+    events.Append(curve_events[i].Count(), curve_events[i].Array());
+    event_count += curve_events[i].UnsignedCount();
+  }
+  return event_count;
+}
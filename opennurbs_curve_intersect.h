@@ -0,0 +1,201 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//   Curve-curve and curve-plane intersections
+//
+////////////////////////////////////////////////////////////////
+
+#if !defined(OPENNURBS_CURVE_INTERSECT_INC_)
+#define OPENNURBS_CURVE_INTERSECT_INC_
+
+/*
+Description:
+  An intersection point or overlap found by ON_IntersectCurveCurve(),
+  ON_IntersectCurvePlane() and the batch intersectors.
+*/
+class ON_CLASS ON_CurveIntersectionEvent
+{
+public:
+  ON_CurveIntersectionEvent() = default;
+  ~ON_CurveIntersectionEvent() = default;
+  ON_CurveIntersectionEvent(const ON_CurveIntersectionEvent&) = default;
+  ON_CurveIntersectionEvent& operator=(const ON_CurveIntersectionEvent&) = default;
+
+  enum class Type : unsigned char
+  {
+    Unset = 0,
+    // The curves intersect at a point. m_a[0] = m_a[1] and m_b[0] = m_b[1].
+    Point = 1,
+    // The curves are within the overlap tolerance of each other on the
+    // intervals m_a[0] < m_a[1] and m_b[0],m_b[1].
+    Overlap = 2
+  };
+
+  Type m_type = ON_CurveIntersectionEvent::Type::Unset;
+
+  // Batch intersectors: indices of the curves in the input array.
+  // Curve-curve batches have m_curve_index[0] < m_curve_index[1].
+  // Curve-plane batches set m_curve_index[1] = ON_UNSET_UINT_INDEX.
+  unsigned int m_curve_index[2] = { ON_UNSET_UINT_INDEX, ON_UNSET_UINT_INDEX };
+
+  // Curve A parameters. m_a[0] <= m_a[1].
+  double m_a[2] = { ON_UNSET_VALUE, ON_UNSET_VALUE };
+
+  // Curve B parameters. m_b[i] is the curve B parameter of the point that
+  // matches m_a[i]. When the curves overlap with opposite orientations,
+  // m_b[0] > m_b[1]. When curve B is closed, an overlap may cross the seam
+  // of curve B. Curve-plane events have m_b[] = ON_UNSET_VALUE.
+  double m_b[2] = { ON_UNSET_VALUE, ON_UNSET_VALUE };
+
+  // m_A[i] = point on curve A at m_a[i].
+  ON_3dPoint m_A[2] = { ON_3dPoint::UnsetPoint, ON_3dPoint::UnsetPoint };
+
+  // m_B[i] = point on curve B at m_b[i] or, for curve-plane events, the
+  // point on the plane closest to m_A[i].
+  ON_3dPoint m_B[2] = { ON_3dPoint::UnsetPoint, ON_3dPoint::UnsetPoint };
+
+  bool IsPoint() const;
+  bool IsOverlap() const;
+};
+
+/*
+Description:
+  Intersect two curves.
+Parameters:
+  curveA - [in]
+  curveB - [in]
+    Any curves supported by ON_CurvePieceList. Polycurves, lines, arcs,
+    polylines and NURBS curves are decomposed into line segments, arcs
+    and Bezier spans.
+  intersection_tolerance - [in]
+    Points closer than intersection_tolerance are intersection points.
+    If <= 0.0, 0.001 is used.
+  overlap_tolerance - [in]
+    Parts of the curves that stay within overlap_tolerance of each other
+    are overlaps. If <= 0.0, 2*intersection_tolerance is used.
+  events - [out]
+    Intersection events are appended to this array and sorted by the
+    curve A parameter.
+Returns:
+  Number of events appended to events[].
+Remarks:
+  Pairs of pieces whose bounding boxes are farther apart than
+  intersection_tolerance are skipped. The remaining pairs are subdivided
+  with bounding box pruning until both parts are nearly straight.
+  The intersection of the chords seeds Newton's method.
+*/
+ON_DECL
+unsigned int ON_IntersectCurveCurve(
+  const ON_Curve& curveA,
+  const ON_Curve& curveB,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  );
+
+/*
+Description:
+  Intersect a curve and a plane.
+Parameters:
+  curve - [in]
+  plane - [in]
+  intersection_tolerance - [in]
+    If <= 0.0, 0.001 is used.
+  overlap_tolerance - [in]
+    Parts of the curve within overlap_tolerance of the plane are overlaps.
+    If <= 0.0, 2*intersection_tolerance is used.
+  events - [out]
+    Intersection events are appended to this array and sorted by the
+    curve parameter. Plane points are in m_B[].
+Returns:
+  Number of events appended to events[].
+Remarks:
+  The signed distances of the Bezier control points to the plane bound
+  the curve's distance to the plane. Spans are subdivided until they
+  are culled, lie in the plane, or have a single root, which is found
+  with a safeguarded Newton iteration.
+*/
+ON_DECL
+unsigned int ON_IntersectCurvePlane(
+  const ON_Curve& curve,
+  const ON_Plane& plane,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  );
+
+/*
+Description:
+  Intersect every pair of distinct curves in a list.
+Parameters:
+  curve_count - [in]
+  curves - [in]
+    Null curves and curves that cannot be decomposed are skipped.
+  intersection_tolerance - [in]
+  overlap_tolerance - [in]
+    See ON_IntersectCurveCurve().
+  bParallel - [in]
+    If true, curves are prepared and pairs are intersected by multiple threads.
+  events - [out]
+    Intersection events are appended to this array. m_curve_index[] identifies
+    the curves. Events are sorted by curve pair and then by the parameter on
+    the curve with the smaller index.
+Returns:
+  Number of events appended to events[].
+Remarks:
+  Each curve is decomposed once. Pairs of curves whose bounding boxes are
+  farther apart than intersection_tolerance are culled with an ON_RTree.
+  Self intersections are not computed.
+*/
+ON_DECL
+unsigned int ON_IntersectCurves(
+  size_t curve_count,
+  const ON_Curve* const* curves,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  bool bParallel,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  );
+
+/*
+Description:
+  Intersect many curves with a plane.
+Parameters:
+  curve_count - [in]
+  curves - [in]
+  plane - [in]
+  intersection_tolerance - [in]
+  overlap_tolerance - [in]
+    See ON_IntersectCurvePlane().
+  bParallel - [in]
+    If true, curves are intersected by multiple threads.
+  events - [out]
+    Intersection events are appended to this array. m_curve_index[0]
+    identifies the curve. Events are sorted by curve index and parameter.
+Returns:
+  Number of events appended to events[].
+*/
+ON_DECL
+unsigned int ON_IntersectCurvesPlane(
+  size_t curve_count,
+  const ON_Curve* const* curves,
+  const ON_Plane& plane,
+  double intersection_tolerance,
+  double overlap_tolerance,
+  bool bParallel,
+  ON_SimpleArray<ON_CurveIntersectionEvent>& events
+  );
+
+#endif
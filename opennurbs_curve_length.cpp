@@ -0,0 +1,372 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+// Bezier pieces are never split more than this many times.
+#define ON_INTERNAL_ARC_LENGTH_MAX_DEPTH 24
+
+// 8 point Gauss-Legendre abscissae and weights on [-1,1]
+static const double Internal_GaussLegendre8[4][2] =
+{
+  { 0.1834346424956498049, 0.3626837833783619830 },
+  { 0.5255324099163289858, 0.3137066458778872873 },
+  { 0.7966664774136267396, 0.2223810344533744706 },
+  { 0.9602898564975362317, 0.1012285362903762591 }
+};
+
+class ON_Internal_ArcLengthNode
+{
+public:
+  double m_t[2];
+  double m_length;
+  unsigned int m_depth;
+};
+
+bool ON_CurveArcLengthTable::Create(
+  const ON_Curve& curve,
+  double fractional_tolerance
+  )
+{
+  Destroy();
+  if (!m_pieces.Create(curve) || m_pieces.IsEmpty())
+  {
+    Destroy();
+    return false;
+  }
+  if (!(fractional_tolerance > 0.0) || !ON_IsValid(fractional_tolerance))
+    fractional_tolerance = 1.0e-8;
+
+  const unsigned int piece_count = m_pieces.PieceCount();
+  m_span_t.Reserve(piece_count + 1);
+  m_span_length.Reserve(piece_count + 1);
+  m_span_piece.Reserve(piece_count);
+  m_span_t.Append(m_pieces.Piece(0).m_curve_domain.m_t[0]);
+  m_span_length.Append(0.0);
+
+  double length = 0.0;
+  ON_SimpleArray<ON_Internal_ArcLengthNode> stack;
+  for (unsigned int i = 0; i < piece_count; i++)
+  {
+    const ON_CurvePiece& piece = m_pieces.Piece(i);
+    const ON_Interval domain = piece.m_curve_domain;
+    if (ON_CurvePiece::Type::Bezier != piece.m_type)
+    {
+      // lines and arcs have constant speed
+      length += Internal_Integrate(i, domain.m_t[0], domain.m_t[1]);
+      m_span_t.Append(domain.m_t[1]);
+      m_span_length.Append(length);
+      m_span_piece.Append(i);
+      continue;
+    }
+
+    // Depth first, left to right, so the spans are appended in order.
+    stack.SetCount(0);
+    ON_Internal_ArcLengthNode& root = stack.AppendNew();
+    root.m_t[0] = domain.m_t[0];
+    root.m_t[1] = domain.m_t[1];
+    root.m_length = Internal_Integrate(i, domain.m_t[0], domain.m_t[1]);
+    root.m_depth = 0;
+    while (stack.Count() > 0)
+    {
+      const ON_Internal_ArcLengthNode node = *stack.Last();
+      stack.Remove();
+      const double t = 0.5 * (node.m_t[0] + node.m_t[1]);
+      const double left_length = Internal_Integrate(i, node.m_t[0], t);
+      const double right_length = Internal_Integrate(i, t, node.m_t[1]);
+      const double halves_length = left_length + right_length;
+      const bool bAccept
+        = node.m_depth >= ON_INTERNAL_ARC_LENGTH_MAX_DEPTH
+        || !(t > node.m_t[0] && t < node.m_t[1])
+        || (node.m_depth > 0 && fabs(halves_length - node.m_length) <= fractional_tolerance * halves_length);
+      if (bAccept)
+      {
+        length += left_length;
+        m_span_t.Append(t);
+        m_span_length.Append(length);
+        m_span_piece.Append(i);
+        length += right_length;
+        m_span_t.Append(node.m_t[1]);
+        m_span_length.Append(length);
+        m_span_piece.Append(i);
+        continue;
+      }
+      ON_Internal_ArcLengthNode& right = stack.AppendNew();
+      right.m_t[0] = t;
+      right.m_t[1] = node.m_t[1];
+      right.m_length = right_length;
+      right.m_depth = node.m_depth + 1;
+      ON_Internal_ArcLengthNode& left = stack.AppendNew();
+      left.m_t[0] = node.m_t[0];
+      left.m_t[1] = t;
+      left.m_length = left_length;
+      left.m_depth = node.m_depth + 1;
+    }
+  }
+
+  return true;
+}
+
+void ON_CurveArcLengthTable::Destroy()
+{
+  m_pieces.Destroy();
+  m_span_t.Destroy();
+  m_span_length.Destroy();
+  m_span_piece.Destroy();
+}
+
+bool ON_CurveArcLengthTable::IsEmpty() const
+{
+  return m_span_piece.Count() <= 0;
+}
+
+const ON_CurvePieceList& ON_CurveArcLengthTable::Pieces() const
+{
+  return m_pieces;
+}
+
+ON_Interval ON_CurveArcLengthTable::Domain() const
+{
+  return IsEmpty() ? ON_Interval::EmptyInterval : ON_Interval(m_span_t[0], *m_span_t.Last());
+}
+
+double ON_CurveArcLengthTable::Length() const
+{
+  return IsEmpty() ? 0.0 : *m_span_length.Last();
+}
+
+double ON_CurveArcLengthTable::Internal_Speed(unsigned int piece_index, double t) const
+{
+  const ON_CurvePiece& piece = m_pieces.Piece(piece_index);
+  ON_3dVector v[2];
+  if (!m_pieces.EvaluatePiece(piece_index, piece.PieceParameter(t), 1, v))
+    return 0.0;
+  return v[1].Length() * fabs(piece.m_piece_domain.Length() / piece.m_curve_domain.Length());
+}
+
+double ON_CurveArcLengthTable::Internal_Integrate(unsigned int piece_index, double t0, double t1) const
+{
+  if (!(t0 < t1))
+    return 0.0;
+  const double c = 0.5 * (t0 + t1);
+  const double r = 0.5 * (t1 - t0);
+  if (ON_CurvePiece::Type::Bezier != m_pieces.Piece(piece_index).m_type)
+    return Internal_Speed(piece_index, c) * (t1 - t0);
+  double length = 0.0;
+  for (int i = 0; i < 4; i++)
+  {
+    const double x = r * Internal_GaussLegendre8[i][0];
+    length += Internal_GaussLegendre8[i][1] * (Internal_Speed(piece_index, c - x) + Internal_Speed(piece_index, c + x));
+  }
+  return r * length;
+}
+
+unsigned int ON_CurveArcLengthTable::Internal_SpanFromParameter(double t) const
+{
+  const int span_count = m_span_piece.Count();
+  int i = ON_SearchMonotoneArray(m_span_t.Array(), span_count + 1, t);
+  if (i < 0)
+    i = 0;
+  else if (i >= span_count)
+    i = span_count - 1;
+  return (unsigned int)i;
+}
+
+unsigned int ON_CurveArcLengthTable::Internal_SpanFromLength(double length, unsigned int span_hint) const
+{
+  const unsigned int span_count = m_span_piece.UnsignedCount();
+  // Increasing lengths usually land in the hint span or the next one.
+  for (unsigned int i = span_hint; i < span_count && i <= span_hint + 1; i++)
+  {
+    if (m_span_length[i] <= length && length < m_span_length[i + 1])
+      return i;
+  }
+  int i = ON_SearchMonotoneArray(m_span_length.Array(), (int)span_count + 1, length);
+  if (i < 0)
+    i = 0;
+  else if (i >= (int)span_count)
+    i = (int)span_count - 1;
+  return (unsigned int)i;
+}
+
+double ON_CurveArcLengthTable::Internal_SpanParameter(unsigned int span_index, double length) const
+{
+  const double t0 = m_span_t[span_index];
+  const double t1 = m_span_t[span_index + 1];
+  const double span_length = m_span_length[span_index + 1] - m_span_length[span_index];
+  const double target = length - m_span_length[span_index];
+  if (!(target > 0.0))
+    return t0;
+  if (!(target < span_length))
+    return t1;
+
+  // exact for lines and arcs
+  double t = t0 + (target / span_length) * (t1 - t0);
+  const unsigned int piece_index = m_span_piece[span_index];
+  if (ON_CurvePiece::Type::Bezier != m_pieces.Piece(piece_index).m_type)
+    return t;
+
+  // Newton's method on integral(t0,t) - target, kept inside a shrinking bracket.
+  const double length_tolerance = 4.0 * ON_EPSILON * Length();
+  double a = t0;
+  double b = t1;
+  for (int iteration = 0; iteration < 32; iteration++)
+  {
+    const double f = Internal_Integrate(piece_index, t0, t) - target;
+    if (fabs(f) <= length_tolerance)
+      break;
+    if (f < 0.0)
+      a = t;
+    else
+      b = t;
+    const double speed = Internal_Speed(piece_index, t);
+    double next_t = (speed > 0.0) ? (t - f / speed) : a;
+    if (!(next_t > a && next_t < b))
+      next_t = 0.5 * (a + b);
+    if (next_t == t || !(b - a > ON_EPSILON * (fabs(t0) + fabs(t1))))
+      break;
+    t = next_t;
+  }
+  return t;
+}
+
+double ON_CurveArcLengthTable::LengthAt(
+  double t
+  ) const
+{
+  if (IsEmpty() || !ON_IsValid(t))
+    return ON_UNSET_VALUE;
+  if (t <= m_span_t[0])
+    return 0.0;
+  if (t >= *m_span_t.Last())
+    return Length();
+  const unsigned int span_index = Internal_SpanFromParameter(t);
+  return m_span_length[span_index] + Internal_Integrate(m_span_piece[span_index], m_span_t[span_index], t);
+}
+
+double ON_CurveArcLengthTable::ParameterAtLength(
+  double length
+  ) const
+{
+  if (IsEmpty() || !ON_IsValid(length))
+    return ON_UNSET_VALUE;
+  if (length <= 0.0)
+    return m_span_t[0];
+  if (length >= Length())
+    return *m_span_t.Last();
+  return Internal_SpanParameter(Internal_SpanFromLength(length, ON_UNSET_UINT_INDEX), length);
+}
+
+double ON_CurveArcLengthTable::ParameterAtNormalizedLength(
+  double s
+  ) const
+{
+  if (IsEmpty() || !ON_IsValid(s))
+    return ON_UNSET_VALUE;
+  if (s <= 0.0)
+    return m_span_t[0];
+  if (s >= 1.0)
+    return *m_span_t.Last();
+  return ParameterAtLength(s * Length());
+}
+
+unsigned int ON_CurveArcLengthTable::GetParametersAtLengths(
+  size_t count,
+  const double* lengths,
+  double* t
+  ) const
+{
+  if (IsEmpty() || 0 == count || nullptr == lengths || nullptr == t || count > (size_t)ON_UNSET_UINT_INDEX)
+    return 0;
+  const double total_length = Length();
+  unsigned int span_index = ON_UNSET_UINT_INDEX;
+  for (size_t i = 0; i < count; i++)
+  {
+    const double length = lengths[i];
+    if (!ON_IsValid(length))
+      t[i] = ON_UNSET_VALUE;
+    else if (length <= 0.0)
+      t[i] = m_span_t[0];
+    else if (length >= total_length)
+      t[i] = *m_span_t.Last();
+    else
+    {
+      span_index = Internal_SpanFromLength(length, span_index);
+      t[i] = Internal_SpanParameter(span_index, length);
+    }
+  }
+  return (unsigned int)count;
+}
+
+unsigned int ON_CurveArcLengthTable::GetLengthsAt(
+  size_t count,
+  const double* t,
+  double* lengths
+  ) const
+{
+  if (IsEmpty() || 0 == count || nullptr == t || nullptr == lengths || count > (size_t)ON_UNSET_UINT_INDEX)
+    return 0;
+  for (size_t i = 0; i < count; i++)
+    lengths[i] = LengthAt(t[i]);
+  return (unsigned int)count;
+}
+
+bool ON_CurveArcLengthTable::DivideByCount(
+  unsigned int segment_count,
+  ON_SimpleArray<double>& t,
+  ON_SimpleArray<ON_3dPoint>* points
+  ) const
+{
+  if (IsEmpty() || segment_count < 1 || segment_count >= 0x7FFFFFFF)
+    return false;
+
+  const int t0_count = t.Count();
+  t.Reserve(t0_count + segment_count + 1);
+  t.SetCount(t0_count + segment_count + 1);
+  double* segment_t = t.Array() + t0_count;
+  const double total_length = Length();
+  unsigned int span_index = ON_UNSET_UINT_INDEX;
+  segment_t[0] = m_span_t[0];
+  for (unsigned int i = 1; i < segment_count; i++)
+  {
+    const double length = (((double)i) / ((double)segment_count)) * total_length;
+    span_index = Internal_SpanFromLength(length, span_index);
+    segment_t[i] = Internal_SpanParameter(span_index, length);
+  }
+  segment_t[segment_count] = *m_span_t.Last();
+
+  if (nullptr != points)
+  {
+    points->Reserve(points->Count() + segment_count + 1);
+    for (unsigned int i = 0; i <= segment_count; i++)
+      points->Append(m_pieces.PointAt(segment_t[i]));
+  }
+  return true;
+}
+
+size_t ON_CurveArcLengthTable::SizeOf() const
+{
+  return sizeof(*this)
+    + (m_pieces.SizeOf() - sizeof(m_pieces))
+    + m_span_t.SizeOfArray()
+    + m_span_length.SizeOfArray()
+    + m_span_piece.SizeOfArray();
+}
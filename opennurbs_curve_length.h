@@ -0,0 +1,170 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//   Curve arc length tables
+//
+////////////////////////////////////////////////////////////////
+
+#if !defined(OPENNURBS_CURVE_LENGTH_INC_)
+#define OPENNURBS_CURVE_LENGTH_INC_
+
+/*
+Description:
+  ON_CurveArcLengthTable integrates the arc length of a curve once and
+  answers length from parameter and parameter from length queries in
+  O(log n) time, where n is the number of table spans.
+
+  Create() decomposes the curve with ON_CurvePieceList. Line and arc
+  pieces have constant speed and are exact. Bezier pieces are split
+  into spans until 8 point Gauss-Legendre quadrature on a span agrees
+  with the sum over its halves to within the fractional tolerance.
+  Queries locate the span with a binary search, integrate the rest of
+  the span with the same rule, and polish parameters with a safeguarded
+  Newton iteration.
+Remarks:
+  The table keeps copies of everything it uses and does not reference the
+  curve. The const member functions may be called from any number of threads.
+*/
+class ON_CLASS ON_CurveArcLengthTable
+{
+public:
+  ON_CurveArcLengthTable() = default;
+  ~ON_CurveArcLengthTable() = default;
+  ON_CurveArcLengthTable(const ON_CurveArcLengthTable&) = default;
+  ON_CurveArcLengthTable& operator=(const ON_CurveArcLengthTable&) = default;
+
+  /*
+  Parameters:
+    curve - [in]
+      Any curve supported by ON_CurvePieceList.
+    fractional_tolerance - [in]
+      Desired relative accuracy of the lengths. If <= 0.0, 1.0e-8 is used.
+  Returns:
+    True if the table was created.
+  */
+  bool Create(
+    const ON_Curve& curve,
+    double fractional_tolerance = 1.0e-8
+    );
+
+  void Destroy();
+
+  bool IsEmpty() const;
+
+  const ON_CurvePieceList& Pieces() const;
+
+  ON_Interval Domain() const;
+
+  /*
+  Returns:
+    Length of the curve.
+  */
+  double Length() const;
+
+  /*
+  Returns:
+    Length of the curve from the start of the domain to t. Parameters
+    outside the domain are clamped. ON_UNSET_VALUE if the table is empty.
+  */
+  double LengthAt(
+    double t
+    ) const;
+
+  /*
+  Returns:
+    Curve parameter where the length from the start of the curve is length.
+    Lengths outside [0,Length()] are clamped. ON_UNSET_VALUE if the table
+    is empty.
+  */
+  double ParameterAtLength(
+    double length
+    ) const;
+
+  /*
+  Returns:
+    ParameterAtLength(s*Length()).
+  */
+  double ParameterAtNormalizedLength(
+    double s
+    ) const;
+
+  /*
+  Description:
+    Batch version of ParameterAtLength().
+  Parameters:
+    count - [in]
+    lengths - [in]
+      Increasing lengths are found fastest.
+    t - [out]
+      t[i] = ParameterAtLength(lengths[i]).
+  Returns:
+    Number of parameters set. 0 if the table is empty.
+  */
+  unsigned int GetParametersAtLengths(
+    size_t count,
+    const double* lengths,
+    double* t
+    ) const;
+
+  /*
+  Description:
+    Batch version of LengthAt().
+  */
+  unsigned int GetLengthsAt(
+    size_t count,
+    const double* t,
+    double* lengths
+    ) const;
+
+  /*
+  Description:
+    Divide the curve into pieces of equal length.
+  Parameters:
+    segment_count - [in] >= 1
+    t - [out]
+      segment_count+1 parameters are appended. The first and last are the
+      ends of the domain.
+    points - [out]
+      If not nullptr, the points at the parameters are appended.
+  Returns:
+    True if successful.
+  */
+  bool DivideByCount(
+    unsigned int segment_count,
+    ON_SimpleArray<double>& t,
+    ON_SimpleArray<ON_3dPoint>* points
+    ) const;
+
+  size_t SizeOf() const;
+
+private:
+  unsigned int Internal_SpanFromParameter(double t) const;
+  unsigned int Internal_SpanFromLength(double length, unsigned int span_hint) const;
+  double Internal_Speed(unsigned int piece_index, double t) const;
+  double Internal_Integrate(unsigned int piece_index, double t0, double t1) const;
+  double Internal_SpanParameter(unsigned int span_index, double length) const;
+
+  ON_CurvePieceList m_pieces;
+
+  // Span i is the parameter interval [m_span_t[i],m_span_t[i+1]] of piece
+  // m_span_piece[i], and m_span_length[i] is the length of the curve from
+  // the start of the domain to m_span_t[i]. m_span_t[] and m_span_length[]
+  // have one more element than m_span_piece[].
+  ON_SimpleArray<double> m_span_t;
+  ON_SimpleArray<double> m_span_length;
+  ON_SimpleArray<unsigned int> m_span_piece;
+};
+
+#endif
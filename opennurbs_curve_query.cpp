@@ -0,0 +1,926 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+/*
+Description:
+  Map x from the interval "from" to the interval "to". When bReversed
+  is true, from[0] maps to to[1]. The ends of "from" map exactly to the
+  ends of "to".
+*/
+static double Internal_MapParameter(
+  double x,
+  const ON_Interval& from,
+  const ON_Interval& to,
+  bool bReversed
+  )
+{
+  if (x == from.m_t[0])
+    return bReversed ? to.m_t[1] : to.m_t[0];
+  if (x == from.m_t[1])
+    return bReversed ? to.m_t[0] : to.m_t[1];
+  if (false == bReversed && from == to)
+    return x;
+  double n = from.NormalizedParameterAt(x);
+  if (bReversed)
+    n = 1.0 - n;
+  return to.ParameterAt(n);
+}
+
+static ON_Interval Internal_MapInterval(
+  const ON_Interval& a,
+  const ON_Interval& from,
+  const ON_Interval& to,
+  bool bReversed
+  )
+{
+  ON_Interval b(
+    Internal_MapParameter(a.m_t[0], from, to, bReversed),
+    Internal_MapParameter(a.m_t[1], from, to, bReversed)
+  );
+  b.MakeIncreasing();
+  return b;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// ON_CurvePiece
+//
+
+double ON_CurvePiece::CurveParameter(
+  double s
+  ) const
+{
+  return Internal_MapParameter(s, m_piece_domain, m_curve_domain, m_bReversed);
+}
+
+double ON_CurvePiece::PieceParameter(
+  double t
+  ) const
+{
+  return Internal_MapParameter(t, m_curve_domain, m_piece_domain, m_bReversed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// ON_CurvePieceList
+//
+
+static int Internal_CompareCurvePiece(const ON_CurvePiece* a, const ON_CurvePiece* b)
+{
+  if (a->m_curve_domain.m_t[0] < b->m_curve_domain.m_t[0])
+    return -1;
+  if (a->m_curve_domain.m_t[0] > b->m_curve_domain.m_t[0])
+    return 1;
+  return 0;
+}
+
+bool ON_CurvePieceList::Create(
+  const ON_Curve& curve
+  )
+{
+  Destroy();
+  const ON_Interval domain = curve.Domain();
+  if (!(domain.m_t[0] < domain.m_t[1]))
+    return false;
+  if (!Internal_Append(curve, domain, domain, false, 0) || m_pieces.Count() <= 0)
+  {
+    Destroy();
+    return false;
+  }
+
+  // Pieces from reversed proxies and polycurves are appended in
+  // decreasing parameter order.
+  m_pieces.QuickSort(Internal_CompareCurvePiece);
+
+  const unsigned int piece_count = m_pieces.UnsignedCount();
+  m_piece_t.Reserve(piece_count + 1);
+  for (unsigned int i = 0; i < piece_count; i++)
+  {
+    m_piece_t.Append(m_pieces[i].m_curve_domain.m_t[0]);
+    m_bbox.Union(m_pieces[i].m_bbox);
+  }
+  m_piece_t.Append(m_pieces[piece_count - 1].m_curve_domain.m_t[1]);
+
+  return true;
+}
+
+bool ON_CurvePieceList::Internal_Append(
+  const ON_Curve& curve,
+  ON_Interval sub_domain,
+  ON_Interval curve_domain,
+  bool bReversed,
+  int depth
+  )
+{
+  // sub_domain is in the parameterization of curve and maps to
+  // curve_domain in the parameterization of the curve passed to Create().
+  if (depth > 32)
+    return false;
+  if (!(sub_domain.m_t[0] < sub_domain.m_t[1]))
+    return true;
+
+  const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(&curve);
+  if (nullptr != polycurve)
+  {
+    const int segment_count = polycurve->Count();
+    for (int i = 0; i < segment_count; i++)
+    {
+      const ON_Curve* segment = polycurve->SegmentCurve(i);
+      if (nullptr == segment)
+        return false;
+      const ON_Interval segment_polycurve_domain = polycurve->SegmentDomain(i);
+      ON_Interval a;
+      if (!a.Intersection(segment_polycurve_domain, sub_domain) || !(a.m_t[0] < a.m_t[1]))
+        continue;
+      const ON_Interval segment_sub_domain = Internal_MapInterval(a, segment_polycurve_domain, segment->Domain(), false);
+      const ON_Interval segment_curve_domain = Internal_MapInterval(a, sub_domain, curve_domain, bReversed);
+      if (!Internal_Append(*segment, segment_sub_domain, segment_curve_domain, bReversed, depth + 1))
+        return false;
+    }
+    return true;
+  }
+
+  const ON_CurveProxy* proxy = ON_CurveProxy::Cast(&curve);
+  if (nullptr != proxy)
+  {
+    const ON_Curve* real_curve = proxy->ProxyCurve();
+    if (nullptr == real_curve)
+      return false;
+    const bool bProxyReversed = proxy->ProxyCurveIsReversed();
+    const ON_Interval real_sub_domain = Internal_MapInterval(sub_domain, proxy->Domain(), proxy->ProxyCurveDomain(), bProxyReversed);
+    return Internal_Append(*real_curve, real_sub_domain, curve_domain, bReversed != bProxyReversed, depth + 1);
+  }
+
+  const ON_LineCurve* line_curve = ON_LineCurve::Cast(&curve);
+  if (nullptr != line_curve)
+  {
+    ON_CurvePiece piece;
+    piece.m_type = ON_CurvePiece::Type::Line;
+    piece.m_line = line_curve->m_line;
+    piece.m_piece_domain = Internal_MapInterval(sub_domain, line_curve->m_t, ON_Interval::ZeroToOne, false);
+    Internal_AppendPiece(piece, curve_domain, bReversed);
+    return true;
+  }
+
+  const ON_PolylineCurve* polyline_curve = ON_PolylineCurve::Cast(&curve);
+  if (nullptr != polyline_curve)
+  {
+    const int point_count = polyline_curve->m_pline.Count();
+    if (point_count < 2 || polyline_curve->m_t.Count() != point_count)
+      return false;
+    for (int i = 0; i + 1 < point_count; i++)
+    {
+      const ON_Interval segment_domain(polyline_curve->m_t[i], polyline_curve->m_t[i + 1]);
+      ON_Interval a;
+      if (!a.Intersection(segment_domain, sub_domain) || !(a.m_t[0] < a.m_t[1]))
+        continue;
+      ON_CurvePiece piece;
+      piece.m_type = ON_CurvePiece::Type::Line;
+      piece.m_line = ON_Line(polyline_curve->m_pline[i], polyline_curve->m_pline[i + 1]);
+      piece.m_piece_domain = Internal_MapInterval(a, segment_domain, ON_Interval::ZeroToOne, false);
+      Internal_AppendPiece(piece, Internal_MapInterval(a, sub_domain, curve_domain, bReversed), bReversed);
+    }
+    return true;
+  }
+
+  const ON_ArcCurve* arc_curve = ON_ArcCurve::Cast(&curve);
+  if (nullptr != arc_curve)
+  {
+    ON_CurvePiece piece;
+    piece.m_type = ON_CurvePiece::Type::Arc;
+    piece.m_arc = arc_curve->m_arc;
+    piece.m_piece_domain = Internal_MapInterval(sub_domain, arc_curve->m_t, arc_curve->m_arc.DomainRadians(), false);
+    Internal_AppendPiece(piece, curve_domain, bReversed);
+    return true;
+  }
+
+  const ON_NurbsCurve* nurbs_curve = ON_NurbsCurve::Cast(&curve);
+  if (nullptr != nurbs_curve)
+    return Internal_AppendNurbs(*nurbs_curve, sub_domain, curve_domain, bReversed);
+
+  // Other curve types are supported when their NURBS form has the same parameterization.
+  ON_NurbsCurve nurbs_form;
+  if (1 != curve.GetNurbForm(nurbs_form))
+    return false;
+  return Internal_AppendNurbs(nurbs_form, sub_domain, curve_domain, bReversed);
+}
+
+bool ON_CurvePieceList::Internal_AppendNurbs(
+  const ON_NurbsCurve& curve,
+  ON_Interval sub_domain,
+  ON_Interval curve_domain,
+  bool bReversed
+  )
+{
+  if (curve.m_dim < 2 || curve.m_dim > 3)
+    return false;
+  ON_NurbsCurveSpanCache span_cache;
+  if (!span_cache.Create(curve))
+    return false;
+
+  ON_BezierCurve bezier;
+  const int span_count = span_cache.SpanCount();
+  for (int span_index = 0; span_index < span_count; span_index++)
+  {
+    const ON_Interval span_domain = span_cache.SpanDomain(span_index);
+    ON_Interval a;
+    if (!a.Intersection(span_domain, sub_domain) || !(a.m_t[0] < a.m_t[1]))
+      continue;
+    if (!span_cache.GetSpanBezier(span_index, bezier))
+      return false;
+    if (a != span_domain)
+    {
+      if (!bezier.Trim(Internal_MapInterval(a, span_domain, ON_Interval::ZeroToOne, false)))
+        return false;
+    }
+
+    ON_CurvePiece piece;
+    piece.m_type = ON_CurvePiece::Type::Bezier;
+    piece.m_order = (unsigned char)bezier.m_order;
+    piece.m_is_rat = bezier.m_is_rat ? 1 : 0;
+    piece.m_cv_index = m_cv.UnsignedCount();
+    piece.m_piece_domain = ON_Interval::ZeroToOne;
+    for (int i = 0; i < bezier.m_order; i++)
+    {
+      const double* cv = bezier.CV(i);
+      ON_4dPoint& P = m_cv.AppendNew();
+      P.x = cv[0];
+      P.y = cv[1];
+      P.z = (3 == bezier.m_dim) ? cv[2] : 0.0;
+      P.w = bezier.m_is_rat ? cv[bezier.m_dim] : 1.0;
+    }
+    Internal_AppendPiece(piece, Internal_MapInterval(a, sub_domain, curve_domain, bReversed), bReversed);
+  }
+  return true;
+}
+
+void ON_CurvePieceList::Internal_AppendPiece(
+  ON_CurvePiece& piece,
+  const ON_Interval& curve_domain,
+  bool bReversed
+  )
+{
+  piece.m_curve_domain = curve_domain;
+  piece.m_bReversed = bReversed;
+  piece.m_bbox = ON_BoundingBox::EmptyBoundingBox;
+  switch (piece.m_type)
+  {
+  case ON_CurvePiece::Type::Line:
+    piece.m_bbox.Set(piece.m_line.PointAt(piece.m_piece_domain.m_t[0]), false);
+    piece.m_bbox.Set(piece.m_line.PointAt(piece.m_piece_domain.m_t[1]), true);
+    break;
+  case ON_CurvePiece::Type::Arc:
+    {
+      ON_Arc arc = piece.m_arc;
+      if (arc.SetAngleIntervalRadians(piece.m_piece_domain))
+        arc.GetTightBoundingBox(piece.m_bbox);
+      else
+        piece.m_bbox = piece.m_arc.BoundingBox();
+    }
+    break;
+  case ON_CurvePiece::Type::Bezier:
+    ON_GetPointListBoundingBox(3, 0 != piece.m_is_rat, piece.m_order, 4, &m_cv[piece.m_cv_index].x, piece.m_bbox, false);
+    break;
+  default:
+    break;
+  }
+  m_pieces.Append(piece);
+}
+
+void ON_CurvePieceList::Destroy()
+{
+  m_pieces.SetCount(0);
+  m_piece_t.SetCount(0);
+  m_cv.SetCount(0);
+  m_bbox = ON_BoundingBox::EmptyBoundingBox;
+}
+
+bool ON_CurvePieceList::IsEmpty() const
+{
+  return (m_pieces.Count() <= 0);
+}
+
+unsigned int ON_CurvePieceList::PieceCount() const
+{
+  return m_pieces.UnsignedCount();
+}
+
+const ON_CurvePiece& ON_CurvePieceList::Piece(
+  unsigned int piece_index
+  ) const
+{
+  return m_pieces[piece_index];
+}
+
+const ON_4dPoint* ON_CurvePieceList::BezierCV(
+  unsigned int piece_index
+  ) const
+{
+  if (piece_index >= m_pieces.UnsignedCount() || ON_CurvePiece::Type::Bezier != m_pieces[piece_index].m_type)
+    return nullptr;
+  return m_cv.Array() + m_pieces[piece_index].m_cv_index;
+}
+
+ON_Interval ON_CurvePieceList::Domain() const
+{
+  const int count = m_piece_t.Count();
+  return (count >= 2) ? ON_Interval(m_piece_t[0], m_piece_t[count - 1]) : ON_Interval::EmptyInterval;
+}
+
+ON_BoundingBox ON_CurvePieceList::BoundingBox() const
+{
+  return m_bbox;
+}
+
+unsigned int ON_CurvePieceList::PieceIndex(
+  double t,
+  int side
+  ) const
+{
+  const int piece_count = m_pieces.Count();
+  if (piece_count <= 0)
+    return ON_UNSET_UINT_INDEX;
+  int i = ON_SearchMonotoneArray(m_piece_t.Array(), piece_count + 1, t);
+  if (i < 0)
+    i = 0;
+  else if (i >= piece_count)
+    i = piece_count - 1;
+  else if (side < 0 && i > 0 && t == m_piece_t[i])
+    i--;
+  return (unsigned int)i;
+}
+
+bool ON_CurvePieceList::EvaluatePiece(
+  unsigned int piece_index,
+  double s,
+  int der_count,
+  ON_3dVector* v
+  ) const
+{
+  if (piece_index >= m_pieces.UnsignedCount() || der_count < 0 || nullptr == v)
+    return false;
+  const ON_CurvePiece& piece = m_pieces[piece_index];
+  switch (piece.m_type)
+  {
+  case ON_CurvePiece::Type::Line:
+    v[0] = ON_3dVector(piece.m_line.PointAt(s));
+    if (der_count >= 1)
+      v[1] = piece.m_line.to - piece.m_line.from;
+    for (int k = 2; k <= der_count; k++)
+      v[k] = ON_3dVector::ZeroVector;
+    return true;
+
+  case ON_CurvePiece::Type::Arc:
+    {
+      v[0] = ON_3dVector(piece.m_arc.PointAt(s));
+      const double c = cos(s);
+      const double sn = sin(s);
+      const ON_3dVector X = piece.m_arc.radius * piece.m_arc.plane.xaxis;
+      const ON_3dVector Y = piece.m_arc.radius * piece.m_arc.plane.yaxis;
+      for (int k = 1; k <= der_count; k++)
+      {
+        switch (k % 4)
+        {
+        case 0: v[k] =  c * X + sn * Y; break;
+        case 1: v[k] = -sn * X + c * Y; break;
+        case 2: v[k] = -c * X - sn * Y; break;
+        case 3: v[k] =  sn * X - c * Y; break;
+        }
+      }
+    }
+    return true;
+
+  case ON_CurvePiece::Type::Bezier:
+    return ON_EvaluateBezier(3, 0 != piece.m_is_rat, piece.m_order, 4, &m_cv[piece.m_cv_index].x, 0.0, 1.0, der_count, s, 3, &v[0].x);
+
+  default:
+    break;
+  }
+  return false;
+}
+
+bool ON_CurvePieceList::Evaluate(
+  double t,
+  int der_count,
+  ON_3dVector* v,
+  int side
+  ) const
+{
+  const unsigned int piece_index = PieceIndex(t, side);
+  if (ON_UNSET_UINT_INDEX == piece_index)
+    return false;
+  const ON_CurvePiece& piece = m_pieces[piece_index];
+  if (!EvaluatePiece(piece_index, piece.PieceParameter(t), der_count, v))
+    return false;
+  if (der_count > 0)
+  {
+    // convert derivatives with respect to the piece parameter to
+    // derivatives with respect to the curve parameter
+    double ds = piece.m_piece_domain.Length() / piece.m_curve_domain.Length();
+    if (piece.m_bReversed)
+      ds = -ds;
+    double scale = 1.0;
+    for (int k = 1; k <= der_count; k++)
+    {
+      scale *= ds;
+      v[k] *= scale;
+    }
+  }
+  return true;
+}
+
+ON_3dPoint ON_CurvePieceList::PointAt(
+  double t
+  ) const
+{
+  ON_3dVector v;
+  return Evaluate(t, 0, &v) ? ON_3dPoint(v) : ON_3dPoint::UnsetPoint;
+}
+
+size_t ON_CurvePieceList::SizeOf() const
+{
+  return sizeof(*this)
+    + m_pieces.SizeOfArray()
+    + m_piece_t.SizeOfArray()
+    + m_cv.SizeOfArray();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// ON_CurveClosestPointQuery
+//
+
+/*
+Description:
+  Minimum distance from P to the box of the Bezier control points.
+  Returns 0 when a weight is not positive and the box is not a hull.
+*/
+static double Internal_BezierHullDistance(
+  int order,
+  bool bIsRational,
+  const ON_4dPoint* cv,
+  const ON_3dPoint& P
+  )
+{
+  ON_BoundingBox bbox;
+  for (int i = 0; i < order; i++)
+  {
+    ON_3dPoint Q(cv[i].x, cv[i].y, cv[i].z);
+    if (bIsRational)
+    {
+      if (!(cv[i].w > 0.0))
+        return 0.0;
+      Q = Q / cv[i].w;
+    }
+    bbox.Set(Q, 0 != i);
+  }
+  return bbox.MinimumDistanceTo(P);
+}
+
+static ON_3dPoint Internal_EuclideanPoint(const ON_4dPoint& cv, bool bIsRational)
+{
+  return bIsRational ? ON_3dPoint(cv.x / cv.w, cv.y / cv.w, cv.z / cv.w) : ON_3dPoint(cv.x, cv.y, cv.z);
+}
+
+/*
+Description:
+  Newton's method for the local minimum of |C(s) - P|^2 on [0,1].
+  s and d are the best parameter and distance found.
+*/
+static void Internal_BezierNewton(
+  int order,
+  bool bIsRational,
+  const ON_4dPoint* cv,
+  const ON_3dPoint& P,
+  double s0,
+  double* s,
+  double* d
+  )
+{
+  ON_3dVector v[3];
+  double u = s0;
+  if (!ON_EvaluateBezier(3, bIsRational, order, 4, &cv[0].x, 0.0, 1.0, 2, u, 3, &v[0].x))
+    return;
+  double du_distance = (ON_3dPoint(v[0]) - P).Length();
+  if (du_distance < *d)
+  {
+    *d = du_distance;
+    *s = u;
+  }
+
+  ON_3dVector w[3];
+  for (int iteration = 0; iteration < 32; iteration++)
+  {
+    const ON_3dVector V = ON_3dPoint(v[0]) - P;
+    const double f1 = V * v[1];
+    const double f2 = v[1] * v[1] + V * v[2];
+    if (0.0 == f1 || !(f2 > 0.0))
+      break;
+    double du = -f1 / f2;
+    double u1 = u;
+    double d1 = du_distance;
+    bool bImproved = false;
+    for (int halving = 0; halving < 8; halving++)
+    {
+      u1 = u + du;
+      if (u1 < 0.0)
+        u1 = 0.0;
+      else if (u1 > 1.0)
+        u1 = 1.0;
+      if (u1 == u)
+        break;
+      if (!ON_EvaluateBezier(3, bIsRational, order, 4, &cv[0].x, 0.0, 1.0, 2, u1, 3, &w[0].x))
+        return;
+      d1 = (ON_3dPoint(w[0]) - P).Length();
+      if (d1 <= du_distance)
+      {
+        bImproved = true;
+        break;
+      }
+      du *= 0.5;
+    }
+    if (!bImproved)
+      break;
+    const double step = fabs(u1 - u);
+    u = u1;
+    du_distance = d1;
+    v[0] = w[0];
+    v[1] = w[1];
+    v[2] = w[2];
+    if (du_distance < *d)
+    {
+      *d = du_distance;
+      *s = u;
+    }
+    if (step <= 4.0 * ON_EPSILON)
+      break;
+  }
+}
+
+/*
+Description:
+  Closest point on a Bezier span. Subspans are culled when their control
+  point box is farther than *d and nearly straight subspans seed Newton's
+  method. *d is only reduced and *s is set when a closer point is found.
+*/
+static void Internal_BezierClosestPoint(
+  int order,
+  bool bIsRational,
+  const ON_4dPoint* cv,
+  const ON_3dPoint& P,
+  double* s,
+  double* d
+  )
+{
+  enum : int
+  {
+    max_order = 16,
+    max_depth = 12
+  };
+  if (order < 2 || order > max_order)
+    return;
+
+  // end points are on the curve
+  for (int end = 0; end < 2; end++)
+  {
+    const double e = P.DistanceTo(Internal_EuclideanPoint(cv[end ? order - 1 : 0], bIsRational));
+    if (e < *d)
+    {
+      *d = e;
+      *s = end ? 1.0 : 0.0;
+    }
+  }
+
+  struct Subspan
+  {
+    ON_4dPoint m_cv[max_order];
+    double m_u0;
+    double m_u1;
+    int m_depth;
+  };
+  Subspan stack[2 * max_depth + 2];
+  int stack_count = 1;
+  memcpy(stack[0].m_cv, cv, order * sizeof(cv[0]));
+  stack[0].m_u0 = 0.0;
+  stack[0].m_u1 = 1.0;
+  stack[0].m_depth = 0;
+
+  while (stack_count > 0)
+  {
+    const Subspan& node = stack[--stack_count];
+    if (Internal_BezierHullDistance(order, bIsRational, node.m_cv, P) > *d)
+      continue;
+
+    const ON_3dPoint A = Internal_EuclideanPoint(node.m_cv[0], bIsRational);
+    const ON_3dPoint B = Internal_EuclideanPoint(node.m_cv[order - 1], bIsRational);
+    const double chord = A.DistanceTo(B);
+    double polygon = 0.0;
+    ON_3dPoint Q = A;
+    for (int i = 1; i < order; i++)
+    {
+      const ON_3dPoint R = Internal_EuclideanPoint(node.m_cv[i], bIsRational);
+      polygon += Q.DistanceTo(R);
+      Q = R;
+    }
+
+    if (node.m_depth >= max_depth || polygon <= (1.0 + 1.0e-3) * chord)
+    {
+      // seed Newton's method with the point on the chord closest to P
+      double x = 0.5;
+      if (chord > 0.0)
+      {
+        x = ((P - A) * (B - A)) / (chord * chord);
+        if (x < 0.0)
+          x = 0.0;
+        else if (x > 1.0)
+          x = 1.0;
+      }
+      Internal_BezierNewton(order, bIsRational, cv, P, node.m_u0 + x * (node.m_u1 - node.m_u0), s, d);
+      continue;
+    }
+
+    // split the subspan in half and search the nearer half first
+    Subspan left, right;
+    memcpy(left.m_cv, node.m_cv, order * sizeof(cv[0]));
+    for (int j = 1; j < order; j++)
+    {
+      right.m_cv[order - j] = left.m_cv[order - 1];
+      for (int i = order - 1; i >= j; i--)
+      {
+        // homogeneous average (ON_4dPoint::operator+ adds euclidean points)
+        ON_4dPoint& Q = left.m_cv[i];
+        const ON_4dPoint& R = left.m_cv[i - 1];
+        Q.x = 0.5 * (Q.x + R.x);
+        Q.y = 0.5 * (Q.y + R.y);
+        Q.z = 0.5 * (Q.z + R.z);
+        Q.w = 0.5 * (Q.w + R.w);
+      }
+    }
+    right.m_cv[0] = left.m_cv[order - 1];
+    const double um = 0.5 * (node.m_u0 + node.m_u1);
+    left.m_u0 = node.m_u0;
+    left.m_u1 = um;
+    right.m_u0 = um;
+    right.m_u1 = node.m_u1;
+    left.m_depth = right.m_depth = node.m_depth + 1;
+
+    const bool bLeftFirst = Internal_BezierHullDistance(order, bIsRational, left.m_cv, P)
+      <= Internal_BezierHullDistance(order, bIsRational, right.m_cv, P);
+    stack[stack_count++] = bLeftFirst ? right : left;
+    stack[stack_count++] = bLeftFirst ? left : right;
+  }
+}
+
+class ON_Internal_CurveClosestPointContext
+{
+public:
+  const ON_CurvePieceList* m_pieces = nullptr;
+  ON_3dPoint m_P = ON_3dPoint::NanPoint;
+  ON_RTreeSphere m_sphere;
+  double m_distance = ON_DBL_MAX;
+  unsigned int m_piece_index = ON_UNSET_UINT_INDEX;
+  double m_s = ON_DBL_QNAN;
+
+  void TestPiece(unsigned int piece_index);
+
+  static bool ON_CALLBACK_CDECL Callback(void* context, ON__INT_PTR id)
+  {
+    ((ON_Internal_CurveClosestPointContext*)context)->TestPiece((unsigned int)id);
+    return true;
+  }
+};
+
+void ON_Internal_CurveClosestPointContext::TestPiece(unsigned int piece_index)
+{
+  const ON_CurvePiece& piece = m_pieces->Piece(piece_index);
+  if (piece.m_bbox.MinimumDistanceTo(m_P) > m_distance)
+    return;
+
+  double s = ON_DBL_QNAN;
+  double d = m_distance;
+  switch (piece.m_type)
+  {
+  case ON_CurvePiece::Type::Line:
+    {
+      double x = piece.m_piece_domain.m_t[0];
+      if (piece.m_line.ClosestPointTo(m_P, &x))
+      {
+        if (x < piece.m_piece_domain.m_t[0])
+          x = piece.m_piece_domain.m_t[0];
+        else if (x > piece.m_piece_domain.m_t[1])
+          x = piece.m_piece_domain.m_t[1];
+      }
+      else
+        x = piece.m_piece_domain.m_t[0];
+      const double e = m_P.DistanceTo(piece.m_line.PointAt(x));
+      if (e < d)
+      {
+        d = e;
+        s = x;
+      }
+    }
+    break;
+
+  case ON_CurvePiece::Type::Arc:
+    {
+      ON_Arc arc = piece.m_arc;
+      double x = piece.m_piece_domain.m_t[0];
+      if (arc.SetAngleIntervalRadians(piece.m_piece_domain) && arc.ClosestPointTo(m_P, &x))
+      {
+        const double e = m_P.DistanceTo(piece.m_arc.PointAt(x));
+        if (e < d)
+        {
+          d = e;
+          s = x;
+        }
+      }
+    }
+    break;
+
+  case ON_CurvePiece::Type::Bezier:
+    Internal_BezierClosestPoint(piece.m_order, 0 != piece.m_is_rat, m_pieces->BezierCV(piece_index), m_P, &s, &d);
+    break;
+
+  default:
+    break;
+  }
+
+  if (d < m_distance && s == s)
+  {
+    m_distance = d;
+    m_piece_index = piece_index;
+    m_s = s;
+    m_sphere.m_radius = d;
+  }
+}
+
+bool ON_CurveClosestPointQuery::Create(
+  const ON_Curve& curve
+  )
+{
+  Destroy();
+  if (!m_pieces.Create(curve))
+    return false;
+  const unsigned int piece_count = m_pieces.PieceCount();
+  for (unsigned int i = 0; i < piece_count; i++)
+  {
+    const ON_BoundingBox& bbox = m_pieces.Piece(i).m_bbox;
+    if (!bbox.IsValid() || !m_piece_tree.Insert(&bbox.m_min.x, &bbox.m_max.x, (ON__INT_PTR)i))
+    {
+      Destroy();
+      return false;
+    }
+  }
+  return true;
+}
+
+void ON_CurveClosestPointQuery::Destroy()
+{
+  m_piece_tree.RemoveAll();
+  m_pieces.Destroy();
+}
+
+bool ON_CurveClosestPointQuery::IsEmpty() const
+{
+  return m_pieces.IsEmpty();
+}
+
+const ON_CurvePieceList& ON_CurveClosestPointQuery::Pieces() const
+{
+  return m_pieces;
+}
+
+bool ON_CurveClosestPointQuery::GetClosestPoint(
+  ON_3dPoint P,
+  double maximum_distance,
+  double* t,
+  ON_3dPoint* closest_point,
+  double* distance
+  ) const
+{
+  if (m_pieces.IsEmpty() || !P.IsValid())
+    return false;
+
+  ON_Internal_CurveClosestPointContext ctx;
+  ctx.m_pieces = &m_pieces;
+  ctx.m_P = P;
+  ctx.m_sphere.m_point[0] = P.x;
+  ctx.m_sphere.m_point[1] = P.y;
+  ctx.m_sphere.m_point[2] = P.z;
+  if (maximum_distance > 0.0)
+  {
+    ctx.m_distance = maximum_distance;
+    ctx.m_sphere.m_radius = maximum_distance;
+  }
+  else
+  {
+    // Start with the nearer end of the curve. The sphere shrinks as closer
+    // points are found.
+    const ON_Interval domain = m_pieces.Domain();
+    const double r = ON_Min(P.DistanceTo(m_pieces.PointAt(domain.m_t[0])), P.DistanceTo(m_pieces.PointAt(domain.m_t[1])));
+    ctx.m_sphere.m_radius = r + 1.0e-8 * (r + m_pieces.BoundingBox().Diagonal().Length());
+  }
+
+  if (m_pieces.PieceCount() <= 4)
+  {
+    for (unsigned int i = 0; i < m_pieces.PieceCount(); i++)
+      ctx.TestPiece(i);
+  }
+  else
+    m_piece_tree.Search(&ctx.m_sphere, ON_Internal_CurveClosestPointContext::Callback, &ctx);
+
+  if (ON_UNSET_UINT_INDEX == ctx.m_piece_index)
+    return false;
+
+  const ON_CurvePiece& piece = m_pieces.Piece(ctx.m_piece_index);
+  if (nullptr != t)
+    *t = piece.CurveParameter(ctx.m_s);
+  if (nullptr != closest_point)
+  {
+    ON_3dVector v;
+    *closest_point = m_pieces.EvaluatePiece(ctx.m_piece_index, ctx.m_s, 0, &v) ? ON_3dPoint(v) : ON_3dPoint::UnsetPoint;
+  }
+  if (nullptr != distance)
+    *distance = ctx.m_distance;
+  return true;
+}
+
+class ON_Internal_CurveClosestPointsContext
+{
+public:
+  const ON_CurveClosestPointQuery* m_query = nullptr;
+  const ON_3dPoint* m_points = nullptr;
+  double m_maximum_distance = 0.0;
+  double* m_t = nullptr;
+  ON_3dPoint* m_closest_points = nullptr;
+};
+
+static void Internal_GetCurveClosestPointsRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+  )
+{
+  const ON_Internal_CurveClosestPointsContext* ctx = (const ON_Internal_CurveClosestPointsContext*)context;
+  for (size_t i = i0; i < i1; i++)
+  {
+    ON_3dPoint Q;
+    if (!ctx->m_query->GetClosestPoint(ctx->m_points[i], ctx->m_maximum_distance, &ctx->m_t[i], &Q))
+    {
+      ctx->m_t[i] = ON_UNSET_VALUE;
+      Q = ON_3dPoint::UnsetPoint;
+    }
+    if (nullptr != ctx->m_closest_points)
+      ctx->m_closest_points[i] = Q;
+  }
+}
+
+unsigned int ON_CurveClosestPointQuery::GetClosestPoints(
+  size_t point_count,
+  const ON_3dPoint* points,
+  double maximum_distance,
+  double* t,
+  ON_3dPoint* closest_points,
+  bool bParallel
+  ) const
+{
+  if (0 == point_count || nullptr == points || nullptr == t)
+    return 0;
+
+  ON_Internal_CurveClosestPointsContext ctx;
+  ctx.m_query = this;
+  ctx.m_points = points;
+  ctx.m_maximum_distance = maximum_distance;
+  ctx.m_t = t;
+  ctx.m_closest_points = closest_points;
+  ON_ParallelFor(point_count, 0x40, bParallel ? 0U : 1U, Internal_GetCurveClosestPointsRange, (ON__UINT_PTR)&ctx);
+
+  unsigned int found_count = 0;
+  for (size_t i = 0; i < point_count; i++)
+  {
+    if (ON_UNSET_VALUE != t[i])
+      ++found_count;
+  }
+  return found_count;
+}
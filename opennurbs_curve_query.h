@@ -0,0 +1,311 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//   Curve pieces and curve closest point queries
+//
+////////////////////////////////////////////////////////////////
+
+#if !defined(OPENNURBS_CURVE_QUERY_INC_)
+#define OPENNURBS_CURVE_QUERY_INC_
+
+/*
+Description:
+  An ON_CurvePiece is a line segment, circular arc or Bezier span of
+  a curve. ON_CurvePieceList decomposes a curve into pieces.
+*/
+class ON_CLASS ON_CurvePiece
+{
+public:
+  ON_CurvePiece() = default;
+  ~ON_CurvePiece() = default;
+  ON_CurvePiece(const ON_CurvePiece&) = default;
+  ON_CurvePiece& operator=(const ON_CurvePiece&) = default;
+
+  enum class Type : unsigned char
+  {
+    Unset = 0,
+    // m_line.PointAt(s) for s in m_piece_domain, a subinterval of [0,1]
+    Line = 1,
+    // m_arc.PointAt(s) for s in m_piece_domain, an angle interval in radians
+    Arc = 2,
+    // Bezier span with parameter s in m_piece_domain = [0,1]. The control
+    // points are ON_CurvePieceList::BezierCV(piece_index).
+    Bezier = 3
+  };
+
+  Type m_type = ON_CurvePiece::Type::Unset;
+
+  // Bezier pieces: order and 1 if the control points are rational
+  unsigned char m_order = 0;
+  unsigned char m_is_rat = 0;
+
+  // true if the curve parameter decreases as the piece parameter increases
+  bool m_bReversed = false;
+
+  // Bezier pieces: index of the first control point in the list's control point array
+  unsigned int m_cv_index = 0;
+
+  // Increasing interval in the parameterization of the curve
+  // passed to ON_CurvePieceList::Create().
+  ON_Interval m_curve_domain = ON_Interval::EmptyInterval;
+
+  // Piece parameter interval. See the comments for ON_CurvePiece::Type.
+  ON_Interval m_piece_domain = ON_Interval::EmptyInterval;
+
+  ON_Line m_line = ON_Line::ZeroLine;
+  ON_Arc m_arc;
+
+  // Contains the piece. For Bezier pieces this is the control polygon box.
+  ON_BoundingBox m_bbox = ON_BoundingBox::EmptyBoundingBox;
+
+  /*
+  Returns:
+    Curve parameter of piece parameter s. The ends of m_piece_domain
+    map exactly to the ends of m_curve_domain.
+  */
+  double CurveParameter(
+    double s
+    ) const;
+
+  /*
+  Returns:
+    Piece parameter of curve parameter t.
+  */
+  double PieceParameter(
+    double t
+    ) const;
+};
+
+/*
+Description:
+  ON_CurvePieceList decomposes a curve into line segments, circular arcs
+  and Bezier spans. ON_PolyCurve segments and ON_CurveProxy subdomains
+  and reversals are resolved when the list is created, so the pieces are
+  sorted by m_curve_domain and PieceIndex() is a binary search.
+
+  Supported curves are ON_LineCurve, ON_ArcCurve, ON_PolylineCurve,
+  ON_NurbsCurve, ON_PolyCurve and ON_CurveProxy (which includes brep edges
+  and trims) and any curve whose ON_Curve::GetNurbForm() has the same
+  parameterization as the curve. Curves must have dimension 2 or 3;
+  2d curves have z = 0.
+Remarks:
+  The list keeps copies of everything it uses and does not reference the
+  curve. The const member functions may be called from any number of threads.
+*/
+class ON_CLASS ON_CurvePieceList
+{
+public:
+  ON_CurvePieceList() = default;
+  ~ON_CurvePieceList() = default;
+  ON_CurvePieceList(const ON_CurvePieceList&) = default;
+  ON_CurvePieceList& operator=(const ON_CurvePieceList&) = default;
+
+  /*
+  Returns:
+    True if every part of the curve was decomposed.
+  */
+  bool Create(
+    const ON_Curve& curve
+    );
+
+  void Destroy();
+
+  bool IsEmpty() const;
+
+  unsigned int PieceCount() const;
+
+  const ON_CurvePiece& Piece(
+    unsigned int piece_index
+    ) const;
+
+  /*
+  Returns:
+    Bezier pieces: pointer to the piece's m_order control points
+    (x,y,z,w). When m_is_rat is 0, w = 1.
+    Other pieces: nullptr.
+  */
+  const ON_4dPoint* BezierCV(
+    unsigned int piece_index
+    ) const;
+
+  ON_Interval Domain() const;
+
+  ON_BoundingBox BoundingBox() const;
+
+  /*
+  Parameters:
+    t - [in] curve parameter
+    side - [in]
+      <  0 if t is at a piece boundary, use the piece to the left.
+      >= 0 if t is at a piece boundary, use the piece to the right.
+  Returns:
+    Index of the piece used to evaluate at t. Parameters outside the
+    domain return the first or last piece. ON_UNSET_UINT_INDEX if the
+    list is empty.
+  */
+  unsigned int PieceIndex(
+    double t,
+    int side = 0
+    ) const;
+
+  /*
+  Description:
+    Evaluate a piece at a piece parameter.
+  Parameters:
+    piece_index - [in]
+    s - [in] piece parameter
+    der_count - [in] number of derivatives with respect to s (>= 0)
+    v - [out] v[0] = point, v[1] = first derivative, ...
+  */
+  bool EvaluatePiece(
+    unsigned int piece_index,
+    double s,
+    int der_count,
+    ON_3dVector* v
+    ) const;
+
+  /*
+  Description:
+    Evaluate at a curve parameter. The results agree with
+    ON_Curve::Evaluate() on the curve passed to Create().
+  Parameters:
+    t - [in] curve parameter
+    der_count - [in] number of derivatives with respect to t (>= 0)
+    v - [out] v[0] = point, v[1] = first derivative, ...
+    side - [in] see PieceIndex()
+  */
+  bool Evaluate(
+    double t,
+    int der_count,
+    ON_3dVector* v,
+    int side = 0
+    ) const;
+
+  ON_3dPoint PointAt(
+    double t
+    ) const;
+
+  size_t SizeOf() const;
+
+private:
+  bool Internal_Append(const ON_Curve& curve, ON_Interval sub_domain, ON_Interval curve_domain, bool bReversed, int depth);
+  bool Internal_AppendNurbs(const ON_NurbsCurve& curve, ON_Interval sub_domain, ON_Interval curve_domain, bool bReversed);
+  void Internal_AppendPiece(ON_CurvePiece& piece, const ON_Interval& curve_domain, bool bReversed);
+
+  ON_SimpleArray<ON_CurvePiece> m_pieces;
+
+  // m_piece_t[i] = m_pieces[i].m_curve_domain[0] and the last value is the
+  // end of the domain.
+  ON_SimpleArray<double> m_piece_t;
+
+  ON_SimpleArray<ON_4dPoint> m_cv;
+
+  ON_BoundingBox m_bbox = ON_BoundingBox::EmptyBoundingBox;
+};
+
+/*
+Description:
+  ON_CurveClosestPointQuery finds the points on a curve closest to test points.
+
+  Create() decomposes the curve into an ON_CurvePieceList and builds an
+  ON_RTree of the piece bounding boxes. A query searches the tree with a
+  shrinking sphere and culls pieces by their bounding boxes.
+  Lines and arcs are solved exactly. Bezier spans are subdivided, and
+  subspans whose control polygon box is farther away than the best point
+  so far are culled. The remaining subspans seed Newton's method, which
+  is clamped to the span.
+
+  Queries are const and use no mutable state, so any number of threads
+  may query the same ON_CurveClosestPointQuery at the same time.
+*/
+class ON_CLASS ON_CurveClosestPointQuery
+{
+public:
+  ON_CurveClosestPointQuery() = default;
+  ~ON_CurveClosestPointQuery() = default;
+
+private:
+  ON_CurveClosestPointQuery(const ON_CurveClosestPointQuery&) = delete;
+  ON_CurveClosestPointQuery& operator=(const ON_CurveClosestPointQuery&) = delete;
+
+public:
+  bool Create(
+    const ON_Curve& curve
+    );
+
+  void Destroy();
+
+  bool IsEmpty() const;
+
+  const ON_CurvePieceList& Pieces() const;
+
+  /*
+  Description:
+    Find the point on the curve closest to P.
+  Parameters:
+    P - [in]
+    maximum_distance - [in]
+      If > 0, only points within maximum_distance of P are considered.
+    t - [out]
+      curve parameter of the closest point
+    closest_point - [out]
+      optional closest point
+    distance - [out]
+      optional distance from P to the closest point
+  Returns:
+    True if a point was found.
+  */
+  bool GetClosestPoint(
+    ON_3dPoint P,
+    double maximum_distance,
+    double* t,
+    ON_3dPoint* closest_point = nullptr,
+    double* distance = nullptr
+    ) const;
+
+  /*
+  Description:
+    Find closest points for many test points.
+  Parameters:
+    point_count - [in]
+    points - [in]
+    maximum_distance - [in]
+      If > 0, only points within maximum_distance of P are considered.
+    t - [out]
+      t[i] = curve parameter of the point closest to points[i] or
+      ON_UNSET_VALUE if no point was found.
+    closest_points - [out]
+      optional. closest_points[i] = point closest to points[i] or
+      ON_3dPoint::UnsetPoint if no point was found.
+    bParallel - [in]
+      If true, points are processed by multiple threads.
+  Returns:
+    Number of points found.
+  */
+  unsigned int GetClosestPoints(
+    size_t point_count,
+    const ON_3dPoint* points,
+    double maximum_distance,
+    double* t,
+    ON_3dPoint* closest_points,
+    bool bParallel
+    ) const;
+
+private:
+  ON_CurvePieceList m_pieces;
+  ON_RTree m_piece_tree;
+};
+
+#endif
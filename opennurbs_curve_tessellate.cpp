@@ -0,0 +1,549 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+// Bezier spans are never split more than this many times.
+#define ON_INTERNAL_TESSELLATE_MAX_DEPTH 30
+
+// Maximum number of segments for a single line or arc piece.
+#define ON_INTERNAL_TESSELLATE_MAX_SEGMENTS 0x1000000
+
+class ON_Internal_TessNode
+{
+public:
+  // Bezier parameter interval of the sub-span
+  double m_u[2];
+  unsigned int m_depth;
+};
+
+class ON_Internal_CurveTessellator
+{
+public:
+  ON_Internal_CurveTessellator(const ON_MeshCurveParameters& mp);
+  ~ON_Internal_CurveTessellator() = default;
+
+private:
+  ON_Internal_CurveTessellator() = delete;
+  ON_Internal_CurveTessellator(const ON_Internal_CurveTessellator&) = delete;
+  ON_Internal_CurveTessellator& operator=(const ON_Internal_CurveTessellator&) = delete;
+
+public:
+  unsigned int Tessellate(
+    const ON_Curve& curve,
+    ON_SimpleArray<ON_3dPoint>& points,
+    ON_SimpleArray<double>* t
+    );
+
+private:
+  void Internal_AddPoint(const ON_3dPoint& P, double t, bool bPieceStart);
+  unsigned int Internal_LineSegmentCount(double length) const;
+  unsigned int Internal_ArcSegmentCount(double radius, double angle) const;
+  bool Internal_IsFlat(const ON_4dPoint* cv, int order) const;
+
+  // s and a are in the direction of travel and may be decreasing.
+  void Internal_AppendLine(const ON_Line& line, const ON_Interval& s, const ON_Interval& t);
+  void Internal_AppendArc(const ON_Arc& arc, const ON_Interval& a, const ON_Interval& t);
+  void Internal_AppendBezier(const ON_4dPoint* cv, int order, bool bReversed, const ON_Interval& t);
+  bool Internal_AppendPieces(const ON_CurvePieceList& pieces);
+
+  double m_tolerance = 0.0;
+  double m_max_angle = 0.0;
+  double m_max_chr = 0.0;
+  double m_min_length = 0.0;
+  double m_max_length = 0.0;
+
+  ON_SimpleArray<ON_3dPoint>* m_points = nullptr;
+  ON_SimpleArray<double>* m_t = nullptr;
+  int m_point_count0 = 0;
+
+  // Bezier subdivision. The control points of m_stack[k] are
+  // m_cv[k*order] to m_cv[k*order+order-1].
+  ON_SimpleArray<ON_Internal_TessNode> m_stack;
+  ON_SimpleArray<ON_4dPoint> m_cv;
+  ON_SimpleArray<ON_4dPoint> m_work;
+};
+
+static double Internal_TessellateSetting(double x)
+{
+  return (x > 0.0 && ON_IsValid(x)) ? x : 0.0;
+}
+
+ON_Internal_CurveTessellator::ON_Internal_CurveTessellator(const ON_MeshCurveParameters& mp)
+  : m_tolerance(Internal_TessellateSetting(mp.m_tolerance))
+  , m_max_angle(Internal_TessellateSetting(mp.m_max_ang_radians))
+  , m_max_chr(Internal_TessellateSetting(mp.m_max_chr))
+  , m_min_length(Internal_TessellateSetting(mp.m_min_edge_length))
+  , m_max_length(Internal_TessellateSetting(mp.m_max_edge_length))
+{
+  if (0.0 == m_tolerance && 0.0 == m_max_angle && 0.0 == m_max_chr)
+    m_max_angle = 15.0 * ON_DEGREES_TO_RADIANS;
+  if (m_max_length > 0.0 && m_min_length > m_max_length)
+    m_min_length = m_max_length;
+}
+
+void ON_Internal_CurveTessellator::Internal_AddPoint(const ON_3dPoint& P, double t, bool bPieceStart)
+{
+  if (bPieceStart && m_points->Count() > m_point_count0)
+  {
+    // pieces of a continuous curve share end points
+    if (P.DistanceTo(*m_points->Last()) <= ON_ZERO_TOLERANCE)
+      return;
+  }
+  m_points->Append(P);
+  if (nullptr != m_t)
+    m_t->Append(t);
+}
+
+static unsigned int Internal_SegmentCount(double x)
+{
+  if (!(x > 1.0))
+    return 1;
+  if (!(x < (double)ON_INTERNAL_TESSELLATE_MAX_SEGMENTS))
+    return ON_INTERNAL_TESSELLATE_MAX_SEGMENTS;
+  return (unsigned int)ceil(x - ON_SQRT_EPSILON);
+}
+
+unsigned int ON_Internal_CurveTessellator::Internal_LineSegmentCount(double length) const
+{
+  return (m_max_length > 0.0) ? Internal_SegmentCount(length / m_max_length) : 1U;
+}
+
+unsigned int ON_Internal_CurveTessellator::Internal_ArcSegmentCount(double radius, double angle) const
+{
+  // Largest angle a segment may subtend. A segment that subtends the angle a has
+  // chord length 2r*sin(a/2) and chord height r*(1-cos(a/2)), and the tangents at
+  // its ends differ by a.
+  double a = ON_HALFPI;
+  if (m_tolerance > 0.0 && m_tolerance < radius)
+    a = ON_Min(a, 2.0 * acos(1.0 - m_tolerance / radius));
+  if (m_max_angle > 0.0)
+    a = ON_Min(a, m_max_angle);
+  if (m_max_chr > 0.0)
+    a = ON_Min(a, 4.0 * atan(2.0 * m_max_chr));
+  if (m_max_length > 0.0 && m_max_length < 2.0 * radius)
+    a = ON_Min(a, 2.0 * asin(0.5 * m_max_length / radius));
+  unsigned int segment_count = Internal_SegmentCount(angle / a);
+
+  if (m_min_length > 0.0 && segment_count > 1)
+  {
+    // The minimum length takes precedence, but segments never subtend more than 90 degrees.
+    const double min_a = (m_min_length < 2.0 * radius) ? 2.0 * asin(0.5 * m_min_length / radius) : ON_PI;
+    const double max_count = floor(angle / min_a);
+    if (max_count < (double)segment_count)
+    {
+      const unsigned int min_count = Internal_SegmentCount(angle / ON_HALFPI);
+      segment_count = (max_count > (double)min_count) ? (unsigned int)max_count : min_count;
+    }
+  }
+
+  return segment_count;
+}
+
+bool ON_Internal_CurveTessellator::Internal_IsFlat(const ON_4dPoint* cv, int order) const
+{
+  // Positively weighted Bezier spans lie in the convex hull of their Euclidean
+  // control points, and the control polygon turns at least as much as the span.
+  const ON_3dPoint P0 = ON_3dPoint(cv[0]);
+  const ON_3dPoint P1 = ON_3dPoint(cv[order - 1]);
+  const ON_3dVector D = P1 - P0;
+  const double DoD = D * D;
+  const double chord_length = sqrt(DoD);
+
+  double polygon_length = 0.0;
+  double height = 0.0;
+  double turning = 0.0;
+  ON_3dPoint A = P0;
+  ON_3dVector prev_leg = ON_3dVector::ZeroVector;
+  for (int i = 1; i < order; i++)
+  {
+    const ON_3dPoint B = ON_3dPoint(cv[i]);
+    const ON_3dVector leg = B - A;
+    const double leg_length = leg.Length();
+    if (leg_length > 0.0)
+    {
+      polygon_length += leg_length;
+      if (!prev_leg.IsZero())
+        turning += atan2(ON_CrossProduct(prev_leg, leg).Length(), prev_leg * leg);
+      prev_leg = leg;
+    }
+    if (i + 1 < order)
+    {
+      // distance from B to the chord
+      double s = (DoD > 0.0) ? ((B - P0) * D) / DoD : 0.0;
+      if (s < 0.0)
+        s = 0.0;
+      else if (s > 1.0)
+        s = 1.0;
+      height = ON_Max(height, B.DistanceTo(P0 + s * D));
+    }
+    A = B;
+  }
+
+  if (!(polygon_length > 0.0))
+    return true;
+  if (m_min_length > 0.0 && polygon_length < 2.0 * m_min_length)
+    return true; // splitting would create a segment shorter than m_min_length
+  if (turning > ON_HALFPI)
+    return false;
+  if (m_max_angle > 0.0 && turning > m_max_angle)
+    return false;
+  if (m_tolerance > 0.0 && height > m_tolerance)
+    return false;
+  if (m_max_chr > 0.0 && height > m_max_chr * chord_length)
+    return false;
+  if (m_max_length > 0.0 && chord_length > m_max_length)
+    return false;
+  return true;
+}
+
+void ON_Internal_CurveTessellator::Internal_AppendLine(const ON_Line& line, const ON_Interval& s, const ON_Interval& t)
+{
+  const ON_3dPoint P0 = line.PointAt(s.m_t[0]);
+  const ON_3dPoint P1 = line.PointAt(s.m_t[1]);
+  const double length = P0.DistanceTo(P1);
+  if (!(length > 0.0))
+    return;
+  Internal_AddPoint(P0, t.m_t[0], true);
+  const unsigned int segment_count = Internal_LineSegmentCount(length);
+  for (unsigned int i = 1; i < segment_count; i++)
+  {
+    const double x = ((double)i) / ((double)segment_count);
+    Internal_AddPoint(line.PointAt(s.ParameterAt(x)), t.ParameterAt(x), false);
+  }
+  Internal_AddPoint(P1, t.m_t[1], false);
+}
+
+void ON_Internal_CurveTessellator::Internal_AppendArc(const ON_Arc& arc, const ON_Interval& a, const ON_Interval& t)
+{
+  const double angle = fabs(a.Length());
+  if (!(arc.radius > 0.0) || !(angle > 0.0))
+    return;
+  Internal_AddPoint(arc.PointAt(a.m_t[0]), t.m_t[0], true);
+  const unsigned int segment_count = Internal_ArcSegmentCount(arc.radius, angle);
+  for (unsigned int i = 1; i < segment_count; i++)
+  {
+    const double x = ((double)i) / ((double)segment_count);
+    Internal_AddPoint(arc.PointAt(a.ParameterAt(x)), t.ParameterAt(x), false);
+  }
+  Internal_AddPoint(arc.PointAt(a.m_t[1]), t.m_t[1], false);
+}
+
+void ON_Internal_CurveTessellator::Internal_AppendBezier(const ON_4dPoint* cv, int order, bool bReversed, const ON_Interval& t)
+{
+  if (nullptr == cv || order < 2)
+    return;
+
+  m_stack.SetCount(0);
+  m_cv.SetCount(0);
+  m_cv.Reserve(4 * order);
+  m_cv.SetCount(order);
+  for (int i = 0; i < order; i++)
+    m_cv[i] = cv[bReversed ? (order - 1 - i) : i];
+  m_work.Reserve(order);
+  m_work.SetCount(order);
+
+  Internal_AddPoint(ON_3dPoint(m_cv[0]), t.m_t[0], true);
+
+  ON_Internal_TessNode& root = m_stack.AppendNew();
+  root.m_u[0] = 0.0;
+  root.m_u[1] = 1.0;
+  root.m_depth = 0;
+
+  while (m_stack.Count() > 0)
+  {
+    // Depth first, left to right, so the points are added in order.
+    const int k = m_stack.Count() - 1;
+    const ON_Internal_TessNode node = m_stack[k];
+    if (node.m_depth >= ON_INTERNAL_TESSELLATE_MAX_DEPTH || Internal_IsFlat(m_cv.Array() + k * order, order))
+    {
+      Internal_AddPoint(ON_3dPoint(m_cv[k * order + order - 1]), t.ParameterAt(node.m_u[1]), false);
+      m_stack.SetCount(k);
+      continue;
+    }
+
+    // Split at the middle. The right half replaces the node and the left half is pushed.
+    if (m_cv.Count() < (k + 2) * order)
+    {
+      m_cv.Reserve(2 * (k + 2) * order);
+      m_cv.SetCount((k + 2) * order);
+    }
+    ON_4dPoint* right = m_cv.Array() + k * order;
+    ON_4dPoint* left = right + order;
+    ON_4dPoint* w = m_work.Array();
+    memcpy(w, right, order * sizeof(w[0]));
+    left[0] = w[0];
+    for (int r = 1; r < order; r++)
+    {
+      for (int i = 0; i < order - r; i++)
+      {
+        w[i].x = 0.5 * (w[i].x + w[i + 1].x);
+        w[i].y = 0.5 * (w[i].y + w[i + 1].y);
+        w[i].z = 0.5 * (w[i].z + w[i + 1].z);
+        w[i].w = 0.5 * (w[i].w + w[i + 1].w);
+      }
+      left[r] = w[0];
+      right[order - 1 - r] = w[order - 1 - r];
+    }
+
+    const double u = 0.5 * (node.m_u[0] + node.m_u[1]);
+    m_stack[k].m_u[0] = u;
+    m_stack[k].m_depth = node.m_depth + 1;
+    ON_Internal_TessNode& left_node = m_stack.AppendNew();
+    left_node.m_u[0] = node.m_u[0];
+    left_node.m_u[1] = u;
+    left_node.m_depth = node.m_depth + 1;
+  }
+}
+
+bool ON_Internal_CurveTessellator::Internal_AppendPieces(const ON_CurvePieceList& pieces)
+{
+  const unsigned int piece_count = pieces.PieceCount();
+  for (unsigned int i = 0; i < piece_count; i++)
+  {
+    const ON_CurvePiece& piece = pieces.Piece(i);
+    ON_Interval s = piece.m_piece_domain;
+    if (piece.m_bReversed)
+      s.Swap();
+    switch (piece.m_type)
+    {
+    case ON_CurvePiece::Type::Line:
+      Internal_AppendLine(piece.m_line, s, piece.m_curve_domain);
+      break;
+    case ON_CurvePiece::Type::Arc:
+      Internal_AppendArc(piece.m_arc, s, piece.m_curve_domain);
+      break;
+    case ON_CurvePiece::Type::Bezier:
+      Internal_AppendBezier(pieces.BezierCV(i), piece.m_order, piece.m_bReversed, piece.m_curve_domain);
+      break;
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+unsigned int ON_Internal_CurveTessellator::Tessellate(
+  const ON_Curve& curve,
+  ON_SimpleArray<ON_3dPoint>& points,
+  ON_SimpleArray<double>* t
+  )
+{
+  m_points = &points;
+  m_t = t;
+  m_point_count0 = points.Count();
+  const int t_count0 = (nullptr != t) ? t->Count() : 0;
+
+  bool rc = false;
+  const ON_LineCurve* line_curve = ON_LineCurve::Cast(&curve);
+  const ON_ArcCurve* arc_curve = (nullptr == line_curve) ? ON_ArcCurve::Cast(&curve) : nullptr;
+  const ON_PolylineCurve* polyline_curve = (nullptr == line_curve && nullptr == arc_curve) ? ON_PolylineCurve::Cast(&curve) : nullptr;
+  if (nullptr != line_curve)
+  {
+    Internal_AppendLine(line_curve->m_line, ON_Interval::ZeroToOne, line_curve->m_t);
+    rc = true;
+  }
+  else if (nullptr != arc_curve)
+  {
+    Internal_AppendArc(arc_curve->m_arc, arc_curve->m_arc.DomainRadians(), arc_curve->m_t);
+    rc = true;
+  }
+  else if (nullptr != polyline_curve)
+  {
+    const ON_Polyline& pline = polyline_curve->m_pline;
+    const int point_count = pline.Count();
+    rc = (point_count >= 2 && polyline_curve->m_t.Count() == point_count);
+    for (int i = 0; rc && i + 1 < point_count; i++)
+    {
+      const ON_Interval segment_domain(polyline_curve->m_t[i], polyline_curve->m_t[i + 1]);
+      Internal_AppendLine(ON_Line(pline[i], pline[i + 1]), ON_Interval::ZeroToOne, segment_domain);
+    }
+  }
+  else
+  {
+    ON_CurvePieceList pieces;
+    rc = pieces.Create(curve) && Internal_AppendPieces(pieces);
+  }
+
+  const unsigned int point_count = (unsigned int)(points.Count() - m_point_count0);
+  m_points = nullptr;
+  m_t = nullptr;
+  if (!rc || point_count < 2)
+  {
+    points.SetCount(m_point_count0);
+    if (nullptr != t)
+      t->SetCount(t_count0);
+    return 0;
+  }
+  return point_count;
+}
+
+unsigned int ON_TessellateCurve(
+  const ON_Curve& curve,
+  const ON_MeshCurveParameters& mp,
+  ON_SimpleArray<ON_3dPoint>& points,
+  ON_SimpleArray<double>* t
+  )
+{
+  ON_Internal_CurveTessellator tessellator(mp);
+  return tessellator.Tessellate(curve, points, t);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// ON_CurveTessellation
+//
+
+void ON_CurveTessellation::Destroy()
+{
+  m_points.Destroy();
+  m_t.Destroy();
+  m_point_index.Destroy();
+}
+
+unsigned int ON_CurveTessellation::CurveCount() const
+{
+  return (m_point_index.UnsignedCount() > 0) ? (m_point_index.UnsignedCount() - 1) : 0U;
+}
+
+unsigned int ON_CurveTessellation::PointCount(
+  unsigned int curve_index
+  ) const
+{
+  return (curve_index < CurveCount()) ? (m_point_index[curve_index + 1] - m_point_index[curve_index]) : 0U;
+}
+
+const ON_3dPoint* ON_CurveTessellation::Points(
+  unsigned int curve_index
+  ) const
+{
+  return (PointCount(curve_index) > 0) ? (m_points.Array() + m_point_index[curve_index]) : nullptr;
+}
+
+const double* ON_CurveTessellation::Parameters(
+  unsigned int curve_index
+  ) const
+{
+  return (PointCount(curve_index) > 0 && m_t.Count() == m_points.Count()) ? (m_t.Array() + m_point_index[curve_index]) : nullptr;
+}
+
+class ON_Internal_TessBatchContext
+{
+public:
+  const ON_Curve* const* m_curves = nullptr;
+  const ON_MeshCurveParameters* m_mp = nullptr;
+  ON_SimpleArray<ON_3dPoint>* m_curve_points = nullptr;
+  ON_SimpleArray<double>* m_curve_t = nullptr;
+  ON_CurveTessellation* m_tessellation = nullptr;
+};
+
+static void Internal_TessellateCurvesRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+  )
+{
+  const ON_Internal_TessBatchContext* ctx = (const ON_Internal_TessBatchContext*)context;
+  ON_Internal_CurveTessellator tessellator(*ctx->m_mp);
+  for (size_t i = i0; i < i1; i++)
+  {
+    if (nullptr != ctx->m_curves[i])
+      tessellator.Tessellate(*ctx->m_curves[i], ctx->m_curve_points[i], &ctx->m_curve_t[i]);
+  }
+}
+
+static void Internal_CopyTessellationRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+  )
+{
+  const ON_Internal_TessBatchContext* ctx = (const ON_Internal_TessBatchContext*)context;
+  ON_CurveTessellation& tessellation = *ctx->m_tessellation;
+  for (size_t i = i0; i < i1; i++)
+  {
+    const ON_SimpleArray<ON_3dPoint>& points = ctx->m_curve_points[i];
+    if (points.Count() <= 0)
+      continue;
+    const unsigned int point_index = tessellation.m_point_index[(int)i];
+    memcpy(tessellation.m_points.Array() + point_index, points.Array(), points.UnsignedCount() * sizeof(points[0]));
+    memcpy(tessellation.m_t.Array() + point_index, ctx->m_curve_t[i].Array(), points.UnsignedCount() * sizeof(double));
+  }
+}
+
+unsigned int ON_TessellateCurves(
+  size_t curve_count,
+  const ON_Curve* const* curves,
+  const ON_MeshCurveParameters& mp,
+  bool bParallel,
+  ON_CurveTessellation& tessellation
+  )
+{
+  tessellation.Destroy();
+  if (0 == curve_count || nullptr == curves || curve_count >= (size_t)ON_UNSET_UINT_INDEX)
+    return 0;
+
+  // Each curve is tessellated into its own arrays and then copied into
+  // the shared arrays.
+  ON_ClassArray< ON_SimpleArray<ON_3dPoint> > curve_points((int)curve_count);
+  ON_ClassArray< ON_SimpleArray<double> > curve_t((int)curve_count);
+  curve_points.SetCount((int)curve_count);
+  curve_t.SetCount((int)curve_count);
+
+  ON_Internal_TessBatchContext ctx;
+  ctx.m_curves = curves;
+  ctx.m_mp = &mp;
+  ctx.m_curve_points = curve_points.Array();
+  ctx.m_curve_t = curve_t.Array();
+  ctx.m_tessellation = &tessellation;
+  ON_ParallelFor(curve_count, 0x10, bParallel ? 0U : 1U, Internal_TessellateCurvesRange, (ON__UINT_PTR)&ctx);
+
+  unsigned int tessellated_count = 0;
+  size_t point_count = 0;
+  tessellation.m_point_index.Reserve((int)(curve_count + 1));
+  for (size_t i = 0; i < curve_count; i++)
+  {
+    tessellation.m_point_index.Append((unsigned int)point_count);
+    const int count = curve_points[(int)i].Count();
+    if (count > 0)
+    {
+      tessellated_count++;
+      point_count += (size_t)count;
+    }
+  }
+  if (point_count > 0x7FFFFFFF)
+  {
+    ON_ERROR("Too many points.");
+    tessellation.Destroy();
+    return 0;
+  }
+  tessellation.m_point_index.Append((unsigned int)point_count);
+
+  tessellation.m_points.Reserve((int)point_count);
+  tessellation.m_points.SetCount((int)point_count);
+  tessellation.m_t.Reserve((int)point_count);
+  tessellation.m_t.SetCount((int)point_count);
+  ON_ParallelFor(curve_count, 0x40, bParallel ? 0U : 1U, Internal_CopyTessellationRange, (ON__UINT_PTR)&ctx);
+
+  return tessellated_count;
+}
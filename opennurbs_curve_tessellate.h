@@ -0,0 +1,134 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//   Adaptive curve tessellation
+//
+////////////////////////////////////////////////////////////////
+
+#if !defined(OPENNURBS_CURVE_TESSELLATE_INC_)
+#define OPENNURBS_CURVE_TESSELLATE_INC_
+
+/*
+Description:
+  Approximate a curve with a polyline.
+Parameters:
+  curve - [in]
+    Any curve supported by ON_CurvePieceList.
+  mp - [in]
+    The polyline meets these ON_MeshCurveParameters settings:
+      m_tolerance: maximum distance from the curve to the polyline.
+      m_max_ang_radians: maximum angle between the curve tangents at
+        the ends of a polyline segment.
+      m_max_chr: maximum (chord height)/(chord length).
+      m_max_edge_length: maximum segment length.
+      m_min_edge_length: segments are not split when a part would be
+        shorter than this. This setting takes precedence over the others.
+    Settings that are <= 0 are ignored. If m_tolerance, m_max_ang_radians
+    and m_max_chr are all <= 0, a maximum angle of 15 degrees is used.
+    m_main_seg_count, m_sub_seg_count and m_max_aspect are ignored.
+  points - [out]
+    The polyline points are appended to this array.
+  t - [out]
+    If not nullptr, the curve parameters of the points are appended to
+    this array.
+Returns:
+  Number of points appended. 0 if the curve cannot be tessellated.
+Remarks:
+  Lines, arcs and polylines are tessellated directly. Other curves are
+  decomposed with ON_CurvePieceList and each Bezier span is subdivided
+  until its control polygon satisfies the settings. The control polygon
+  bounds the span, so the tolerance and angle settings are guaranteed
+  rather than sampled. Polyline vertices, kinks and piece ends are
+  always polyline points, and no segment turns more than 90 degrees.
+*/
+ON_DECL
+unsigned int ON_TessellateCurve(
+  const ON_Curve& curve,
+  const ON_MeshCurveParameters& mp,
+  ON_SimpleArray<ON_3dPoint>& points,
+  ON_SimpleArray<double>* t
+  );
+
+/*
+Description:
+  The polylines of many curves stored in shared arrays.
+  ON_TessellateCurves() creates an ON_CurveTessellation.
+*/
+class ON_CLASS ON_CurveTessellation
+{
+public:
+  ON_CurveTessellation() = default;
+  ~ON_CurveTessellation() = default;
+  ON_CurveTessellation(const ON_CurveTessellation&) = default;
+  ON_CurveTessellation& operator=(const ON_CurveTessellation&) = default;
+
+  void Destroy();
+
+  unsigned int CurveCount() const;
+
+  /*
+  Returns:
+    Number of polyline points for the curve. 0 if the curve could not
+    be tessellated.
+  */
+  unsigned int PointCount(
+    unsigned int curve_index
+    ) const;
+
+  const ON_3dPoint* Points(
+    unsigned int curve_index
+    ) const;
+
+  const double* Parameters(
+    unsigned int curve_index
+    ) const;
+
+  // Polyline points of all curves.
+  ON_SimpleArray<ON_3dPoint> m_points;
+
+  // m_t[i] = curve parameter of m_points[i].
+  ON_SimpleArray<double> m_t;
+
+  // Curve i uses m_points[m_point_index[i]] to m_points[m_point_index[i+1]-1].
+  // When there are curves, m_point_index[] has CurveCount()+1 elements.
+  ON_SimpleArray<unsigned int> m_point_index;
+};
+
+/*
+Description:
+  Tessellate many curves.
+Parameters:
+  curve_count - [in]
+  curves - [in]
+    Null curves are skipped.
+  mp - [in]
+    See ON_TessellateCurve().
+  bParallel - [in]
+    If true, curves are tessellated and copied by multiple threads.
+  tessellation - [out]
+    The polylines. Previous contents are destroyed.
+Returns:
+  Number of curves that were tessellated.
+*/
+ON_DECL
+unsigned int ON_TessellateCurves(
+  size_t curve_count,
+  const ON_Curve* const* curves,
+  const ON_MeshCurveParameters& mp,
+  bool bParallel,
+  ON_CurveTessellation& tessellation
+  );
+
+#endif
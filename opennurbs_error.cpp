@@ -21,6 +21,8 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+#include "opennurbs_subd_data.h"
+
 
 // openNURBS Geometry Library Errors and Warnings
 //
@@ -127,8 +129,32 @@ void ON_BrepIncrementErrorCount()
   ON_Brep::ErrorCount++;
 } 
 
+static thread_local ON_SubDErrorCountCapture* ON_SUBD_ERROR_COUNT_CAPTURE = nullptr;
+
+ON_SubDErrorCountCapture::ON_SubDErrorCountCapture()
+  : m_previous_capture(ON_SUBD_ERROR_COUNT_CAPTURE)
+{
+  ON_SUBD_ERROR_COUNT_CAPTURE = this;
+}
+
+ON_SubDErrorCountCapture::~ON_SubDErrorCountCapture()
+{
+  ON_SUBD_ERROR_COUNT_CAPTURE = m_previous_capture;
+}
+
+unsigned int ON_SubDErrorCountCapture::Count() const
+{
+  return m_count;
+}
+
 void ON_SubDIncrementErrorCount()
 {
+  if (nullptr != ON_SUBD_ERROR_COUNT_CAPTURE)
+  {
+    // An ON_ParallelFor worker is running. The calling thread reports the count.
+    ON_SUBD_ERROR_COUNT_CAPTURE->m_count++;
+    return;
+  }
   ON_ERROR_COUNT++;
   ON_SubD::ErrorCount++;
 } 
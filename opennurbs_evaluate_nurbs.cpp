@@ -669,13 +669,24 @@ RELATED FUNCTIONS:
   return true;
 }
 
-bool ON_EvaluateNurbsBasis(
-  int order, 
+/*
+The evaluators below are templates on the order (and, where it matters,
+the dimension) so the common degree 1 to 3 cases in 2d, 3d and 3d
+rational are compiled with constant loop bounds. When fixed_order or
+fixed_dim is > 0 it replaces the runtime value, the compiler unrolls the
+loops and the scratch buffer size tests fold away. The arithmetic is the
+same in every instantiation, so the specialized and generic paths return
+identical results. A value of 0 selects the generic code.
+*/
+template <int fixed_order>
+static bool Internal_EvaluateNurbsBasis(
+  int runtime_order,
   const double* knot,
   double t,
-  double* N 
+  double* N
   )
 {
+  const int order = (fixed_order > 0) ? fixed_order : runtime_order;
   double a0, a1, x, y;
   const double *k0;
   double *t_k, *k_t, *N0;
@@ -766,13 +777,37 @@ bool ON_EvaluateNurbsBasis(
 }
 
 
-bool ON_EvaluateNurbsBasisDerivatives(
-  int order,
+bool ON_EvaluateNurbsBasis(
+  int order, 
+  const double* knot,
+  double t,
+  double* N 
+  )
+{
+  switch (order)
+  {
+  case 2:
+    return Internal_EvaluateNurbsBasis<2>(order, knot, t, N);
+  case 3:
+    return Internal_EvaluateNurbsBasis<3>(order, knot, t, N);
+  case 4:
+    return Internal_EvaluateNurbsBasis<4>(order, knot, t, N);
+  default:
+    break;
+  }
+  return Internal_EvaluateNurbsBasis<0>(order, knot, t, N);
+}
+
+
+template <int fixed_order>
+static bool Internal_EvaluateNurbsBasisDerivatives(
+  int runtime_order,
   const double* knot, 
   int der_count,
   double* N 
 )
 {
+  const int order = (fixed_order > 0) ? fixed_order : runtime_order;
 	double dN, c;
 	const double *k0, *k1;
 	double *a0, *a1, *ptr, **dk;
@@ -885,10 +920,185 @@ bool ON_EvaluateNurbsBasisDerivatives(
   return true;
 }
 
+bool ON_EvaluateNurbsBasisDerivatives(
+  int order,
+  const double* knot, 
+  int der_count,
+  double* N 
+)
+{
+  switch (order)
+  {
+  case 2:
+    return Internal_EvaluateNurbsBasisDerivatives<2>(order, knot, der_count, N);
+  case 3:
+    return Internal_EvaluateNurbsBasisDerivatives<3>(order, knot, der_count, N);
+  case 4:
+    return Internal_EvaluateNurbsBasisDerivatives<4>(order, knot, der_count, N);
+  default:
+    break;
+  }
+  return Internal_EvaluateNurbsBasisDerivatives<0>(order, knot, der_count, N);
+}
+
+bool ON_NurbsSpanBasis::SetSpan(
+  int order,
+  const double* knot
+  )
+{
+  m_order = 0;
+  m_bEmptySpan = false;
+  if (order < 2 || order > ON_NurbsSpanBasis::MaximumOrder || nullptr == knot)
+    return false;
+
+  const int d = order - 1;
+  for (int i = 0; i < 2 * d; i++)
+  {
+    if (false == ON_IsValid(knot[i]) || (i > 0 && knot[i] < knot[i - 1]))
+      return false;
+    m_knot[i] = knot[i];
+  }
+
+  m_order = order;
+  if (knot[d - 1] == knot[d])
+  {
+    // value is defined to be zero on empty spans
+    m_bEmptySpan = true;
+    return true;
+  }
+
+  for (int j = 1; j <= d; j++)
+  {
+    for (int r = 0; r < j; r++)
+      m_inverse_knot_difference[j][r] = 1.0 / (knot[d + r] - knot[d - j + r]);
+  }
+
+  return true;
+}
+
+int ON_NurbsSpanBasis::Order() const
+{
+  return m_order;
+}
+
+ON_Interval ON_NurbsSpanBasis::Domain() const
+{
+  return (m_order >= 2) ? ON_Interval(m_knot[m_order - 2], m_knot[m_order - 1]) : ON_Interval::EmptyInterval;
+}
+
+bool ON_NurbsSpanBasis::Evaluate(
+  double t,
+  int der_count,
+  double* N
+  ) const
+{
+  const int order = m_order;
+  if (order < 2 || der_count < 0 || nullptr == N)
+    return false;
+
+  const int d = order - 1;
+  if (m_bEmptySpan)
+  {
+    memset(N, 0, (der_count + 1) * order * sizeof(N[0]));
+    return true;
+  }
+
+  // ndu[r][j] (r <= j) = value of the r-th degree j basis function.
+  // This is the triangular scheme used by ON_EvaluateNurbsBasis()
+  // with the divisions replaced by multiplications.
+  double ndu[ON_NurbsSpanBasis::MaximumOrder][ON_NurbsSpanBasis::MaximumOrder];
+  double left[ON_NurbsSpanBasis::MaximumOrder];
+  double right[ON_NurbsSpanBasis::MaximumOrder];
+  ndu[0][0] = 1.0;
+  for (int j = 1; j <= d; j++)
+  {
+    left[j] = t - m_knot[d - j];
+    right[j] = m_knot[d - 1 + j] - t;
+    double saved = 0.0;
+    for (int r = 0; r < j; r++)
+    {
+      const double y = ndu[r][j - 1] * m_inverse_knot_difference[j][r];
+      ndu[r][j] = saved + right[r + 1] * y;
+      saved = left[j - r] * y;
+    }
+    ndu[j][j] = saved;
+  }
+  for (int i = 0; i <= d; i++)
+    N[i] = ndu[i][d];
+
+  // Same end knot cleanup as ON_EvaluateNurbsBasis().
+  const double x = 1.0 - ON_SQRT_EPSILON;
+  if (N[0] >= x)
+  {
+    if (N[0] != 1.0 && N[0] <= 1.0 + ON_SQRT_EPSILON)
+    {
+      int i = 1;
+      while (i <= d && 0.0 == N[i])
+        i++;
+      if (i > d)
+        N[0] = 1.0;
+    }
+  }
+  else if (N[d] >= x)
+  {
+    if (N[d] != 1.0 && N[d] <= 1.0 + ON_SQRT_EPSILON)
+    {
+      int i = 0;
+      while (i < d && 0.0 == N[i])
+        i++;
+      if (i == d)
+        N[d] = 1.0;
+    }
+  }
+
+  if (der_count <= 0)
+    return true;
+
+  const int n = (der_count < d) ? der_count : d;
+  if (1 == n)
+  {
+    // First derivatives are differences of the degree d-1 basis functions.
+    const double* inv = m_inverse_knot_difference[d];
+    double* N1 = N + order;
+    double y0 = 0.0;
+    for (int r = 0; r < d; r++)
+    {
+      const double y1 = ndu[r][d - 1] * inv[r];
+      N1[r] = y0 - y1;
+      y0 = y1;
+    }
+    N1[d] = y0;
+
+    // apply d!/(d-1)! scaling factor
+    for (int i = 0; i <= d; i++)
+      N1[i] *= (double)d;
+  }
+  else if (n >= 2)
+  {
+    // ON_EvaluateNurbsBasisDerivatives() needs the basis functions of
+    // every degree in the layout ON_EvaluateNurbsBasis() uses.
+    double T[ON_NurbsSpanBasis::MaximumOrder * ON_NurbsSpanBasis::MaximumOrder];
+    for (int j = 0; j <= d; j++)
+    {
+      for (int r = 0; r <= j; r++)
+        T[(d - j) * (order + 1) + r] = ndu[r][j];
+    }
+    memcpy(T, N, order * sizeof(T[0])); // cleaned up values
+    ON_EvaluateNurbsBasisDerivatives(order, m_knot, n, T);
+    memcpy(N + order, T + order, n * order * sizeof(T[0]));
+  }
+
+  if (der_count > n)
+    memset(N + (n + 1) * order, 0, (der_count - n) * order * sizeof(N[0]));
+
+  return true;
+}
+
+template <int fixed_order, int fixed_dim>
 static
-bool ON_EvaluateNurbsNonRationalSpan( 
-                  int dim,             // dimension
-                  int order,           // order
+bool Internal_EvaluateNurbsNonRationalSpan( 
+                  int runtime_dim,     // dimension
+                  int runtime_order,   // order
                   const double* knot,  // knot[] array of (2*order-2) doubles
                   int cv_stride,       // cv_stride >= (is_rat)?dim+1:dim
                   const double* cv,    // cv[order*cv_stride] array
@@ -898,6 +1108,8 @@ bool ON_EvaluateNurbsNonRationalSpan(
                   double* v            // v[(der_count+1)*v_stride] array
                   )
 {
+  const int dim = (fixed_dim > 0) ? fixed_dim : runtime_dim;
+  const int order = (fixed_order > 0) ? fixed_order : runtime_order;
   const int stride_minus_dim = cv_stride - dim;
   const int cv_len = cv_stride*order;
   int i, j, k;
@@ -929,9 +1141,9 @@ bool ON_EvaluateNurbsNonRationalSpan(
     der_count = order-1;
 
 	// evaluate basis functions
-	ON_EvaluateNurbsBasis( order, knot, t, N );
+	Internal_EvaluateNurbsBasis<fixed_order>( order, knot, t, N );
 	if ( der_count ) 
-		ON_EvaluateNurbsBasisDerivatives( order, knot, der_count, N );
+		Internal_EvaluateNurbsBasisDerivatives<fixed_order>( order, knot, der_count, N );
 
 	// convert cv's into answers
 	for (i = 0; i <= der_count; i++, v += v_stride, N += order) {
@@ -966,6 +1178,62 @@ bool ON_EvaluateNurbsNonRationalSpan(
 	return true;
 }
 
+template <int fixed_order>
+static
+bool Internal_EvaluateNurbsNonRationalSpanDim( 
+                  int dim,
+                  int order,
+                  const double* knot,
+                  int cv_stride,
+                  const double* cv,
+                  int der_count,
+                  double t,
+                  int v_stride,
+                  double* v
+                  )
+{
+  // dim = 4 is the homogeneous case of 3d rational curves and surfaces
+  switch (dim)
+  {
+  case 2:
+    return Internal_EvaluateNurbsNonRationalSpan<fixed_order, 2>(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 3:
+    return Internal_EvaluateNurbsNonRationalSpan<fixed_order, 3>(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 4:
+    return Internal_EvaluateNurbsNonRationalSpan<fixed_order, 4>(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v);
+  default:
+    break;
+  }
+  return Internal_EvaluateNurbsNonRationalSpan<fixed_order, 0>(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v);
+}
+
+static
+bool ON_EvaluateNurbsNonRationalSpan( 
+                  int dim,             // dimension
+                  int order,           // order
+                  const double* knot,  // knot[] array of (2*order-2) doubles
+                  int cv_stride,       // cv_stride >= (is_rat)?dim+1:dim
+                  const double* cv,    // cv[order*cv_stride] array
+                  int der_count,       // number of derivatives to compute
+                  double t,            // evaluation parameter
+                  int v_stride,        // v_stride (>=dimension)
+                  double* v            // v[(der_count+1)*v_stride] array
+                  )
+{
+  switch (order)
+  {
+  case 2:
+    return Internal_EvaluateNurbsNonRationalSpanDim<2>(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 3:
+    return Internal_EvaluateNurbsNonRationalSpanDim<3>(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 4:
+    return Internal_EvaluateNurbsNonRationalSpanDim<4>(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v);
+  default:
+    break;
+  }
+  return Internal_EvaluateNurbsNonRationalSpan<0, 0>(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v);
+}
+
 static
 bool ON_EvaluateNurbsRationalSpan( 
                   int dim,             // dimension
@@ -1243,9 +1511,11 @@ bool ON_EvaluateNurbsSurfaceSpan(
 }
 
 
-bool ON_EvaluateNurbsDeBoor(
-                           int cv_dim,
-                           int order, 
+template <int fixed_order, int fixed_dim>
+static
+bool Internal_EvaluateNurbsDeBoor(
+                           int runtime_cv_dim,
+                           int runtime_order, 
                            int cv_stride,
                            double *cv,
                            const double *knots, 
@@ -1372,6 +1642,8 @@ bool ON_EvaluateNurbsDeBoor(
  *   TL_EvNurbBasis(), TL_EvNurb(), TL_EvdeCasteljau(), TL_EvQuotientRule()
  */
 {
+  const int cv_dim = (fixed_dim > 0) ? fixed_dim : runtime_cv_dim;
+  const int order = (fixed_order > 0) ? fixed_order : runtime_order;
   double 
     workarray[21], alpha0, alpha1, t0, t1, dt, *delta_t, *free_delta_t, *cv0, *cv1;
   const double 
@@ -1512,6 +1784,59 @@ bool ON_EvaluateNurbsDeBoor(
 }
 
 
+template <int fixed_order>
+static
+bool Internal_EvaluateNurbsDeBoorDim(
+                           int cv_dim,
+                           int order, 
+                           int cv_stride,
+                           double *cv,
+                           const double *knots, 
+                           int side,
+                           double mult_k, 
+                           double t
+                           )
+{
+  switch (cv_dim)
+  {
+  case 2:
+    return Internal_EvaluateNurbsDeBoor<fixed_order, 2>(cv_dim, order, cv_stride, cv, knots, side, mult_k, t);
+  case 3:
+    return Internal_EvaluateNurbsDeBoor<fixed_order, 3>(cv_dim, order, cv_stride, cv, knots, side, mult_k, t);
+  case 4:
+    return Internal_EvaluateNurbsDeBoor<fixed_order, 4>(cv_dim, order, cv_stride, cv, knots, side, mult_k, t);
+  default:
+    break;
+  }
+  return Internal_EvaluateNurbsDeBoor<fixed_order, 0>(cv_dim, order, cv_stride, cv, knots, side, mult_k, t);
+}
+
+bool ON_EvaluateNurbsDeBoor(
+                           int cv_dim,
+                           int order, 
+                           int cv_stride,
+                           double *cv,
+                           const double *knots, 
+                           int side,
+                           double mult_k, 
+                           double t
+                           )
+{
+  switch (order)
+  {
+  case 2:
+    return Internal_EvaluateNurbsDeBoorDim<2>(cv_dim, order, cv_stride, cv, knots, side, mult_k, t);
+  case 3:
+    return Internal_EvaluateNurbsDeBoorDim<3>(cv_dim, order, cv_stride, cv, knots, side, mult_k, t);
+  case 4:
+    return Internal_EvaluateNurbsDeBoorDim<4>(cv_dim, order, cv_stride, cv, knots, side, mult_k, t);
+  default:
+    break;
+  }
+  return Internal_EvaluateNurbsDeBoor<0, 0>(cv_dim, order, cv_stride, cv, knots, side, mult_k, t);
+}
+
+
 bool ON_EvaluateNurbsBlossom(int cvdim,
                              int order, 
                              int cv_stride,
@@ -196,6 +196,96 @@ bool ON_EvaluateNurbsBasisDerivatives(
   double* N
   );
 
+/*
+Description:
+  ON_NurbsSpanBasis evaluates the B-spline basis functions of one
+  span at many parameters. The reciprocals of the knot differences
+  used by the basis recurrences are calculated once by SetSpan(),
+  so each evaluation uses only multiplications and additions and
+  allocates no memory.
+Remarks:
+  A ON_NurbsSpanBasis is not modified by Evaluate() and may be used
+  by more than one thread at the same time.
+See Also:
+  ON_EvaluateNurbsBasis
+  ON_EvaluateNurbsBasisDerivatives
+*/
+class ON_CLASS ON_NurbsSpanBasis
+{
+public:
+  ON_NurbsSpanBasis() = default;
+  ~ON_NurbsSpanBasis() = default;
+  ON_NurbsSpanBasis(const ON_NurbsSpanBasis&) = default;
+  ON_NurbsSpanBasis& operator=(const ON_NurbsSpanBasis&) = default;
+
+  // Largest order SetSpan() accepts.
+  enum : int
+  {
+    MaximumOrder = 16
+  };
+
+  /*
+  Parameters:
+    order - [in]
+      2 <= order <= ON_NurbsSpanBasis::MaximumOrder
+    knot - [in]
+      array of 2*(order-1) knots. These are the knots that are active
+      for the span, the same as the knot[] parameter of
+      ON_EvaluateNurbsBasis().
+  Returns:
+    True if successful. False if the order is not supported or the
+    knots are not valid.
+  */
+  bool SetSpan(
+    int order,
+    const double* knot
+    );
+
+  /*
+  Returns:
+    Order passed to SetSpan() or 0 if no span is set.
+  */
+  int Order() const;
+
+  /*
+  Returns:
+    The span's domain [knot[order-2],knot[order-1]].
+  */
+  ON_Interval Domain() const;
+
+  /*
+  Description:
+    Evaluates the basis functions and their derivatives.
+  Parameters:
+    t - [in]
+      evaluation parameter
+    der_count - [in]
+      number of derivatives (>= 0)
+    N - [out]
+      array of (der_count+1)*Order() doubles.
+      N[k*Order()+i] = k-th derivative of the i-th basis function.
+      Derivatives with k >= Order() are zero.
+  Returns:
+    True if successful.
+  Remarks:
+    The results are the same as the results of ON_EvaluateNurbsBasis()
+    and ON_EvaluateNurbsBasisDerivatives(), up to rounding.
+  */
+  bool Evaluate(
+    double t,
+    int der_count,
+    double* N
+    ) const;
+
+private:
+  int m_order = 0;
+  bool m_bEmptySpan = false;
+  double m_knot[2 * MaximumOrder - 2] = {};
+  // m_inverse_knot_difference[j][r] = 1/(knot[d+r] - knot[d-j+r])
+  // for 1 <= j <= d and 0 <= r < j, where d = degree.
+  double m_inverse_knot_difference[MaximumOrder][MaximumOrder] = {};
+};
+
 /*
 Description:
   Evaluate a NURBS curve span.
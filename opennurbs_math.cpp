@@ -1552,20 +1552,9 @@ bool ON_TransformPointList(
       }
       break;
     default: // dim = 3
-      while(count--) {
-				w = xform.m_xform[3][0]*point[0] + xform.m_xform[3][1]*point[1] + xform.m_xform[3][2]*point[2] + xform.m_xform[3][3];
-        if (w==0.0)  {
-          rc = false;
-          w = 1.0;
-        }
-        else
-				  w = 1.0/w;
-				x = xform.m_xform[0][0]*point[0] + xform.m_xform[0][1]*point[1] + xform.m_xform[0][2]*point[2] + xform.m_xform[0][3];
-				y = xform.m_xform[1][0]*point[0] + xform.m_xform[1][1]*point[1] + xform.m_xform[1][2]*point[2] + xform.m_xform[1][3];
-				z = xform.m_xform[2][0]*point[0] + xform.m_xform[2][1]*point[1] + xform.m_xform[2][2]*point[2] + xform.m_xform[2][3];
-				point[0] = (float)(w*x); point[1] = (float)(w*y); point[2] = (float)(w*z);
-				point += stride;
-      }
+      // ON_Xform::TransformPointList() skips the homogeneous divide
+      // when xform is affine and gives identical results.
+      rc = xform.TransformPointList((size_t)count, (size_t)stride, point, false);
       break;
     }
   }
@@ -1651,20 +1640,9 @@ bool ON_TransformPointList(
       }
       break;
     default: // dim = 3
-      while(count--) {
-				w = xform.m_xform[3][0]*point[0] + xform.m_xform[3][1]*point[1] + xform.m_xform[3][2]*point[2] + xform.m_xform[3][3];
-        if (w==0.0)  {
-          rc = false;
-          w = 1.0;
-        }
-        else
-				  w = 1.0/w;
-				x = xform.m_xform[0][0]*point[0] + xform.m_xform[0][1]*point[1] + xform.m_xform[0][2]*point[2] + xform.m_xform[0][3];
-				y = xform.m_xform[1][0]*point[0] + xform.m_xform[1][1]*point[1] + xform.m_xform[1][2]*point[2] + xform.m_xform[1][3];
-				z = xform.m_xform[2][0]*point[0] + xform.m_xform[2][1]*point[1] + xform.m_xform[2][2]*point[2] + xform.m_xform[2][3];
-				point[0] = w*x; point[1] = w*y; point[2] = w*z;
-				point += stride;
-      }
+      // ON_Xform::TransformPointList() skips the homogeneous divide
+      // when xform is affine and gives identical results.
+      rc = xform.TransformPointList((size_t)count, (size_t)stride, point, false);
       break;
     }
   }
@@ -1705,7 +1683,7 @@ ON_TransformVectorList(
                   )
 {
   bool rc = true;
-  double x, y, z;
+  double x, y;
 
   if ( !ON_IsValidPointList( dim, 0, count, stride, vector ) )
     return false;
@@ -1730,13 +1708,7 @@ ON_TransformVectorList(
     }
     break;
   default: // dim >= 3
-    while(count--) {
-			x = xform.m_xform[0][0]*vector[0] + xform.m_xform[0][1]*vector[1] + xform.m_xform[0][2]*vector[2];
-			y = xform.m_xform[1][0]*vector[0] + xform.m_xform[1][1]*vector[1] + xform.m_xform[1][2]*vector[2];
-			z = xform.m_xform[2][0]*vector[0] + xform.m_xform[2][1]*vector[1] + xform.m_xform[2][2]*vector[2];
-			vector[0] = (float)x; vector[1] = (float)y; vector[2] = (float)z;
-			vector += stride;
-    }
+    rc = xform.TransformVectorList((size_t)count, (size_t)stride, vector, false);
     break;
   }
 
@@ -1753,7 +1725,7 @@ ON_TransformVectorList(
                   )
 {
   bool rc = true;
-  double x, y, z;
+  double x, y;
 
   if ( !ON_IsValidPointList( dim, 0, count, stride, vector ) )
     return false;
@@ -1778,13 +1750,7 @@ ON_TransformVectorList(
     }
     break;
   default: // dim >= 3
-    while(count--) {
-			x = xform.m_xform[0][0]*vector[0] + xform.m_xform[0][1]*vector[1] + xform.m_xform[0][2]*vector[2];
-			y = xform.m_xform[1][0]*vector[0] + xform.m_xform[1][1]*vector[1] + xform.m_xform[1][2]*vector[2];
-			z = xform.m_xform[2][0]*vector[0] + xform.m_xform[2][1]*vector[1] + xform.m_xform[2][2]*vector[2];
-			vector[0] = x; vector[1] = y; vector[2] = z;
-			vector += stride;
-    }
+    rc = xform.TransformVectorList((size_t)count, (size_t)stride, vector, false);
     break;
   }
 
@@ -2856,11 +2856,11 @@ bool ON_Mesh::GetBBox( // returns true if successful
       {
         const ON_3dPointArray& dV = DoublePrecisionVertices();
         if ( dV.UnsignedCount() == m_V.UnsignedCount() )
-          rc = m_vertex_bbox.Set(dV, false);
+          rc = m_vertex_bbox.SetFromPointList(false, dV.UnsignedCount(), 3, &dV[0].x, false, true);
       }
       if (false == rc)
       {
-        rc = m_vertex_bbox.Set(m_V, false);
+        rc = m_vertex_bbox.SetFromPointList(false, m_V.UnsignedCount(), 3, &m_V[0].x, false, true);
       }
     }
 
@@ -2936,7 +2936,7 @@ bool ON_Mesh::Transform(
   const bool bSyncheddV = bIsValid_fV && bIsValid_dV && HasSynchronizedDoubleAndSinglePrecisionVertices();
 
   if (bIsValid_dV)
-    ON_TransformPointList(3, false, vertex_count, 3, &m_dV[0][0], xform);
+    xform.TransformPointList(vertex_count, m_dV.Array(), true);
   
   double d = xform.Determinant();
   bool rc = false;
@@ -2949,7 +2949,7 @@ bool ON_Mesh::Transform(
   }
   else if ( bIsValid_fV )
   {
-    rc = ON_TransformPointList( 3, false, vertex_count, 3, &m_V[0][0], xform );
+    rc = xform.TransformPointList(vertex_count, m_V.Array(), true);
   }
 
   if ( rc )
@@ -2994,14 +2994,18 @@ bool ON_Mesh::Transform(
       //     in Andrew Glassner (editor), 
       //     Graphics Gems, Academic Press, Inc., 
       //     pp. 539-547, 1990. 
-      ON_Xform N_xform;
-      const double det = xform.GetSurfaceNormalXform(N_xform);
-      rc = ON_TransformVectorList( 3, vertex_count, 3, &m_N[0][0], N_xform )?true:false;
-      if ( det < 0.0 )
+      const double det = xform.TransformNormalList(vertex_count, 3, &m_N[0][0], true, true);
+      if (0.0 == det)
+      {
+        // xform is too close to singular to invert, for example a
+        // uniform scale by 1e-6, and the normals were not changed.
+        // Calculate them from the transformed vertices.
+        rc = ComputeFaceNormals() && ComputeVertexNormals();
+      }
+      else if ( det < 0.0 )
       {
         FlipVertexNormals();
       }
-      UnitizeVertexNormals();
     }
 
     if ( rc && HasFaceNormals() ) 
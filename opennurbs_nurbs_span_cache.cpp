@@ -0,0 +1,765 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+/*
+Description:
+  Convert Bezier control points to power basis coefficients.
+  power[j] = C(d,j) * Sum( 0 <= i <= j, (-1)^(j-i) C(j,i) bezier[i] )
+  where d = order-1. bezier[] and power[] must not overlap.
+*/
+static void Internal_BezierToPowerBasis(
+  int cvdim,
+  int order,
+  int bezier_stride,
+  const double* bezier,
+  int power_stride,
+  double* power
+  )
+{
+  const int d = order - 1;
+  for (int j = 0; j <= d; j++)
+  {
+    double* a = power + j * power_stride;
+    for (int k = 0; k < cvdim; k++)
+      a[k] = 0.0;
+    const double c = ON_BinomialCoefficient(j, d - j);
+    for (int i = 0; i <= j; i++)
+    {
+      double b = c * ON_BinomialCoefficient(i, j - i);
+      if (0 != ((j - i) & 1))
+        b = -b;
+      const double* cv = bezier + i * bezier_stride;
+      for (int k = 0; k < cvdim; k++)
+        a[k] += b * cv[k];
+    }
+  }
+}
+
+/*
+Description:
+  Evaluate a polynomial and its derivatives with Horner's scheme.
+Parameters:
+  a - [in]
+    order coefficients, a[j*coefficient_stride] is the coefficient of u^j.
+  P - [out]
+    P[n*P_stride] = n-th derivative at u for 0 <= n <= der_count.
+*/
+static void Internal_EvaluatePowerBasis(
+  int cvdim,
+  int order,
+  int coefficient_stride,
+  const double* a,
+  double u,
+  int der_count,
+  int P_stride,
+  double* P
+  )
+{
+  const int d = order - 1;
+  for (int n = 1; n <= der_count; n++)
+  {
+    double* Pn = P + n * P_stride;
+    for (int k = 0; k < cvdim; k++)
+      Pn[k] = 0.0;
+  }
+
+  const double* c = a + d * coefficient_stride;
+  for (int k = 0; k < cvdim; k++)
+    P[k] = c[k];
+
+  for (int j = d - 1; j >= 0; j--)
+  {
+    c -= coefficient_stride;
+    const int nmax = (der_count < d - j) ? der_count : (d - j);
+    for (int n = nmax; n >= 1; n--)
+    {
+      double* Pn = P + n * P_stride;
+      const double* Pm = Pn - P_stride;
+      for (int k = 0; k < cvdim; k++)
+        Pn[k] = Pn[k] * u + Pm[k];
+    }
+    for (int k = 0; k < cvdim; k++)
+      P[k] = P[k] * u + c[k];
+  }
+
+  double f = 1.0;
+  for (int n = 2; n <= der_count; n++)
+  {
+    f *= n;
+    double* Pn = P + n * P_stride;
+    for (int k = 0; k < cvdim; k++)
+      Pn[k] *= f;
+  }
+}
+
+static int Internal_SpanIndex(
+  const ON_SimpleArray<double>& span_t,
+  int span_count,
+  double t,
+  int side,
+  int* hint
+  )
+{
+  if (span_count <= 0)
+    return -1;
+  const double* a = span_t.Array();
+  if (nullptr != hint && *hint >= 0 && *hint < span_count)
+  {
+    if (a[*hint] < t && t < a[*hint + 1])
+      return *hint;
+  }
+  int i = ON_SearchMonotoneArray(a, span_count + 1, t);
+  if (i < 0)
+    i = 0;
+  else if (i >= span_count)
+    i = span_count - 1;
+  else if (side < 0 && i > 0 && t == a[i])
+    i--;
+  if (nullptr != hint)
+    *hint = i;
+  return i;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// ON_NurbsCurveSpanCache
+//
+
+bool ON_NurbsCurveSpanCache::Create(
+  const ON_NurbsCurve& curve
+  )
+{
+  Destroy();
+
+  const int dim = curve.m_dim;
+  const int order = curve.m_order;
+  const int cv_count = curve.m_cv_count;
+  if (dim < 1 || order < 2 || order > ON_NurbsCurveSpanCache::MaximumOrder || cv_count < order)
+    return false;
+  if (nullptr == curve.m_cv || nullptr == curve.m_knot || curve.m_cv_stride < curve.CVSize())
+    return false;
+
+  const int cvdim = curve.CVSize();
+  const double* knot = curve.m_knot;
+
+  int span_count = 0;
+  for (int i = 0; i <= cv_count - order; i++)
+  {
+    if (knot[i + order - 2] < knot[i + order - 1])
+      span_count++;
+  }
+  if (span_count <= 0)
+    return false;
+
+  const int span_size = order * cvdim;
+  m_span_t.Reserve(span_count + 1);
+  m_bezier_cv.Reserve(span_count * span_size);
+  m_bezier_cv.SetCount(span_count * span_size);
+  m_power.Reserve(span_count * span_size);
+  m_power.SetCount(span_count * span_size);
+
+  int span_index = 0;
+  for (int i = 0; i <= cv_count - order; i++)
+  {
+    const double t0 = knot[i + order - 2];
+    const double t1 = knot[i + order - 1];
+    if (!(t0 < t1))
+      continue;
+    double* bez = m_bezier_cv.Array() + span_index * span_size;
+    for (int j = 0; j < order; j++)
+      memcpy(bez + j * cvdim, curve.CV(i + j), cvdim * sizeof(bez[0]));
+    ON_ConvertNurbSpanToBezier(cvdim, order, cvdim, bez, knot + i, t0, t1);
+    Internal_BezierToPowerBasis(cvdim, order, cvdim, bez, cvdim, m_power.Array() + span_index * span_size);
+    m_span_t.Append(t0);
+    span_index++;
+  }
+  m_span_t.Append(knot[cv_count - 1]);
+
+  m_dim = dim;
+  m_is_rat = curve.m_is_rat ? 1 : 0;
+  m_order = order;
+  m_span_count = span_count;
+  m_content_crc = curve.DataCRC(0);
+
+  return true;
+}
+
+void ON_NurbsCurveSpanCache::Destroy()
+{
+  m_dim = 0;
+  m_is_rat = 0;
+  m_order = 0;
+  m_span_count = 0;
+  m_content_crc = 0;
+  m_span_t.SetCount(0);
+  m_bezier_cv.SetCount(0);
+  m_power.SetCount(0);
+}
+
+bool ON_NurbsCurveSpanCache::IsEmpty() const
+{
+  return (m_span_count <= 0);
+}
+
+bool ON_NurbsCurveSpanCache::IsCurrent(
+  const ON_NurbsCurve& curve
+  ) const
+{
+  if (m_span_count <= 0)
+    return false;
+  if (curve.m_dim != m_dim || curve.m_order != m_order || (curve.m_is_rat ? 1 : 0) != m_is_rat)
+    return false;
+  return (curve.DataCRC(0) == m_content_crc);
+}
+
+ON__UINT32 ON_NurbsCurveSpanCache::ContentCRC() const
+{
+  return m_content_crc;
+}
+
+int ON_NurbsCurveSpanCache::Dimension() const
+{
+  return m_dim;
+}
+
+bool ON_NurbsCurveSpanCache::IsRational() const
+{
+  return (0 != m_is_rat);
+}
+
+int ON_NurbsCurveSpanCache::Order() const
+{
+  return m_order;
+}
+
+int ON_NurbsCurveSpanCache::SpanCount() const
+{
+  return m_span_count;
+}
+
+ON_Interval ON_NurbsCurveSpanCache::Domain() const
+{
+  return (m_span_count > 0)
+    ? ON_Interval(m_span_t[0], m_span_t[m_span_count])
+    : ON_Interval::EmptyInterval;
+}
+
+ON_Interval ON_NurbsCurveSpanCache::SpanDomain(
+  int span_index
+  ) const
+{
+  return (span_index >= 0 && span_index < m_span_count)
+    ? ON_Interval(m_span_t[span_index], m_span_t[span_index + 1])
+    : ON_Interval::EmptyInterval;
+}
+
+int ON_NurbsCurveSpanCache::SpanIndex(
+  double t,
+  int side,
+  int* hint
+  ) const
+{
+  return Internal_SpanIndex(m_span_t, m_span_count, t, side, hint);
+}
+
+const double* ON_NurbsCurveSpanCache::SpanBezierCV(
+  int span_index
+  ) const
+{
+  if (span_index < 0 || span_index >= m_span_count)
+    return nullptr;
+  return m_bezier_cv.Array() + span_index * m_order * (m_dim + m_is_rat);
+}
+
+bool ON_NurbsCurveSpanCache::GetSpanBezier(
+  int span_index,
+  ON_BezierCurve& bezier
+  ) const
+{
+  const double* cv = SpanBezierCV(span_index);
+  if (nullptr == cv)
+    return false;
+  if (!bezier.Create(m_dim, 0 != m_is_rat, m_order))
+    return false;
+  const int cvdim = m_dim + m_is_rat;
+  for (int i = 0; i < m_order; i++)
+    memcpy(bezier.CV(i), cv + i * cvdim, cvdim * sizeof(cv[0]));
+  return true;
+}
+
+ON_BoundingBox ON_NurbsCurveSpanCache::SpanBoundingBox(
+  int span_index
+  ) const
+{
+  ON_BoundingBox bbox;
+  const double* cv = SpanBezierCV(span_index);
+  if (nullptr != cv)
+    ON_GetPointListBoundingBox(m_dim, 0 != m_is_rat, m_order, m_dim + m_is_rat, cv, bbox, false);
+  return bbox;
+}
+
+bool ON_NurbsCurveSpanCache::Evaluate(
+  double t,
+  int der_count,
+  int v_stride,
+  double* v,
+  int side,
+  int* hint
+  ) const
+{
+  if (m_span_count <= 0 || der_count < 0 || v_stride < m_dim || nullptr == v)
+    return false;
+
+  const int span_index = SpanIndex(t, side, hint);
+  const double t0 = m_span_t[span_index];
+  const double t1 = m_span_t[span_index + 1];
+  const double u = (t - t0) / (t1 - t0);
+  const int cvdim = m_dim + m_is_rat;
+  const int span_size = m_order * cvdim;
+
+  double stack_buffer[64];
+  void* heap_buffer = 0;
+  const size_t sizeof_buffer = (der_count + 1) * cvdim * sizeof(stack_buffer[0]);
+  double* P = (sizeof_buffer <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer = onmalloc(sizeof_buffer));
+
+  Internal_EvaluatePowerBasis(cvdim, m_order, cvdim, m_power.Array() + span_index * span_size, u, der_count, cvdim, P);
+
+  if (1.0 == u)
+  {
+    // The span's end point is its last Bezier control point. The
+    // power basis sum can differ from it in the last bit.
+    memcpy(P, m_bezier_cv.Array() + span_index * span_size + span_size - cvdim, cvdim * sizeof(P[0]));
+  }
+
+  // convert derivatives with respect to u to derivatives with respect to t
+  const double du = 1.0 / (t1 - t0);
+  double s = 1.0;
+  for (int n = 1; n <= der_count; n++)
+  {
+    s *= du;
+    double* Pn = P + n * cvdim;
+    for (int k = 0; k < cvdim; k++)
+      Pn[k] *= s;
+  }
+
+  bool rc = m_is_rat ? ON_EvaluateQuotientRule(m_dim, der_count, cvdim, P) : true;
+  if (rc)
+  {
+    for (int n = 0; n <= der_count; n++)
+      memcpy(v + n * v_stride, P + n * cvdim, m_dim * sizeof(v[0]));
+  }
+
+  if (heap_buffer)
+    onfree(heap_buffer);
+
+  return rc;
+}
+
+ON_3dPoint ON_NurbsCurveSpanCache::PointAt(
+  double t
+  ) const
+{
+  double v[3] = {};
+  if (m_dim < 1 || m_dim > 3 || !Evaluate(t, 0, 3, v))
+    return ON_3dPoint::UnsetPoint;
+  return ON_3dPoint(v);
+}
+
+bool ON_NurbsCurveSpanCache::Ev1Der(
+  double t,
+  ON_3dPoint& point,
+  ON_3dVector& derivative,
+  int side,
+  int* hint
+  ) const
+{
+  double v[6] = {};
+  if (m_dim < 1 || m_dim > 3 || !Evaluate(t, 1, 3, v, side, hint))
+    return false;
+  point = ON_3dPoint(v);
+  derivative = ON_3dVector(v + 3);
+  return true;
+}
+
+size_t ON_NurbsCurveSpanCache::SizeOf() const
+{
+  return sizeof(*this)
+    + m_span_t.SizeOfArray()
+    + m_bezier_cv.SizeOfArray()
+    + m_power.SizeOfArray();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// ON_NurbsSurfaceSpanCache
+//
+
+bool ON_NurbsSurfaceSpanCache::Create(
+  const ON_NurbsSurface& surface
+  )
+{
+  Destroy();
+
+  const int dim = surface.m_dim;
+  if (dim < 1 || nullptr == surface.m_cv)
+    return false;
+  const int cvdim = surface.CVSize();
+  if (surface.m_cv_stride[0] < cvdim || surface.m_cv_stride[1] < cvdim)
+    return false;
+
+  ON_SimpleArray<int> span_cv_index[2];
+  for (int dir = 0; dir < 2; dir++)
+  {
+    const int order = surface.m_order[dir];
+    const int cv_count = surface.m_cv_count[dir];
+    const double* knot = surface.m_knot[dir];
+    if (order < 2 || order > ON_NurbsSurfaceSpanCache::MaximumOrder || cv_count < order || nullptr == knot)
+      return false;
+    span_cv_index[dir].Reserve(cv_count - order + 1);
+    m_span_t[dir].Reserve(cv_count - order + 2);
+    for (int i = 0; i <= cv_count - order; i++)
+    {
+      if (knot[i + order - 2] < knot[i + order - 1])
+      {
+        span_cv_index[dir].Append(i);
+        m_span_t[dir].Append(knot[i + order - 2]);
+      }
+    }
+    if (span_cv_index[dir].Count() <= 0)
+    {
+      Destroy();
+      return false;
+    }
+    m_span_t[dir].Append(knot[cv_count - 1]);
+  }
+
+  const int order0 = surface.m_order[0];
+  const int order1 = surface.m_order[1];
+  const int span_count0 = span_cv_index[0].Count();
+  const int span_count1 = span_cv_index[1].Count();
+  const int patch_size = order0 * order1 * cvdim;
+  const int patch_count = span_count0 * span_count1;
+
+  m_bezier_cv.Reserve(patch_count * patch_size);
+  m_bezier_cv.SetCount(patch_count * patch_size);
+  m_power.Reserve(patch_count * patch_size);
+  m_power.SetCount(patch_count * patch_size);
+
+  ON_SimpleArray<double> row(order1 * cvdim);
+  row.SetCount(order1 * cvdim);
+
+  for (int si = 0; si < span_count0; si++)
+  {
+    const int i0 = span_cv_index[0][si];
+    const double* knot0 = surface.m_knot[0] + i0;
+    for (int sj = 0; sj < span_count1; sj++)
+    {
+      const int i1 = span_cv_index[1][sj];
+      const double* knot1 = surface.m_knot[1] + i1;
+      const int patch_index = si * span_count1 + sj;
+      double* bez = m_bezier_cv.Array() + patch_index * patch_size;
+      double* power = m_power.Array() + patch_index * patch_size;
+
+      for (int i = 0; i < order0; i++)
+      {
+        for (int j = 0; j < order1; j++)
+          memcpy(bez + (i * order1 + j) * cvdim, surface.CV(i0 + i, i1 + j), cvdim * sizeof(bez[0]));
+      }
+
+      // convert to Bezier in the "s" direction, then in the "t" direction
+      for (int j = 0; j < order1; j++)
+        ON_ConvertNurbSpanToBezier(cvdim, order0, order1 * cvdim, bez + j * cvdim, knot0, knot0[order0 - 2], knot0[order0 - 1]);
+      for (int i = 0; i < order0; i++)
+        ON_ConvertNurbSpanToBezier(cvdim, order1, cvdim, bez + i * order1 * cvdim, knot1, knot1[order1 - 2], knot1[order1 - 1]);
+
+      // power basis in the "s" direction, then in the "t" direction
+      for (int j = 0; j < order1; j++)
+        Internal_BezierToPowerBasis(cvdim, order0, order1 * cvdim, bez + j * cvdim, order1 * cvdim, power + j * cvdim);
+      for (int i = 0; i < order0; i++)
+      {
+        double* a = power + i * order1 * cvdim;
+        memcpy(row.Array(), a, order1 * cvdim * sizeof(a[0]));
+        Internal_BezierToPowerBasis(cvdim, order1, cvdim, row.Array(), cvdim, a);
+      }
+    }
+  }
+
+  m_dim = dim;
+  m_is_rat = surface.m_is_rat ? 1 : 0;
+  m_order[0] = order0;
+  m_order[1] = order1;
+  m_span_count[0] = span_count0;
+  m_span_count[1] = span_count1;
+  m_content_crc = surface.DataCRC(0);
+
+  return true;
+}
+
+void ON_NurbsSurfaceSpanCache::Destroy()
+{
+  m_dim = 0;
+  m_is_rat = 0;
+  m_order[0] = m_order[1] = 0;
+  m_span_count[0] = m_span_count[1] = 0;
+  m_content_crc = 0;
+  m_span_t[0].SetCount(0);
+  m_span_t[1].SetCount(0);
+  m_bezier_cv.SetCount(0);
+  m_power.SetCount(0);
+}
+
+bool ON_NurbsSurfaceSpanCache::IsEmpty() const
+{
+  return (m_span_count[0] <= 0 || m_span_count[1] <= 0);
+}
+
+bool ON_NurbsSurfaceSpanCache::IsCurrent(
+  const ON_NurbsSurface& surface
+  ) const
+{
+  if (IsEmpty())
+    return false;
+  if (surface.m_dim != m_dim
+    || surface.m_order[0] != m_order[0]
+    || surface.m_order[1] != m_order[1]
+    || (surface.m_is_rat ? 1 : 0) != m_is_rat
+    )
+    return false;
+  return (surface.DataCRC(0) == m_content_crc);
+}
+
+ON__UINT32 ON_NurbsSurfaceSpanCache::ContentCRC() const
+{
+  return m_content_crc;
+}
+
+int ON_NurbsSurfaceSpanCache::Dimension() const
+{
+  return m_dim;
+}
+
+bool ON_NurbsSurfaceSpanCache::IsRational() const
+{
+  return (0 != m_is_rat);
+}
+
+int ON_NurbsSurfaceSpanCache::Order(int dir) const
+{
+  return (0 == dir || 1 == dir) ? m_order[dir] : 0;
+}
+
+int ON_NurbsSurfaceSpanCache::SpanCount(int dir) const
+{
+  return (0 == dir || 1 == dir) ? m_span_count[dir] : 0;
+}
+
+ON_Interval ON_NurbsSurfaceSpanCache::Domain(int dir) const
+{
+  return ((0 == dir || 1 == dir) && m_span_count[dir] > 0)
+    ? ON_Interval(m_span_t[dir][0], m_span_t[dir][m_span_count[dir]])
+    : ON_Interval::EmptyInterval;
+}
+
+ON_Interval ON_NurbsSurfaceSpanCache::SpanDomain(int dir, int span_index) const
+{
+  return ((0 == dir || 1 == dir) && span_index >= 0 && span_index < m_span_count[dir])
+    ? ON_Interval(m_span_t[dir][span_index], m_span_t[dir][span_index + 1])
+    : ON_Interval::EmptyInterval;
+}
+
+int ON_NurbsSurfaceSpanCache::SpanIndex(
+  int dir,
+  double t,
+  int side,
+  int* hint
+  ) const
+{
+  if (0 != dir && 1 != dir)
+    return -1;
+  return Internal_SpanIndex(m_span_t[dir], m_span_count[dir], t, side, hint);
+}
+
+const double* ON_NurbsSurfaceSpanCache::SpanBezierCV(
+  int span_index0,
+  int span_index1
+  ) const
+{
+  if (span_index0 < 0 || span_index0 >= m_span_count[0] || span_index1 < 0 || span_index1 >= m_span_count[1])
+    return nullptr;
+  const int patch_size = m_order[0] * m_order[1] * (m_dim + m_is_rat);
+  return m_bezier_cv.Array() + (span_index0 * m_span_count[1] + span_index1) * patch_size;
+}
+
+bool ON_NurbsSurfaceSpanCache::GetSpanBezier(
+  int span_index0,
+  int span_index1,
+  ON_BezierSurface& bezier
+  ) const
+{
+  const double* cv = SpanBezierCV(span_index0, span_index1);
+  if (nullptr == cv)
+    return false;
+  if (!bezier.Create(m_dim, 0 != m_is_rat, m_order[0], m_order[1]))
+    return false;
+  const int cvdim = m_dim + m_is_rat;
+  for (int i = 0; i < m_order[0]; i++)
+  {
+    for (int j = 0; j < m_order[1]; j++)
+      memcpy(bezier.CV(i, j), cv + (i * m_order[1] + j) * cvdim, cvdim * sizeof(cv[0]));
+  }
+  return true;
+}
+
+ON_BoundingBox ON_NurbsSurfaceSpanCache::SpanBoundingBox(
+  int span_index0,
+  int span_index1
+  ) const
+{
+  ON_BoundingBox bbox;
+  const double* cv = SpanBezierCV(span_index0, span_index1);
+  if (nullptr != cv)
+    ON_GetPointListBoundingBox(m_dim, 0 != m_is_rat, m_order[0] * m_order[1], m_dim + m_is_rat, cv, bbox, false);
+  return bbox;
+}
+
+bool ON_NurbsSurfaceSpanCache::Evaluate(
+  double s,
+  double t,
+  int der_count,
+  int v_stride,
+  double* v,
+  int quadrant,
+  int* hint
+  ) const
+{
+  if (IsEmpty() || der_count < 0 || v_stride < m_dim || nullptr == v)
+    return false;
+
+  int side0 = 0, side1 = 0;
+  switch (quadrant)
+  {
+  case 1: side0 =  1; side1 =  1; break;
+  case 2: side0 = -1; side1 =  1; break;
+  case 3: side0 = -1; side1 = -1; break;
+  case 4: side0 =  1; side1 = -1; break;
+  }
+
+  const int span_index0 = SpanIndex(0, s, side0, hint);
+  const int span_index1 = SpanIndex(1, t, side1, (nullptr != hint) ? hint + 1 : nullptr);
+  const double s0 = m_span_t[0][span_index0];
+  const double s1 = m_span_t[0][span_index0 + 1];
+  const double t0 = m_span_t[1][span_index1];
+  const double t1 = m_span_t[1][span_index1 + 1];
+  const double u = (s - s0) / (s1 - s0);
+  const double w = (t - t0) / (t1 - t0);
+
+  const int cvdim = m_dim + m_is_rat;
+  const int order0 = m_order[0];
+  const int order1 = m_order[1];
+  const int patch_size = order0 * order1 * cvdim;
+  const double* a = m_power.Array() + (span_index0 * m_span_count[1] + span_index1) * patch_size;
+
+  // Q[(l*order0 + i)*cvdim] = l-th "t" derivative of the i-th "s" coefficient
+  // R[(n*(n+1)/2 + l)*cvdim] = partial derivative d^n/(ds^(n-l) dt^l)
+  // P[k*cvdim] = scratch for "s" derivatives
+  const int R_count = (der_count + 1) * (der_count + 2) / 2;
+  double stack_buffer[256];
+  void* heap_buffer = 0;
+  const size_t sizeof_buffer = ((der_count + 1) * (order0 + 1) + R_count) * cvdim * sizeof(stack_buffer[0]);
+  double* Q = (sizeof_buffer <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer = onmalloc(sizeof_buffer));
+  double* R = Q + (der_count + 1) * order0 * cvdim;
+  double* P = R + R_count * cvdim;
+
+  for (int i = 0; i < order0; i++)
+    Internal_EvaluatePowerBasis(cvdim, order1, cvdim, a + i * order1 * cvdim, w, der_count, order0 * cvdim, Q + i * cvdim);
+
+  const double ds = 1.0 / (s1 - s0);
+  const double dt = 1.0 / (t1 - t0);
+  double scale_t = 1.0;
+  for (int l = 0; l <= der_count; l++)
+  {
+    Internal_EvaluatePowerBasis(cvdim, order0, cvdim, Q + l * order0 * cvdim, u, der_count - l, cvdim, P);
+    double scale = scale_t;
+    for (int k = 0; k + l <= der_count; k++)
+    {
+      const int n = k + l;
+      double* Rn = R + (n * (n + 1) / 2 + l) * cvdim;
+      const double* Pk = P + k * cvdim;
+      for (int c = 0; c < cvdim; c++)
+        Rn[c] = scale * Pk[c];
+      scale *= ds;
+    }
+    scale_t *= dt;
+  }
+
+  bool rc = m_is_rat ? ON_EvaluateQuotientRule2(m_dim, der_count, cvdim, R) : true;
+  if (rc)
+  {
+    for (int n = 0; n < R_count; n++)
+      memcpy(v + n * v_stride, R + n * cvdim, m_dim * sizeof(v[0]));
+  }
+
+  if (heap_buffer)
+    onfree(heap_buffer);
+
+  return rc;
+}
+
+ON_3dPoint ON_NurbsSurfaceSpanCache::PointAt(
+  double s,
+  double t
+  ) const
+{
+  double v[3] = {};
+  if (m_dim < 1 || m_dim > 3 || !Evaluate(s, t, 0, 3, v))
+    return ON_3dPoint::UnsetPoint;
+  return ON_3dPoint(v);
+}
+
+bool ON_NurbsSurfaceSpanCache::Ev1Der(
+  double s,
+  double t,
+  ON_3dPoint& point,
+  ON_3dVector& ds,
+  ON_3dVector& dt,
+  int quadrant,
+  int* hint
+  ) const
+{
+  double v[9] = {};
+  if (m_dim < 1 || m_dim > 3 || !Evaluate(s, t, 1, 3, v, quadrant, hint))
+    return false;
+  point = ON_3dPoint(v);
+  ds = ON_3dVector(v + 3);
+  dt = ON_3dVector(v + 6);
+  return true;
+}
+
+size_t ON_NurbsSurfaceSpanCache::SizeOf() const
+{
+  return sizeof(*this)
+    + m_span_t[0].SizeOfArray()
+    + m_span_t[1].SizeOfArray()
+    + m_bezier_cv.SizeOfArray()
+    + m_power.SizeOfArray();
+}
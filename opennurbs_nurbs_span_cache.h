@@ -0,0 +1,356 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+//
+//   Cached Bezier span representations of NURBS curves and surfaces
+//
+////////////////////////////////////////////////////////////////
+
+#if !defined(OPENNURBS_NURBS_SPAN_CACHE_INC_)
+#define OPENNURBS_NURBS_SPAN_CACHE_INC_
+
+/*
+Description:
+  ON_NurbsCurveSpanCache is an evaluation cache for code that evaluates
+  the same ON_NurbsCurve many times (closest point, intersection,
+  tessellation, ...).
+
+  Create() converts every nonempty span of the curve to Bezier form
+  with ON_ConvertNurbSpanToBezier() and then to power basis
+  coefficients in the normalized span parameter
+  u = (t - t0)/(t1 - t0). Evaluation finds the span with a binary
+  search of the span parameters and evaluates with Horner's scheme.
+Remarks:
+  The cache keeps copies of everything it uses and does not reference
+  the curve. Create() saves the curve's ON_NurbsCurve::DataCRC() and
+  IsCurrent() compares it with the curve's current value, so callers
+  can tell when the curve has been modified and the cache must be
+  recreated.
+
+  The const member functions do not modify the cache, so a cache may
+  be shared by any number of threads once Create() has returned.
+
+  Power basis evaluation is faster than de Boor evaluation, but high
+  degree spans can lose a few digits of precision. For orders above
+  ON_NurbsCurveSpanCache::MaximumOrder, Create() fails and the curve
+  should be evaluated directly.
+*/
+class ON_CLASS ON_NurbsCurveSpanCache
+{
+public:
+  ON_NurbsCurveSpanCache() = default;
+  ~ON_NurbsCurveSpanCache() = default;
+  ON_NurbsCurveSpanCache(const ON_NurbsCurveSpanCache&) = default;
+  ON_NurbsCurveSpanCache& operator=(const ON_NurbsCurveSpanCache&) = default;
+
+  enum : int
+  {
+    MaximumOrder = 16
+  };
+
+  /*
+  Description:
+    Convert the spans of curve to Bezier and power basis form.
+  Parameters:
+    curve - [in]
+  Returns:
+    True if successful. When false is returned the cache is empty.
+  */
+  bool Create(
+    const ON_NurbsCurve& curve
+    );
+
+  void Destroy();
+
+  bool IsEmpty() const;
+
+  /*
+  Returns:
+    True if the cache was created from a curve with the same dimension,
+    order, knots and control points as curve.
+  */
+  bool IsCurrent(
+    const ON_NurbsCurve& curve
+    ) const;
+
+  /*
+  Returns:
+    The value of ON_NurbsCurve::DataCRC(0) for the curve passed to Create().
+  */
+  ON__UINT32 ContentCRC() const;
+
+  int Dimension() const;
+  bool IsRational() const;
+  int Order() const;
+
+  /*
+  Returns:
+    Number of nonempty spans.
+  */
+  int SpanCount() const;
+
+  ON_Interval Domain() const;
+
+  ON_Interval SpanDomain(
+    int span_index
+    ) const;
+
+  /*
+  Description:
+    Find the span used to evaluate at t.
+  Parameters:
+    t - [in]
+    side - [in]
+      <  0 if t is at a span boundary, use the span to the left.
+      >= 0 if t is at a span boundary, use the span to the right.
+    hint - [in/out]
+      optional span index hint. If hint is not nullptr, *hint is tested
+      before the binary search and set to the returned value.
+  Returns:
+    Index of a span. Parameters outside the domain return the first or
+    last span.
+  */
+  int SpanIndex(
+    double t,
+    int side = 0,
+    int* hint = nullptr
+    ) const;
+
+  /*
+  Returns:
+    Pointer to the Order() Bezier control points of the span. Each
+    control point has Dimension()+(IsRational()?1:0) doubles, and
+    rational control points are homogeneous.
+  */
+  const double* SpanBezierCV(
+    int span_index
+    ) const;
+
+  bool GetSpanBezier(
+    int span_index,
+    ON_BezierCurve& bezier
+    ) const;
+
+  /*
+  Returns:
+    The bounding box of the span's Bezier control polygon. When all
+    weights are positive, the span is inside this box.
+  */
+  ON_BoundingBox SpanBoundingBox(
+    int span_index
+    ) const;
+
+  /*
+  Description:
+    Evaluate the curve. The parameters and results match
+    ON_NurbsCurve::Evaluate().
+  Parameters:
+    t - [in] evaluation parameter
+    der_count - [in] (>= 0) number of derivatives
+    v_stride - [in] (>= Dimension())
+    v - [out] array of length (der_count+1)*v_stride
+    side - [in] see SpanIndex()
+    hint - [in/out] optional span index hint
+  Returns:
+    False if the cache is empty or the evaluation failed.
+  */
+  bool Evaluate(
+    double t,
+    int der_count,
+    int v_stride,
+    double* v,
+    int side = 0,
+    int* hint = nullptr
+    ) const;
+
+  ON_3dPoint PointAt(
+    double t
+    ) const;
+
+  bool Ev1Der(
+    double t,
+    ON_3dPoint& point,
+    ON_3dVector& derivative,
+    int side = 0,
+    int* hint = nullptr
+    ) const;
+
+  size_t SizeOf() const;
+
+private:
+  int m_dim = 0;
+  int m_is_rat = 0;
+  int m_order = 0;
+  int m_span_count = 0;
+  ON__UINT32 m_content_crc = 0;
+
+  // m_span_t[i] < m_span_t[i+1] are the span parameters (m_span_count+1 values)
+  ON_SimpleArray<double> m_span_t;
+
+  // For each span, m_order homogeneous Bezier control points
+  ON_SimpleArray<double> m_bezier_cv;
+
+  // For each span, m_order power basis coefficients in the normalized
+  // span parameter. Coefficient j of span i starts at
+  // m_power[(i*m_order + j)*cvdim].
+  ON_SimpleArray<double> m_power;
+};
+
+/*
+Description:
+  ON_NurbsSurfaceSpanCache is the surface version of
+  ON_NurbsCurveSpanCache. Create() converts every nonempty span of
+  an ON_NurbsSurface to a Bezier patch and to tensor product power basis
+  coefficients. Evaluation uses nested Horner's schemes.
+Remarks:
+  The cache keeps copies of everything it uses. IsCurrent() compares the
+  surface's ON_NurbsSurface::DataCRC() with the value saved by Create().
+  The const member functions may be called from any number of threads.
+*/
+class ON_CLASS ON_NurbsSurfaceSpanCache
+{
+public:
+  ON_NurbsSurfaceSpanCache() = default;
+  ~ON_NurbsSurfaceSpanCache() = default;
+  ON_NurbsSurfaceSpanCache(const ON_NurbsSurfaceSpanCache&) = default;
+  ON_NurbsSurfaceSpanCache& operator=(const ON_NurbsSurfaceSpanCache&) = default;
+
+  enum : int
+  {
+    MaximumOrder = 16
+  };
+
+  bool Create(
+    const ON_NurbsSurface& surface
+    );
+
+  void Destroy();
+
+  bool IsEmpty() const;
+
+  bool IsCurrent(
+    const ON_NurbsSurface& surface
+    ) const;
+
+  ON__UINT32 ContentCRC() const;
+
+  int Dimension() const;
+  bool IsRational() const;
+  int Order(int dir) const;
+  int SpanCount(int dir) const;
+  ON_Interval Domain(int dir) const;
+  ON_Interval SpanDomain(int dir, int span_index) const;
+
+  /*
+  Parameters:
+    dir - [in] 0 = "s", 1 = "t"
+    t - [in]
+    side - [in] see ON_NurbsCurveSpanCache::SpanIndex()
+    hint - [in/out] optional span index hint
+  */
+  int SpanIndex(
+    int dir,
+    double t,
+    int side = 0,
+    int* hint = nullptr
+    ) const;
+
+  /*
+  Returns:
+    Pointer to the Order(0)*Order(1) Bezier control points of the patch.
+    Control point (i,j) starts at
+    SpanBezierCV(i0,i1)[(i*Order(1) + j)*(Dimension()+(IsRational()?1:0))].
+  */
+  const double* SpanBezierCV(
+    int span_index0,
+    int span_index1
+    ) const;
+
+  bool GetSpanBezier(
+    int span_index0,
+    int span_index1,
+    ON_BezierSurface& bezier
+    ) const;
+
+  ON_BoundingBox SpanBoundingBox(
+    int span_index0,
+    int span_index1
+    ) const;
+
+  /*
+  Description:
+    Evaluate the surface. The parameters and results match
+    ON_NurbsSurface::Evaluate().
+  Parameters:
+    s, t - [in] evaluation parameters
+    der_count - [in] (>= 0) number of derivatives
+    v_stride - [in] (>= Dimension())
+    v - [out] array of length v_stride*(der_count+1)*(der_count+2)/2
+    quadrant - [in] optional - determines which side to evaluate from
+       0 = default
+       1 from NE quadrant
+       2 from NW quadrant
+       3 from SW quadrant
+       4 from SE quadrant
+    hint - [in/out] optional span index hints
+  Returns:
+    False if the cache is empty or the evaluation failed.
+  */
+  bool Evaluate(
+    double s,
+    double t,
+    int der_count,
+    int v_stride,
+    double* v,
+    int quadrant = 0,
+    int* hint = nullptr
+    ) const;
+
+  ON_3dPoint PointAt(
+    double s,
+    double t
+    ) const;
+
+  bool Ev1Der(
+    double s,
+    double t,
+    ON_3dPoint& point,
+    ON_3dVector& ds,
+    ON_3dVector& dt,
+    int quadrant = 0,
+    int* hint = nullptr
+    ) const;
+
+  size_t SizeOf() const;
+
+private:
+  int m_dim = 0;
+  int m_is_rat = 0;
+  int m_order[2] = {};
+  int m_span_count[2] = {};
+  ON__UINT32 m_content_crc = 0;
+
+  ON_SimpleArray<double> m_span_t[2];
+
+  // For each patch (span_index0*m_span_count[1] + span_index1),
+  // m_order[0]*m_order[1] homogeneous Bezier control points.
+  ON_SimpleArray<double> m_bezier_cv;
+
+  // For each patch, m_order[0]*m_order[1] power basis coefficients.
+  // The coefficient of u^i v^j is at index (i*m_order[1] + j)*cvdim of
+  // the patch's block.
+  ON_SimpleArray<double> m_power;
+};
+
+#endif
@@ -1610,6 +1610,147 @@ ON_NurbsCurve::Evaluate( // returns false if unable to evaluate
 }
 
 
+bool ON_NurbsCurve::EvaluateMany(
+  size_t t_count,
+  const double* t,
+  int der_count,
+  size_t point_stride,
+  size_t derivative_stride,
+  double* v,
+  int side
+  ) const
+{
+  if (0 == t_count)
+    return true;
+
+  const int dim = m_dim;
+  const int order = m_order;
+  if (nullptr == t || nullptr == v || der_count < 0 || dim < 1 || order < 2 || m_cv_count < order)
+    return false;
+  if (nullptr == m_knot || nullptr == m_cv)
+    return false;
+  if (point_stride < (size_t)dim || (der_count > 0 && derivative_stride < (size_t)dim))
+    return false;
+
+  const int cvdim = m_is_rat ? (dim + 1) : dim;
+  const int der_count1 = der_count + 1;
+  const int blend_der_count = (der_count < order) ? der_count : (order - 1);
+
+  // N[] = basis values, span_cv[] = span control points copied to
+  // contiguous memory, hv[] = homogeneous point and derivatives
+  ON_SimpleArray<double> buffer;
+  double* N = buffer.Reserve(der_count1 * order + order * cvdim + der_count1 * cvdim);
+  double* span_cv = N + der_count1 * order;
+  double* hv = span_cv + order * cvdim;
+
+  ON_NurbsSpanBasis basis;
+  const bool bBasis = (order <= ON_NurbsSpanBasis::MaximumOrder);
+  const bool bTuneup = (-2 == side || 2 == side);
+  int span_index = -1;
+  double k0 = 0.0;
+  double k1 = 0.0;
+
+  bool rc = true;
+  for (size_t i = 0; i < t_count; i++)
+  {
+    double s = t[i];
+    double* vi = v + i * point_stride;
+
+    bool bEvaluated = false;
+    if (ON_IsValid(s))
+    {
+      if (span_index < 0 || bTuneup || !(k0 < s && s < k1))
+      {
+        int si = ON_NurbsSpanIndex(order, m_cv_count, m_knot, s, side, (span_index > 0) ? span_index : 0);
+        if (bTuneup)
+        {
+          // same parameter tuneup as ON_NurbsCurve::Evaluate()
+          double a = s;
+          if (ON_TuneupEvaluationParameter(side, m_knot[si + order - 2], m_knot[si + order - 1], &a))
+          {
+            s = a;
+            si = ON_NurbsSpanIndex(order, m_cv_count, m_knot, s, side, si);
+          }
+        }
+        if (si != span_index)
+        {
+          span_index = si;
+          k0 = m_knot[si + order - 2];
+          k1 = m_knot[si + order - 1];
+          if (bBasis)
+            basis.SetSpan(order, m_knot + si);
+          const double* cv = m_cv + si * m_cv_stride;
+          for (int j = 0; j < order; j++, cv += m_cv_stride)
+            memcpy(span_cv + j * cvdim, cv, cvdim * sizeof(span_cv[0]));
+        }
+      }
+
+      if (bBasis && basis.Evaluate(s, blend_der_count, N))
+      {
+        for (int k = 0; k <= blend_der_count; k++)
+        {
+          double* h = hv + k * cvdim;
+          const double* Nk = N + k * order;
+          for (int c = 0; c < cvdim; c++)
+            h[c] = 0.0;
+          for (int j = 0; j < order; j++)
+          {
+            const double b = Nk[j];
+            const double* cv = span_cv + j * cvdim;
+            for (int c = 0; c < cvdim; c++)
+              h[c] += b * cv[c];
+          }
+        }
+        for (int k = blend_der_count + 1; k <= der_count; k++)
+        {
+          double* h = hv + k * cvdim;
+          for (int c = 0; c < cvdim; c++)
+            h[c] = 0.0;
+        }
+        if (2 == order)
+        {
+          // Same fix as ON_EvaluateNurbsSpan() for cases when,
+          // numerically, t*a + (1.0-t)*a != a.
+          for (int c = 0; c < cvdim; c++)
+          {
+            if (span_cv[c] == span_cv[cvdim + c])
+              hv[c] = span_cv[c];
+          }
+        }
+        bEvaluated = m_is_rat ? ON_EvaluateQuotientRule(dim, der_count, cvdim, hv) : true;
+        if (bEvaluated && cvdim != dim)
+        {
+          for (int k = 1; k <= der_count; k++)
+            memmove(hv + k * dim, hv + k * cvdim, dim * sizeof(hv[0]));
+        }
+      }
+      else if (false == bBasis)
+      {
+        bEvaluated = ON_EvaluateNurbsSpan(
+          dim, m_is_rat, order,
+          m_knot + span_index,
+          m_cv_stride, m_cv + (m_cv_stride * span_index),
+          der_count, s, dim, hv
+        );
+      }
+    }
+
+    // hv[] has der_count+1 results with stride dim
+    for (int k = 0; k <= der_count; k++)
+    {
+      double* dst = vi + k * derivative_stride;
+      const double* src = hv + k * dim;
+      for (int c = 0; c < dim; c++)
+        dst[c] = bEvaluated ? src[c] : ON_DBL_QNAN;
+    }
+    if (false == bEvaluated)
+      rc = false;
+  }
+
+  return rc;
+}
+
+
 bool 
 ON_NurbsCurve::IsClosed() const
 {
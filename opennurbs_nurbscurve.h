@@ -549,6 +549,51 @@ public:
                          //            repeated evaluations
          ) const override;
 
+  /*
+  Description:
+    Evaluates the curve at many parameters.
+  Parameters:
+    t_count - [in]
+      number of parameters
+    t - [in]
+      array of t_count parameters. The parameters may be in any order.
+      Consecutive parameters in the same span share the span setup, so
+      sorted parameters evaluate fastest.
+    der_count - [in]
+      number of derivatives (>= 0)
+    point_stride - [in]
+    derivative_stride - [in]
+      (>= Dimension())
+      The k-th derivative at t[i] is returned in
+      v[n], ..., v[n+Dimension()-1], where
+      n = i*point_stride + k*derivative_stride.
+      For interleaved results (point and derivatives at t[0], then
+      point and derivatives at t[1], ...) use
+      derivative_stride = Dimension() and
+      point_stride = (der_count+1)*Dimension().
+      For separate point and derivative arrays use
+      point_stride = Dimension() and
+      derivative_stride = t_count*Dimension().
+    v - [out]
+    side - [in]
+      Same as the side parameter of ON_NurbsCurve::Evaluate().
+  Returns:
+    True if every parameter was evaluated. Results at parameters
+    that cannot be evaluated are set to ON_DBL_QNAN.
+  Remarks:
+    The results are the same as calling ON_NurbsCurve::Evaluate() at
+    each parameter, up to rounding.
+  */
+  bool EvaluateMany(
+    size_t t_count,
+    const double* t,
+    int der_count,
+    size_t point_stride,
+    size_t derivative_stride,
+    double* v,
+    int side = 0
+    ) const;
+
 
   /*
   Parameters:
@@ -658,6 +658,70 @@ bool ON_NurbsSurface::GetBBox( // returns true if successful
             boxmin, boxmax, bGrowBox?true:false );
 }
 
+bool ON_NurbsSurface::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    bool bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  if ( m_dim < 1 || m_order[0] < 2 || m_order[1] < 2 || m_cv_count[0] < m_order[0] || m_cv_count[1] < m_order[1] )
+    return false;
+
+  if ( bGrowBox && !tight_bbox.IsValid() )
+  {
+    bGrowBox = false;
+  }
+
+  if ( !bGrowBox )
+  {
+    tight_bbox.Destroy();
+  }
+
+  // Putting the corners in the box lets many spans be skipped.
+  const ON_Interval udom = Domain(0);
+  const ON_Interval vdom = Domain(1);
+  for ( int i = 0; i < 4; i++ )
+  {
+    ON_3dPoint P = PointAt( udom[i%2], vdom[i/2] );
+    if ( xform )
+      P = (*xform)*P;
+    tight_bbox.Set( P, bGrowBox );
+    bGrowBox = true;
+  }
+
+  if ( ON_WorldBBoxIsInTightBBox( tight_bbox, BoundingBox(), xform ) )
+  {
+    // Surface is inside tight_bbox
+    return true;
+  }
+
+  ON_BezierSurface B;
+  for ( int i = 0; i <= m_cv_count[0] - m_order[0]; i++ )
+  {
+    if ( !(m_knot[0][i + m_order[0]-2] < m_knot[0][i + m_order[0]-1]) )
+      continue;
+    for ( int j = 0; j <= m_cv_count[1] - m_order[1]; j++ )
+    {
+      if ( !(m_knot[1][j + m_order[1]-2] < m_knot[1][j + m_order[1]-1]) )
+        continue;
+      if ( m_dim <= 3 )
+      {
+        // The span is inside the box of its control points.
+        ON_BoundingBox span_bbox( ON_3dPoint::Origin, ON_3dPoint::Origin );
+        if ( ON_GetPointGridBoundingBox( m_dim, m_is_rat, m_order[0], m_order[1], m_cv_stride[0], m_cv_stride[1], 
+                                         CV(i,j), &span_bbox.m_min.x, &span_bbox.m_max.x, false )
+             && ON_WorldBBoxIsInTightBBox( tight_bbox, span_bbox, xform ) )
+          continue;
+      }
+      if ( !ConvertSpanToBezier( i, j, B ) )
+        continue;
+      B.GetTightBoundingBox( tight_bbox, true, xform );
+    }
+  }
+
+  return tight_bbox.IsValid();
+}
+
 bool ON_NurbsSurface::Transform( const ON_Xform& xform )
 {
   DestroySurfaceTree();
@@ -920,6 +984,266 @@ ON_NurbsSurface::Evaluate( // returns false if unable to evaluate
 }
 
 
+class ON_Internal_NurbsSurfaceGrid
+{
+public:
+  const ON_NurbsSurface* m_srf = nullptr;
+  int m_count[2] = {};
+  const double* m_t[2] = {};
+
+  // m_span[dir][i] = span index for m_t[dir][i]
+  // m_basis[dir][i*2*order ...] = basis values followed by their
+  //   first derivatives at m_t[dir][i]
+  ON_SimpleArray<int> m_span[2];
+  ON_SimpleArray<double> m_basis[2];
+
+  // range of first direction control point indices used by the grid
+  int m_cv0 = 0;
+  int m_cv1 = 0;
+
+  ON_3dPoint* m_points = nullptr;
+  ON_3dVector* m_Ds = nullptr;
+  ON_3dVector* m_Dt = nullptr;
+  ON_3dVector* m_normals = nullptr;
+  // partial derivatives closer to parallel than ON_Surface::EvNormal()
+  // permits are handled by ON_Surface::EvNormal()
+  double m_cos_parallel_tolerance = cos(0.01 * ON_DEFAULT_ANGLE_TOLERANCE);
+  std::atomic<int> m_failure_count{ 0 };
+
+  bool SetBasis(int dir)
+  {
+    const ON_NurbsSurface* srf = m_srf;
+    const int order = srf->m_order[dir];
+    const int count = m_count[dir];
+    m_span[dir].Reserve(count);
+    m_span[dir].SetCount(count);
+    m_basis[dir].Reserve(2 * order * count);
+    m_basis[dir].SetCount(2 * order * count);
+
+    ON_SimpleArray<double> N(order * order);
+    N.SetCount(order * order);
+    int span_index = 0;
+    for (int i = 0; i < count; i++)
+    {
+      const double t = m_t[dir][i];
+      if (false == ON_IsValid(t))
+        return false;
+      span_index = ON_NurbsSpanIndex(order, srf->m_cv_count[dir], srf->m_knot[dir], t, 1, span_index);
+      const double* knot = srf->m_knot[dir] + span_index;
+      if (false == ON_EvaluateNurbsBasis(order, knot, t, N.Array()))
+        return false;
+      if (false == ON_EvaluateNurbsBasisDerivatives(order, knot, 1, N.Array()))
+        return false;
+      m_span[dir][i] = span_index;
+      memcpy(m_basis[dir].Array() + 2 * order * i, N.Array(), 2 * order * sizeof(N[0]));
+    }
+    return true;
+  }
+
+  void EvaluateRow(int j, double* Q, double* Qt) const
+  {
+    const ON_NurbsSurface* srf = m_srf;
+    const int dim = srf->m_dim;
+    const bool bIsRational = srf->m_is_rat ? true : false;
+    const int cvdim = bIsRational ? (dim + 1) : dim;
+    const int order0 = srf->m_order[0];
+    const int order1 = srf->m_order[1];
+    const int span1 = m_span[1][j];
+    const double* Nt = m_basis[1].Array() + 2 * order1 * j;
+    const double* dNt = Nt + order1;
+
+    // Q[a] = curve in the first direction with the second
+    // parameter fixed at t[j]; Qt[a] = its second partial.
+    for (int a = m_cv0; a <= m_cv1; a++)
+    {
+      double* q = Q + a * cvdim;
+      double* qt = Qt + a * cvdim;
+      for (int c = 0; c < cvdim; c++)
+      {
+        q[c] = 0.0;
+        qt[c] = 0.0;
+      }
+      const double* cv = srf->m_cv + a * srf->m_cv_stride[0] + span1 * srf->m_cv_stride[1];
+      for (int b = 0; b < order1; b++, cv += srf->m_cv_stride[1])
+      {
+        const double n = Nt[b];
+        const double dn = dNt[b];
+        for (int c = 0; c < cvdim; c++)
+        {
+          q[c] += n * cv[c];
+          qt[c] += dn * cv[c];
+        }
+      }
+    }
+
+    const int s_count = m_count[0];
+    const double* s_basis = m_basis[0].Array();
+    for (int i = 0; i < s_count; i++)
+    {
+      const int span0 = m_span[0][i];
+      const double* Ns = s_basis + 2 * order0 * i;
+      const double* dNs = Ns + order0;
+      double P[4] = {};
+      double Ps[4] = {};
+      double Pt[4] = {};
+      const double* q = Q + span0 * cvdim;
+      const double* qt = Qt + span0 * cvdim;
+      for (int a = 0; a < order0; a++, q += cvdim, qt += cvdim)
+      {
+        const double n = Ns[a];
+        const double dn = dNs[a];
+        for (int c = 0; c < cvdim; c++)
+        {
+          P[c] += n * q[c];
+          Ps[c] += dn * q[c];
+          Pt[c] += n * qt[c];
+        }
+      }
+
+      bool bEvaluated = true;
+      if (bIsRational)
+      {
+        const double w = P[dim];
+        if (0.0 != w)
+        {
+          const double w1 = 1.0 / w;
+          for (int c = 0; c < dim; c++)
+          {
+            P[c] *= w1;
+            Ps[c] = (Ps[c] - P[c] * Ps[dim]) * w1;
+            Pt[c] = (Pt[c] - P[c] * Pt[dim]) * w1;
+          }
+        }
+        else
+          bEvaluated = false;
+      }
+
+      const size_t k = ((size_t)j) * s_count + i;
+      if (false == bEvaluated)
+      {
+        if (nullptr != m_points)
+          m_points[k] = ON_3dPoint::NanPoint;
+        if (nullptr != m_Ds)
+          m_Ds[k] = ON_3dVector::NanVector;
+        if (nullptr != m_Dt)
+          m_Dt[k] = ON_3dVector::NanVector;
+        if (nullptr != m_normals)
+          m_normals[k] = ON_3dVector::NanVector;
+        const_cast<ON_Internal_NurbsSurfaceGrid*>(this)->m_failure_count++;
+        continue;
+      }
+
+      if (2 == dim)
+      {
+        P[2] = 0.0;
+        Ps[2] = 0.0;
+        Pt[2] = 0.0;
+      }
+      if (nullptr != m_points)
+        m_points[k] = ON_3dPoint(P[0], P[1], P[2]);
+      if (nullptr != m_Ds)
+        m_Ds[k] = ON_3dVector(Ps[0], Ps[1], Ps[2]);
+      if (nullptr != m_Dt)
+        m_Dt[k] = ON_3dVector(Pt[0], Pt[1], Pt[2]);
+      if (nullptr != m_normals)
+      {
+        // Same test as ON_Surface::EvNormal(). Near singular points
+        // ON_Surface::EvNormal() is used to find the limiting normal.
+        const ON_3dVector ds(Ps[0], Ps[1], Ps[2]);
+        const ON_3dVector dt(Pt[0], Pt[1], Pt[2]);
+        const double len_ds = ds.Length();
+        const double len_dt = dt.Length();
+        ON_3dVector N = ON_3dVector::NanVector;
+        bool bNormal = false;
+        if (len_ds > ON_SQRT_EPSILON * len_dt && len_dt > ON_SQRT_EPSILON * len_ds)
+        {
+          const ON_3dVector a = ds / len_ds;
+          const ON_3dVector b = dt / len_dt;
+          if (fabs(a * b) < m_cos_parallel_tolerance)
+          {
+            N = ON_CrossProduct(a, b);
+            bNormal = N.Unitize();
+          }
+        }
+        if (false == bNormal)
+        {
+          if (false == srf->EvNormal(m_t[0][i], m_t[1][j], N))
+          {
+            N = ON_3dVector::NanVector;
+            const_cast<ON_Internal_NurbsSurfaceGrid*>(this)->m_failure_count++;
+          }
+        }
+        m_normals[k] = N;
+      }
+    }
+  }
+
+  static void EvaluateRows(ON__UINT_PTR context, unsigned int thread_index, size_t j0, size_t j1)
+  {
+    const ON_Internal_NurbsSurfaceGrid* grid = (const ON_Internal_NurbsSurfaceGrid*)context;
+    const int cvdim = grid->m_srf->CVSize();
+    const size_t q_count = ((size_t)grid->m_srf->m_cv_count[0]) * cvdim;
+    ON_SimpleArray<double> buffer;
+    double* Q = buffer.Reserve(2 * q_count);
+    double* Qt = Q + q_count;
+    for (size_t j = j0; j < j1; j++)
+      grid->EvaluateRow((int)j, Q, Qt);
+  }
+};
+
+bool ON_NurbsSurface::EvaluateGrid(
+  int s_count,
+  const double* s,
+  int t_count,
+  const double* t,
+  ON_3dPoint* points,
+  ON_3dVector* Ds,
+  ON_3dVector* Dt,
+  ON_3dVector* normals
+  ) const
+{
+  if (s_count <= 0 || t_count <= 0 || nullptr == s || nullptr == t)
+    return false;
+  if (2 != m_dim && 3 != m_dim)
+    return false;
+  if (m_order[0] < 2 || m_order[1] < 2 || m_cv_count[0] < m_order[0] || m_cv_count[1] < m_order[1])
+    return false;
+  if (nullptr == m_cv || nullptr == m_knot[0] || nullptr == m_knot[1])
+    return false;
+  if (nullptr == points && nullptr == Ds && nullptr == Dt && nullptr == normals)
+    return true;
+
+  ON_Internal_NurbsSurfaceGrid grid;
+  grid.m_srf = this;
+  grid.m_count[0] = s_count;
+  grid.m_count[1] = t_count;
+  grid.m_t[0] = s;
+  grid.m_t[1] = t;
+  grid.m_points = points;
+  grid.m_Ds = Ds;
+  grid.m_Dt = Dt;
+  grid.m_normals = normals;
+  if (false == grid.SetBasis(0) || false == grid.SetBasis(1))
+    return false;
+
+  grid.m_cv0 = grid.m_span[0][0];
+  grid.m_cv1 = grid.m_cv0;
+  for (int i = 1; i < s_count; i++)
+  {
+    const int span_index = grid.m_span[0][i];
+    if (span_index < grid.m_cv0)
+      grid.m_cv0 = span_index;
+    else if (span_index > grid.m_cv1)
+      grid.m_cv1 = span_index;
+  }
+  grid.m_cv1 += m_order[0] - 1;
+
+  ON_ParallelFor(t_count, 4, 0, ON_Internal_NurbsSurfaceGrid::EvaluateRows, (ON__UINT_PTR)&grid);
+
+  return (0 == grid.m_failure_count);
+}
+
+
 ON_Curve* ON_NurbsSurface::IsoCurve(
        int dir,          // 0 first parameter varies and second parameter is constant
                          //   e.g., point on IsoCurve(0,c) at t is srf(t,c)
@@ -259,6 +259,9 @@ public:
   // virtual ON_Geometry GetBBox override		
   bool GetBBox( double* boxmin, double* boxmax, bool bGrowBox = false ) const override;
 
+  // virtual ON_Geometry GetTightBoundingBox override		
+  bool GetTightBoundingBox( class ON_BoundingBox& tight_bbox, bool bGrowBox = false, const class ON_Xform* xform = nullptr ) const override;
+
   bool Transform( 
          const ON_Xform&
          ) override;
@@ -483,6 +486,49 @@ public:
                          //            repeated evaluations
          ) const override;
 
+  /*
+  Description:
+    Evaluates the surface on a grid of parameters.
+  Parameters:
+    s_count - [in]
+    s - [in]
+      array of s_count first parameters
+    t_count - [in]
+    t - [in]
+      array of t_count second parameters
+    points - [out]
+      If not nullptr, an array of s_count*t_count points.
+      points[j*s_count+i] = surface point at (s[i],t[j]).
+    Ds - [out]
+    Dt - [out]
+      If not nullptr, arrays of s_count*t_count first partial
+      derivatives, in the same order as points[].
+    normals - [out]
+      If not nullptr, an array of s_count*t_count unit normals,
+      in the same order as points[].
+  Returns:
+    True if every grid point was evaluated. Results that cannot be
+    evaluated are set to ON_3dPoint::NanPoint or ON_3dVector::NanVector.
+  Remarks:
+    The basis functions are evaluated once for each s[] and each t[].
+    For each t[j] the control points are blended in the t direction
+    once, then each grid point is a short sum in the s direction.
+    Rows of the grid are evaluated in parallel.
+    The surface dimension must be 2 or 3. The results are the same as
+    calling ON_NurbsSurface::Evaluate() and ON_Surface::EvNormal() at
+    each grid point, up to rounding.
+  */
+  bool EvaluateGrid(
+    int s_count,
+    const double* s,
+    int t_count,
+    const double* t,
+    ON_3dPoint* points,
+    ON_3dVector* Ds,
+    ON_3dVector* Dt,
+    ON_3dVector* normals
+    ) const;
+
   /*
   Description:
     Get isoparametric curve.
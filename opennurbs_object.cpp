@@ -1989,6 +1989,8 @@ void ON_Brep::DestroyRuntimeCache( bool bDelete )
   //    m_bbox is private and recalculated as needed makes
   //    it different than the m_pbox info on trims and loops.
   m_bbox.Destroy();
+
+  DestroyComponentTree();
 }
 
 
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+static std::atomic<unsigned int> ON_Parallel_MaximumThreadCount(0);
+
+unsigned int ON_Parallel::MaximumThreadCount()
+{
+#if defined(OPENNURBS_NO_STD_THREAD)
+  return 1;
+#else
+  unsigned int thread_count = ON_Parallel_MaximumThreadCount;
+  if (0 == thread_count)
+  {
+    thread_count = std::thread::hardware_concurrency();
+    if (0 == thread_count)
+      thread_count = 1;
+  }
+  return thread_count;
+#endif
+}
+
+void ON_Parallel::SetMaximumThreadCount(
+  unsigned int maximum_thread_count
+)
+{
+  ON_Parallel_MaximumThreadCount = maximum_thread_count;
+}
+
+unsigned int ON_Parallel::ThreadCount(
+  size_t task_count,
+  size_t min_tasks_per_thread,
+  unsigned int max_thread_count
+)
+{
+  if (task_count <= 1)
+    return 1;
+  const unsigned int global_max = ON_Parallel::MaximumThreadCount();
+  if (0 == max_thread_count || max_thread_count > global_max)
+    max_thread_count = global_max;
+  if (min_tasks_per_thread < 1)
+    min_tasks_per_thread = 1;
+  const size_t n = task_count / min_tasks_per_thread;
+  if (n < (size_t)max_thread_count)
+    max_thread_count = (n >= 1) ? ((unsigned int)n) : 1U;
+  return max_thread_count;
+}
+
+unsigned int ON_ParallelFor(
+  size_t task_count,
+  size_t min_tasks_per_thread,
+  unsigned int max_thread_count,
+  void (*range_function)(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1),
+  ON__UINT_PTR context
+)
+{
+  if (nullptr == range_function)
+    return 0;
+  if (0 == task_count)
+    return 1;
+
+  const unsigned int thread_count = ON_Parallel::ThreadCount(task_count, min_tasks_per_thread, max_thread_count);
+
+#if !defined(OPENNURBS_NO_STD_THREAD)
+  if (thread_count > 1)
+  {
+    // Block t is [t*task_count/thread_count, (t+1)*task_count/thread_count).
+    std::unique_ptr<std::thread[]> threads(new std::thread[thread_count - 1]);
+    for (unsigned int t = 1; t < thread_count; t++)
+    {
+      const size_t i0 = (task_count * t) / thread_count;
+      const size_t i1 = (task_count * (t + 1)) / thread_count;
+      threads[t - 1] = std::thread(range_function, context, t, i0, i1);
+    }
+    range_function(context, 0, 0, task_count / thread_count);
+    for (unsigned int t = 1; t < thread_count; t++)
+      threads[t - 1].join();
+    return thread_count;
+  }
+#endif
+
+  range_function(context, 0, 0, task_count);
+  return 1;
+}
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#if !defined(OPENNURBS_PARALLEL_INC_)
+#define OPENNURBS_PARALLEL_INC_
+
+/*
+Description:
+  ON_ParallelFor() is a simple fork-join loop used by opennurbs
+  to divide large, independent calculations among threads.
+  The index range [0,task_count) is split into contiguous blocks
+  and each block is passed to range_function.  The partition depends
+  only on task_count, min_tasks_per_thread and the thread count, so
+  a calculation that writes results by task index is deterministic.
+Remarks:
+  When opennurbs is compiled with OPENNURBS_NO_STD_THREAD defined,
+  every loop runs on the calling thread.
+*/
+class ON_CLASS ON_Parallel
+{
+public:
+  ON_Parallel() = delete;
+  ~ON_Parallel() = delete;
+  ON_Parallel(const ON_Parallel&) = delete;
+  ON_Parallel& operator=(const ON_Parallel&) = delete;
+
+  /*
+  Returns:
+    The maximum number of threads ON_ParallelFor() will use.
+    This is the value set by SetMaximumThreadCount() or, by default,
+    the number of hardware threads.  The returned value is always >= 1.
+  */
+  static unsigned int MaximumThreadCount();
+
+  /*
+  Description:
+    Set a global limit on the number of threads used by ON_ParallelFor().
+  Parameters:
+    maximum_thread_count - [in]
+      0: use the number of hardware threads (default).
+      1: all opennurbs parallel calculations run on the calling thread.
+  */
+  static void SetMaximumThreadCount(
+    unsigned int maximum_thread_count
+  );
+
+  /*
+  Parameters:
+    task_count - [in]
+    min_tasks_per_thread - [in]
+      Minimum number of tasks it takes to make a thread worth starting.
+    max_thread_count - [in]
+      0: use ON_Parallel::MaximumThreadCount().
+  Returns:
+    Number of threads ON_ParallelFor() will use for the same parameters.
+    The returned value is >= 1 and <= max(1,task_count).
+  */
+  static unsigned int ThreadCount(
+    size_t task_count,
+    size_t min_tasks_per_thread,
+    unsigned int max_thread_count
+  );
+};
+
+/*
+Description:
+  Call range_function on contiguous blocks of [0,task_count).
+Parameters:
+  task_count - [in]
+  min_tasks_per_thread - [in]
+    Minimum number of tasks it takes to make a thread worth starting.
+    Small loops run on the calling thread.
+  max_thread_count - [in]
+    0: use ON_Parallel::MaximumThreadCount().
+    1: run on the calling thread.
+  range_function - [in]
+    Called once per block.
+      context - [in] the value passed to ON_ParallelFor().
+      thread_index - [in]
+        0 <= thread_index < ON_Parallel::ThreadCount(task_count,min_tasks_per_thread,max_thread_count).
+        Block thread_index covers [i0,i1) and blocks are ordered by thread_index.
+        thread_index = 0 always runs on the calling thread.
+        Use thread_index to select per-thread scratch storage.
+      i0 - [in]
+      i1 - [in]
+        The block is the index range i0 <= i < i1.
+  context - [in]
+    Passed to range_function.
+Returns:
+  Number of threads used.  0 if the input is not valid.
+*/
+ON_DECL
+unsigned int ON_ParallelFor(
+  size_t task_count,
+  size_t min_tasks_per_thread,
+  unsigned int max_thread_count,
+  void (*range_function)(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1),
+  ON__UINT_PTR context
+);
+
+#endif
@@ -252,7 +252,7 @@ bool ON_PointCloud::GetBBox( // returns true if successful
        ) const
 {
   if ( !m_bbox.IsValid() ) {
-    m_P.GetBBox( (double*)&m_bbox.m_min.x, (double*)&m_bbox.m_max.x, false );
+    const_cast<ON_BoundingBox&>(m_bbox).SetFromPointList( false, m_P.UnsignedCount(), 3, (m_P.Count() > 0) ? &m_P[0].x : nullptr, false, true );
   }
   bool rc = m_bbox.IsValid();
   if (rc) {
@@ -289,7 +289,7 @@ bool ON_PointCloud::Transform(
        )
 {
   TransformUserData(xform);
-  bool rc = m_P.Transform(xform);
+  bool rc = xform.TransformPointList(m_P.UnsignedCount(), m_P.Array(), true);
   if (rc && HasPlane() )
     rc = m_plane.Transform(xform);
   m_bbox.Destroy();
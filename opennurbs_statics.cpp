@@ -2881,6 +2881,8 @@ const ON_AggregateComponentStatusEx ON_AggregateComponentStatusEx::NotCurrent =
 
 const ON_SubDComponentPoint ON_SubDComponentPoint::Unset = ON_SubDComponentPoint();
 
+const ON_SubDSurfaceQueryPoint ON_SubDSurfaceQueryPoint::Unset = ON_SubDSurfaceQueryPoint();
+
 static ON_SubDMeshFragmentGrid Internal_EmptyLimitMeshFragmentGridInit()
 {
   ON_SubDMeshFragmentGrid empty;
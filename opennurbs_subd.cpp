@@ -14904,6 +14904,76 @@ const ON_SubDHash ON_SubDimple::FacePackingTopologyHash() const
   return m_face_packing_topology_hash;
 }
 
+template <class T>
+class ON_Internal_SaveSubdivisionPointsContext
+{
+public:
+  const T* const* m_a = nullptr;
+  // ON_SubDIncrementErrorCount() calls made by the workers
+  std::atomic<unsigned int> m_error_count{ 0 };
+};
+
+template <class T>
+static void Internal_SaveSubdivisionPointsRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+)
+{
+  ON_Internal_SaveSubdivisionPointsContext<T>* c = (ON_Internal_SaveSubdivisionPointsContext<T>*)context;
+  const T* const* a = c->m_a;
+  ON_SubDErrorCountCapture errors;
+  double P[3];
+  for (size_t i = i0; i < i1; i++)
+    a[i]->GetSubdivisionPoint(P);
+  if (errors.Count() > 0)
+    c->m_error_count += errors.Count();
+}
+
+template <class T>
+static void Internal_SaveSubdivisionPoints(
+  const ON_SimpleArray<const T*>& a
+)
+{
+  ON_Internal_SaveSubdivisionPointsContext<T> context;
+  context.m_a = a.Array();
+  ON_ParallelFor(a.UnsignedCount(), 0x800, 0, Internal_SaveSubdivisionPointsRange<T>, (ON__UINT_PTR)&context);
+
+  // Damaged components were marked by the workers. Count their errors here,
+  // on the calling thread.
+  for (unsigned int i = context.m_error_count; i > 0; i--)
+    ON_SubDIncrementErrorCount();
+}
+
+static void Internal_ParallelSaveSubdivisionPoints(
+  const ON_SubDLevel& level0
+)
+{
+  // Each component's subdivision point depends only on level0 control net
+  // points and, for vertices, on the saved face subdivision points. Evaluating
+  // faces, then edges, then vertices lets each pass run in parallel because
+  // every thread writes only the saved point of the components it owns.
+  // The serial topology pass in GlobalSubdivide() then uses the saved points.
+  if (ON_Parallel::ThreadCount(level0.m_face_count, 0x800, 0) <= 1)
+    return;
+
+  ON_SimpleArray<const ON_SubDFace*> faces(level0.m_face_count);
+  for (const ON_SubDFace* f0 = level0.m_face[0]; nullptr != f0; f0 = f0->m_next_face)
+    faces.Append(f0);
+  Internal_SaveSubdivisionPoints(faces);
+
+  ON_SimpleArray<const ON_SubDEdge*> edges(level0.m_edge_count);
+  for (const ON_SubDEdge* e0 = level0.m_edge[0]; nullptr != e0; e0 = e0->m_next_edge)
+    edges.Append(e0);
+  Internal_SaveSubdivisionPoints(edges);
+
+  ON_SimpleArray<const ON_SubDVertex*> vertices(level0.m_vertex_count);
+  for (const ON_SubDVertex* v0 = level0.m_vertex[0]; nullptr != v0; v0 = v0->m_next_vertex)
+    vertices.Append(v0);
+  Internal_SaveSubdivisionPoints(vertices);
+}
+
 unsigned int ON_SubDimple::GlobalSubdivide()
 {
   if (m_levels.UnsignedCount() <= 0)
@@ -14921,6 +14991,11 @@ unsigned int ON_SubDimple::GlobalSubdivide()
 
   level0.UpdateEdgeSectorCoefficients(true);
 
+  // Evaluate level1 vertex locations in parallel before the level1
+  // components are allocated and linked. Allocation is done below on
+  // this thread in level0 order so component ids are deterministic.
+  Internal_ParallelSaveSubdivisionPoints(level0);
+
   const unsigned int level1_index = level0_index+1;
   
   ON_SubDLevel* level1 = SubDLevel(level1_index,true);
@@ -7800,6 +7800,27 @@ public:
   */
   void ClearEvaluationCache() const;
 
+  /*
+  Description:
+    Get the faces whose mesh fragments changed since the change flags were last cleared.
+    ON_SubDVertex::SetControlNetPoint(P,true) and ON_SubD::TransformComponents() mark
+    only the faces whose limit surface depends on the moved control net points.
+    Renderers use this list to upload only the fragments that changed.
+  Parameters:
+    changed_faces - [out]
+      Faces in the active level with ON_SubDFace::MeshFragmentsChanged() = true.
+      If a face's fragments are dirty, ON_SubDFace::MeshFragments() returns nullptr
+      until the fragments are updated.
+    bClearChangedFlags - [in]
+      If true, the flags on the returned faces are cleared.
+  Returns:
+    Number of faces appended to changed_faces[].
+  */
+  unsigned int GetFacesWithChangedMeshFragments(
+    ON_SimpleArray<const class ON_SubDFace*>& changed_faces,
+    bool bClearChangedFlags
+  ) const;
+
   /*
   Description:
     This function copies cached evaluations of component subdivision points and limit
@@ -15344,6 +15365,24 @@ public:
   */
   const class ON_SubDMeshFragment* MeshFragments() const;
 
+  /*
+  Returns:
+    True if this face's mesh fragments were marked dirty, transformed,
+    or removed since the last call to ClearMeshFragmentsChanged().
+  Remarks:
+    Moving a control net point marks only the faces whose limit surface
+    depends on that point. Renderers use this information to upload
+    only the fragments that changed.
+    See ON_SubD::GetFacesWithChangedMeshFragments().
+  */
+  bool MeshFragmentsChanged() const;
+
+  /*
+  Description:
+    Clears the flag returned by MeshFragmentsChanged().
+  */
+  void ClearMeshFragmentsChanged() const;
+
 
   /// <summary>
   /// The face's control net center point is the average of the face's
@@ -17142,6 +17181,271 @@ private:
   mutable unsigned int m_half_size_fragment_count = 0;
 };
 
+/*
+Description:
+  ON_SubDMeshFragmentBuffers copies the points, normals and texture coordinates
+  of the fragments delivered by an ON_SubDMeshFragmentIterator into caller supplied
+  single precision buffers that can be handed directly to a GPU.
+
+  The vertices of each fragment are contiguous and in grid point order. Fragments
+  with the same grid share one triangle index buffer, so fragment i is drawn with
+  the index buffer for grid FragmentGridIndex(i) and base vertex FragmentVertexOffset(i).
+
+  The fragment list is kept by this class and its memory is reused by later calls
+  to SetFragments(). Vertex and index buffers are always supplied by the caller,
+  so exporting an updated SubD with a reused ON_SubDMeshFragmentBuffers does not
+  allocate memory.
+
+  Each face can be exported with a display density reduction. A reduced fragment
+  uses every 2^reduction grid point in each direction. Where neighboring faces are
+  exported with different reductions, the points on the finer face's side of the
+  shared edge are moved onto the coarser face's edge polyline so the exported mesh
+  has no cracks.
+Example:
+  ON_SubDMeshFragmentIterator fit(subd);
+  ON_SubDMeshFragmentBuffers buffers;
+  buffers.SetFragments(fit);
+  const unsigned int stride = ON_SubDMeshFragmentBuffers::InterleavedFloatCount(true, false);
+  float* V = ... buffers.VertexCount()*stride floats ...
+  buffers.GetInterleavedVertices(V, true, false, true);
+  for (unsigned int gi = 0; gi < buffers.GridCount(); ++gi)
+  {
+    unsigned int* I = ... buffers.TriangleIndexCount(gi) unsigned ints ...
+    buffers.GetTriangleIndices(gi, I);
+  }
+*/
+class ON_CLASS ON_SubDMeshFragmentBuffers
+{
+public:
+  ON_SubDMeshFragmentBuffers() = default;
+  ~ON_SubDMeshFragmentBuffers() = default;
+  ON_SubDMeshFragmentBuffers(const ON_SubDMeshFragmentBuffers&) = default;
+  ON_SubDMeshFragmentBuffers& operator=(const ON_SubDMeshFragmentBuffers&) = default;
+
+  /*
+  Description:
+    Get the fragments from fit and the vertex and grid counts.
+  Parameters:
+    fit - [in]
+      fit.SubDAppearance() selects surface or control net points.
+  Returns:
+    Number of fragments.
+  */
+  unsigned int SetFragments(
+    ON_SubDMeshFragmentIterator& fit
+  );
+
+  /*
+  Description:
+    Get the fragments from fit and use a callback to select the display
+    density reduction for each face.
+  Parameters:
+    fit - [in]
+      fit.SubDAppearance() selects surface or control net points.
+    fragment_density_reduction - [in]
+      nullptr or a function that returns the desired display density reduction
+      for a fragment. 0 = no reduction, 1 = quarter as many quads, ...
+      A face uses the smallest value returned for its fragments. The reduction
+      is limited so a face edge always has at least 2 segments.
+    context - [in]
+      passed as the first parameter to fragment_density_reduction.
+  Returns:
+    Number of fragments.
+  */
+  unsigned int SetFragments(
+    ON_SubDMeshFragmentIterator& fit,
+    unsigned int(*fragment_density_reduction)(ON__UINT_PTR context, const ON_SubDMeshFragment& fragment),
+    ON__UINT_PTR context
+  );
+
+  /*
+  Description:
+    Get the fragments from fit and select the display density reduction for
+    each face from its projected size in a viewport.
+  Parameters:
+    fit - [in]
+    viewport - [in]
+    pixel_tolerance - [in]
+      Target length of a mesh quad edge in pixels. 
+      Faces whose quads are smaller than this on screen are exported with fewer quads.
+  Returns:
+    Number of fragments.
+  */
+  unsigned int SetFragments(
+    ON_SubDMeshFragmentIterator& fit,
+    const ON_Viewport& viewport,
+    double pixel_tolerance
+  );
+
+  /*
+  Parameters:
+    fragment - [in]
+    subd_appearance - [in]
+    world_to_screen - [in]
+      world to screen transformation.
+    pixel_tolerance - [in]
+      Target length of a mesh quad edge in pixels.
+  Returns:
+    The largest display density reduction that keeps the projected length of 
+    the fragment's boundary segments at or below pixel_tolerance.
+    If any boundary point is behind the camera, 0 is returned.
+  */
+  static unsigned int DensityReductionFromProjectedSize(
+    const ON_SubDMeshFragment& fragment,
+    ON_SubDComponentLocation subd_appearance,
+    const ON_Xform& world_to_screen,
+    double pixel_tolerance
+  );
+
+  /*
+  Description:
+    Removes the fragments. Memory is kept for reuse.
+  */
+  void Clear();
+
+  unsigned int FragmentCount() const;
+
+  /*
+  Returns:
+    Total number of vertices in all fragments.
+  */
+  unsigned int VertexCount() const;
+
+  /*
+  Returns:
+    Number of distinct grids used by the fragments.
+  */
+  unsigned int GridCount() const;
+
+  const ON_SubDMeshFragmentGrid& Grid(
+    unsigned int grid_index
+  ) const;
+
+  /*
+  Returns:
+    6 * Grid(grid_index).GridFaceCount(). Each grid quad is two triangles.
+  */
+  unsigned int TriangleIndexCount(
+    unsigned int grid_index
+  ) const;
+
+  const ON_SubDMeshFragment* Fragment(
+    unsigned int fragment_index
+  ) const;
+
+  /*
+  Returns:
+    Index of the fragment's first vertex in the vertex buffers.
+  */
+  unsigned int FragmentVertexOffset(
+    unsigned int fragment_index
+  ) const;
+
+  unsigned int FragmentGridIndex(
+    unsigned int fragment_index
+  ) const;
+
+  /*
+  Returns:
+    Display density reduction used to export the fragment.
+  */
+  unsigned int FragmentDensityReduction(
+    unsigned int fragment_index
+  ) const;
+
+  /*
+  Returns:
+    Number of floats per vertex written by GetInterleavedVertices().
+    3 for the point, 3 more for a normal and 2 more for a texture coordinate.
+  */
+  static unsigned int InterleavedFloatCount(
+    bool bNormals,
+    bool bTextureCoordinates
+  );
+
+  /*
+  Description:
+    Write interleaved (x,y,z[,nx,ny,nz][,s,t]) vertices.
+  Parameters:
+    vertices - [out]
+      Capacity must be at least VertexCount()*InterleavedFloatCount(bNormals,bTextureCoordinates).
+    bNormals - [in]
+    bTextureCoordinates - [in]
+      Missing normals and texture coordinates are written as zeros.
+    bParallel - [in]
+      If true, large exports are divided among threads with ON_ParallelFor().
+  Returns:
+    True if successful.
+  */
+  bool GetInterleavedVertices(
+    float* vertices,
+    bool bNormals,
+    bool bTextureCoordinates,
+    bool bParallel
+  ) const;
+
+  /*
+  Description:
+    Write vertices into separate arrays.
+  Parameters:
+    points - [out]
+      nullptr or capacity >= 3*VertexCount().
+    normals - [out]
+      nullptr or capacity >= 3*VertexCount().
+    texture_coordinates - [out]
+      nullptr or capacity >= 2*VertexCount().
+    bParallel - [in]
+      If true, large exports are divided among threads with ON_ParallelFor().
+  Returns:
+    True if successful.
+  */
+  bool GetVertexArrays(
+    float* points,
+    float* normals,
+    float* texture_coordinates,
+    bool bParallel
+  ) const;
+
+  /*
+  Description:
+    Write the triangle indices for a grid. The indices are relative to a
+    fragment's first vertex.
+  Parameters:
+    grid_index - [in]
+    indices - [out]
+      Capacity must be at least TriangleIndexCount(grid_index).
+  Returns:
+    Number of indices written.
+  */
+  unsigned int GetTriangleIndices(
+    unsigned int grid_index,
+    unsigned int* indices
+  ) const;
+
+private:
+  bool Internal_GetVertices(
+    float* P,
+    float* N,
+    float* T,
+    size_t stride,
+    bool bParallel
+  ) const;
+
+  ON_SubDComponentLocation m_subd_appearance = ON_SubDComponentLocation::Surface;
+  unsigned int m_vertex_count = 0;
+  ON_SimpleArray<const ON_SubDMeshFragment*> m_fragments;
+  // m_vertex_offset[] has FragmentCount()+1 elements.
+  ON_SimpleArray<unsigned int> m_vertex_offset;
+  ON_SimpleArray<unsigned int> m_grid_index;
+  // m_reduction[] bits 0-3 = fragment's display density reduction.
+  // Bits 4(k+1) to 4(k+1)+3 = log2(fragment edge segments/neighbor edge segments)
+  // on grid side k when the neighbor is coarser, and 0 otherwise.
+  ON_SimpleArray<ON__UINT32> m_reduction;
+  ON_SimpleArray<ON_SubDMeshFragmentGrid> m_grids;
+  // indexed by face id, edge segment count of each exported face
+  ON_SimpleArray<unsigned short> m_face_edge_segment_count;
+};
+
 
 //////////////////////////////////////////////////////////////////////////
 //
@@ -18676,6 +18980,574 @@ private:
   ON_SimpleArray<double> m__buffer; // m_LP, m_L1, m_L2, m_E1, m_E2 memory  
 };
 
+//////////////////////////////////////////////////////////////////////////
+//
+// ON_SubDSurfacePointStencils
+//
+
+/*
+Description:
+  ON_SubDSurfacePointStencils stores, for every vertex on the active level of
+  a SubD, a sparse list of weights (a stencil) that maps control net points to
+  the vertex's surface point and to the two tangents used to calculate the
+  surface normal at that point.
+
+  The weights depend on the SubD topology, vertex and edge tags, edge sharpness,
+  and sector coefficients. They do not depend on control net point locations.
+  After control net points are edited, the surface points and normals can be
+  recalculated with a sparse matrix - vector product and no local subdivision.
+Remarks:
+  Corner sector coefficients depend on the angle between the corner's crease
+  edges, so moving the vertices around a corner can change the weights.
+  IsValidFor() checks the corner sector angles and returns false when the
+  stencils must be recreated.
+*/
+class ON_CLASS ON_SubDSurfacePointStencils
+{
+public:
+  ON_SubDSurfacePointStencils() = default;
+  ~ON_SubDSurfacePointStencils() = default;
+  ON_SubDSurfacePointStencils(const ON_SubDSurfacePointStencils&) = default;
+  ON_SubDSurfacePointStencils& operator=(const ON_SubDSurfacePointStencils&) = default;
+
+public:
+  /*
+  Description:
+    Calculate the surface point stencils for every vertex on the active level of subd.
+  Parameters:
+    subd - [in]
+  Returns:
+    True if successful. 
+    Vertices whose surface point cannot be evaluated (wire vertices, damaged topology)
+    have empty stencils and evaluate to ON_3dPoint::NanPoint.
+  Remarks:
+    Create() evaluates sector point rings on a private copy of subd, so subd is not modified.
+    The cost is comparable to evaluating every vertex surface point a few dozen times.
+  */
+  bool Create(
+    const class ON_SubD& subd
+  );
+
+  void Destroy();
+
+  /*
+  Returns:
+    Number of vertices (rows) in the stencil table.
+  */
+  unsigned int VertexCount() const;
+
+  /*
+  Returns:
+    Total number of nonzero stencil weights.
+  */
+  unsigned int StencilWeightCount() const;
+
+  /*
+  Parameters:
+    vertex_index - [in]
+      0 <= vertex_index < VertexCount()
+  Returns:
+    The id of the SubD vertex whose control net point is control_points[vertex_index]
+    and whose surface point is surface_points[vertex_index] in Evaluate().
+    The vertex order is the order of ON_SubDVertexIterator when Create() was called.
+  */
+  unsigned int VertexId(
+    unsigned int vertex_index
+  ) const;
+
+  /*
+  Parameters:
+    subd - [in]
+  Returns:
+    True if subd has the vertex ids and topology these stencils were created from
+    and every corner sector has the snapped corner angle it had when Create()
+    was called.
+  Remarks:
+    Changes to vertex tags or edge sharpness are not detected. 
+    Call Create() after changing them.
+  */
+  bool IsValidFor(
+    const class ON_SubD& subd
+  ) const;
+
+  /*
+  Description:
+    Evaluate surface points and, optionally, surface normals from control net points.
+  Parameters:
+    control_point_stride - [in] (>= 3)
+    control_points - [in]
+      VertexCount() control net points. control_points[i*control_point_stride] is
+      the control net point of the vertex with id VertexId(i).
+    surface_point_stride - [in] (>= 3)
+    surface_points - [out]
+      VertexCount() surface points.
+    surface_normal_stride - [in] (>= 3 when surface_normals is not nullptr)
+    surface_normals - [out]
+      If not nullptr, VertexCount() unit surface normals are returned.
+      The normal is the zero vector when the surface tangents are parallel.
+    bParallel - [in]
+      If true, the work may be split across ON_Parallel::MaximumThreadCount() threads.
+  Returns:
+    True if successful.
+  */
+  bool Evaluate(
+    size_t control_point_stride,
+    const double* control_points,
+    size_t surface_point_stride,
+    double* surface_points,
+    size_t surface_normal_stride,
+    double* surface_normals,
+    bool bParallel
+  ) const;
+
+  /*
+  Description:
+    Evaluate surface points and, optionally, surface normals using the current
+    control net points of subd.
+  Parameters:
+    subd - [in]
+      IsValidFor(subd) must be true.
+    surface_points - [out]
+      surface_points[i] is the surface point of the vertex with id VertexId(i).
+    surface_normals - [out]
+      If not nullptr, surface_normals[i] is the surface normal of the vertex with id VertexId(i).
+    bParallel - [in]
+      If true, the work may be split across ON_Parallel::MaximumThreadCount() threads.
+  Returns:
+    True if successful.
+  */
+  bool Evaluate(
+    const class ON_SubD& subd,
+    ON_SimpleArray<ON_3dPoint>& surface_points,
+    ON_SimpleArray<ON_3dVector>* surface_normals,
+    bool bParallel
+  ) const;
+
+private:
+  ON_SHA1_Hash m_topology_hash;
+
+  // m_vertex_id[i] = id of the vertex whose control point is control_points[i]
+  ON_SimpleArray<unsigned int> m_vertex_id;
+
+  // The stencil for vertex i is
+  //   m_stencil_index[j] and m_stencil_weight[3*j],[3*j+1],[3*j+2]
+  //   for m_stencil_start[i] <= j < m_stencil_start[i+1]
+  // The three weights are for the surface point and the two surface tangents.
+  ON_SimpleArray<unsigned int> m_stencil_start;
+  ON_SimpleArray<unsigned int> m_stencil_index;
+  ON_SimpleArray<double> m_stencil_weight;
+
+  // Corner sectors. For each corner vertex face, m_corner_sector[] has the triple
+  //   vertex index, index of the face in the vertex's m_faces[], ON_SubDSectorType::CornerSectorAngleIndex()
+  // Vertex indices increase.
+  ON_SimpleArray<unsigned int> m_corner_sector;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//
+// ON_SubDTopologySnapshot
+//
+
+/*
+Description:
+  ON_SubDTopologySnapshot is a compact, read-only copy of the active level
+  of a SubD control net. Components are identified by 32-bit indices,
+  adjacency is stored in flat compressed sparse row (CSR) arrays and the
+  control net points are stored as separate x, y and z arrays.
+
+  Vertices, edges and faces are indexed in ON_SubDVertexIterator,
+  ON_SubDEdgeIterator and ON_SubDFaceIterator order. The vertex order is the
+  same as ON_SubDSurfacePointStencils, so surface points can be evaluated
+  directly from GetControlNetPoints().
+
+  For a quad mesh-like SubD, a snapshot uses about one sixth of the memory
+  reported by ON_SubD::SizeOf(). ToSubD() creates an ON_SubD for meshing and other
+  calculations that need the full SubD. Write() and Read() save the
+  snapshot without creating an ON_SubD.
+Remarks:
+  Edge and face references in the CSR arrays are packed as 
+  (index << 1) | direction. For a face's edge, direction 1 means the 
+  edge is reversed in the face's boundary. For a vertex's edge, direction 1
+  means the vertex is the edge's end. For an edge's face, direction 1 means
+  the edge is reversed in the face's boundary.
+*/
+class ON_CLASS ON_SubDTopologySnapshot
+{
+public:
+  ON_SubDTopologySnapshot() = default;
+  ~ON_SubDTopologySnapshot() = default;
+  ON_SubDTopologySnapshot(const ON_SubDTopologySnapshot&) = default;
+  ON_SubDTopologySnapshot& operator=(const ON_SubDTopologySnapshot&) = default;
+
+public:
+  /*
+  Description:
+    Create a snapshot of the active level of subd.
+  Returns:
+    True if successful.
+  */
+  bool Create(
+    const class ON_SubD& subd
+  );
+
+  void Destroy();
+
+  bool IsEmpty() const;
+
+  unsigned int VertexCount() const;
+  unsigned int EdgeCount() const;
+  unsigned int FaceCount() const;
+
+  /*
+  Returns:
+    Number of bytes used by this snapshot.
+  */
+  size_t SizeOf() const;
+
+  /*
+  Returns:
+    Geometry content serial number of the SubD when Create() was called.
+  */
+  ON__UINT64 GeometryContentSerialNumber() const;
+
+  /////////////////////////////////////////////////////////////////
+  //
+  // Vertices
+  //
+  unsigned int VertexId(unsigned int vertex_index) const;
+  ON_SubDVertexTag VertexTag(unsigned int vertex_index) const;
+  const ON_3dPoint ControlNetPoint(unsigned int vertex_index) const;
+
+  /*
+  Returns:
+    Arrays of VertexCount() control net point coordinates.
+  */
+  const double* ControlNetX() const;
+  const double* ControlNetY() const;
+  const double* ControlNetZ() const;
+
+  /*
+  Description:
+    Copy the control net points to an interleaved array.
+  Parameters:
+    point_stride - [in] (>= 3)
+    points - [out]
+      capacity >= VertexCount()*point_stride
+  Returns:
+    True if successful.
+  Remarks:
+    The output can be passed to ON_SubDSurfacePointStencils::Evaluate().
+  */
+  bool GetControlNetPoints(
+    size_t point_stride,
+    double* points
+  ) const;
+
+  unsigned int VertexEdgeCount(unsigned int vertex_index) const;
+
+  /*
+  Returns:
+    (edge index << 1) | (1 if the vertex is the edge's end)
+  */
+  unsigned int VertexEdge(unsigned int vertex_index, unsigned int i) const;
+
+  unsigned int VertexFaceCount(unsigned int vertex_index) const;
+  unsigned int VertexFace(unsigned int vertex_index, unsigned int i) const;
+
+  /////////////////////////////////////////////////////////////////
+  //
+  // Edges
+  //
+  unsigned int EdgeId(unsigned int edge_index) const;
+  ON_SubDEdgeTag EdgeTag(unsigned int edge_index) const;
+  const ON_SubDEdgeSharpness EdgeSharpness(unsigned int edge_index) const;
+
+  /*
+  Parameters:
+    edge_index - [in]
+    evi - [in]
+      0 = start vertex, 1 = end vertex
+  */
+  unsigned int EdgeVertex(unsigned int edge_index, unsigned int evi) const;
+
+  unsigned int EdgeFaceCount(unsigned int edge_index) const;
+
+  /*
+  Returns:
+    (face index << 1) | (1 if the edge is reversed in the face's boundary)
+  */
+  unsigned int EdgeFace(unsigned int edge_index, unsigned int i) const;
+
+  /////////////////////////////////////////////////////////////////
+  //
+  // Faces
+  //
+  unsigned int FaceId(unsigned int face_index) const;
+  unsigned int FaceEdgeCount(unsigned int face_index) const;
+
+  /*
+  Returns:
+    (edge index << 1) | (1 if the edge is reversed in the face's boundary)
+  */
+  unsigned int FaceEdge(unsigned int face_index, unsigned int i) const;
+
+  /*
+  Returns:
+    Index of the vertex at the start of the face's i-th edge.
+  */
+  unsigned int FaceVertex(unsigned int face_index, unsigned int i) const;
+
+  /////////////////////////////////////////////////////////////////
+  //
+  // SubD and archive
+  //
+
+  /*
+  Description:
+    Create a SubD from the snapshot. Component ids are preserved.
+  Parameters:
+    destination_subd - [in]
+      If not nullptr, the SubD is created in destination_subd.
+  Returns:
+    A pointer to the SubD or nullptr if the snapshot is empty or not valid.
+  */
+  class ON_SubD* ToSubD(
+    class ON_SubD* destination_subd
+  ) const;
+
+  bool Write(
+    class ON_BinaryArchive& archive
+  ) const;
+
+  bool Read(
+    class ON_BinaryArchive& archive
+  );
+
+private:
+  ON__UINT64 m_geometry_content_serial_number = 0;
+
+  // vertices
+  ON_SimpleArray<unsigned int> m_vertex_id;
+  ON_SimpleArray<unsigned char> m_vertex_tag;
+  ON_SimpleArray<double> m_x;
+  ON_SimpleArray<double> m_y;
+  ON_SimpleArray<double> m_z;
+  ON_SimpleArray<unsigned int> m_vertex_edge_start; // VertexCount()+1
+  ON_SimpleArray<unsigned int> m_vertex_edge;
+  ON_SimpleArray<unsigned int> m_vertex_face_start; // VertexCount()+1
+  ON_SimpleArray<unsigned int> m_vertex_face;
+
+  // edges
+  ON_SimpleArray<unsigned int> m_edge_id;
+  ON_SimpleArray<unsigned char> m_edge_tag;
+  ON_SimpleArray<unsigned int> m_edge_vertex; // 2*EdgeCount()
+  // m_edge_sharpness[] is empty when no edge is sharp. Otherwise 2*EdgeCount().
+  ON_SimpleArray<float> m_edge_sharpness;
+  ON_SimpleArray<unsigned int> m_edge_face_start; // EdgeCount()+1
+  ON_SimpleArray<unsigned int> m_edge_face;
+
+  // faces
+  ON_SimpleArray<unsigned int> m_face_id;
+  ON_SimpleArray<unsigned int> m_face_edge_start; // FaceCount()+1
+  ON_SimpleArray<unsigned int> m_face_edge;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//
+// ON_SubDSurfaceQuery
+//
+
+/*
+Description:
+  ON_SubDSurfaceQueryPoint reports a point on a SubD surface found by
+  ON_SubDSurfaceQuery.
+*/
+class ON_CLASS ON_SubDSurfaceQueryPoint
+{
+public:
+  static const ON_SubDSurfaceQueryPoint Unset;
+
+  ON_SubDSurfaceQueryPoint() = default;
+  ~ON_SubDSurfaceQueryPoint() = default;
+  ON_SubDSurfaceQueryPoint(const ON_SubDSurfaceQueryPoint&) = default;
+  ON_SubDSurfaceQueryPoint& operator=(const ON_SubDSurfaceQueryPoint&) = default;
+
+  bool IsSet() const;
+
+  // The face the point is on.
+  ON_SubDComponentPtr m_component_ptr = ON_SubDComponentPtr::Null;
+
+  // When the face is a quad, m_face_corner_index is ON_UNSET_UINT_INDEX and
+  // m_face_parameter is the quad's (s,t) with face->Vertex(0) at (0,0),
+  // face->Vertex(1) at (1,0), face->Vertex(2) at (1,1) and face->Vertex(3) at (0,1).
+  //
+  // Otherwise m_face_corner_index identifies the face corner subquad and
+  // m_face_parameter is the subquad's (s,t) with face->Vertex(m_face_corner_index)
+  // at (0,0), the midpoint of face->Edge(m_face_corner_index) at (1,0),
+  // the face center at (1,1) and the midpoint of the previous face edge at (0,1).
+  unsigned int m_face_corner_index = ON_UNSET_UINT_INDEX;
+  ON_2dPoint m_face_parameter = ON_2dPoint::NanPoint;
+
+  // surface point and unit normal
+  ON_3dPoint m_point = ON_3dPoint::NanPoint;
+  ON_3dVector m_normal = ON_3dVector::NanVector;
+
+  // GetClosestPoint(): distance from the test point to m_point.
+  // IntersectRay(): ray parameter of m_point.
+  double m_distance = ON_DBL_QNAN;
+};
+
+/*
+Description:
+  ON_SubDSurfaceQuery answers closest point and ray intersection queries
+  on a SubD surface.
+
+  Create() converts the surface of every face into bicubic patches and
+  builds an ON_RTree of the patch bounding boxes. Queries search the tree
+  and refine candidates with Newton iteration on the patches.
+
+  Patches are exact pieces of the SubD surface. Near an extraordinary vertex
+  the face is locally subdivided and the tiny corner region left after the
+  last subdivision is a bilinear patch through points on the surface.
+
+  Queries are const and use no mutable state, so any number of threads may
+  query the same ON_SubDSurfaceQuery at the same time.
+Remarks:
+  The query references the faces of the SubD passed to Create(). The SubD
+  must exist and not be modified while the query is used. 
+  GeometryContentSerialNumber() can be used to detect changes.
+*/
+class ON_CLASS ON_SubDSurfaceQuery
+{
+public:
+  ON_SubDSurfaceQuery() = default;
+  ~ON_SubDSurfaceQuery() = default;
+
+private:
+  ON_SubDSurfaceQuery(const ON_SubDSurfaceQuery&) = delete;
+  ON_SubDSurfaceQuery& operator=(const ON_SubDSurfaceQuery&) = delete;
+
+public:
+  /*
+  Description:
+    Create patches and the patch tree for the active level of subd.
+  Parameters:
+    subd - [in]
+    maximum_subdivision_depth - [in]
+      Number of local subdivisions applied toward an extraordinary vertex.
+      The approximated region at the vertex has size 2^-(depth+1) of the face.
+      Values are clamped to 1 to 8.
+  Returns:
+    True if successful.
+  Remarks:
+    Create() may update values SubD caches on subd's components, 
+    so it must not be called while other threads are using subd.
+  */
+  bool Create(
+    const class ON_SubD& subd,
+    unsigned int maximum_subdivision_depth = 6
+  );
+
+  void Destroy();
+
+  bool IsEmpty() const;
+
+  unsigned int PatchCount() const;
+
+  const ON_BoundingBox BoundingBox() const;
+
+  /*
+  Returns:
+    Geometry content serial number of the SubD when Create() was called.
+  */
+  ON__UINT64 GeometryContentSerialNumber() const;
+
+  /*
+  Description:
+    Find the point on the SubD surface closest to P.
+  Parameters:
+    P - [in]
+    maximum_distance - [in]
+      If > 0, only points within maximum_distance of P are considered.
+    closest_point - [out]
+  Returns:
+    True if a point was found.
+  */
+  bool GetClosestPoint(
+    ON_3dPoint P,
+    double maximum_distance,
+    ON_SubDSurfaceQueryPoint& closest_point
+  ) const;
+
+  /*
+  Description:
+    Find closest points for many test points.
+  Parameters:
+    point_count - [in]
+    points - [in]
+    maximum_distance - [in]
+      If > 0, only points within maximum_distance of P are considered.
+    closest_points - [out]
+      closest_points[i] is Unset when no point was found for points[i].
+    bParallel - [in]
+      If true, points are processed by multiple threads.
+  Returns:
+    Number of points found.
+  */
+  unsigned int GetClosestPoints(
+    size_t point_count,
+    const ON_3dPoint* points,
+    double maximum_distance,
+    ON_SubDSurfaceQueryPoint* closest_points,
+    bool bParallel
+  ) const;
+
+  /*
+  Description:
+    Find the first point where a ray hits the SubD surface.
+  Parameters:
+    ray - [in]
+      The ray is ray.m_P + t*ray.m_V with t >= 0.
+    maximum_parameter - [in]
+      If > 0, only hits with t <= maximum_parameter are considered.
+    hit_point - [out]
+      hit_point.m_distance is the ray parameter t.
+  Returns:
+    True if the ray hits the surface.
+  */
+  bool IntersectRay(
+    const ON_3dRay& ray,
+    double maximum_parameter,
+    ON_SubDSurfaceQueryPoint& hit_point
+  ) const;
+
+private:
+  friend class ON_Internal_SubDSurfaceQueryBuilder;
+
+  ON__UINT64 m_geometry_content_serial_number = 0;
+  ON_BoundingBox m_bbox = ON_BoundingBox::EmptyBoundingBox;
+
+  // m_patch_cv[] has 48 doubles per patch (bicubic Bezier CVs [i][j][xyz])
+  ON_SimpleArray<double> m_patch_cv;
+
+  // The face parameter of patch parameter (u,v) is
+  //  s = m[0] + m[2]*u + m[4]*v, t = m[1] + m[3]*u + m[5]*v
+  // where m[] are the 6 doubles for the patch in m_patch_map[].
+  ON_SimpleArray<double> m_patch_map;
+
+  ON_SimpleArray<ON_BoundingBox> m_patch_bbox;
+  ON_SimpleArray<ON_SubDComponentPtr> m_patch_face;
+  ON_SimpleArray<unsigned int> m_patch_face_corner;
+  ON_RTree m_patch_tree;
+
+  const ON_SubDSurfaceQueryPoint Internal_QueryPoint(
+    unsigned int patch_index,
+    double u,
+    double v,
+    double distance
+  ) const;
+};
+
 //////////////////////////////////////////////////////////////////////////
 //
 // ON_SubD_FixedSizeHeap
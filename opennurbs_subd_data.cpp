@@ -749,8 +749,8 @@ bool ON_SubDVertex::SetControlNetPoint(
         if (nullptr == face)
           continue;
 
-        // face->ON_SubDComponentBase::Internal_ClearSubdivisionPointAndSurfacePointFlags() is fast
-        face->ON_SubDComponentBase::Internal_ClearSubdivisionPointAndSurfacePointFlags();
+        // face->ClearSavedSubdivisionPoints() is fast and records the mesh fragment change.
+        face->ClearSavedSubdivisionPoints();
 
         const ON_SubDEdgePtr* face_eptr = face->m_edge4;
         for (unsigned short fei = 0; fei < face->m_edge_count; fei++, face_eptr++)
@@ -795,7 +795,7 @@ bool ON_SubDVertex::SetControlNetPoint(
             // moving "this" vertex.
             const ON_SubDFace* f2 = v1->m_faces[v1fi];
             if (nullptr != f2)
-              f2->ON_SubDComponentBase::Internal_ClearSubdivisionPointAndSurfacePointFlags();
+              f2->ClearSavedSubdivisionPoints();
           }
         }
       }
@@ -855,6 +855,8 @@ bool ON_SubDFace::Transform(
     }
     else
       Internal_ClearSurfacePointFlag();
+    if (nullptr != m_mesh_fragments)
+      Internal_SetModified1Flag();
   }
   else
     this->ClearSavedSubdivisionPoints();
@@ -417,6 +417,33 @@ void ON_SubDIncrementErrorCount(); // defined in opennurbs_subd.cpp
 #define ON_SUBD_RETURN_ERROR(rc) (ON_SubDIncrementErrorCount(),rc)
 #define ON_SUBD_RETURN_ERROR_MSG(msg,rc) (ON_SubDIncrementErrorCount(),ON_ERROR(msg),rc)
 
+//////////////////////////////////////////////////////////////////////////
+//
+// ON_SubDErrorCountCapture
+//
+//  While an ON_SubDErrorCountCapture is in scope, ON_SubDIncrementErrorCount()
+//  calls made on the same thread are added to Count() and the global error
+//  counters are not changed. ON_ParallelFor workers use a capture and the
+//  calling thread reports the total with ON_SubDIncrementErrorCount().
+//
+class ON_SubDErrorCountCapture
+{
+public:
+  ON_SubDErrorCountCapture();
+  ~ON_SubDErrorCountCapture();
+
+  unsigned int Count() const;
+
+private:
+  friend void ON_SubDIncrementErrorCount();
+  ON_SubDErrorCountCapture* m_previous_capture = nullptr;
+  unsigned int m_count = 0;
+
+private:
+  ON_SubDErrorCountCapture(const ON_SubDErrorCountCapture&) = delete;
+  ON_SubDErrorCountCapture& operator=(const ON_SubDErrorCountCapture&) = delete;
+};
+
 //////////////////////////////////////////////////////////////////////////
 //
 // ON_SubDVertexPtr, ON_SubDEdgePtr, and ON_SubDFacePtr are unsigned ints 
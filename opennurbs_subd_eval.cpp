@@ -1134,6 +1134,22 @@ void ON_SubDFace::ClearSavedSubdivisionPoints() const
 {
   // considering using a global pool for the limit fragment cache - not yet.
   ON_SubDComponentBase::Internal_ClearSubdivisionPointAndSurfacePointFlags();
+  if (nullptr != m_mesh_fragments)
+  {
+    // The fragments are now dirty. Record the change so renderers can
+    // find the faces whose fragments need to be uploaded again.
+    Internal_SetModified1Flag();
+  }
+}
+
+bool ON_SubDFace::MeshFragmentsChanged() const
+{
+  return Internal_Modified1IsSet();
+}
+
+void ON_SubDFace::ClearMeshFragmentsChanged() const
+{
+  Internal_ClearModifiedFlags();
 }
 
 void ON_SubDFace::ClearSavedSubdivisionPoints(bool bClearNeighborhood) const
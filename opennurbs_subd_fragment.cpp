@@ -2211,7 +2211,7 @@ unsigned int ON_SubDMeshFragmentGrid::GridId() const
 {
   for (;;)
   {
-    if (nullptr != m_F)
+    if (nullptr == m_F)
       break;
 
     // m_F_count = 2^(2n)
@@ -2225,6 +2225,7 @@ unsigned int ON_SubDMeshFragmentGrid::GridId() const
         return id;
       }
     }
+    break;
   }
 
   return 0;
@@ -4407,3 +4408,606 @@ unsigned int ON_SubDMeshFragmentIterator::MaximumDensityPointCount() const
 {
   return TotalPointCount(MaximumMeshDensity());
 }
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+//
+// ON_SubDMeshFragmentBuffers
+//
+
+void ON_SubDMeshFragmentBuffers::Clear()
+{
+  m_subd_appearance = ON_SubDComponentLocation::Surface;
+  m_vertex_count = 0;
+  m_fragments.SetCount(0);
+  m_vertex_offset.SetCount(0);
+  m_grid_index.SetCount(0);
+  m_reduction.SetCount(0);
+  m_grids.SetCount(0);
+  m_face_edge_segment_count.SetCount(0);
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::SetFragments(
+  ON_SubDMeshFragmentIterator& fit
+)
+{
+  return SetFragments(fit, nullptr, 0);
+}
+
+static unsigned int Internal_FragmentEdgeSegmentCount(
+  const ON_SubDMeshFragment* fragment,
+  unsigned int side_segment_count
+)
+{
+  // A full fragment side spans a face edge. 
+  // A partial (n-gon corner) fragment side spans half of a face edge.
+  return fragment->IsFullFaceFragment() ? side_segment_count : 2U * side_segment_count;
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::SetFragments(
+  ON_SubDMeshFragmentIterator& fit,
+  unsigned int(*fragment_density_reduction)(ON__UINT_PTR context, const ON_SubDMeshFragment& fragment),
+  ON__UINT_PTR context
+)
+{
+  Clear();
+  m_subd_appearance = fit.SubDAppearance();
+
+  const unsigned int fragment_capacity = fit.FragmentCount();
+  m_fragments.Reserve(fragment_capacity);
+  m_vertex_offset.Reserve(fragment_capacity + 1);
+  m_grid_index.Reserve(fragment_capacity);
+  m_reduction.Reserve(fragment_capacity);
+
+  // Get the fragments and the display density reduction of each face.
+  unsigned int max_face_id = 0;
+  unsigned int face_fragment0 = 0;
+  unsigned int face_reduction = 0;
+  const ON_SubDFace* face = nullptr;
+  for (const ON_SubDMeshFragment* fragment = fit.FirstFragment(); nullptr != fragment; fragment = fit.NextFragment())
+  {
+    const unsigned int point_count = fragment->PointArrayCount(m_subd_appearance);
+    if (0 == point_count || nullptr == fragment->PointArray(m_subd_appearance))
+      continue;
+    const ON_SubDMeshFragmentGrid& grid = fragment->Grid(m_subd_appearance);
+    if (nullptr == grid.m_F || 0 == grid.m_F_count || point_count != grid.GridPointCount())
+      continue;
+
+    unsigned int reduction = 0;
+    if (nullptr != fragment_density_reduction)
+    {
+      // Keep at least 2 segments on each face edge so the middle of an n-gon
+      // edge is always a mesh vertex. This is required for stitching.
+      const unsigned int side_segment_count = grid.SideSegmentCount();
+      unsigned int max_reduction = 0;
+      while (
+        (side_segment_count >> (max_reduction + 1)) >= 1
+        && (Internal_FragmentEdgeSegmentCount(fragment, side_segment_count) >> (max_reduction + 1)) >= 2
+        )
+        max_reduction++;
+      reduction = fragment_density_reduction(context, *fragment);
+      if (reduction > max_reduction)
+        reduction = max_reduction;
+    }
+
+    if (nullptr == face || face != fragment->m_face)
+    {
+      face = fragment->m_face;
+      face_fragment0 = m_fragments.UnsignedCount();
+      face_reduction = reduction;
+      if (nullptr != face && face->m_id > max_face_id)
+        max_face_id = face->m_id;
+    }
+    else if (reduction < face_reduction)
+    {
+      // Every fragment of a face uses the same reduction.
+      face_reduction = reduction;
+      for (unsigned int i = face_fragment0; i < m_reduction.UnsignedCount(); ++i)
+        m_reduction[i] = face_reduction;
+    }
+
+    m_fragments.Append(fragment);
+    m_reduction.Append(face_reduction);
+  }
+
+  const unsigned int fragment_count = m_fragments.UnsignedCount();
+
+  if (nullptr != fragment_density_reduction)
+  {
+    m_face_edge_segment_count.Reserve(max_face_id + 1);
+    m_face_edge_segment_count.SetCount(max_face_id + 1);
+    m_face_edge_segment_count.Zero();
+    for (unsigned int i = 0; i < fragment_count; ++i)
+    {
+      const ON_SubDMeshFragment* fragment = m_fragments[i];
+      if (nullptr == fragment->m_face)
+        continue;
+      const unsigned int side_segment_count = fragment->Grid(m_subd_appearance).SideSegmentCount() >> m_reduction[i];
+      m_face_edge_segment_count[fragment->m_face->m_id] = (unsigned short)Internal_FragmentEdgeSegmentCount(fragment, side_segment_count);
+    }
+  }
+
+  unsigned int vertex_count = 0;
+  const unsigned int* prev_F = nullptr;
+  unsigned int prev_grid_index = ON_UNSET_UINT_INDEX;
+  for (unsigned int i = 0; i < fragment_count; ++i)
+  {
+    const ON_SubDMeshFragment* fragment = m_fragments[i];
+    const unsigned int reduction = m_reduction[i];
+    const ON_SubDMeshFragmentGrid& fragment_grid = fragment->Grid(m_subd_appearance);
+    const unsigned int side_segment_count = fragment_grid.SideSegmentCount() >> reduction;
+
+    // A reduced fragment is exported as a full density grid with fewer points.
+    const ON_SubDMeshFragmentGrid grid
+      = (0 == reduction)
+      ? fragment_grid
+      : ON_SubDMeshFragmentGrid::QuadGridFromSideSegmentCount(side_segment_count, 0);
+
+    // Grids are shared resources and are identified by their quad index array.
+    // Fragments with the same m_F have the same grid point layout. GridId() is
+    // not used because the one quad grid and the empty grid both have id 0.
+    // Adjacent fragments almost always share a grid.
+    unsigned int grid_index = prev_grid_index;
+    if (ON_UNSET_UINT_INDEX == grid_index || grid.m_F != prev_F)
+    {
+      grid_index = ON_UNSET_UINT_INDEX;
+      for (unsigned int gi = 0; gi < m_grids.UnsignedCount(); ++gi)
+      {
+        if (grid.m_F == m_grids[gi].m_F)
+        {
+          grid_index = gi;
+          break;
+        }
+      }
+      if (ON_UNSET_UINT_INDEX == grid_index)
+      {
+        grid_index = m_grids.UnsignedCount();
+        m_grids.Append(grid);
+      }
+      prev_F = grid.m_F;
+      prev_grid_index = grid_index;
+    }
+
+    ON__UINT32 stitch = 0;
+    if (m_face_edge_segment_count.UnsignedCount() > 0 && nullptr != fragment->m_face)
+    {
+      const unsigned int edge_segment_count = m_face_edge_segment_count[fragment->m_face->m_id];
+      for (unsigned int side = 0; side < 4; ++side)
+      {
+        const ON_SubDEdge* e = fragment->SubDEdge(side);
+        const ON_SubDFace* f = (nullptr != e) ? e->NeighborFace(fragment->m_face, false) : nullptr;
+        if (nullptr == f || f->m_id > max_face_id)
+          continue;
+        const unsigned int neighbor_edge_segment_count = m_face_edge_segment_count[f->m_id];
+        if (0 == neighbor_edge_segment_count || neighbor_edge_segment_count >= edge_segment_count)
+          continue;
+        unsigned int ratio_log2 = 0;
+        while ((neighbor_edge_segment_count << ratio_log2) < edge_segment_count)
+          ratio_log2++;
+        if ((neighbor_edge_segment_count << ratio_log2) != edge_segment_count || 0 != side_segment_count % (1U << ratio_log2))
+          continue;
+        stitch |= (ratio_log2 << (4 * (side + 1)));
+      }
+    }
+
+    m_vertex_offset.Append(vertex_count);
+    m_grid_index.Append(grid_index);
+    m_reduction[i] = (reduction | stitch);
+    vertex_count += grid.GridPointCount();
+  }
+  m_vertex_offset.Append(vertex_count);
+  m_vertex_count = vertex_count;
+
+  return fragment_count;
+}
+
+class ON_Internal_SubDMeshFragmentViewportContext
+{
+public:
+  ON_SubDComponentLocation m_subd_appearance = ON_SubDComponentLocation::Surface;
+  ON_Xform m_world_to_screen = ON_Xform::IdentityTransformation;
+  double m_pixel_tolerance = 0.0;
+};
+
+static unsigned int Internal_ViewportDensityReduction(
+  ON__UINT_PTR context,
+  const ON_SubDMeshFragment& fragment
+)
+{
+  const ON_Internal_SubDMeshFragmentViewportContext& ctx = *((const ON_Internal_SubDMeshFragmentViewportContext*)context);
+  return ON_SubDMeshFragmentBuffers::DensityReductionFromProjectedSize(fragment, ctx.m_subd_appearance, ctx.m_world_to_screen, ctx.m_pixel_tolerance);
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::SetFragments(
+  ON_SubDMeshFragmentIterator& fit,
+  const ON_Viewport& viewport,
+  double pixel_tolerance
+)
+{
+  ON_Internal_SubDMeshFragmentViewportContext ctx;
+  ctx.m_subd_appearance = fit.SubDAppearance();
+  ctx.m_pixel_tolerance = pixel_tolerance;
+  if (
+    false == (pixel_tolerance > 0.0 && pixel_tolerance < ON_UNSET_POSITIVE_VALUE)
+    || false == viewport.GetXform(ON::world_cs, ON::screen_cs, ctx.m_world_to_screen)
+    )
+    return SetFragments(fit);
+  return SetFragments(fit, Internal_ViewportDensityReduction, (ON__UINT_PTR)&ctx);
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::DensityReductionFromProjectedSize(
+  const ON_SubDMeshFragment& fragment,
+  ON_SubDComponentLocation subd_appearance,
+  const ON_Xform& world_to_screen,
+  double pixel_tolerance
+)
+{
+  if (false == (pixel_tolerance > 0.0))
+    return 0;
+  const ON_SubDMeshFragmentGrid& grid = fragment.Grid(subd_appearance);
+  const unsigned int side_segment_count = grid.SideSegmentCount();
+  const double* P = fragment.PointArray(subd_appearance);
+  const size_t P_stride = fragment.PointArrayStride(subd_appearance);
+  if (side_segment_count < 2 || nullptr == P || fragment.PointArrayCount(subd_appearance) != grid.GridPointCount())
+    return 0;
+
+  // Maximum projected length of a segment on the fragment's boundary.
+  const double(*m)[4] = world_to_screen.m_xform;
+  const unsigned int n = side_segment_count + 1;
+  double max_length2 = 0.0;
+  ON_2dPoint prev = ON_2dPoint::NanPoint;
+  for (unsigned int k = 0; k <= 4 * side_segment_count; ++k)
+  {
+    const unsigned int side = (k / side_segment_count) % 4;
+    const unsigned int t = k % side_segment_count;
+    unsigned int i, j;
+    switch (side)
+    {
+    case 0: i = t; j = 0; break;
+    case 1: i = side_segment_count; j = t; break;
+    case 2: i = side_segment_count - t; j = side_segment_count; break;
+    default: i = 0; j = side_segment_count - t; break;
+    }
+    const double* p = P + (i + n * j) * P_stride;
+    const double w = m[3][0] * p[0] + m[3][1] * p[1] + m[3][2] * p[2] + m[3][3];
+    if (false == (w > 0.0))
+      return 0; // behind the camera
+    const ON_2dPoint q(
+      (m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2] + m[0][3]) / w,
+      (m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2] + m[1][3]) / w
+    );
+    if (k > 0)
+    {
+      const double d2 = (q.x - prev.x) * (q.x - prev.x) + (q.y - prev.y) * (q.y - prev.y);
+      if (d2 > max_length2)
+        max_length2 = d2;
+    }
+    prev = q;
+  }
+  if (false == (max_length2 >= 0.0))
+    return 0;
+
+  unsigned int reduction = 0;
+  double length = sqrt(max_length2);
+  while ((side_segment_count >> (reduction + 1)) >= 1 && 2.0 * length <= pixel_tolerance)
+  {
+    length *= 2.0;
+    reduction++;
+  }
+  return reduction;
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::FragmentCount() const
+{
+  return m_fragments.UnsignedCount();
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::VertexCount() const
+{
+  return m_vertex_count;
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::GridCount() const
+{
+  return m_grids.UnsignedCount();
+}
+
+const ON_SubDMeshFragmentGrid& ON_SubDMeshFragmentBuffers::Grid(
+  unsigned int grid_index
+) const
+{
+  return (grid_index < m_grids.UnsignedCount()) ? m_grids[grid_index] : ON_SubDMeshFragmentGrid::Empty;
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::TriangleIndexCount(
+  unsigned int grid_index
+) const
+{
+  return 6U * Grid(grid_index).m_F_count;
+}
+
+const ON_SubDMeshFragment* ON_SubDMeshFragmentBuffers::Fragment(
+  unsigned int fragment_index
+) const
+{
+  return (fragment_index < m_fragments.UnsignedCount()) ? m_fragments[fragment_index] : nullptr;
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::FragmentVertexOffset(
+  unsigned int fragment_index
+) const
+{
+  return (fragment_index < m_fragments.UnsignedCount()) ? m_vertex_offset[fragment_index] : ON_UNSET_UINT_INDEX;
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::FragmentGridIndex(
+  unsigned int fragment_index
+) const
+{
+  return (fragment_index < m_fragments.UnsignedCount()) ? m_grid_index[fragment_index] : ON_UNSET_UINT_INDEX;
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::FragmentDensityReduction(
+  unsigned int fragment_index
+) const
+{
+  return (fragment_index < m_fragments.UnsignedCount()) ? (m_reduction[fragment_index] & 0xFU) : 0U;
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::InterleavedFloatCount(
+  bool bNormals,
+  bool bTextureCoordinates
+)
+{
+  return 3U + (bNormals ? 3U : 0U) + (bTextureCoordinates ? 2U : 0U);
+}
+
+class ON_Internal_SubDMeshFragmentBuffersContext
+{
+public:
+  ON_SubDComponentLocation m_subd_appearance = ON_SubDComponentLocation::Surface;
+  const ON_SubDMeshFragment* const* m_fragments = nullptr;
+  const unsigned int* m_vertex_offset = nullptr;
+  const ON__UINT32* m_reduction = nullptr;
+  // Any of m_P, m_N, m_T may be nullptr. m_N and m_T may point into the same
+  // buffer as m_P when the vertices are interleaved.
+  float* m_P = nullptr;
+  float* m_N = nullptr;
+  float* m_T = nullptr;
+  size_t m_P_stride = 0;
+  size_t m_N_stride = 0;
+  size_t m_T_stride = 0;
+};
+
+static void Internal_StitchFragmentBufferSide(
+  float* a,
+  size_t a_stride,
+  unsigned int dim,
+  unsigned int side,
+  unsigned int side_segment_count,
+  unsigned int coarse_step,
+  bool bUnitize
+)
+{
+  // Move the points between coarse vertices onto the line segment joining them.
+  const unsigned int n = side_segment_count + 1;
+  size_t vi[3] = {};
+  for (unsigned int t = 0; t <= side_segment_count; ++t)
+  {
+    switch (side)
+    {
+    case 0: vi[0] = t; break;
+    case 1: vi[0] = side_segment_count + n * t; break;
+    case 2: vi[0] = (side_segment_count - t) + n * side_segment_count; break;
+    default: vi[0] = n * (side_segment_count - t); break;
+    }
+    const unsigned int r = t % coarse_step;
+    if (0 == r)
+    {
+      vi[1] = vi[0];
+      continue;
+    }
+    const unsigned int t2 = t - r + coarse_step;
+    switch (side)
+    {
+    case 0: vi[2] = t2; break;
+    case 1: vi[2] = side_segment_count + n * t2; break;
+    case 2: vi[2] = (side_segment_count - t2) + n * side_segment_count; break;
+    default: vi[2] = n * (side_segment_count - t2); break;
+    }
+    const float s = ((float)r) / ((float)coarse_step);
+    const float* p1 = a + vi[1] * a_stride;
+    const float* p2 = a + vi[2] * a_stride;
+    float* p = a + vi[0] * a_stride;
+    for (unsigned int k = 0; k < dim; ++k)
+      p[k] = (1.0f - s) * p1[k] + s * p2[k];
+    if (bUnitize)
+    {
+      const double len = sqrt(((double)p[0]) * p[0] + ((double)p[1]) * p[1] + ((double)p[2]) * p[2]);
+      if (len > 0.0)
+      {
+        p[0] = (float)(p[0] / len);
+        p[1] = (float)(p[1] / len);
+        p[2] = (float)(p[2] / len);
+      }
+    }
+  }
+}
+
+static void Internal_GetFragmentBufferVerticesRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+)
+{
+  const ON_Internal_SubDMeshFragmentBuffersContext& ctx = *((const ON_Internal_SubDMeshFragmentBuffersContext*)context);
+  for (size_t i = i0; i < i1; ++i)
+  {
+    const ON_SubDMeshFragment* fragment = ctx.m_fragments[i];
+    const size_t vi0 = ctx.m_vertex_offset[i];
+    const size_t count = ctx.m_vertex_offset[i + 1] - vi0;
+    const unsigned int reduction = (ctx.m_reduction[i] & 0xFU);
+
+    // Exported point k = (ei,ej) is fragment grid point (ei*step,ej*step).
+    const unsigned int side_segment_count = fragment->Grid(ctx.m_subd_appearance).SideSegmentCount();
+    const size_t step = ((size_t)1) << reduction;
+    const size_t n = (side_segment_count >> reduction) + 1;
+    const size_t src_n = side_segment_count + 1;
+
+    if (nullptr != ctx.m_P)
+    {
+      const double* src = fragment->PointArray(ctx.m_subd_appearance);
+      const size_t src_stride = fragment->PointArrayStride(ctx.m_subd_appearance);
+      float* dst = ctx.m_P + vi0 * ctx.m_P_stride;
+      for (size_t k = 0; k < count; ++k, dst += ctx.m_P_stride)
+      {
+        const double* p = src + step * ((k % n) + src_n * (k / n)) * src_stride;
+        dst[0] = (float)p[0];
+        dst[1] = (float)p[1];
+        dst[2] = (float)p[2];
+      }
+    }
+
+    if (nullptr != ctx.m_N)
+    {
+      // NormalArrayStride() is 0 when every vertex has the same normal.
+      const double* src
+        = (src_n * src_n == fragment->NormalArrayCount(ctx.m_subd_appearance))
+        ? fragment->NormalArray(ctx.m_subd_appearance)
+        : nullptr;
+      const size_t src_stride = fragment->NormalArrayStride(ctx.m_subd_appearance);
+      float* dst = ctx.m_N + vi0 * ctx.m_N_stride;
+      for (size_t k = 0; k < count; ++k, dst += ctx.m_N_stride)
+      {
+        if (nullptr != src)
+        {
+          const double* p = src + step * ((k % n) + src_n * (k / n)) * src_stride;
+          dst[0] = (float)p[0];
+          dst[1] = (float)p[1];
+          dst[2] = (float)p[2];
+        }
+        else
+          dst[0] = dst[1] = dst[2] = 0.0f;
+      }
+    }
+
+    if (nullptr != ctx.m_T)
+    {
+      const double* src
+        = (src_n * src_n == fragment->TextureCoordinateArrayCount(ctx.m_subd_appearance))
+        ? fragment->TextureCoordinateArray(ctx.m_subd_appearance)
+        : nullptr;
+      const size_t src_stride = fragment->TextureCoordinateArrayStride(ctx.m_subd_appearance);
+      float* dst = ctx.m_T + vi0 * ctx.m_T_stride;
+      for (size_t k = 0; k < count; ++k, dst += ctx.m_T_stride)
+      {
+        if (nullptr != src)
+        {
+          const double* p = src + step * ((k % n) + src_n * (k / n)) * src_stride;
+          dst[0] = (float)p[0];
+          dst[1] = (float)p[1];
+        }
+        else
+          dst[0] = dst[1] = 0.0f;
+      }
+    }
+
+    // Remove cracks along edges shared with coarser neighbors.
+    for (unsigned int side = 0; side < 4; ++side)
+    {
+      const unsigned int ratio_log2 = ((ctx.m_reduction[i] >> (4 * (side + 1))) & 0xFU);
+      if (0 == ratio_log2)
+        continue;
+      const unsigned int coarse_step = (1U << ratio_log2);
+      const unsigned int export_side_segment_count = (unsigned int)(n - 1);
+      if (nullptr != ctx.m_P)
+        Internal_StitchFragmentBufferSide(ctx.m_P + vi0 * ctx.m_P_stride, ctx.m_P_stride, 3, side, export_side_segment_count, coarse_step, false);
+      if (nullptr != ctx.m_N)
+        Internal_StitchFragmentBufferSide(ctx.m_N + vi0 * ctx.m_N_stride, ctx.m_N_stride, 3, side, export_side_segment_count, coarse_step, true);
+      if (nullptr != ctx.m_T)
+        Internal_StitchFragmentBufferSide(ctx.m_T + vi0 * ctx.m_T_stride, ctx.m_T_stride, 2, side, export_side_segment_count, coarse_step, false);
+    }
+  }
+}
+
+bool ON_SubDMeshFragmentBuffers::Internal_GetVertices(
+  float* P,
+  float* N,
+  float* T,
+  size_t stride,
+  bool bParallel
+) const
+{
+  const unsigned int fragment_count = m_fragments.UnsignedCount();
+  if (0 == fragment_count)
+    return (nullptr != P || nullptr != N || nullptr != T);
+
+  ON_Internal_SubDMeshFragmentBuffersContext ctx;
+  ctx.m_subd_appearance = m_subd_appearance;
+  ctx.m_fragments = m_fragments.Array();
+  ctx.m_vertex_offset = m_vertex_offset.Array();
+  ctx.m_reduction = m_reduction.Array();
+  ctx.m_P = P;
+  ctx.m_N = N;
+  ctx.m_T = T;
+  ctx.m_P_stride = (0 != stride) ? stride : 3;
+  ctx.m_N_stride = (0 != stride) ? stride : 3;
+  ctx.m_T_stride = (0 != stride) ? stride : 2;
+
+  ON_ParallelFor(fragment_count, 0x100, bParallel ? 0U : 1U, Internal_GetFragmentBufferVerticesRange, (ON__UINT_PTR)&ctx);
+  return true;
+}
+
+bool ON_SubDMeshFragmentBuffers::GetInterleavedVertices(
+  float* vertices,
+  bool bNormals,
+  bool bTextureCoordinates,
+  bool bParallel
+) const
+{
+  if (nullptr == vertices)
+    return false;
+  const size_t stride = ON_SubDMeshFragmentBuffers::InterleavedFloatCount(bNormals, bTextureCoordinates);
+  float* N = bNormals ? (vertices + 3) : nullptr;
+  float* T = bTextureCoordinates ? (vertices + (bNormals ? 6 : 3)) : nullptr;
+  return Internal_GetVertices(vertices, N, T, stride, bParallel);
+}
+
+bool ON_SubDMeshFragmentBuffers::GetVertexArrays(
+  float* points,
+  float* normals,
+  float* texture_coordinates,
+  bool bParallel
+) const
+{
+  if (nullptr == points && nullptr == normals && nullptr == texture_coordinates)
+    return false;
+  return Internal_GetVertices(points, normals, texture_coordinates, 0, bParallel);
+}
+
+unsigned int ON_SubDMeshFragmentBuffers::GetTriangleIndices(
+  unsigned int grid_index,
+  unsigned int* indices
+) const
+{
+  if (nullptr == indices || grid_index >= m_grids.UnsignedCount())
+    return 0;
+  const ON_SubDMeshFragmentGrid& grid = m_grids[grid_index];
+  const unsigned int* fvi = grid.m_F;
+  if (nullptr == fvi)
+    return 0;
+  const size_t F_stride = (grid.m_F_stride >= 4) ? grid.m_F_stride : 4;
+  unsigned int* dst = indices;
+  for (unsigned int fi = 0; fi < grid.m_F_count; ++fi, fvi += F_stride)
+  {
+    dst[0] = fvi[0];
+    dst[1] = fvi[1];
+    dst[2] = fvi[2];
+    dst[3] = fvi[0];
+    dst[4] = fvi[2];
+    dst[5] = fvi[3];
+    dst += 6;
+  }
+  return (unsigned int)(dst - indices);
+}
@@ -29,7 +29,7 @@ public:
   // In ON_Mesh to ON_SubD, there is a ON_MeshNGonEdge for each mesh ngon edge.
   // So, for an interior edge, there will be 2 ON_MeshNGonEdge values, one
   // for each attached ngon.
-  // Sorting ON_MeshNGonEdge by m_u.mesh_edge_id will group the these
+  // Sorting ON_MeshNGonEdge by EdgeTopologyId() will group the these
   // edges together.
   static const ON_MeshNGonEdge Unset;
   static const ON_MeshNGonEdge Create(
@@ -58,8 +58,6 @@ public:
     return ON_MeshNGonEdge::Unset;
   }
 
-  static int CompareMeshEdgeTopologyId(const void* lhs, const void* rhs);
-
   /*
   Returns:
     True if a and b reference the same topological edge and the normals
@@ -170,25 +168,6 @@ const ON_MeshNGonEdge ON_MeshNGonEdge::Create(
 
 
 
-int ON_MeshNGonEdge::CompareMeshEdgeTopologyId(const void* lhs, const void* rhs)
-{
-  // compare location ids
-  const ON_2udex lhs_edge_topology_id = ((const ON_MeshNGonEdge*)lhs)->EdgeTopologyId();
-  const ON_2udex rhs_edge_topology_id = ((const ON_MeshNGonEdge*)rhs)->EdgeTopologyId();
-
-  if (lhs_edge_topology_id.i < rhs_edge_topology_id.i)
-    return -1;
-  if (lhs_edge_topology_id.i > rhs_edge_topology_id.i)
-    return 1;
-
-  if (lhs_edge_topology_id.j < rhs_edge_topology_id.j)
-    return -1;
-  if (lhs_edge_topology_id.j > rhs_edge_topology_id.j)
-    return 1;
-
-  return 0;
-}
-
 bool ON_MeshNGonEdge::TagEdgeAsCrease(
   const ON_MeshNGonEdge& a,
   const ON_MeshNGonEdge& b,
@@ -223,6 +202,81 @@ bool ON_MeshNGonEdge::TagEdgeAsCrease(
   return false;
 }
 
+static void Internal_SortMeshEdgesByTopologyId(
+  const ON_SimpleArray<ON_MeshNGonEdge>& mesh_edges,
+  unsigned int mesh_point_id_count,
+  unsigned int* mesh_edge_map
+)
+{
+  // Sets mesh_edge_map[] so mesh_edges[mesh_edge_map[]] is sorted by EdgeTopologyId().
+  // The topology ids are pairs of mesh point ids < mesh_point_id_count, so a two pass
+  // counting sort (by j, then by i) is linear and stable. Comparison sorting millions
+  // of edges was the most expensive part of creating a SubD from a large mesh.
+  const unsigned int mesh_edge_count = mesh_edges.UnsignedCount();
+  const ON_MeshNGonEdge* a = mesh_edges.Array();
+
+  ON_SimpleArray<unsigned int> bucket(mesh_point_id_count + 1);
+  bucket.SetCount(mesh_point_id_count + 1);
+  ON_SimpleArray<unsigned int> by_j(mesh_edge_count);
+  by_j.SetCount(mesh_edge_count);
+
+  for (unsigned int pass = 0; pass < 2; ++pass)
+  {
+    bucket.Zero();
+    for (unsigned int k = 0; k < mesh_edge_count; ++k)
+    {
+      const ON_2udex id = a[k].EdgeTopologyId();
+      ++bucket[1 + (0 == pass ? id.j : id.i)];
+    }
+    for (unsigned int n = 1; n <= mesh_point_id_count; ++n)
+      bucket[n] += bucket[n - 1];
+
+    if (0 == pass)
+    {
+      for (unsigned int k = 0; k < mesh_edge_count; ++k)
+        by_j[bucket[a[k].EdgeTopologyId().j]++] = k;
+    }
+    else
+    {
+      for (unsigned int n = 0; n < mesh_edge_count; ++n)
+      {
+        const unsigned int k = by_j[n];
+        mesh_edge_map[bucket[a[k].EdgeTopologyId().i]++] = k;
+      }
+    }
+  }
+}
+
+class ON_Internal_MeshEdgeCreaseContext
+{
+public:
+  const ON_MeshNGonEdge* m_mesh_edges = nullptr;
+  const unsigned int* m_mesh_edge_map = nullptr;
+  const unsigned int* m_group_start = nullptr;
+  const unsigned int* m_mesh_point_id = nullptr;
+  bool* m_bCrease = nullptr;
+};
+
+static void Internal_TagMeshEdgeCreasesRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+)
+{
+  const ON_Internal_MeshEdgeCreaseContext& c = *((const ON_Internal_MeshEdgeCreaseContext*)context);
+  for (size_t gi = i0; gi < i1; ++gi)
+  {
+    const unsigned int k0 = c.m_group_start[gi];
+    const unsigned int k1 = c.m_group_start[gi + 1];
+    const ON_MeshNGonEdge& mesh_edge0 = c.m_mesh_edges[c.m_mesh_edge_map[k0]];
+    bool bCrease = false;
+    for (unsigned int k = k0 + 1; k < k1 && false == bCrease; ++k)
+      bCrease = ON_MeshNGonEdge::TagEdgeAsCrease(mesh_edge0, c.m_mesh_edges[c.m_mesh_edge_map[k]], c.m_mesh_point_id);
+    c.m_bCrease[gi] = bCrease;
+  }
+}
+
 static bool Internal_CandidateTagIsBetterCreaseEnd(
   ON_SubDVertexTag current_tag,
   const ON_SubDVertex* candidate
@@ -497,6 +551,111 @@ static double Internal_FaceCornerAngleRadians(const ON_SubDVertex* v, const ON_S
   return ON_DBL_QNAN;
 }
 
+static bool Internal_IsMeshCornerVertex(
+  const ON_SubDVertex* vertex,
+  const ON_SubDFromMeshParameters* from_mesh_options,
+  bool bLookForConvexCorners,
+  double max_convex_angle_radians,
+  bool bLookForConcaveCorners,
+  double min_concave_angle_radians
+)
+{
+  // vertex is a crease vertex. Returns true if it should be tagged as a corner.
+  if ( 1 + vertex->m_face_count != vertex->m_edge_count )
+    return false;
+
+  ON_SubDComponentPtrPair boundary_pair = vertex->BoundaryEdgePair();
+  if (false == boundary_pair.BothAreNotNull())
+    return false;
+
+  bool bConvexCorner
+    = bLookForConvexCorners
+    && vertex->m_edge_count <= from_mesh_options->MaximumConvexCornerEdgeCount()
+    ;
+  bool bConcaveCorner
+    = bLookForConcaveCorners
+    && vertex->m_edge_count >= from_mesh_options->MinimumConcaveCornerEdgeCount()
+    ;
+
+  if (false == bConvexCorner && false == bConcaveCorner)
+    return false;
+
+  // add up angles of faces at this vertex
+  // If the faces are not coplanar, this sum can exceed 2pi.
+  double vertex_angle_radians = 0.0;
+  for (unsigned short vei = 0; vei < vertex->m_face_count; ++vei)
+  {
+    const double a = Internal_FaceCornerAngleRadians(vertex, vertex->m_faces[vei]);
+    if (false == (a > 0.0 && a < ON_PI) )
+    {
+      vertex_angle_radians = ON_DBL_QNAN;
+      break;
+    }
+    vertex_angle_radians += a;
+  }
+  if (false == (vertex_angle_radians > 0.0))
+    return false;
+
+  bConvexCorner = bConvexCorner && vertex_angle_radians <= max_convex_angle_radians;
+  bConcaveCorner = bConcaveCorner && vertex_angle_radians >= min_concave_angle_radians;
+  if (bConvexCorner == bConcaveCorner)
+    return false; // the corner must be exactly one of convex or concave
+
+  // Finally, test the angle between the boundary edges. That angle must also pass the min/max tests.
+  // This test cannot be done earlier, because we need to know if we are making a concave or convex corner
+  // to do this test correctly.
+  const double boundary_angle_radians = ON_SubDSectorType::CornerSectorAngleRadiansFromEdges(boundary_pair.First().EdgePtr(), boundary_pair.Second().EdgePtr());
+  if (false == (boundary_angle_radians > 0.0 && boundary_angle_radians < ON_PI))
+    return false; // the angle is always acute because it does not look at the active side
+  if (bConvexCorner)
+  {
+    if (false == (boundary_angle_radians <= max_convex_angle_radians))
+      return false;
+  }
+  else if (bConcaveCorner)
+  {
+    if (false == ((ON_2PI - boundary_angle_radians) >= min_concave_angle_radians))
+      return false;
+  }
+  else
+    return false; // should never get here
+
+  return true;
+}
+
+class ON_Internal_MeshCornerContext
+{
+public:
+  const ON_SubDVertex* const* m_vertices = nullptr;
+  const ON_SubDFromMeshParameters* m_from_mesh_options = nullptr;
+  bool m_bLookForConvexCorners = false;
+  bool m_bLookForConcaveCorners = false;
+  double m_max_convex_angle_radians = ON_DBL_QNAN;
+  double m_min_concave_angle_radians = ON_DBL_QNAN;
+  bool* m_bCorner = nullptr;
+};
+
+static void Internal_FindMeshCornersRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+)
+{
+  const ON_Internal_MeshCornerContext& c = *((const ON_Internal_MeshCornerContext*)context);
+  for (size_t i = i0; i < i1; ++i)
+  {
+    c.m_bCorner[i] = Internal_IsMeshCornerVertex(
+      c.m_vertices[i],
+      c.m_from_mesh_options,
+      c.m_bLookForConvexCorners,
+      c.m_max_convex_angle_radians,
+      c.m_bLookForConcaveCorners,
+      c.m_min_concave_angle_radians
+    );
+  }
+}
+
 ON_SubD* ON_SubD::Internal_CreateFromMeshWithValidNgons(
   const class ON_Mesh* mesh,
   const class ON_SubDFromMeshParameters* from_mesh_options,
@@ -733,6 +892,71 @@ ON_SubD* ON_SubD::Internal_CreateFromMeshWithValidNgons(
   bool bHasTaggedVertices = false;
   bool bHasNonmanifoldCornerVertices = false;
 
+  ////////////////////////////////////////////////////////////////////////
+  //
+  // If we are adding interior crease, set the mesh_edge_ref.m_mesh_Ni / m_mesh_Nj values used to detect creases.
+  //
+  if ( ON_SubDFromMeshParameters::InteriorCreaseOption::AtMeshDoubleEdge != crease_test )
+  {
+    crease_test = ON_SubDFromMeshParameters::InteriorCreaseOption::None;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  //
+  // Group mesh_edges[] by SubD edge.
+  // 
+  // An subd interior edge will have 2 consecutive element in mesh_edges[].
+  // A subd non-manifold edge with k faces with have k consecutive element in mesh_edges[].
+  // A subd boundary edge will have 1 element in mesh_edges[].
+  // A subd wire edge will have 1 element in mesh_edges[].
+  //
+
+  // mesh_edge_map[] is used to sort the sort mesh_edges[] into groups that correspond to the same SubD edge.
+  // The order of mesh_edges[] cannot be changed because the current order is neede to efficiently create the SubD faces.
+  unsigned int* mesh_edge_map = (unsigned int*)ws.GetMemory(mesh_edges.UnsignedCount() * sizeof(mesh_edge_map[0]));
+  Internal_SortMeshEdgesByTopologyId(mesh_edges, mesh_point_id_count, mesh_edge_map);
+
+  // mesh_edges[mesh_edge_map[group_start[gi]]], ..., mesh_edges[mesh_edge_map[group_start[gi+1]-1]]
+  // use the same SubD edge.
+  // vertex_edge_capacity[] and vertex_face_capacity[] are used to allocate SubD vertex
+  // edge and face arrays once instead of growing them as each edge and face is added.
+  ON_SimpleArray<unsigned int> group_start(mesh_edges.UnsignedCount() + 1);
+  unsigned int* vertex_edge_capacity = (unsigned int*)ws.GetIntMemory(mesh_point_id_count);
+  unsigned int* vertex_face_capacity = (unsigned int*)ws.GetIntMemory(mesh_point_id_count);
+  memset(vertex_edge_capacity, 0, mesh_point_id_count * sizeof(vertex_edge_capacity[0]));
+  memset(vertex_face_capacity, 0, mesh_point_id_count * sizeof(vertex_face_capacity[0]));
+  for (unsigned int i = 0; i < mesh_edges.UnsignedCount(); ++i)
+  {
+    ++vertex_face_capacity[mesh_point_id[mesh_edges[i].m_mesh_Vi]];
+    const ON_2udex topology_id = mesh_edges[mesh_edge_map[i]].EdgeTopologyId();
+    if (0 != i)
+    {
+      const ON_2udex topology_id0 = mesh_edges[mesh_edge_map[i - 1]].EdgeTopologyId();
+      if (topology_id0.i == topology_id.i && topology_id0.j == topology_id.j)
+        continue;
+    }
+    group_start.Append(i);
+    ++vertex_edge_capacity[topology_id.i];
+    ++vertex_edge_capacity[topology_id.j];
+  }
+  const unsigned int group_count = group_start.UnsignedCount();
+  group_start.Append(mesh_edges.UnsignedCount());
+
+  // When looking for interior creases, the groups are independent and are tested in parallel.
+  ON_SimpleArray<bool> group_crease;
+  if (ON_SubDFromMeshParameters::InteriorCreaseOption::None != crease_test)
+  {
+    group_crease.Reserve(group_count);
+    group_crease.SetCount(group_count);
+    ON_Internal_MeshEdgeCreaseContext crease_context;
+    crease_context.m_mesh_edges = mesh_edges.Array();
+    crease_context.m_mesh_edge_map = mesh_edge_map;
+    crease_context.m_group_start = group_start.Array();
+    crease_context.m_mesh_point_id = mesh_point_id;
+    crease_context.m_bCrease = group_crease.Array();
+    ON_ParallelFor(group_count, 0x1000, 0, Internal_TagMeshEdgeCreasesRange, (ON__UINT_PTR)&crease_context);
+  }
+
   //////////////////////////////////////////////////////////////////////
   //
   // create subd vertices
@@ -762,65 +986,32 @@ ON_SubD* ON_SubD::Internal_CreateFromMeshWithValidNgons(
     }
 
     const ON_3dPoint P = mesh_points[mesh_point_map[i]];
-    ON_SubDVertex* subd_vertex = new_subd->AddVertex(ON_SubDVertexTag::Smooth, &P.x);
+    ON_SubDVertex* subd_vertex = new_subd->AddVertexForExperts(
+      0,
+      ON_SubDVertexTag::Smooth,
+      &P.x,
+      vertex_edge_capacity[vid0] < 0xFFFFU ? vertex_edge_capacity[vid0] : 0U,
+      vertex_face_capacity[vid0] < 0xFFFFU ? vertex_face_capacity[vid0] : 0U
+    );
     while (i < j)
       subd_V[mesh_point_map[i++]] = subd_vertex;
   }
 
-
-  ////////////////////////////////////////////////////////////////////////
-  //
-  // If we are adding interior crease, set the mesh_edge_ref.m_mesh_Ni / m_mesh_Nj values used to detect creases.
-  //
-  if ( ON_SubDFromMeshParameters::InteriorCreaseOption::AtMeshDoubleEdge != crease_test )
-  {
-    crease_test = ON_SubDFromMeshParameters::InteriorCreaseOption::None;
-  }
-
   //////////////////////////////////////////////////////////////////////
   //
   // Create SubD edges.
   // 
-  // An subd interior edge will have 2 consecutive element in mesh_edges[].
-  // A subd non-manifold edge with k faces with have k consecutive element in mesh_edges[].
-  // A subd boundary edge will have 1 element in mesh_edges[].
-  // A subd wire edge will have 1 element in mesh_edges[].
-  //
-
-  // mesh_edge_map[] is used to sort the sort mesh_edges[] into groups that correspond to the same SubD edge.
-  // The order of mesh_edges[] cannot be changed because the current order is neede to efficiently create the SubD faces.
-  unsigned int* mesh_edge_map = (unsigned int*)ws.GetMemory(mesh_edges.UnsignedCount() * sizeof(mesh_edge_map[0]));
-  ON_Sort(
-    ON::sort_algorithm::quick_sort,
-    mesh_edge_map, mesh_edges.Array(),
-    mesh_edges.UnsignedCount(),
-    sizeof(ON_MeshNGonEdge),
-    ON_MeshNGonEdge::CompareMeshEdgeTopologyId
-  );
-
-  for (unsigned int i = 0; i < mesh_edges.UnsignedCount(); /*empty iterator*/)
+  for (unsigned int gi = 0; gi < group_count; ++gi)
   {
+    unsigned int i = group_start[gi];
+    const unsigned int j = group_start[gi + 1];
     const ON_MeshNGonEdge& mesh_edge0 = mesh_edges[mesh_edge_map[i]];
-    const ON_2udex topology_id0 = mesh_edge0.EdgeTopologyId();
 
-    // get the group of mesh_edges[] that will use the same SubD edge.
-    // and determine if that edge should be tagged as a crease.
-    ON_SubDEdgeTag edge_tag = ON_SubDEdgeTag::Smooth;
-    unsigned j = i + 1;
-    for (/*empty init*/; j < mesh_edges.UnsignedCount(); ++j)
-    {
-      ON_MeshNGonEdge& mesh_edge1 = mesh_edges[mesh_edge_map[j]];
-      const ON_2udex topology_id1 = mesh_edge1.EdgeTopologyId();
-      if (topology_id0.i != topology_id1.i || topology_id0.j != topology_id1.j)
-        break;
-      if (ON_SubDFromMeshParameters::InteriorCreaseOption::None != crease_test)
-      {
-        if (ON_MeshNGonEdge::TagEdgeAsCrease(mesh_edge0, mesh_edge1, mesh_point_id))
-          edge_tag = ON_SubDEdgeTag::Crease;
-      }
-    }
-    if ( j-i != 2 )
-      edge_tag = ON_SubDEdgeTag::Crease; // wire, boundary, or non-manifold edge
+    // determine if the edge should be tagged as a crease.
+    const ON_SubDEdgeTag edge_tag 
+      = (2 == j - i && (0 == group_crease.UnsignedCount() || false == group_crease[gi]))
+      ? ON_SubDEdgeTag::Smooth
+      : ON_SubDEdgeTag::Crease; // interior crease, wire, boundary, or non-manifold edge
 
     // create the SubD edge.
     ON_SubDVertex* v0[2] = { subd_V[mesh_edge0.m_mesh_Vi],  subd_V[mesh_edge0.m_mesh_Vj] };
@@ -1097,73 +1288,33 @@ ON_SubD* ON_SubD::Internal_CreateFromMeshWithValidNgons(
     ;
   if (bLookForConvexCorners || bLookForConcaveCorners)
   {
-    // Add corners
+    // Add corners.
+    // Each crease vertex test reads only control net geometry, so the
+    // tests run in parallel and the tags are set afterwards.
+    ON_SimpleArray<const ON_SubDVertex*> crease_vertices;
     ON_SubDVertexIterator vit(*new_subd);
-    for (ON_SubDVertex* vertex = const_cast<ON_SubDVertex*>(vit.FirstVertex()); nullptr != vertex; vertex = const_cast<ON_SubDVertex*>(vit.NextVertex()))
+    for (const ON_SubDVertex* vertex = vit.FirstVertex(); nullptr != vertex; vertex = vit.NextVertex())
     {
-      if (ON_SubDVertexTag::Crease != vertex->m_vertex_tag)
-        continue;
-      if ( 1 + vertex->m_face_count != vertex->m_edge_count )
-        continue;
-
-      ON_SubDComponentPtrPair boundary_pair = vertex->BoundaryEdgePair();
-      if (false == boundary_pair.BothAreNotNull())
-        continue;
-
-      bool bConvexCorner
-        = bLookForConvexCorners
-        && vertex->m_edge_count <= from_mesh_options->MaximumConvexCornerEdgeCount()
-        ;
-      bool bConcaveCorner
-        = bLookForConcaveCorners
-        && vertex->m_edge_count >= from_mesh_options->MinimumConcaveCornerEdgeCount()
-        ;
-
-      if (false == bConvexCorner && false == bConcaveCorner)
-        continue;
-
-      // add up angles of faces at this vertex
-      // If the faces are not coplanar, this sum can exceed 2pi.
-      double vertex_angle_radians = 0.0;
-      for (unsigned short vei = 0; vei < vertex->m_face_count; ++vei)
-      {
-        const double a = Internal_FaceCornerAngleRadians(vertex, vertex->m_faces[vei]);
-        if (false == (a > 0.0 && a < ON_PI) )
-        {
-          vertex_angle_radians = ON_DBL_QNAN;
-          break;
-        }
-        vertex_angle_radians += a;
-      }
-      if (false == (vertex_angle_radians > 0.0))
-        continue;
-
-      bConvexCorner = bConvexCorner && vertex_angle_radians <= max_convex_angle_radians;
-      bConcaveCorner = bConcaveCorner && vertex_angle_radians >= min_concave_angle_radians;
-      if (bConvexCorner ? 0 : 1 == bConcaveCorner ? 0 : 1)
-        continue;
-
-      // Finally, test the angle between the boundary edges. That angle must also pass the min/max tests.
-      // This test cannot be done earlier, because we need to know if we are making a concave or convex corner
-      // to do this test correctly.
-      const double boundary_angle_radians = ON_SubDSectorType::CornerSectorAngleRadiansFromEdges(boundary_pair.First().EdgePtr(), boundary_pair.Second().EdgePtr());
-      if (false == boundary_angle_radians > 0.0 && boundary_angle_radians < ON_PI)
-        continue; // the angle is always acute because it does not look at the active side
-      if (bConvexCorner)
-      {
-        if (false == (boundary_angle_radians <= max_convex_angle_radians))
-          continue;
-      }
-      else if (bConcaveCorner)
-      {
-        if (false == ((ON_2PI - boundary_angle_radians) >= min_concave_angle_radians))
-          continue;
-      }
-      else
-        continue; // should never get here
-
+      if (ON_SubDVertexTag::Crease == vertex->m_vertex_tag)
+        crease_vertices.Append(vertex);
+    }
 
-      vertex->m_vertex_tag = ON_SubDVertexTag::Corner;        
+    ON_SimpleArray<bool> bCorner(crease_vertices.UnsignedCount());
+    bCorner.SetCount(crease_vertices.UnsignedCount());
+    ON_Internal_MeshCornerContext corner_context;
+    corner_context.m_vertices = crease_vertices.Array();
+    corner_context.m_from_mesh_options = from_mesh_options;
+    corner_context.m_bLookForConvexCorners = bLookForConvexCorners;
+    corner_context.m_bLookForConcaveCorners = bLookForConcaveCorners;
+    corner_context.m_max_convex_angle_radians = max_convex_angle_radians;
+    corner_context.m_min_concave_angle_radians = min_concave_angle_radians;
+    corner_context.m_bCorner = bCorner.Array();
+    ON_ParallelFor(crease_vertices.UnsignedCount(), 0x400, 0, Internal_FindMeshCornersRange, (ON__UINT_PTR)&corner_context);
+
+    for (unsigned int i = 0; i < crease_vertices.UnsignedCount(); ++i)
+    {
+      if (bCorner[i])
+        const_cast<ON_SubDVertex*>(crease_vertices[i])->m_vertex_tag = ON_SubDVertexTag::Corner;
     }
   }
 
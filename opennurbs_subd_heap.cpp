@@ -2183,6 +2183,8 @@ bool ON_SubDHeap::ReturnMeshFragments(const ON_SubDFace * face)
   {
     face->Internal_ClearSurfacePointFlag();
     ON_SubDMeshFragment* fragment = face->m_mesh_fragments;
+    if (nullptr != fragment)
+      face->Internal_SetModified1Flag();
     face->m_mesh_fragments = nullptr;
     while (nullptr != fragment)
     {
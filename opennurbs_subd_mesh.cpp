@@ -2343,3 +2343,21 @@ void ON_SubD::ClearEvaluationCache() const
     level->ClearEvaluationCache();
   }
 }
+
+unsigned int ON_SubD::GetFacesWithChangedMeshFragments(
+  ON_SimpleArray<const ON_SubDFace*>& changed_faces,
+  bool bClearChangedFlags
+) const
+{
+  const unsigned int count0 = changed_faces.UnsignedCount();
+  ON_SubDFaceIterator fit(*this);
+  for (const ON_SubDFace* f = fit.FirstFace(); nullptr != f; f = fit.NextFace())
+  {
+    if (false == f->MeshFragmentsChanged())
+      continue;
+    changed_faces.Append(f);
+    if (bClearChangedFlags)
+      f->ClearMeshFragmentsChanged();
+  }
+  return changed_faces.UnsignedCount() - count0;
+}
@@ -0,0 +1,994 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+#include "opennurbs_subd_data.h"
+
+/*
+  How the patches are created:
+
+  A quad whose ON_SubDQuadNeighborhood is a cubic patch is one bicubic
+  B-spline span. Otherwise each quadrant of the quad with an exact patch is
+  added and the remaining quadrants are locally subdivided toward their
+  extraordinary corner until the maximum depth is reached. Faces that are
+  not quads are first subdivided into one quad per face corner.
+
+  Every patch is stored as a bicubic Bezier so its CVs bound the patch.
+  The patch's (u,v) is mapped to the face parameters with an affine map.
+*/
+
+#define ON_SUBD_QUERY_MAXIMUM_DEPTH 8
+
+static void Internal_CubicBernstein(
+  double u,
+  double B[4],
+  double dB[4],
+  double ddB[4]
+)
+{
+  const double u1 = 1.0 - u;
+  B[0] = u1 * u1 * u1;
+  B[1] = 3.0 * u * u1 * u1;
+  B[2] = 3.0 * u * u * u1;
+  B[3] = u * u * u;
+  if (nullptr != dB)
+  {
+    dB[0] = -3.0 * u1 * u1;
+    dB[1] = 3.0 * u1 * u1 - 6.0 * u * u1;
+    dB[2] = 6.0 * u * u1 - 3.0 * u * u;
+    dB[3] = 3.0 * u * u;
+  }
+  if (nullptr != ddB)
+  {
+    ddB[0] = 6.0 * u1;
+    ddB[1] = 18.0 * u - 12.0;
+    ddB[2] = 6.0 - 18.0 * u;
+    ddB[3] = 6.0 * u;
+  }
+}
+
+static const ON_3dPoint Internal_PatchPoint(
+  const double* cv,
+  double u,
+  double v
+)
+{
+  double Bu[4], Bv[4];
+  Internal_CubicBernstein(u, Bu, nullptr, nullptr);
+  Internal_CubicBernstein(v, Bv, nullptr, nullptr);
+  double S[3] = {};
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      const double w = Bu[i] * Bv[j];
+      const double* P = cv + 3 * (4 * i + j);
+      S[0] += w * P[0];
+      S[1] += w * P[1];
+      S[2] += w * P[2];
+    }
+  }
+  return ON_3dPoint(S);
+}
+
+/*
+Description:
+  Evaluate a bicubic Bezier patch and its first and second partial derivatives.
+  D[0] = S, D[1] = Su, D[2] = Sv, D[3] = Suu, D[4] = Suv, D[5] = Svv
+*/
+static void Internal_EvaluatePatch(
+  const double* cv,
+  double u,
+  double v,
+  ON_3dVector D[6]
+)
+{
+  double Bu[3][4], Bv[3][4];
+  Internal_CubicBernstein(u, Bu[0], Bu[1], Bu[2]);
+  Internal_CubicBernstein(v, Bv[0], Bv[1], Bv[2]);
+  for (int k = 0; k < 6; k++)
+    D[k] = ON_3dVector::ZeroVector;
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      const ON_3dVector P(cv + 3 * (4 * i + j));
+      D[0] += (Bu[0][i] * Bv[0][j]) * P;
+      D[1] += (Bu[1][i] * Bv[0][j]) * P;
+      D[2] += (Bu[0][i] * Bv[1][j]) * P;
+      D[3] += (Bu[2][i] * Bv[0][j]) * P;
+      D[4] += (Bu[1][i] * Bv[1][j]) * P;
+      D[5] += (Bu[0][i] * Bv[2][j]) * P;
+    }
+  }
+}
+
+static double Internal_Clamp01(double t)
+{
+  return (t < 0.0) ? 0.0 : ((t > 1.0) ? 1.0 : t);
+}
+
+/*
+Description:
+  Find the closest point on a bicubic Bezier patch to P.
+  The best point on a 5x5 sample grid is refined with Newton iteration
+  on the squared distance. Parameters are clamped to the patch.
+*/
+static double Internal_PatchClosestPoint(
+  const double* cv,
+  ON_3dPoint P,
+  double* u,
+  double* v
+)
+{
+  double best_u = 0.0;
+  double best_v = 0.0;
+  double best_d2 = ON_DBL_MAX;
+  for (int i = 0; i <= 4; i++)
+  {
+    for (int j = 0; j <= 4; j++)
+    {
+      const double d2 = (Internal_PatchPoint(cv, 0.25 * i, 0.25 * j) - P).LengthSquared();
+      if (d2 < best_d2)
+      {
+        best_d2 = d2;
+        best_u = 0.25 * i;
+        best_v = 0.25 * j;
+      }
+    }
+  }
+
+  ON_3dVector D[6];
+  for (int newton_count = 0; newton_count < 16; newton_count++)
+  {
+    Internal_EvaluatePatch(cv, best_u, best_v, D);
+    const ON_3dVector R = D[0] - ON_3dVector(P);
+    const double g0 = D[1] * R;
+    const double g1 = D[2] * R;
+    double H00 = D[1] * D[1] + D[3] * R;
+    double H01 = D[1] * D[2] + D[4] * R;
+    double H11 = D[2] * D[2] + D[5] * R;
+    double det = H00 * H11 - H01 * H01;
+    if (!(H00 > 0.0 && det > 0.0))
+    {
+      // Hessian is not positive definite - use Gauss-Newton
+      H00 = D[1] * D[1];
+      H01 = D[1] * D[2];
+      H11 = D[2] * D[2];
+      det = H00 * H11 - H01 * H01;
+      if (!(det > 0.0))
+        break;
+    }
+    double du = -(H11 * g0 - H01 * g1) / det;
+    double dv = -(H00 * g1 - H01 * g0) / det;
+
+    bool bImproved = false;
+    for (int halving_count = 0; halving_count < 6; halving_count++)
+    {
+      const double u1 = Internal_Clamp01(best_u + du);
+      const double v1 = Internal_Clamp01(best_v + dv);
+      const double d2 = (Internal_PatchPoint(cv, u1, v1) - P).LengthSquared();
+      if (d2 < best_d2)
+      {
+        du = u1 - best_u;
+        dv = v1 - best_v;
+        best_u = u1;
+        best_v = v1;
+        best_d2 = d2;
+        bImproved = true;
+        break;
+      }
+      du *= 0.5;
+      dv *= 0.5;
+    }
+    if (false == bImproved || fabs(du) + fabs(dv) <= 1.0e-14)
+      break;
+  }
+
+  *u = best_u;
+  *v = best_v;
+  return sqrt(best_d2);
+}
+
+/*
+Returns:
+  True if the ray O + t*V with t0 <= t <= t1 hits bbox.
+*/
+static bool Internal_RayHitsBox(
+  const ON_BoundingBox& bbox,
+  const ON_3dPoint& O,
+  const ON_3dVector& V,
+  double t0,
+  double t1
+)
+{
+  for (int k = 0; k < 3; k++)
+  {
+    if (0.0 == V[k])
+    {
+      if (O[k] < bbox.m_min[k] || O[k] > bbox.m_max[k])
+        return false;
+      continue;
+    }
+    double a = (bbox.m_min[k] - O[k]) / V[k];
+    double b = (bbox.m_max[k] - O[k]) / V[k];
+    if (a > b)
+    {
+      const double x = a;
+      a = b;
+      b = x;
+    }
+    if (a > t0)
+      t0 = a;
+    if (b < t1)
+      t1 = b;
+    if (t0 > t1)
+      return false;
+  }
+  return true;
+}
+
+/*
+Description:
+  Find the first hit of the ray O + t*V with the bicubic Bezier patch for
+  t0 <= t <= t1. Newton iteration on S(u,v) - (O + t*V) = 0 is started in
+  every cell of a 4x4 sample grid whose box the ray hits.
+*/
+static bool Internal_PatchRayHit(
+  const double* cv,
+  const ON_3dPoint& O,
+  const ON_3dVector& V,
+  double t0,
+  double t1,
+  double* hit_u,
+  double* hit_v,
+  double* hit_t
+)
+{
+  ON_3dPoint G[5][5];
+  for (int i = 0; i <= 4; i++)
+  {
+    for (int j = 0; j <= 4; j++)
+      G[i][j] = Internal_PatchPoint(cv, 0.25 * i, 0.25 * j);
+  }
+
+  const double VoV = V * V;
+  if (!(VoV > 0.0))
+    return false;
+
+  bool rc = false;
+  ON_3dVector D[6];
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      ON_BoundingBox cell_bbox(G[i][j], G[i][j]);
+      cell_bbox.Set(G[i + 1][j], true);
+      cell_bbox.Set(G[i + 1][j + 1], true);
+      cell_bbox.Set(G[i][j + 1], true);
+      // The sampled points do not bound the cell's surface.
+      const double pad = 0.25 * cell_bbox.Diagonal().Length() + ON_ZERO_TOLERANCE;
+      cell_bbox.m_min -= ON_3dVector(pad, pad, pad);
+      cell_bbox.m_max += ON_3dVector(pad, pad, pad);
+      if (false == Internal_RayHitsBox(cell_bbox, O, V, t0, t1))
+        continue;
+
+      const double tolerance = 1.0e-10 * (1.0 + cell_bbox.Diagonal().Length());
+      double u = 0.25 * (i + 0.5);
+      double v = 0.25 * (j + 0.5);
+      double t = ((Internal_PatchPoint(cv, u, v) - O) * V) / VoV;
+      for (int newton_count = 0; newton_count < 16; newton_count++)
+      {
+        Internal_EvaluatePatch(cv, u, v, D);
+        const ON_3dVector F = D[0] - ON_3dVector(O) - t * V;
+        // Solve [Su, Sv, -V] * (du,dv,dt) = -F with Cramer's rule.
+        const ON_3dVector SvxV = ON_CrossProduct(D[2], -V);
+        const double det = D[1] * SvxV;
+        if (!(fabs(det) > 0.0))
+          break;
+        const double du = -(F * SvxV) / det;
+        const double dv = -(D[1] * ON_CrossProduct(F, -V)) / det;
+        const double dt = -(D[1] * ON_CrossProduct(D[2], F)) / det;
+        u += du;
+        v += dv;
+        t += dt;
+        if (u < -0.5 || u > 1.5 || v < -0.5 || v > 1.5)
+          break;
+        if (fabs(du) + fabs(dv) <= 1.0e-14)
+          break;
+      }
+      if (u < -1.0e-9 || u > 1.0 + 1.0e-9 || v < -1.0e-9 || v > 1.0 + 1.0e-9)
+        continue;
+      u = Internal_Clamp01(u);
+      v = Internal_Clamp01(v);
+      if (!(t >= t0 && t <= t1))
+        continue;
+      const ON_3dVector F = Internal_PatchPoint(cv, u, v) - O - t * V;
+      if (!(F.Length() <= tolerance))
+        continue;
+      *hit_u = u;
+      *hit_v = v;
+      *hit_t = t;
+      t1 = t;
+      rc = true;
+    }
+  }
+  return rc;
+}
+
+class ON_Internal_SubDSurfaceQueryBuilder
+{
+public:
+  ON_Internal_SubDSurfaceQueryBuilder(
+    ON_SubDSurfaceQuery& query,
+    unsigned int maximum_depth
+  )
+    : m_query(query)
+    , m_maximum_depth(maximum_depth)
+  {}
+
+  ~ON_Internal_SubDSurfaceQueryBuilder() = default;
+
+  bool AddFace(
+    const ON_SubDFace* face
+  );
+
+  void CreateTree();
+
+private:
+  ON_Internal_SubDSurfaceQueryBuilder(const ON_Internal_SubDSurfaceQueryBuilder&) = delete;
+  ON_Internal_SubDSurfaceQueryBuilder& operator=(const ON_Internal_SubDSurfaceQueryBuilder&) = delete;
+
+  bool Internal_AddQuad(
+    unsigned int depth,
+    const double map[6]
+  );
+
+  void Internal_AddPatch(
+    const double bezier_cv[4][4][3],
+    const double map[6]
+  );
+
+  /*
+  Description:
+    Evaluate the surface at face parameter (s,t) using patches >= patch0.
+  */
+  bool Internal_FacePoint(
+    unsigned int patch0,
+    double s,
+    double t,
+    ON_3dPoint& P
+  ) const;
+
+  static void Internal_BezierFromBSpline(
+    const double bspline_cv[4][4][3],
+    double bezier_cv[4][4][3]
+  );
+
+  static void Internal_ComposeMap(
+    const double map[6],
+    const double c[6],
+    double composite[6]
+  );
+
+  ON_SubDSurfaceQuery& m_query;
+  const unsigned int m_maximum_depth;
+  ON_SubDComponentPtr m_face_ptr = ON_SubDComponentPtr::Null;
+  unsigned int m_face_corner = ON_UNSET_UINT_INDEX;
+
+  // m_qnbd[depth+1] is a subdivision of a quadrant of m_qnbd[depth]
+  // and its components are in m_fsh[depth+1]. Quadrants next to an
+  // extraordinary corner go one level deeper than m_maximum_depth and
+  // the approximate quadrants need one more level.
+  // m_fsh[] must be declared before m_qnbd[] so it is destroyed last.
+  ON_SubD_FixedSizeHeap m_fsh[ON_SUBD_QUERY_MAXIMUM_DEPTH + 3];
+  ON_SubDQuadNeighborhood m_qnbd[ON_SUBD_QUERY_MAXIMUM_DEPTH + 3];
+};
+
+void ON_Internal_SubDSurfaceQueryBuilder::Internal_BezierFromBSpline(
+  const double bspline_cv[4][4][3],
+  double bezier_cv[4][4][3]
+)
+{
+  // Uniform cubic B-spline span to Bezier
+  const double M[4][4] = {
+    { 1.0 / 6.0, 4.0 / 6.0, 1.0 / 6.0, 0.0 },
+    { 0.0, 4.0 / 6.0, 2.0 / 6.0, 0.0 },
+    { 0.0, 2.0 / 6.0, 4.0 / 6.0, 0.0 },
+    { 0.0, 1.0 / 6.0, 4.0 / 6.0, 1.0 / 6.0 }
+  };
+  double tmp[4][4][3];
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      for (int k = 0; k < 3; k++)
+        tmp[i][j][k] = M[i][0] * bspline_cv[0][j][k] + M[i][1] * bspline_cv[1][j][k] + M[i][2] * bspline_cv[2][j][k] + M[i][3] * bspline_cv[3][j][k];
+    }
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      for (int k = 0; k < 3; k++)
+        bezier_cv[i][j][k] = M[j][0] * tmp[i][0][k] + M[j][1] * tmp[i][1][k] + M[j][2] * tmp[i][2][k] + M[j][3] * tmp[i][3][k];
+    }
+  }
+}
+
+void ON_Internal_SubDSurfaceQueryBuilder::Internal_ComposeMap(
+  const double m[6],
+  const double c[6],
+  double composite[6]
+)
+{
+  // m(x,y) = (m[0] + m[2]*x + m[4]*y, m[1] + m[3]*x + m[5]*y) and (x,y) = c(u,v)
+  composite[0] = m[0] + m[2] * c[0] + m[4] * c[1];
+  composite[1] = m[1] + m[3] * c[0] + m[5] * c[1];
+  composite[2] = m[2] * c[2] + m[4] * c[3];
+  composite[3] = m[3] * c[2] + m[5] * c[3];
+  composite[4] = m[2] * c[4] + m[4] * c[5];
+  composite[5] = m[3] * c[4] + m[5] * c[5];
+}
+
+void ON_Internal_SubDSurfaceQueryBuilder::Internal_AddPatch(
+  const double bezier_cv[4][4][3],
+  const double map[6]
+)
+{
+  m_query.m_patch_cv.Append(48, &bezier_cv[0][0][0]);
+  m_query.m_patch_map.Append(6, map);
+  m_query.m_patch_face.Append(m_face_ptr);
+  m_query.m_patch_face_corner.Append(m_face_corner);
+  ON_BoundingBox bbox = ON_BoundingBox::EmptyBoundingBox;
+  bbox.Set(3, false, 16, 3, &bezier_cv[0][0][0], false);
+  m_query.m_patch_bbox.Append(bbox);
+}
+
+bool ON_Internal_SubDSurfaceQueryBuilder::Internal_FacePoint(
+  unsigned int patch0,
+  double s,
+  double t,
+  ON_3dPoint& P
+) const
+{
+  const unsigned int patch_count = m_query.m_patch_map.UnsignedCount() / 6;
+  for (unsigned int pi = patch0; pi < patch_count; pi++)
+  {
+    const double* m = m_query.m_patch_map.Array() + 6 * pi;
+    const double det = m[2] * m[5] - m[4] * m[3];
+    if (0.0 == det)
+      continue;
+    const double u = (m[5] * (s - m[0]) - m[4] * (t - m[1])) / det;
+    const double v = (m[2] * (t - m[1]) - m[3] * (s - m[0])) / det;
+    if (u >= -ON_ZERO_TOLERANCE && u <= 1.0 + ON_ZERO_TOLERANCE && v >= -ON_ZERO_TOLERANCE && v <= 1.0 + ON_ZERO_TOLERANCE)
+    {
+      P = Internal_PatchPoint(m_query.m_patch_cv.Array() + 48 * pi, Internal_Clamp01(u), Internal_Clamp01(v));
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ON_Internal_SubDSurfaceQueryBuilder::Internal_AddQuad(
+  unsigned int depth,
+  const double map[6]
+)
+{
+  ON_SubDQuadNeighborhood& qnbd = m_qnbd[depth];
+
+  double bspline_cv[4][4][3];
+  double bezier_cv[4][4][3];
+  double patch_map[4][6];
+
+  if (qnbd.m_bIsCubicPatch && qnbd.GetLimitSurfaceCV(&bspline_cv[0][0][0], 4U))
+  {
+    Internal_BezierFromBSpline(bspline_cv, bezier_cv);
+    Internal_AddPatch(bezier_cv, map);
+    return true;
+  }
+
+  // Patches for this quad are m_query patches >= patch0.
+  const unsigned int patch0 = m_query.m_patch_map.UnsignedCount() / 6;
+
+  // quadrant fvi is the (x,y) region [x0,x0+1/2] x [y0,y0+1/2]
+  const double quadrant_x0[4] = { 0.0, 0.5, 0.5, 0.0 };
+  const double quadrant_y0[4] = { 0.0, 0.0, 0.5, 0.5 };
+
+  bool rc = true;
+  bool bApproximateQuadrant[4] = {};
+  for (unsigned int fvi = 0; fvi < 4; fvi++)
+  {
+    const double quadrant_map[6] = { quadrant_x0[fvi], quadrant_y0[fvi], 0.5, 0.0, 0.0, 0.5 };
+    Internal_ComposeMap(map, quadrant_map, patch_map[fvi]);
+
+    if (qnbd.m_bExactQuadrantPatch[fvi] && qnbd.GetLimitSubSurfaceSinglePatchCV(fvi, bspline_cv))
+    {
+      Internal_BezierFromBSpline(bspline_cv, bezier_cv);
+      Internal_AddPatch(bezier_cv, patch_map[fvi]);
+      continue;
+    }
+
+    // A quadrant next to an extraordinary corner gets one more subdivision
+    // so the approximate region is only at the extraordinary vertex.
+    const unsigned int maximum_depth
+      = qnbd.m_bExtraordinaryCornerVertex[fvi]
+      ? m_maximum_depth
+      : m_maximum_depth + 1;
+    if (depth < maximum_depth && qnbd.Subdivide(fvi, m_fsh[depth + 1], &m_qnbd[depth + 1]))
+    {
+      // The subdivided quad has the same orientation as qnbd and covers quadrant fvi.
+      if (false == Internal_AddQuad(depth + 1, patch_map[fvi]))
+        rc = false;
+      continue;
+    }
+
+    bApproximateQuadrant[fvi] = true;
+  }
+
+  for (unsigned int fvi = 0; fvi < 4; fvi++)
+  {
+    if (false == bApproximateQuadrant[fvi])
+      continue;
+
+    // Approximate the quadrant with a bilinear patch through its 4 corner
+    // surface points. The quadrant's corner at qnbd's corner fvi is the
+    // vertex's surface point. The other corners are on the patches
+    // added for the other quadrants. When a surface point is not available,
+    // the subdivision control point is used.
+    const double corner_u[4] = { 0.0, 1.0, 1.0, 0.0 };
+    const double corner_v[4] = { 0.0, 0.0, 1.0, 1.0 };
+    const double* m = patch_map[fvi];
+    const bool bHaveSubdivision = qnbd.Subdivide(fvi, m_fsh[depth + 1], &m_qnbd[depth + 1]);
+    ON_3dPoint Q[4];
+    for (unsigned int qci = 0; qci < 4; qci++)
+    {
+      const unsigned int grid_corner = (fvi + qci) % 4;
+      if (qci == 0)
+      {
+        // grid_corner = fvi
+        const ON_SubDVertex* v = qnbd.CenterVertex(fvi);
+        ON_SubDSectorSurfacePoint sp;
+        if (nullptr != v && v->GetSurfacePoint(qnbd.CenterQuad(), sp))
+        {
+          Q[fvi] = ON_3dPoint(sp.m_limitP);
+          continue;
+        }
+      }
+      else
+      {
+        const double s = m[0] + m[2] * corner_u[grid_corner] + m[4] * corner_v[grid_corner];
+        const double t = m[1] + m[3] * corner_u[grid_corner] + m[5] * corner_v[grid_corner];
+        if (Internal_FacePoint(patch0, s, t, Q[grid_corner]))
+          continue;
+      }
+      const ON_SubDVertex* v1 = bHaveSubdivision ? m_qnbd[depth + 1].CenterVertex(grid_corner) : nullptr;
+      if (nullptr == v1)
+      {
+        ON_SubDIncrementErrorCount();
+        return false;
+      }
+      Q[grid_corner] = v1->ControlNetPoint();
+    }
+    if (bHaveSubdivision)
+      ON_SubDQuadNeighborhood::Clear(&m_qnbd[depth + 1], false);
+
+    for (int i = 0; i < 4; i++)
+    {
+      const double a = i / 3.0;
+      for (int j = 0; j < 4; j++)
+      {
+        const double b = j / 3.0;
+        const ON_3dPoint P
+          = ((1.0 - a) * (1.0 - b)) * Q[0] + (a * (1.0 - b)) * Q[1]
+          + (a * b) * Q[2] + ((1.0 - a) * b) * Q[3];
+        bezier_cv[i][j][0] = P.x;
+        bezier_cv[i][j][1] = P.y;
+        bezier_cv[i][j][2] = P.z;
+      }
+    }
+    Internal_AddPatch(bezier_cv, patch_map[fvi]);
+  }
+
+  return rc;
+}
+
+bool ON_Internal_SubDSurfaceQueryBuilder::AddFace(
+  const ON_SubDFace* face
+)
+{
+  if (nullptr == face || face->m_edge_count < 3)
+    return ON_SUBD_RETURN_ERROR(false);
+
+  m_face_ptr = ON_SubDComponentPtr::Create(face);
+
+  bool rc = false;
+  if (4 == face->m_edge_count)
+  {
+    m_face_corner = ON_UNSET_UINT_INDEX;
+    if (m_qnbd[0].Set(face))
+    {
+      const double identity_map[6] = { 0.0, 0.0, 1.0, 0.0, 0.0, 1.0 };
+      rc = Internal_AddQuad(0, identity_map);
+    }
+  }
+  else
+  {
+    // Subquad m_face1[i] is (face center, midpoint of face->Edge(i-1), face->Vertex(i), midpoint of face->Edge(i)).
+    // The corner subquad parameters have face->Vertex(i) at (0,0) and the face center at (1,1).
+    ON_SubDFaceNeighborhood fn;
+    if (fn.Subdivide(face) && fn.m_face1_count == face->m_edge_count)
+    {
+      const double corner_map[6] = { 1.0, 1.0, -1.0, 0.0, 0.0, -1.0 };
+      rc = true;
+      for (unsigned int i = 0; i < fn.m_face1_count; i++)
+      {
+        m_face_corner = i;
+        if (false == m_qnbd[0].Set(fn.m_face1[i]) || false == Internal_AddQuad(0, corner_map))
+          rc = false;
+      }
+    }
+    // m_qnbd[0] references components in fn.
+    ON_SubDQuadNeighborhood::Clear(&m_qnbd[0], false);
+  }
+
+  return rc ? true : ON_SUBD_RETURN_ERROR(false);
+}
+
+void ON_Internal_SubDSurfaceQueryBuilder::CreateTree()
+{
+  const unsigned int patch_count = m_query.m_patch_bbox.UnsignedCount();
+  m_query.m_bbox = ON_BoundingBox::EmptyBoundingBox;
+  for (unsigned int pi = 0; pi < patch_count; pi++)
+  {
+    const ON_BoundingBox& bbox = m_query.m_patch_bbox[pi];
+    m_query.m_patch_tree.Insert(bbox.m_min, bbox.m_max, (int)pi);
+    m_query.m_bbox.Union(bbox);
+  }
+}
+
+bool ON_SubDSurfaceQueryPoint::IsSet() const
+{
+  return m_component_ptr.IsNotNull() && m_point.IsValid();
+}
+
+bool ON_SubDSurfaceQuery::Create(
+  const ON_SubD& subd,
+  unsigned int maximum_subdivision_depth
+)
+{
+  Destroy();
+
+  if (maximum_subdivision_depth < 1)
+    maximum_subdivision_depth = 1;
+  else if (maximum_subdivision_depth > ON_SUBD_QUERY_MAXIMUM_DEPTH)
+    maximum_subdivision_depth = ON_SUBD_QUERY_MAXIMUM_DEPTH;
+
+  const unsigned int face_count = subd.FaceCount();
+  if (0 == face_count)
+    return false;
+
+  m_patch_cv.Reserve(48 * face_count);
+  m_patch_map.Reserve(6 * face_count);
+  m_patch_bbox.Reserve(face_count);
+  m_patch_face.Reserve(face_count);
+  m_patch_face_corner.Reserve(face_count);
+
+  bool rc = true;
+  {
+    ON_Internal_SubDSurfaceQueryBuilder builder(*this, maximum_subdivision_depth);
+    ON_SubDFaceIterator fit(subd);
+    for (const ON_SubDFace* f = fit.FirstFace(); nullptr != f; f = fit.NextFace())
+    {
+      if (false == builder.AddFace(f))
+        rc = false;
+    }
+    builder.CreateTree();
+  }
+
+  if (0 == m_patch_bbox.UnsignedCount())
+  {
+    Destroy();
+    return ON_SUBD_RETURN_ERROR(false);
+  }
+
+  m_geometry_content_serial_number = subd.GeometryContentSerialNumber();
+  return rc;
+}
+
+void ON_SubDSurfaceQuery::Destroy()
+{
+  m_geometry_content_serial_number = 0;
+  m_bbox = ON_BoundingBox::EmptyBoundingBox;
+  m_patch_cv.Destroy();
+  m_patch_map.Destroy();
+  m_patch_bbox.Destroy();
+  m_patch_face.Destroy();
+  m_patch_face_corner.Destroy();
+  m_patch_tree.RemoveAll();
+}
+
+bool ON_SubDSurfaceQuery::IsEmpty() const
+{
+  return 0 == m_patch_bbox.UnsignedCount();
+}
+
+unsigned int ON_SubDSurfaceQuery::PatchCount() const
+{
+  return m_patch_bbox.UnsignedCount();
+}
+
+const ON_BoundingBox ON_SubDSurfaceQuery::BoundingBox() const
+{
+  return m_bbox;
+}
+
+ON__UINT64 ON_SubDSurfaceQuery::GeometryContentSerialNumber() const
+{
+  return m_geometry_content_serial_number;
+}
+
+const ON_SubDSurfaceQueryPoint ON_SubDSurfaceQuery::Internal_QueryPoint(
+  unsigned int patch_index,
+  double u,
+  double v,
+  double distance
+) const
+{
+  const double* cv = m_patch_cv.Array() + 48 * patch_index;
+  const double* m = m_patch_map.Array() + 6 * patch_index;
+
+  ON_3dVector D[6];
+  Internal_EvaluatePatch(cv, u, v, D);
+  ON_3dVector N = ON_CrossProduct(D[1], D[2]);
+  if (false == N.Unitize())
+  {
+    // degenerate patch corner - use a point just inside the patch
+    ON_3dVector D1[6];
+    Internal_EvaluatePatch(cv, 0.999999 * u + 0.0000005, 0.999999 * v + 0.0000005, D1);
+    N = ON_CrossProduct(D1[1], D1[2]);
+    N.Unitize();
+  }
+  // The normal points the same way as the face parameter's s x t.
+  if (m[2] * m[5] - m[4] * m[3] < 0.0)
+    N = -N;
+
+  ON_SubDSurfaceQueryPoint qp;
+  qp.m_component_ptr = m_patch_face[patch_index];
+  qp.m_face_corner_index = m_patch_face_corner[patch_index];
+  qp.m_face_parameter.x = Internal_Clamp01(m[0] + m[2] * u + m[4] * v);
+  qp.m_face_parameter.y = Internal_Clamp01(m[1] + m[3] * u + m[5] * v);
+  qp.m_point = D[0];
+  qp.m_normal = N;
+  qp.m_distance = distance;
+  return qp;
+}
+
+class ON_Internal_SubDSurfaceQueryCandidate
+{
+public:
+  // lower bound of the distance from the test point to the patch
+  double m_distance;
+  unsigned int m_patch_index;
+
+  static int Compare(const ON_Internal_SubDSurfaceQueryCandidate* a, const ON_Internal_SubDSurfaceQueryCandidate* b)
+  {
+    if (a->m_distance < b->m_distance)
+      return -1;
+    if (a->m_distance > b->m_distance)
+      return 1;
+    return (a->m_patch_index < b->m_patch_index) ? -1 : ((a->m_patch_index > b->m_patch_index) ? 1 : 0);
+  }
+};
+
+class ON_Internal_SubDSurfaceQueryContext
+{
+public:
+  ON_Internal_SubDSurfaceQueryContext() = default;
+  ~ON_Internal_SubDSurfaceQueryContext() = default;
+
+  const double* m_patch_cv = nullptr;
+  const ON_BoundingBox* m_patch_bbox = nullptr;
+
+  // closest point
+  ON_RTreeSphere m_sphere;
+  ON_3dPoint m_P = ON_3dPoint::NanPoint;
+  ON_SimpleArray<ON_Internal_SubDSurfaceQueryCandidate> m_candidates;
+
+  // ray
+  ON_3dRay m_ray;
+
+  unsigned int m_patch_index = ON_UNSET_UINT_INDEX;
+  double m_u = ON_DBL_QNAN;
+  double m_v = ON_DBL_QNAN;
+  double m_d = ON_DBL_QNAN;
+};
+
+static bool ON_CALLBACK_CDECL Internal_ClosestPointCallback(void* a_context, ON__INT_PTR a_id)
+{
+  ON_Internal_SubDSurfaceQueryContext* ctx = (ON_Internal_SubDSurfaceQueryContext*)a_context;
+  ON_Internal_SubDSurfaceQueryCandidate c;
+  c.m_patch_index = (unsigned int)a_id;
+  c.m_distance = ctx->m_patch_bbox[c.m_patch_index].MinimumDistanceTo(ctx->m_P);
+  if (c.m_distance <= ctx->m_sphere.m_radius)
+    ctx->m_candidates.Append(c);
+  return true;
+}
+
+bool ON_SubDSurfaceQuery::GetClosestPoint(
+  ON_3dPoint P,
+  double maximum_distance,
+  ON_SubDSurfaceQueryPoint& closest_point
+) const
+{
+  closest_point = ON_SubDSurfaceQueryPoint::Unset;
+  if (IsEmpty() || false == P.IsValid())
+    return false;
+
+  ON_Internal_SubDSurfaceQueryContext ctx;
+  ctx.m_patch_cv = m_patch_cv.Array();
+  ctx.m_patch_bbox = m_patch_bbox.Array();
+  ctx.m_P = P;
+  ctx.m_sphere.m_point[0] = P.x;
+  ctx.m_sphere.m_point[1] = P.y;
+  ctx.m_sphere.m_point[2] = P.z;
+
+  const double search_radius
+    = (maximum_distance > 0.0)
+    ? maximum_distance
+    : (1.0 + ON_SQRT_EPSILON) * m_bbox.MaximumDistanceTo(P);
+
+  // Search a sphere that grows until it contains a surface point.
+  // Patches in the sphere are tested in order of their bounding box distance
+  // so the search stops as soon as no closer point is possible.
+  ctx.m_sphere.m_radius = m_bbox.MinimumDistanceTo(P) + 0.01 * m_bbox.Diagonal().Length();
+  for (;;)
+  {
+    if (ctx.m_sphere.m_radius > search_radius)
+      ctx.m_sphere.m_radius = search_radius;
+    ctx.m_candidates.SetCount(0);
+    m_patch_tree.Search(&ctx.m_sphere, Internal_ClosestPointCallback, &ctx);
+    ctx.m_candidates.QuickSort(ON_Internal_SubDSurfaceQueryCandidate::Compare);
+    double best_distance = ctx.m_sphere.m_radius;
+    for (unsigned int i = 0; i < ctx.m_candidates.UnsignedCount(); i++)
+    {
+      const ON_Internal_SubDSurfaceQueryCandidate& c = ctx.m_candidates[i];
+      if (c.m_distance > best_distance)
+        break;
+      double u, v;
+      const double d = Internal_PatchClosestPoint(ctx.m_patch_cv + 48 * c.m_patch_index, P, &u, &v);
+      if (d <= best_distance)
+      {
+        ctx.m_patch_index = c.m_patch_index;
+        ctx.m_u = u;
+        ctx.m_v = v;
+        ctx.m_d = d;
+        best_distance = d;
+      }
+    }
+    if (ON_UNSET_UINT_INDEX != ctx.m_patch_index || !(ctx.m_sphere.m_radius < search_radius))
+      break;
+    ctx.m_sphere.m_radius *= 2.0;
+  }
+
+  if (ON_UNSET_UINT_INDEX == ctx.m_patch_index)
+    return false;
+  closest_point = Internal_QueryPoint(ctx.m_patch_index, ctx.m_u, ctx.m_v, ctx.m_d);
+  return true;
+}
+
+class ON_Internal_SubDSurfaceQueryClosestPointsContext
+{
+public:
+  const ON_SubDSurfaceQuery* m_query = nullptr;
+  const ON_3dPoint* m_points = nullptr;
+  ON_SubDSurfaceQueryPoint* m_closest_points = nullptr;
+  double m_maximum_distance = 0.0;
+};
+
+static void Internal_GetClosestPointsRange(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+)
+{
+  const ON_Internal_SubDSurfaceQueryClosestPointsContext* ctx = (const ON_Internal_SubDSurfaceQueryClosestPointsContext*)context;
+  for (size_t i = i0; i < i1; i++)
+    ctx->m_query->GetClosestPoint(ctx->m_points[i], ctx->m_maximum_distance, ctx->m_closest_points[i]);
+}
+
+unsigned int ON_SubDSurfaceQuery::GetClosestPoints(
+  size_t point_count,
+  const ON_3dPoint* points,
+  double maximum_distance,
+  ON_SubDSurfaceQueryPoint* closest_points,
+  bool bParallel
+) const
+{
+  if (0 == point_count || nullptr == points || nullptr == closest_points)
+    return 0;
+
+  ON_Internal_SubDSurfaceQueryClosestPointsContext ctx;
+  ctx.m_query = this;
+  ctx.m_points = points;
+  ctx.m_closest_points = closest_points;
+  ctx.m_maximum_distance = maximum_distance;
+  ON_ParallelFor(point_count, 0x40, bParallel ? 0U : 1U, Internal_GetClosestPointsRange, (ON__UINT_PTR)&ctx);
+
+  unsigned int found_count = 0;
+  for (size_t i = 0; i < point_count; i++)
+  {
+    if (closest_points[i].IsSet())
+      ++found_count;
+  }
+  return found_count;
+}
+
+static bool ON_CALLBACK_CDECL Internal_RayHitCallback(void* a_context, ON__INT_PTR a_id)
+{
+  ON_Internal_SubDSurfaceQueryContext* ctx = (ON_Internal_SubDSurfaceQueryContext*)a_context;
+  const unsigned int patch_index = (unsigned int)a_id;
+  if (false == Internal_RayHitsBox(ctx->m_patch_bbox[patch_index], ctx->m_ray.m_P, ctx->m_ray.m_V, 0.0, ctx->m_d))
+    return true;
+  double u, v, t;
+  if (Internal_PatchRayHit(ctx->m_patch_cv + 48 * patch_index, ctx->m_ray.m_P, ctx->m_ray.m_V, 0.0, ctx->m_d, &u, &v, &t))
+  {
+    ctx->m_patch_index = patch_index;
+    ctx->m_u = u;
+    ctx->m_v = v;
+    ctx->m_d = t;
+  }
+  return true;
+}
+
+bool ON_SubDSurfaceQuery::IntersectRay(
+  const ON_3dRay& ray,
+  double maximum_parameter,
+  ON_SubDSurfaceQueryPoint& hit_point
+) const
+{
+  hit_point = ON_SubDSurfaceQueryPoint::Unset;
+  if (IsEmpty() || false == ray.m_P.IsValid() || false == ray.m_V.IsValid() || ray.m_V.IsZero())
+    return false;
+
+  ON_Internal_SubDSurfaceQueryContext ctx;
+  ctx.m_patch_cv = m_patch_cv.Array();
+  ctx.m_patch_bbox = m_patch_bbox.Array();
+  ctx.m_ray = ray;
+
+  // m_d = largest ray parameter that needs to be considered
+  ctx.m_d
+    = (maximum_parameter > 0.0)
+    ? maximum_parameter
+    : (1.0 + ON_SQRT_EPSILON) * m_bbox.MaximumDistanceTo(ray.m_P) / ray.m_V.Length();
+  if (false == Internal_RayHitsBox(m_bbox, ray.m_P, ray.m_V, 0.0, ctx.m_d))
+    return false;
+
+  const ON_Line line(ray.m_P, ray.m_P + ctx.m_d * ray.m_V);
+  m_patch_tree.Search(&line, Internal_RayHitCallback, &ctx);
+
+  if (ON_UNSET_UINT_INDEX == ctx.m_patch_index)
+    return false;
+  hit_point = Internal_QueryPoint(ctx.m_patch_index, ctx.m_u, ctx.m_v, ctx.m_d);
+  return true;
+}
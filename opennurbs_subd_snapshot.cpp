@@ -0,0 +1,810 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+#include "opennurbs_subd_data.h"
+
+void ON_SubDTopologySnapshot::Destroy()
+{
+  m_geometry_content_serial_number = 0;
+  m_vertex_id.Destroy();
+  m_vertex_tag.Destroy();
+  m_x.Destroy();
+  m_y.Destroy();
+  m_z.Destroy();
+  m_vertex_edge_start.Destroy();
+  m_vertex_edge.Destroy();
+  m_vertex_face_start.Destroy();
+  m_vertex_face.Destroy();
+  m_edge_id.Destroy();
+  m_edge_tag.Destroy();
+  m_edge_vertex.Destroy();
+  m_edge_sharpness.Destroy();
+  m_edge_face_start.Destroy();
+  m_edge_face.Destroy();
+  m_face_id.Destroy();
+  m_face_edge_start.Destroy();
+  m_face_edge.Destroy();
+}
+
+static void Internal_IndexFromId(
+  const ON_SimpleArray<unsigned int>& ids,
+  ON_SimpleArray<unsigned int>& index_from_id
+)
+{
+  unsigned int max_id = 0;
+  for (unsigned int i = 0; i < ids.UnsignedCount(); i++)
+  {
+    if (ids[i] > max_id)
+      max_id = ids[i];
+  }
+  index_from_id.Reserve(max_id + 1);
+  index_from_id.SetCount(max_id + 1);
+  for (unsigned int i = 0; i <= max_id; i++)
+    index_from_id[i] = ON_UNSET_UINT_INDEX;
+  for (unsigned int i = 0; i < ids.UnsignedCount(); i++)
+    index_from_id[ids[i]] = i;
+}
+
+static unsigned int Internal_IndexFromComponentId(
+  const ON_SimpleArray<unsigned int>& index_from_id,
+  const ON_SubDComponentBase* c
+)
+{
+  return (nullptr != c && c->m_id < index_from_id.UnsignedCount()) ? index_from_id[c->m_id] : ON_UNSET_UINT_INDEX;
+}
+
+bool ON_SubDTopologySnapshot::Create(
+  const ON_SubD& subd
+)
+{
+  Destroy();
+
+  const unsigned int vertex_count = subd.VertexCount();
+  const unsigned int edge_count = subd.EdgeCount();
+  const unsigned int face_count = subd.FaceCount();
+  if (0 == vertex_count)
+    return false;
+
+  m_geometry_content_serial_number = subd.GeometryContentSerialNumber();
+
+  // Component ids and vertex information in iterator order
+  m_vertex_id.Reserve(vertex_count);
+  m_vertex_tag.Reserve(vertex_count);
+  m_x.Reserve(vertex_count);
+  m_y.Reserve(vertex_count);
+  m_z.Reserve(vertex_count);
+  m_vertex_edge_start.Reserve(vertex_count + 1);
+  m_vertex_face_start.Reserve(vertex_count + 1);
+  unsigned int vertex_edge_count = 0;
+  unsigned int vertex_face_count = 0;
+  ON_SubDVertexIterator vit(subd);
+  for (const ON_SubDVertex* v = vit.FirstVertex(); nullptr != v; v = vit.NextVertex())
+  {
+    m_vertex_id.Append(v->m_id);
+    m_vertex_tag.Append((unsigned char)v->m_vertex_tag);
+    m_x.Append(v->m_P[0]);
+    m_y.Append(v->m_P[1]);
+    m_z.Append(v->m_P[2]);
+    m_vertex_edge_start.Append(vertex_edge_count);
+    m_vertex_face_start.Append(vertex_face_count);
+    vertex_edge_count += v->m_edge_count;
+    vertex_face_count += v->m_face_count;
+  }
+  m_vertex_edge_start.Append(vertex_edge_count);
+  m_vertex_face_start.Append(vertex_face_count);
+
+  m_edge_id.Reserve(edge_count);
+  m_edge_tag.Reserve(edge_count);
+  m_edge_face_start.Reserve(edge_count + 1);
+  unsigned int edge_face_count = 0;
+  bool bSharpEdges = false;
+  ON_SubDEdgeIterator eit(subd);
+  for (const ON_SubDEdge* e = eit.FirstEdge(); nullptr != e; e = eit.NextEdge())
+  {
+    m_edge_id.Append(e->m_id);
+    m_edge_tag.Append((unsigned char)e->m_edge_tag);
+    m_edge_face_start.Append(edge_face_count);
+    edge_face_count += e->m_face_count;
+    if (e->IsSharp())
+      bSharpEdges = true;
+  }
+  m_edge_face_start.Append(edge_face_count);
+
+  m_face_id.Reserve(face_count);
+  m_face_edge_start.Reserve(face_count + 1);
+  unsigned int face_edge_count = 0;
+  ON_SubDFaceIterator fit(subd);
+  for (const ON_SubDFace* f = fit.FirstFace(); nullptr != f; f = fit.NextFace())
+  {
+    m_face_id.Append(f->m_id);
+    m_face_edge_start.Append(face_edge_count);
+    face_edge_count += f->m_edge_count;
+  }
+  m_face_edge_start.Append(face_edge_count);
+
+  if (
+    vertex_count != m_vertex_id.UnsignedCount()
+    || edge_count != m_edge_id.UnsignedCount()
+    || face_count != m_face_id.UnsignedCount()
+    )
+  {
+    Destroy();
+    return ON_SUBD_RETURN_ERROR(false);
+  }
+
+  ON_SimpleArray<unsigned int> vertex_index_from_id;
+  ON_SimpleArray<unsigned int> edge_index_from_id;
+  ON_SimpleArray<unsigned int> face_index_from_id;
+  Internal_IndexFromId(m_vertex_id, vertex_index_from_id);
+  Internal_IndexFromId(m_edge_id, edge_index_from_id);
+  Internal_IndexFromId(m_face_id, face_index_from_id);
+
+  // Adjacency
+  bool bDamaged = false;
+
+  m_vertex_edge.Reserve(vertex_edge_count);
+  m_vertex_face.Reserve(vertex_face_count);
+  for (const ON_SubDVertex* v = vit.FirstVertex(); nullptr != v; v = vit.NextVertex())
+  {
+    for (unsigned short vei = 0; vei < v->m_edge_count; vei++)
+    {
+      const ON_SubDEdge* e = v->Edge(vei);
+      const unsigned int ei = Internal_IndexFromComponentId(edge_index_from_id, e);
+      if (ON_UNSET_UINT_INDEX == ei)
+        bDamaged = true;
+      m_vertex_edge.Append((ei << 1) | ((nullptr != e && v == e->m_vertex[1]) ? 1U : 0U));
+    }
+    for (unsigned short vfi = 0; vfi < v->m_face_count; vfi++)
+    {
+      const unsigned int fi = Internal_IndexFromComponentId(face_index_from_id, v->m_faces[vfi]);
+      if (ON_UNSET_UINT_INDEX == fi)
+        bDamaged = true;
+      m_vertex_face.Append(fi);
+    }
+  }
+
+  m_edge_vertex.Reserve(2 * edge_count);
+  m_edge_face.Reserve(edge_face_count);
+  if (bSharpEdges)
+    m_edge_sharpness.Reserve(2 * edge_count);
+  for (const ON_SubDEdge* e = eit.FirstEdge(); nullptr != e; e = eit.NextEdge())
+  {
+    for (unsigned int evi = 0; evi < 2; evi++)
+    {
+      const unsigned int vi = Internal_IndexFromComponentId(vertex_index_from_id, e->m_vertex[evi]);
+      if (ON_UNSET_UINT_INDEX == vi)
+        bDamaged = true;
+      m_edge_vertex.Append(vi);
+    }
+    for (unsigned short efi = 0; efi < e->m_face_count; efi++)
+    {
+      const ON_SubDFacePtr fptr = e->FacePtr(efi);
+      const unsigned int fi = Internal_IndexFromComponentId(face_index_from_id, fptr.Face());
+      if (ON_UNSET_UINT_INDEX == fi)
+        bDamaged = true;
+      m_edge_face.Append((fi << 1) | (unsigned int)fptr.FaceDirection());
+    }
+    if (bSharpEdges)
+    {
+      const ON_SubDEdgeSharpness s = e->Sharpness(false);
+      m_edge_sharpness.Append((float)s.EndSharpness(0));
+      m_edge_sharpness.Append((float)s.EndSharpness(1));
+    }
+  }
+
+  m_face_edge.Reserve(face_edge_count);
+  for (const ON_SubDFace* f = fit.FirstFace(); nullptr != f; f = fit.NextFace())
+  {
+    for (unsigned short fei = 0; fei < f->m_edge_count; fei++)
+    {
+      const ON_SubDEdgePtr eptr = f->EdgePtr(fei);
+      const unsigned int ei = Internal_IndexFromComponentId(edge_index_from_id, eptr.Edge());
+      if (ON_UNSET_UINT_INDEX == ei)
+        bDamaged = true;
+      m_face_edge.Append((ei << 1) | (unsigned int)eptr.EdgeDirection());
+    }
+  }
+
+  if (bDamaged)
+  {
+    Destroy();
+    return ON_SUBD_RETURN_ERROR(false);
+  }
+
+  return true;
+}
+
+bool ON_SubDTopologySnapshot::IsEmpty() const
+{
+  return 0 == m_vertex_id.UnsignedCount();
+}
+
+unsigned int ON_SubDTopologySnapshot::VertexCount() const
+{
+  return m_vertex_id.UnsignedCount();
+}
+
+unsigned int ON_SubDTopologySnapshot::EdgeCount() const
+{
+  return m_edge_id.UnsignedCount();
+}
+
+unsigned int ON_SubDTopologySnapshot::FaceCount() const
+{
+  return m_face_id.UnsignedCount();
+}
+
+size_t ON_SubDTopologySnapshot::SizeOf() const
+{
+  return
+    sizeof(*this)
+    + m_vertex_id.SizeOfArray()
+    + m_vertex_tag.SizeOfArray()
+    + m_x.SizeOfArray()
+    + m_y.SizeOfArray()
+    + m_z.SizeOfArray()
+    + m_vertex_edge_start.SizeOfArray()
+    + m_vertex_edge.SizeOfArray()
+    + m_vertex_face_start.SizeOfArray()
+    + m_vertex_face.SizeOfArray()
+    + m_edge_id.SizeOfArray()
+    + m_edge_tag.SizeOfArray()
+    + m_edge_vertex.SizeOfArray()
+    + m_edge_sharpness.SizeOfArray()
+    + m_edge_face_start.SizeOfArray()
+    + m_edge_face.SizeOfArray()
+    + m_face_id.SizeOfArray()
+    + m_face_edge_start.SizeOfArray()
+    + m_face_edge.SizeOfArray();
+}
+
+ON__UINT64 ON_SubDTopologySnapshot::GeometryContentSerialNumber() const
+{
+  return m_geometry_content_serial_number;
+}
+
+unsigned int ON_SubDTopologySnapshot::VertexId(unsigned int vertex_index) const
+{
+  return (vertex_index < m_vertex_id.UnsignedCount()) ? m_vertex_id[vertex_index] : 0U;
+}
+
+ON_SubDVertexTag ON_SubDTopologySnapshot::VertexTag(unsigned int vertex_index) const
+{
+  return (vertex_index < m_vertex_tag.UnsignedCount()) ? ON_SubD::VertexTagFromUnsigned(m_vertex_tag[vertex_index]) : ON_SubDVertexTag::Unset;
+}
+
+const ON_3dPoint ON_SubDTopologySnapshot::ControlNetPoint(unsigned int vertex_index) const
+{
+  return (vertex_index < m_x.UnsignedCount()) ? ON_3dPoint(m_x[vertex_index], m_y[vertex_index], m_z[vertex_index]) : ON_3dPoint::NanPoint;
+}
+
+const double* ON_SubDTopologySnapshot::ControlNetX() const
+{
+  return m_x.Array();
+}
+
+const double* ON_SubDTopologySnapshot::ControlNetY() const
+{
+  return m_y.Array();
+}
+
+const double* ON_SubDTopologySnapshot::ControlNetZ() const
+{
+  return m_z.Array();
+}
+
+bool ON_SubDTopologySnapshot::GetControlNetPoints(
+  size_t point_stride,
+  double* points
+) const
+{
+  if (point_stride < 3 || nullptr == points)
+    return false;
+  const unsigned int vertex_count = m_x.UnsignedCount();
+  const double* x = m_x.Array();
+  const double* y = m_y.Array();
+  const double* z = m_z.Array();
+  for (unsigned int i = 0; i < vertex_count; i++, points += point_stride)
+  {
+    points[0] = x[i];
+    points[1] = y[i];
+    points[2] = z[i];
+  }
+  return true;
+}
+
+unsigned int ON_SubDTopologySnapshot::VertexEdgeCount(unsigned int vertex_index) const
+{
+  return (vertex_index < m_vertex_id.UnsignedCount()) ? (m_vertex_edge_start[vertex_index + 1] - m_vertex_edge_start[vertex_index]) : 0U;
+}
+
+unsigned int ON_SubDTopologySnapshot::VertexEdge(unsigned int vertex_index, unsigned int i) const
+{
+  return (i < VertexEdgeCount(vertex_index)) ? m_vertex_edge[m_vertex_edge_start[vertex_index] + i] : ON_UNSET_UINT_INDEX;
+}
+
+unsigned int ON_SubDTopologySnapshot::VertexFaceCount(unsigned int vertex_index) const
+{
+  return (vertex_index < m_vertex_id.UnsignedCount()) ? (m_vertex_face_start[vertex_index + 1] - m_vertex_face_start[vertex_index]) : 0U;
+}
+
+unsigned int ON_SubDTopologySnapshot::VertexFace(unsigned int vertex_index, unsigned int i) const
+{
+  return (i < VertexFaceCount(vertex_index)) ? m_vertex_face[m_vertex_face_start[vertex_index] + i] : ON_UNSET_UINT_INDEX;
+}
+
+unsigned int ON_SubDTopologySnapshot::EdgeId(unsigned int edge_index) const
+{
+  return (edge_index < m_edge_id.UnsignedCount()) ? m_edge_id[edge_index] : 0U;
+}
+
+ON_SubDEdgeTag ON_SubDTopologySnapshot::EdgeTag(unsigned int edge_index) const
+{
+  return (edge_index < m_edge_tag.UnsignedCount()) ? ON_SubD::EdgeTagFromUnsigned(m_edge_tag[edge_index]) : ON_SubDEdgeTag::Unset;
+}
+
+const ON_SubDEdgeSharpness ON_SubDTopologySnapshot::EdgeSharpness(unsigned int edge_index) const
+{
+  if (edge_index < m_edge_id.UnsignedCount() && 2 * m_edge_id.UnsignedCount() == m_edge_sharpness.UnsignedCount())
+    return ON_SubDEdgeSharpness::FromInterval(m_edge_sharpness[2 * edge_index], m_edge_sharpness[2 * edge_index + 1]);
+  return ON_SubDEdgeSharpness::Smooth;
+}
+
+unsigned int ON_SubDTopologySnapshot::EdgeVertex(unsigned int edge_index, unsigned int evi) const
+{
+  return (edge_index < m_edge_id.UnsignedCount() && evi < 2) ? m_edge_vertex[2 * edge_index + evi] : ON_UNSET_UINT_INDEX;
+}
+
+unsigned int ON_SubDTopologySnapshot::EdgeFaceCount(unsigned int edge_index) const
+{
+  return (edge_index < m_edge_id.UnsignedCount()) ? (m_edge_face_start[edge_index + 1] - m_edge_face_start[edge_index]) : 0U;
+}
+
+unsigned int ON_SubDTopologySnapshot::EdgeFace(unsigned int edge_index, unsigned int i) const
+{
+  return (i < EdgeFaceCount(edge_index)) ? m_edge_face[m_edge_face_start[edge_index] + i] : ON_UNSET_UINT_INDEX;
+}
+
+unsigned int ON_SubDTopologySnapshot::FaceId(unsigned int face_index) const
+{
+  return (face_index < m_face_id.UnsignedCount()) ? m_face_id[face_index] : 0U;
+}
+
+unsigned int ON_SubDTopologySnapshot::FaceEdgeCount(unsigned int face_index) const
+{
+  return (face_index < m_face_id.UnsignedCount()) ? (m_face_edge_start[face_index + 1] - m_face_edge_start[face_index]) : 0U;
+}
+
+unsigned int ON_SubDTopologySnapshot::FaceEdge(unsigned int face_index, unsigned int i) const
+{
+  return (i < FaceEdgeCount(face_index)) ? m_face_edge[m_face_edge_start[face_index] + i] : ON_UNSET_UINT_INDEX;
+}
+
+unsigned int ON_SubDTopologySnapshot::FaceVertex(unsigned int face_index, unsigned int i) const
+{
+  const unsigned int fe = FaceEdge(face_index, i);
+  return (ON_UNSET_UINT_INDEX != fe) ? m_edge_vertex[2 * (fe >> 1) + (fe & 1U)] : ON_UNSET_UINT_INDEX;
+}
+
+ON_SubD* ON_SubDTopologySnapshot::ToSubD(
+  ON_SubD* destination_subd
+) const
+{
+  if (nullptr != destination_subd)
+    destination_subd->Destroy();
+
+  const unsigned int vertex_count = VertexCount();
+  const unsigned int edge_count = EdgeCount();
+  const unsigned int face_count = FaceCount();
+  if (0 == vertex_count)
+    return nullptr;
+
+  ON_SubD* subd
+    = (nullptr != destination_subd)
+    ? destination_subd
+    : new ON_SubD();
+
+  ON_SimpleArray<ON_SubDVertex*> vertices(vertex_count);
+  ON_SimpleArray<ON_SubDEdge*> edges(edge_count);
+  ON_SimpleArray<ON_SubDEdgePtr> face_edges(ON_SubDFace::MaximumEdgeCount);
+
+  bool rc = true;
+  for (unsigned int vi = 0; vi < vertex_count && rc; vi++)
+  {
+    const double P[3] = { m_x[vi], m_y[vi], m_z[vi] };
+    ON_SubDVertex* v = subd->AddVertexForExperts(m_vertex_id[vi], VertexTag(vi), P, VertexEdgeCount(vi), VertexFaceCount(vi));
+    vertices.Append(v);
+    rc = (nullptr != v);
+  }
+
+  const bool bSharpEdges = (2 * edge_count == m_edge_sharpness.UnsignedCount());
+  for (unsigned int ei = 0; ei < edge_count && rc; ei++)
+  {
+    const unsigned int vi0 = m_edge_vertex[2 * ei];
+    const unsigned int vi1 = m_edge_vertex[2 * ei + 1];
+    if (vi0 >= vertex_count || vi1 >= vertex_count)
+    {
+      rc = false;
+      break;
+    }
+    const ON_SubDEdgeTag edge_tag = EdgeTag(ei);
+    ON_SubDEdge* e = subd->AddEdgeForExperts(
+      m_edge_id[ei],
+      edge_tag,
+      vertices[vi0],
+      ON_SubDSectorType::UnsetSectorCoefficient,
+      vertices[vi1],
+      ON_SubDSectorType::UnsetSectorCoefficient,
+      EdgeFaceCount(ei)
+    );
+    edges.Append(e);
+    rc = (nullptr != e);
+    if (rc && bSharpEdges && ON_SubDEdgeTag::Crease != edge_tag)
+    {
+      const ON_SubDEdgeSharpness s = EdgeSharpness(ei);
+      if (s.IsSharp())
+        e->SetSharpnessForExperts(s);
+    }
+  }
+
+  for (unsigned int fi = 0; fi < face_count && rc; fi++)
+  {
+    const unsigned int face_edge_count = FaceEdgeCount(fi);
+    face_edges.SetCount(0);
+    for (unsigned int i = 0; i < face_edge_count; i++)
+    {
+      const unsigned int fe = m_face_edge[m_face_edge_start[fi] + i];
+      if ((fe >> 1) >= edge_count)
+        break;
+      face_edges.Append(ON_SubDEdgePtr::Create(edges[fe >> 1], fe & 1U));
+    }
+    rc = face_edge_count == face_edges.UnsignedCount()
+      && nullptr != subd->AddFaceForExperts(m_face_id[fi], face_edges.Array(), face_edges.UnsignedCount());
+  }
+
+  if (false == rc)
+  {
+    if (subd != destination_subd)
+      delete subd;
+    else
+      subd->Destroy();
+    return ON_SUBD_RETURN_ERROR(nullptr);
+  }
+
+  subd->UpdateAllTagsAndSectorCoefficients(true);
+  return subd;
+}
+
+bool ON_SubDTopologySnapshot::Write(
+  ON_BinaryArchive& archive
+) const
+{
+  const int chunk_version = 1;
+  if (false == archive.BeginWrite3dmAnonymousChunk(chunk_version))
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    const unsigned int vertex_count = VertexCount();
+    const unsigned int edge_count = EdgeCount();
+    const unsigned int face_count = FaceCount();
+    const unsigned int vertex_edge_count = m_vertex_edge.UnsignedCount();
+    const unsigned int vertex_face_count = m_vertex_face.UnsignedCount();
+    const unsigned int edge_face_count = m_edge_face.UnsignedCount();
+    const unsigned int face_edge_count = m_face_edge.UnsignedCount();
+    const bool bSharpEdges = (edge_count > 0 && 2 * edge_count == m_edge_sharpness.UnsignedCount());
+
+    if (!archive.WriteInt(vertex_count))
+      break;
+    if (!archive.WriteInt(edge_count))
+      break;
+    if (!archive.WriteInt(face_count))
+      break;
+    if (!archive.WriteInt(vertex_edge_count))
+      break;
+    if (!archive.WriteInt(vertex_face_count))
+      break;
+    if (!archive.WriteInt(edge_face_count))
+      break;
+    if (!archive.WriteInt(face_edge_count))
+      break;
+    if (!archive.WriteBool(bSharpEdges))
+      break;
+    if (0 == vertex_count)
+    {
+      rc = true;
+      break;
+    }
+
+    if (!archive.WriteInt(vertex_count, m_vertex_id.Array()))
+      break;
+    if (!archive.WriteChar(vertex_count, m_vertex_tag.Array()))
+      break;
+    if (!archive.WriteDouble(vertex_count, m_x.Array()))
+      break;
+    if (!archive.WriteDouble(vertex_count, m_y.Array()))
+      break;
+    if (!archive.WriteDouble(vertex_count, m_z.Array()))
+      break;
+    if (!archive.WriteInt(vertex_count + 1, m_vertex_edge_start.Array()))
+      break;
+    if (!archive.WriteInt(vertex_edge_count, m_vertex_edge.Array()))
+      break;
+    if (!archive.WriteInt(vertex_count + 1, m_vertex_face_start.Array()))
+      break;
+    if (!archive.WriteInt(vertex_face_count, m_vertex_face.Array()))
+      break;
+
+    if (!archive.WriteInt(edge_count, m_edge_id.Array()))
+      break;
+    if (!archive.WriteChar(edge_count, m_edge_tag.Array()))
+      break;
+    if (!archive.WriteInt(2 * edge_count, m_edge_vertex.Array()))
+      break;
+    if (bSharpEdges && !archive.WriteFloat(2 * edge_count, m_edge_sharpness.Array()))
+      break;
+    if (!archive.WriteInt(edge_count + 1, m_edge_face_start.Array()))
+      break;
+    if (!archive.WriteInt(edge_face_count, m_edge_face.Array()))
+      break;
+
+    if (!archive.WriteInt(face_count, m_face_id.Array()))
+      break;
+    if (!archive.WriteInt(face_count + 1, m_face_edge_start.Array()))
+      break;
+    if (!archive.WriteInt(face_edge_count, m_face_edge.Array()))
+      break;
+
+    rc = true;
+    break;
+  }
+
+  if (!archive.EndWrite3dmChunk())
+    rc = false;
+
+  return rc;
+}
+
+static bool Internal_SnapshotCountFitsInChunk(
+  ON_BinaryArchive& archive,
+  const ON_3DM_BIG_CHUNK& chunk,
+  ON__UINT64 count,
+  ON__UINT64 element_size
+)
+{
+  // Counts come from the archive. A damaged archive must not cause a
+  // huge allocation before the read fails, so count elements must fit
+  // in what is left of the chunk.
+  const ON__UINT64 pos = archive.CurrentPosition();
+  if (pos > chunk.m_end_offset)
+    return false;
+  return (count <= (chunk.m_end_offset - pos) / element_size);
+}
+
+static bool Internal_ReadSnapshotBytes(
+  ON_BinaryArchive& archive,
+  const ON_3DM_BIG_CHUNK& chunk,
+  unsigned int count,
+  ON_SimpleArray<unsigned char>& a
+)
+{
+  if (false == Internal_SnapshotCountFitsInChunk(archive, chunk, count, sizeof(a[0])))
+    return false;
+  a.Reserve(count);
+  a.SetCount(count);
+  return (0 == count) || archive.ReadChar(count, a.Array());
+}
+
+static bool Internal_ReadSnapshotInts(
+  ON_BinaryArchive& archive,
+  const ON_3DM_BIG_CHUNK& chunk,
+  unsigned int count,
+  ON_SimpleArray<unsigned int>& a
+)
+{
+  if (false == Internal_SnapshotCountFitsInChunk(archive, chunk, count, sizeof(a[0])))
+    return false;
+  a.Reserve(count);
+  a.SetCount(count);
+  return (0 == count) || archive.ReadInt(count, a.Array());
+}
+
+static bool Internal_ReadSnapshotDoubles(
+  ON_BinaryArchive& archive,
+  const ON_3DM_BIG_CHUNK& chunk,
+  unsigned int count,
+  ON_SimpleArray<double>& a
+)
+{
+  if (false == Internal_SnapshotCountFitsInChunk(archive, chunk, count, sizeof(a[0])))
+    return false;
+  a.Reserve(count);
+  a.SetCount(count);
+  return (0 == count) || archive.ReadDouble(count, a.Array());
+}
+
+static bool Internal_IsValidSnapshotStart(
+  const ON_SimpleArray<unsigned int>& start,
+  unsigned int count
+)
+{
+  const unsigned int start_count = start.UnsignedCount();
+  if (0 == start_count || 0 != start[0] || count != start[start_count - 1])
+    return false;
+  for (unsigned int i = 1; i < start_count; i++)
+  {
+    if (start[i] < start[i - 1])
+      return false;
+  }
+  return true;
+}
+
+static bool Internal_IsValidSnapshotIndex(
+  const ON_SimpleArray<unsigned int>& index,
+  unsigned int shift,
+  unsigned int count
+)
+{
+  // Every (index[i] >> shift) must be < count.
+  const unsigned int index_count = index.UnsignedCount();
+  const unsigned int* a = index.Array();
+  for (unsigned int i = 0; i < index_count; i++)
+  {
+    if ((a[i] >> shift) >= count)
+      return false;
+  }
+  return true;
+}
+
+bool ON_SubDTopologySnapshot::Read(
+  ON_BinaryArchive& archive
+)
+{
+  Destroy();
+
+  int chunk_version = 0;
+  if (false == archive.BeginRead3dmAnonymousChunk(&chunk_version))
+    return false;
+
+  ON_3DM_BIG_CHUNK chunk;
+  archive.GetCurrentChunk(chunk);
+
+  bool rc = false;
+  for (;;)
+  {
+    if (chunk_version <= 0)
+      break;
+
+    unsigned int vertex_count = 0;
+    unsigned int edge_count = 0;
+    unsigned int face_count = 0;
+    unsigned int vertex_edge_count = 0;
+    unsigned int vertex_face_count = 0;
+    unsigned int edge_face_count = 0;
+    unsigned int face_edge_count = 0;
+    bool bSharpEdges = false;
+
+    if (!archive.ReadInt(&vertex_count))
+      break;
+    if (!archive.ReadInt(&edge_count))
+      break;
+    if (!archive.ReadInt(&face_count))
+      break;
+    if (!archive.ReadInt(&vertex_edge_count))
+      break;
+    if (!archive.ReadInt(&vertex_face_count))
+      break;
+    if (!archive.ReadInt(&edge_face_count))
+      break;
+    if (!archive.ReadInt(&face_edge_count))
+      break;
+    if (!archive.ReadBool(&bSharpEdges))
+      break;
+    if (0 == vertex_count)
+    {
+      rc = true;
+      break;
+    }
+    // 2*index + direction must fit in an unsigned int.
+    if (vertex_count > 0x7FFFFFFFU || edge_count > 0x7FFFFFFFU || face_count > 0x7FFFFFFFU)
+      break;
+
+    if (!Internal_ReadSnapshotInts(archive, chunk, vertex_count, m_vertex_id))
+      break;
+    if (!Internal_ReadSnapshotBytes(archive, chunk, vertex_count, m_vertex_tag))
+      break;
+    if (!Internal_ReadSnapshotDoubles(archive, chunk, vertex_count, m_x))
+      break;
+    if (!Internal_ReadSnapshotDoubles(archive, chunk, vertex_count, m_y))
+      break;
+    if (!Internal_ReadSnapshotDoubles(archive, chunk, vertex_count, m_z))
+      break;
+    if (!Internal_ReadSnapshotInts(archive, chunk, vertex_count + 1, m_vertex_edge_start))
+      break;
+    if (!Internal_ReadSnapshotInts(archive, chunk, vertex_edge_count, m_vertex_edge))
+      break;
+    if (!Internal_ReadSnapshotInts(archive, chunk, vertex_count + 1, m_vertex_face_start))
+      break;
+    if (!Internal_ReadSnapshotInts(archive, chunk, vertex_face_count, m_vertex_face))
+      break;
+
+    if (!Internal_ReadSnapshotInts(archive, chunk, edge_count, m_edge_id))
+      break;
+    if (!Internal_ReadSnapshotBytes(archive, chunk, edge_count, m_edge_tag))
+      break;
+    if (!Internal_ReadSnapshotInts(archive, chunk, 2 * edge_count, m_edge_vertex))
+      break;
+    if (bSharpEdges)
+    {
+      if (false == Internal_SnapshotCountFitsInChunk(archive, chunk, 2 * (ON__UINT64)edge_count, sizeof(m_edge_sharpness[0])))
+        break;
+      m_edge_sharpness.Reserve(2 * edge_count);
+      m_edge_sharpness.SetCount(2 * edge_count);
+      if (!archive.ReadFloat(2 * edge_count, m_edge_sharpness.Array()))
+        break;
+    }
+    if (!Internal_ReadSnapshotInts(archive, chunk, edge_count + 1, m_edge_face_start))
+      break;
+    if (!Internal_ReadSnapshotInts(archive, chunk, edge_face_count, m_edge_face))
+      break;
+
+    if (!Internal_ReadSnapshotInts(archive, chunk, face_count, m_face_id))
+      break;
+    if (!Internal_ReadSnapshotInts(archive, chunk, face_count + 1, m_face_edge_start))
+      break;
+    if (!Internal_ReadSnapshotInts(archive, chunk, face_edge_count, m_face_edge))
+      break;
+
+    // The CSR offsets must be consistent with the array sizes.
+    if (
+      false == Internal_IsValidSnapshotStart(m_vertex_edge_start, vertex_edge_count)
+      || false == Internal_IsValidSnapshotStart(m_vertex_face_start, vertex_face_count)
+      || false == Internal_IsValidSnapshotStart(m_edge_face_start, edge_face_count)
+      || false == Internal_IsValidSnapshotStart(m_face_edge_start, face_edge_count)
+      )
+      break;
+
+    // The accessors do not check the stored indices. m_vertex_edge[],
+    // m_edge_face[] and m_face_edge[] values are 2*index + direction.
+    if (
+      false == Internal_IsValidSnapshotIndex(m_vertex_edge, 1, edge_count)
+      || false == Internal_IsValidSnapshotIndex(m_vertex_face, 0, face_count)
+      || false == Internal_IsValidSnapshotIndex(m_edge_vertex, 0, vertex_count)
+      || false == Internal_IsValidSnapshotIndex(m_edge_face, 1, face_count)
+      || false == Internal_IsValidSnapshotIndex(m_face_edge, 1, edge_count)
+      )
+      break;
+
+    rc = true;
+    break;
+  }
+
+  if (!archive.EndRead3dmChunk())
+    rc = false;
+
+  if (false == rc)
+    Destroy();
+
+  return rc;
+}
@@ -0,0 +1,527 @@
+//
+// Copyright (c) 1993-2022 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+
+#include "opennurbs.h"
+
+#if !defined(ON_COMPILING_OPENNURBS)
+// This check is included in all opennurbs source .c and .cpp files to insure
+// ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
+// When opennurbs source is being compiled, ON_COMPILING_OPENNURBS is defined
+// and the opennurbs .h files alter what is declared and how it is declared.
+#error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
+#endif
+
+#include "opennurbs_subd_data.h"
+
+/*
+  How the stencils are calculated:
+
+  The surface point and tangents at a vertex are m_LP, m_L1, m_L2 from the
+  sector's ON_SubDMatrix applied to the sector point ring. The point ring
+  is either the control net points around the vertex or their subdivision
+  points, so it is a linear function of the control net points of the
+  vertices on the faces and edges around the vertex (the vertex "support").
+
+  The weights are found by probing a private copy of the SubD. The vertices
+  are colored so no two vertices in the same support share a color. For each
+  color, the probe control net points are set to 1 for vertices with that
+  color and 0 otherwise. Every point ring is then evaluated and the resulting
+  value is the weight of the one support vertex with that color.
+*/
+
+class ON_SubDSurfacePointStencilVertex
+{
+public:
+  const ON_SubDVertex* m_vertex = nullptr;
+  const ON_SubDMatrix* m_SM = nullptr;
+  ON_SubDSectorIterator m_sit;
+};
+
+static unsigned int Internal_AppendSupport(
+  ON_SimpleArray<unsigned int>& support,
+  unsigned int support0,
+  unsigned int vertex_index
+)
+{
+  for (unsigned int i = support0; i < support.UnsignedCount(); i++)
+  {
+    if (vertex_index == support[i])
+      return i;
+  }
+  support.Append(vertex_index);
+  return support.UnsignedCount() - 1;
+}
+
+void ON_SubDSurfacePointStencils::Destroy()
+{
+  m_topology_hash = ON_SHA1_Hash::ZeroDigest;
+  m_vertex_id.Destroy();
+  m_stencil_start.Destroy();
+  m_stencil_index.Destroy();
+  m_stencil_weight.Destroy();
+  m_corner_sector.Destroy();
+}
+
+unsigned int ON_SubDSurfacePointStencils::VertexCount() const
+{
+  return m_vertex_id.UnsignedCount();
+}
+
+unsigned int ON_SubDSurfacePointStencils::StencilWeightCount() const
+{
+  return m_stencil_index.UnsignedCount();
+}
+
+unsigned int ON_SubDSurfacePointStencils::VertexId(
+  unsigned int vertex_index
+) const
+{
+  return (vertex_index < m_vertex_id.UnsignedCount()) ? m_vertex_id[vertex_index] : 0U;
+}
+
+bool ON_SubDSurfacePointStencils::IsValidFor(
+  const ON_SubD& subd
+) const
+{
+  const unsigned int vertex_count = m_vertex_id.UnsignedCount();
+  if (0 == vertex_count || vertex_count != subd.VertexCount())
+    return false;
+  if (m_topology_hash != subd.SubDHash(ON_SubDHashType::TopologyAndEdgeCreases, false).SubDHash())
+    return false;
+
+  // Corner sector coefficients depend on the snapped angle between the
+  // corner's crease edges, which changes when control net points move.
+  const unsigned int corner_sector_count = m_corner_sector.UnsignedCount() / 3;
+  if (corner_sector_count > 0)
+  {
+    const unsigned int* cs = m_corner_sector.Array();
+    const unsigned int* cs1 = cs + 3 * corner_sector_count;
+    unsigned int vertex_index = 0;
+    ON_SubDVertexIterator vit(subd);
+    for (const ON_SubDVertex* v = vit.FirstVertex(); nullptr != v && cs < cs1; v = vit.NextVertex(), vertex_index++)
+    {
+      for (/*empty*/; cs < cs1 && vertex_index == cs[0]; cs += 3)
+      {
+        if (v->m_id != m_vertex_id[vertex_index] || cs[1] >= v->m_face_count)
+          return false;
+        const ON_SubDSectorType sector_type = ON_SubDSectorType::Create(v->m_faces[cs[1]], v);
+        if (false == sector_type.IsValid() || cs[2] != sector_type.CornerSectorAngleIndex())
+          return false;
+      }
+    }
+    if (cs < cs1)
+      return false;
+  }
+
+  return true;
+}
+
+bool ON_SubDSurfacePointStencils::Create(
+  const ON_SubD& subd
+)
+{
+  Destroy();
+
+  const unsigned int vertex_count = subd.VertexCount();
+  if (0 == vertex_count)
+    return false;
+
+  // vertex ids in iterator order
+  unsigned int max_id = 0;
+  m_vertex_id.Reserve(vertex_count);
+  ON_SubDVertexIterator vit(subd);
+  for (const ON_SubDVertex* v = vit.FirstVertex(); nullptr != v; v = vit.NextVertex())
+  {
+    m_vertex_id.Append(v->m_id);
+    if (v->m_id > max_id)
+      max_id = v->m_id;
+  }
+  if (vertex_count != m_vertex_id.UnsignedCount())
+  {
+    Destroy();
+    return ON_SUBD_RETURN_ERROR(false);
+  }
+
+  ON_SimpleArray<unsigned int> index_from_id(max_id + 1);
+  index_from_id.SetCount(max_id + 1);
+  for (unsigned int i = 0; i <= max_id; i++)
+    index_from_id[i] = ON_UNSET_UINT_INDEX;
+  for (unsigned int i = 0; i < vertex_count; i++)
+    index_from_id[m_vertex_id[i]] = i;
+
+  // The probe copy has its control net points overwritten below.
+  ON_SubD probe(subd);
+  ON_SimpleArray<ON_SubDSurfacePointStencilVertex> sv(vertex_count);
+  sv.SetCount(vertex_count);
+  for (unsigned int i = 0; i < vertex_count; i++)
+    sv[i] = ON_SubDSurfacePointStencilVertex();
+
+  ON_SubDVertexIterator probe_vit(probe);
+  for (const ON_SubDVertex* v = probe_vit.FirstVertex(); nullptr != v; v = probe_vit.NextVertex())
+  {
+    const unsigned int i = (v->m_id <= max_id) ? index_from_id[v->m_id] : ON_UNSET_UINT_INDEX;
+    if (i >= vertex_count || nullptr != sv[i].m_vertex)
+    {
+      Destroy();
+      return ON_SUBD_RETURN_ERROR(false);
+    }
+    sv[i].m_vertex = v;
+  }
+  for (unsigned int i = 0; i < vertex_count; i++)
+  {
+    if (nullptr == sv[i].m_vertex)
+    {
+      Destroy();
+      return ON_SUBD_RETURN_ERROR(false);
+    }
+  }
+
+  // Get the sector and subdivision matrix for each vertex while the probe
+  // has the original control net points. This matches the sector used by
+  // ON_SubDVertex::SurfacePoint().
+  unsigned int max_R = 0;
+  for (unsigned int i = 0; i < vertex_count; i++)
+  {
+    ON_SubDSurfacePointStencilVertex& s = sv[i];
+    if (nullptr == s.m_vertex || 0 == s.m_vertex->m_face_count)
+      continue;
+    if (nullptr == s.m_sit.Initialize(s.m_vertex))
+      continue;
+    s.m_sit.IncrementToCrease(-1);
+    const ON_SubDSectorType sector_type = ON_SubDSectorType::Create(s.m_sit);
+    if (false == sector_type.IsValid())
+      continue;
+    const unsigned int R = sector_type.PointRingCount();
+    if (R < 3)
+      continue;
+    const ON_SubDMatrix& SM = ON_SubDMatrix::FromCache(sector_type);
+    if (R != SM.m_R || nullptr == SM.m_LP || nullptr == SM.m_L1 || nullptr == SM.m_L2)
+      continue;
+    s.m_SM = &SM;
+    if (R > max_R)
+      max_R = R;
+  }
+
+  // support[support_start[i],...,support_start[i+1]-1] = indices of the vertices
+  // whose control net points can change the point ring of vertex i.
+  ON_SimpleArray<unsigned int> support_start(vertex_count + 1);
+  ON_SimpleArray<unsigned int> support(16 * vertex_count);
+  for (unsigned int i = 0; i < vertex_count; i++)
+  {
+    const unsigned int support0 = support.UnsignedCount();
+    support_start.Append(support0);
+    const ON_SubDVertex* v = sv[i].m_vertex;
+    support.Append(i);
+    for (unsigned short vei = 0; vei < v->m_edge_count; vei++)
+    {
+      const ON_SubDVertex* v1 = v->Edge(vei) ? v->Edge(vei)->OtherEndVertex(v) : nullptr;
+      if (nullptr != v1 && v1->m_id <= max_id && index_from_id[v1->m_id] < vertex_count)
+        Internal_AppendSupport(support, support0, index_from_id[v1->m_id]);
+    }
+    for (unsigned short vfi = 0; vfi < v->m_face_count; vfi++)
+    {
+      const ON_SubDFace* f = v->m_faces[vfi];
+      if (nullptr == f)
+        continue;
+      for (unsigned int fvi = 0; fvi < f->m_edge_count; fvi++)
+      {
+        const ON_SubDVertex* v1 = f->Vertex(fvi);
+        if (nullptr != v1 && v1->m_id <= max_id && index_from_id[v1->m_id] < vertex_count)
+          Internal_AppendSupport(support, support0, index_from_id[v1->m_id]);
+      }
+    }
+  }
+  support_start.Append(support.UnsignedCount());
+
+  // Greedy coloring. Two vertices get different colors when they
+  // are in the support of the same vertex. Supports are symmetric
+  // (vertices that share a face or edge), so the vertices that
+  // conflict with j are the supports of the vertices in the support of j.
+  ON_SimpleArray<unsigned int> color(vertex_count);
+  color.SetCount(vertex_count);
+  for (unsigned int j = 0; j < vertex_count; j++)
+    color[j] = ON_UNSET_UINT_INDEX;
+  ON_SimpleArray<unsigned int> color_stamp(64);
+  unsigned int color_count = 0;
+  for (unsigned int j = 0; j < vertex_count; j++)
+  {
+    for (unsigned int a = support_start[j]; a < support_start[j + 1]; a++)
+    {
+      const unsigned int v = support[a];
+      for (unsigned int b = support_start[v]; b < support_start[v + 1]; b++)
+      {
+        const unsigned int c = color[support[b]];
+        if (c < color_count)
+          color_stamp[c] = j;
+      }
+    }
+    unsigned int c = 0;
+    while (c < color_count && j == color_stamp[c])
+      c++;
+    if (c == color_count)
+    {
+      color_stamp.Append(ON_UNSET_UINT_INDEX);
+      color_count++;
+    }
+    color[j] = c;
+  }
+
+  // weight[3*a], weight[3*a+1], weight[3*a+2] = point, tangent1 and tangent2 weights of support[a]
+  ON_SimpleArray<double> weight(3 * support.UnsignedCount());
+  weight.SetCount(3 * support.UnsignedCount());
+  weight.Zero();
+  ON_SimpleArray<bool> bFailed(vertex_count);
+  bFailed.SetCount(vertex_count);
+  for (unsigned int i = 0; i < vertex_count; i++)
+    bFailed[i] = (nullptr == sv[i].m_SM);
+
+  ON_SimpleArray<ON_3dPoint> point_ring(max_R);
+  point_ring.SetCount(max_R);
+
+  for (unsigned int c = 0; c < color_count; c++)
+  {
+    for (unsigned int i = 0; i < vertex_count; i++)
+    {
+      ON_SubDVertex* v = const_cast<ON_SubDVertex*>(sv[i].m_vertex);
+      if (nullptr == v)
+        continue;
+      v->m_P[0] = (c == color[i]) ? 1.0 : 0.0;
+      v->m_P[1] = 0.0;
+      v->m_P[2] = 0.0;
+    }
+
+    // Clear saved subdivision points without calling ClearEvaluationCache(),
+    // which would recalculate corner sector coefficients from the probe points.
+    {
+      ON_SubDVertexIterator it(probe);
+      for (const ON_SubDVertex* v = it.FirstVertex(); nullptr != v; v = it.NextVertex())
+        v->ClearSavedSubdivisionPoints();
+      ON_SubDEdgeIterator eit(probe);
+      for (const ON_SubDEdge* e = eit.FirstEdge(); nullptr != e; e = eit.NextEdge())
+        e->ClearSavedSubdivisionPoints();
+      ON_SubDFaceIterator fit(probe);
+      for (const ON_SubDFace* f = fit.FirstFace(); nullptr != f; f = fit.NextFace())
+        f->ClearSavedSubdivisionPoints();
+    }
+
+    for (unsigned int i = 0; i < vertex_count; i++)
+    {
+      if (bFailed[i])
+        continue;
+      const ON_SubDSurfacePointStencilVertex& s = sv[i];
+      const unsigned int R = s.m_SM->m_R;
+      if (R != ON_SubD::GetSectorPointRing(true, s.m_sit, &point_ring[0].x, R, 3))
+      {
+        bFailed[i] = true;
+        continue;
+      }
+      double L[3] = {};
+      for (unsigned int r = 0; r < R; r++)
+      {
+        const double x = point_ring[r].x;
+        L[0] += s.m_SM->m_LP[r] * x;
+        L[1] += s.m_SM->m_L1[r] * x;
+        L[2] += s.m_SM->m_L2[r] * x;
+      }
+      unsigned int a = support_start[i];
+      while (a < support_start[i + 1] && c != color[support[a]])
+        a++;
+      if (a < support_start[i + 1])
+      {
+        weight[3 * a] = L[0];
+        weight[3 * a + 1] = L[1];
+        weight[3 * a + 2] = L[2];
+      }
+      else if (0.0 != L[0] || 0.0 != L[1] || 0.0 != L[2])
+      {
+        // point ring depends on a vertex outside the support
+        bFailed[i] = true;
+      }
+    }
+  }
+
+  // pack the nonzero weights
+  m_stencil_start.Reserve(vertex_count + 1);
+  m_stencil_index.Reserve(support.UnsignedCount());
+  m_stencil_weight.Reserve(3 * support.UnsignedCount());
+  for (unsigned int i = 0; i < vertex_count; i++)
+  {
+    m_stencil_start.Append(m_stencil_index.UnsignedCount());
+    if (bFailed[i])
+      continue;
+    for (unsigned int a = support_start[i]; a < support_start[i + 1]; a++)
+    {
+      const double* w = &weight[3 * a];
+      if (0.0 == w[0] && 0.0 == w[1] && 0.0 == w[2])
+        continue;
+      m_stencil_index.Append(support[a]);
+      m_stencil_weight.Append(3, w);
+    }
+  }
+  m_stencil_start.Append(m_stencil_index.UnsignedCount());
+
+  for (unsigned int i = 0; i < vertex_count; i++)
+  {
+    const ON_SubDVertex* v = sv[i].m_vertex;
+    if (ON_SubDVertexTag::Corner != v->m_vertex_tag)
+      continue;
+    const ON_SubDVertex* v0 = subd.VertexFromId(v->m_id);
+    for (unsigned short vfi = 0; nullptr != v0 && vfi < v0->m_face_count; vfi++)
+    {
+      const ON_SubDSectorType sector_type = ON_SubDSectorType::Create(v0->m_faces[vfi], v0);
+      if (false == sector_type.IsValid())
+        continue;
+      m_corner_sector.Append(i);
+      m_corner_sector.Append(vfi);
+      m_corner_sector.Append(sector_type.CornerSectorAngleIndex());
+    }
+  }
+
+  m_topology_hash = subd.SubDHash(ON_SubDHashType::TopologyAndEdgeCreases, false).SubDHash();
+
+  return true;
+}
+
+class ON_SubDSurfacePointStencilsContext
+{
+public:
+  const unsigned int* m_stencil_start = nullptr;
+  const unsigned int* m_stencil_index = nullptr;
+  const double* m_stencil_weight = nullptr;
+  size_t m_control_point_stride = 0;
+  const double* m_control_points = nullptr;
+  size_t m_surface_point_stride = 0;
+  double* m_surface_points = nullptr;
+  size_t m_surface_normal_stride = 0;
+  double* m_surface_normals = nullptr;
+};
+
+static void Internal_EvaluateSurfacePointStencils(
+  ON__UINT_PTR context,
+  unsigned int thread_index,
+  size_t i0,
+  size_t i1
+)
+{
+  const ON_SubDSurfacePointStencilsContext& ctx = *((const ON_SubDSurfacePointStencilsContext*)context);
+  const size_t cp_stride = ctx.m_control_point_stride;
+  for (size_t i = i0; i < i1; i++)
+  {
+    const unsigned int j0 = ctx.m_stencil_start[i];
+    const unsigned int j1 = ctx.m_stencil_start[i + 1];
+    double* P = ctx.m_surface_points + i * ctx.m_surface_point_stride;
+    double* N = (nullptr != ctx.m_surface_normals) ? (ctx.m_surface_normals + i * ctx.m_surface_normal_stride) : nullptr;
+    if (j0 == j1)
+    {
+      P[0] = P[1] = P[2] = ON_DBL_QNAN;
+      if (nullptr != N)
+        N[0] = N[1] = N[2] = ON_DBL_QNAN;
+      continue;
+    }
+
+    double L[3][3] = {};
+    const double* w = ctx.m_stencil_weight + 3 * (size_t)j0;
+    for (unsigned int j = j0; j < j1; j++, w += 3)
+    {
+      const double* C = ctx.m_control_points + ctx.m_stencil_index[j] * cp_stride;
+      L[0][0] += w[0] * C[0]; L[0][1] += w[0] * C[1]; L[0][2] += w[0] * C[2];
+      L[1][0] += w[1] * C[0]; L[1][1] += w[1] * C[1]; L[1][2] += w[1] * C[2];
+      L[2][0] += w[2] * C[0]; L[2][1] += w[2] * C[1]; L[2][2] += w[2] * C[2];
+    }
+
+    P[0] = L[0][0];
+    P[1] = L[0][1];
+    P[2] = L[0][2];
+
+    if (nullptr != N)
+    {
+      ON_3dVector V = ON_CrossProduct(ON_3dVector(L[1]), ON_3dVector(L[2]));
+      if (false == V.Unitize())
+        V = ON_3dVector::ZeroVector;
+      N[0] = V.x;
+      N[1] = V.y;
+      N[2] = V.z;
+    }
+  }
+}
+
+bool ON_SubDSurfacePointStencils::Evaluate(
+  size_t control_point_stride,
+  const double* control_points,
+  size_t surface_point_stride,
+  double* surface_points,
+  size_t surface_normal_stride,
+  double* surface_normals,
+  bool bParallel
+) const
+{
+  const unsigned int vertex_count = m_vertex_id.UnsignedCount();
+  if (0 == vertex_count || vertex_count + 1 != m_stencil_start.UnsignedCount())
+    return false;
+  if (control_point_stride < 3 || nullptr == control_points)
+    return ON_SUBD_RETURN_ERROR(false);
+  if (surface_point_stride < 3 || nullptr == surface_points)
+    return ON_SUBD_RETURN_ERROR(false);
+  if (nullptr != surface_normals && surface_normal_stride < 3)
+    return ON_SUBD_RETURN_ERROR(false);
+
+  ON_SubDSurfacePointStencilsContext ctx;
+  ctx.m_stencil_start = m_stencil_start.Array();
+  ctx.m_stencil_index = m_stencil_index.Array();
+  ctx.m_stencil_weight = m_stencil_weight.Array();
+  ctx.m_control_point_stride = control_point_stride;
+  ctx.m_control_points = control_points;
+  ctx.m_surface_point_stride = surface_point_stride;
+  ctx.m_surface_points = surface_points;
+  ctx.m_surface_normal_stride = surface_normal_stride;
+  ctx.m_surface_normals = surface_normals;
+
+  ON_ParallelFor(vertex_count, 0x1000, bParallel ? 0U : 1U, Internal_EvaluateSurfacePointStencils, (ON__UINT_PTR)&ctx);
+  return true;
+}
+
+bool ON_SubDSurfacePointStencils::Evaluate(
+  const ON_SubD& subd,
+  ON_SimpleArray<ON_3dPoint>& surface_points,
+  ON_SimpleArray<ON_3dVector>* surface_normals,
+  bool bParallel
+) const
+{
+  const unsigned int vertex_count = m_vertex_id.UnsignedCount();
+  if (0 == vertex_count || vertex_count != subd.VertexCount())
+    return ON_SUBD_RETURN_ERROR(false);
+
+  ON_SimpleArray<ON_3dPoint> control_points(vertex_count);
+  ON_SubDVertexIterator vit(subd);
+  for (const ON_SubDVertex* v = vit.FirstVertex(); nullptr != v; v = vit.NextVertex())
+  {
+    const unsigned int i = control_points.UnsignedCount();
+    if (i >= vertex_count || v->m_id != m_vertex_id[i])
+      return ON_SUBD_RETURN_ERROR(false);
+    control_points.Append(ON_3dPoint(v->m_P));
+  }
+  if (vertex_count != control_points.UnsignedCount())
+    return ON_SUBD_RETURN_ERROR(false);
+
+  surface_points.Reserve(vertex_count);
+  surface_points.SetCount(vertex_count);
+  double* N = nullptr;
+  if (nullptr != surface_normals)
+  {
+    surface_normals->Reserve(vertex_count);
+    surface_normals->SetCount(vertex_count);
+    N = &(*surface_normals)[0].x;
+  }
+
+  return Evaluate(3, &control_points[0].x, 3, &surface_points[0].x, 3, N, bParallel);
+}
@@ -835,6 +835,230 @@ void ON_Xform::ActOnRight(double x,double y,double z,double w,double v[4]) const
   }
 }
 
+// Batch transformation kernels.
+// The coefficients are copied into locals so the loops have no aliasing
+// between the matrix and the list and the compiler can keep them in registers.
+// The arithmetic is done in double precision in the same order
+// ON_TransformPointList() uses so the results are identical.
+
+template <class T>
+static void Internal_TransformAffinePoints(const ON_Xform& xform, size_t count, size_t stride, T* p)
+{
+  const double m00 = xform.m_xform[0][0], m01 = xform.m_xform[0][1], m02 = xform.m_xform[0][2], m03 = xform.m_xform[0][3];
+  const double m10 = xform.m_xform[1][0], m11 = xform.m_xform[1][1], m12 = xform.m_xform[1][2], m13 = xform.m_xform[1][3];
+  const double m20 = xform.m_xform[2][0], m21 = xform.m_xform[2][1], m22 = xform.m_xform[2][2], m23 = xform.m_xform[2][3];
+  if (3 == stride)
+  {
+    // packed list - the common case for ON_3dPointArray, ON_Mesh::m_V and ON_Mesh::m_dV
+    for (size_t i = 0; i < count; i++)
+    {
+      T* q = p + 3 * i;
+      const double x = q[0], y = q[1], z = q[2];
+      q[0] = (T)(m00 * x + m01 * y + m02 * z + m03);
+      q[1] = (T)(m10 * x + m11 * y + m12 * z + m13);
+      q[2] = (T)(m20 * x + m21 * y + m22 * z + m23);
+    }
+  }
+  else
+  {
+    for (T* p1 = p + count * stride; p < p1; p += stride)
+    {
+      const double x = p[0], y = p[1], z = p[2];
+      p[0] = (T)(m00 * x + m01 * y + m02 * z + m03);
+      p[1] = (T)(m10 * x + m11 * y + m12 * z + m13);
+      p[2] = (T)(m20 * x + m21 * y + m22 * z + m23);
+    }
+  }
+}
+
+template <class T>
+static bool Internal_TransformProjectivePoints(const ON_Xform& xform, size_t count, size_t stride, T* p)
+{
+  const double m00 = xform.m_xform[0][0], m01 = xform.m_xform[0][1], m02 = xform.m_xform[0][2], m03 = xform.m_xform[0][3];
+  const double m10 = xform.m_xform[1][0], m11 = xform.m_xform[1][1], m12 = xform.m_xform[1][2], m13 = xform.m_xform[1][3];
+  const double m20 = xform.m_xform[2][0], m21 = xform.m_xform[2][1], m22 = xform.m_xform[2][2], m23 = xform.m_xform[2][3];
+  const double m30 = xform.m_xform[3][0], m31 = xform.m_xform[3][1], m32 = xform.m_xform[3][2], m33 = xform.m_xform[3][3];
+  bool rc = true;
+  for (T* p1 = p + count * stride; p < p1; p += stride)
+  {
+    const double x = p[0], y = p[1], z = p[2];
+    double w = m30 * x + m31 * y + m32 * z + m33;
+    if (0.0 == w)
+    {
+      rc = false;
+      w = 1.0;
+    }
+    else
+      w = 1.0 / w;
+    p[0] = (T)(w * (m00 * x + m01 * y + m02 * z + m03));
+    p[1] = (T)(w * (m10 * x + m11 * y + m12 * z + m13));
+    p[2] = (T)(w * (m20 * x + m21 * y + m22 * z + m23));
+  }
+  return rc;
+}
+
+template <class T>
+static bool Internal_TransformVectors(const ON_Xform& xform, bool bUnitize, size_t count, size_t stride, T* v)
+{
+  const double m00 = xform.m_xform[0][0], m01 = xform.m_xform[0][1], m02 = xform.m_xform[0][2];
+  const double m10 = xform.m_xform[1][0], m11 = xform.m_xform[1][1], m12 = xform.m_xform[1][2];
+  const double m20 = xform.m_xform[2][0], m21 = xform.m_xform[2][1], m22 = xform.m_xform[2][2];
+  bool rc = true;
+  for (T* v1 = v + count * stride; v < v1; v += stride)
+  {
+    const double x = v[0], y = v[1], z = v[2];
+    ON_3dVector V(
+      m00 * x + m01 * y + m02 * z,
+      m10 * x + m11 * y + m12 * z,
+      m20 * x + m21 * y + m22 * z
+    );
+    if (bUnitize && false == V.Unitize())
+      rc = false;
+    v[0] = (T)V.x;
+    v[1] = (T)V.y;
+    v[2] = (T)V.z;
+  }
+  return rc;
+}
+
+enum class Internal_XformListType : unsigned char
+{
+  AffinePoints = 0,
+  ProjectivePoints = 1,
+  Vectors = 2,
+  UnitVectors = 3
+};
+
+template <class T>
+class Internal_XformListContext
+{
+public:
+  Internal_XformListContext(const ON_Xform& xform, Internal_XformListType list_type, size_t stride, T* list)
+    : m_xform(xform)
+    , m_list_type(list_type)
+    , m_stride(stride)
+    , m_list(list)
+  {}
+
+  const ON_Xform& m_xform;
+  const Internal_XformListType m_list_type;
+  const size_t m_stride;
+  T* m_list;
+  std::atomic<bool> m_rc{ true };
+
+  static void Range(ON__UINT_PTR context, unsigned int thread_index, size_t i0, size_t i1)
+  {
+    Internal_XformListContext<T>* ctx = (Internal_XformListContext<T>*)context;
+    T* p = ctx->m_list + i0 * ctx->m_stride;
+    const size_t count = i1 - i0;
+    bool rc = true;
+    switch (ctx->m_list_type)
+    {
+    case Internal_XformListType::AffinePoints:
+      Internal_TransformAffinePoints(ctx->m_xform, count, ctx->m_stride, p);
+      break;
+    case Internal_XformListType::ProjectivePoints:
+      rc = Internal_TransformProjectivePoints(ctx->m_xform, count, ctx->m_stride, p);
+      break;
+    case Internal_XformListType::Vectors:
+      rc = Internal_TransformVectors(ctx->m_xform, false, count, ctx->m_stride, p);
+      break;
+    case Internal_XformListType::UnitVectors:
+      rc = Internal_TransformVectors(ctx->m_xform, true, count, ctx->m_stride, p);
+      break;
+    }
+    if (false == rc)
+      ctx->m_rc = false;
+  }
+
+  bool Run(size_t count, bool bParallel)
+  {
+    // Transforming a point is a few dozen flops, so a thread
+    // needs tens of thousands of points to pay for itself.
+    const size_t min_points_per_thread = 0x8000;
+    ON_ParallelFor(count, min_points_per_thread, bParallel ? 0U : 1U, Internal_XformListContext<T>::Range, (ON__UINT_PTR)this);
+    return m_rc;
+  }
+};
+
+template <class T>
+static bool Internal_TransformPointList(const ON_Xform& xform, size_t count, size_t stride, T* points, bool bParallel)
+{
+  if (0 == count)
+    return true;
+  if (stride < 3 || nullptr == points)
+    return false;
+  const Internal_XformListType list_type
+    = (0.0 == xform.m_xform[3][0] && 0.0 == xform.m_xform[3][1] && 0.0 == xform.m_xform[3][2] && 1.0 == xform.m_xform[3][3])
+    ? Internal_XformListType::AffinePoints
+    : Internal_XformListType::ProjectivePoints;
+  Internal_XformListContext<T> ctx(xform, list_type, stride, points);
+  return ctx.Run(count, bParallel);
+}
+
+template <class T>
+static bool Internal_TransformVectorList(const ON_Xform& xform, bool bUnitize, size_t count, size_t stride, T* vectors, bool bParallel)
+{
+  if (0 == count)
+    return true;
+  if (stride < 3 || nullptr == vectors)
+    return false;
+  Internal_XformListContext<T> ctx(xform, bUnitize ? Internal_XformListType::UnitVectors : Internal_XformListType::Vectors, stride, vectors);
+  return ctx.Run(count, bParallel);
+}
+
+bool ON_Xform::TransformPointList(size_t point_count, size_t point_stride, double* points, bool bParallel) const
+{
+  return Internal_TransformPointList(*this, point_count, point_stride, points, bParallel);
+}
+
+bool ON_Xform::TransformPointList(size_t point_count, size_t point_stride, float* points, bool bParallel) const
+{
+  return Internal_TransformPointList(*this, point_count, point_stride, points, bParallel);
+}
+
+bool ON_Xform::TransformPointList(size_t point_count, ON_3dPoint* points, bool bParallel) const
+{
+  return Internal_TransformPointList(*this, point_count, 3, (nullptr != points) ? &points->x : nullptr, bParallel);
+}
+
+bool ON_Xform::TransformPointList(size_t point_count, ON_3fPoint* points, bool bParallel) const
+{
+  return Internal_TransformPointList(*this, point_count, 3, (nullptr != points) ? &points->x : nullptr, bParallel);
+}
+
+bool ON_Xform::TransformVectorList(size_t vector_count, size_t vector_stride, double* vectors, bool bParallel) const
+{
+  return Internal_TransformVectorList(*this, false, vector_count, vector_stride, vectors, bParallel);
+}
+
+bool ON_Xform::TransformVectorList(size_t vector_count, size_t vector_stride, float* vectors, bool bParallel) const
+{
+  return Internal_TransformVectorList(*this, false, vector_count, vector_stride, vectors, bParallel);
+}
+
+double ON_Xform::TransformNormalList(size_t normal_count, size_t normal_stride, double* normals, bool bUnitize, bool bParallel) const
+{
+  ON_Xform N_xform;
+  const double det = GetSurfaceNormalXform(N_xform);
+  if (0.0 == det)
+    return 0.0;
+  if (false == Internal_TransformVectorList(N_xform, bUnitize, normal_count, normal_stride, normals, bParallel))
+    return 0.0;
+  return det;
+}
+
+double ON_Xform::TransformNormalList(size_t normal_count, size_t normal_stride, float* normals, bool bUnitize, bool bParallel) const
+{
+  ON_Xform N_xform;
+  const double det = GetSurfaceNormalXform(N_xform);
+  if (0.0 == det)
+    return 0.0;
+  if (false == Internal_TransformVectorList(N_xform, bUnitize, normal_count, normal_stride, normals, bParallel))
+    return 0.0;
+  return det;
+}
+
 const ON_Xform operator*(double c, const ON_Xform& xform)
 {
   ON_Xform cx(xform);
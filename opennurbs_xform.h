@@ -546,6 +546,120 @@ public:
          double[4] // ans
          ) const;
 
+  ////////////////////////////////////////////////////////////////
+  // batch point and vector transformations
+
+  /*
+  Description:
+    Transform a list of 3d points in place.
+  Parameters:
+    point_count - [in]
+    point_stride - [in]
+      Number of coordinates between the first coordinates of successive
+      points.  point_stride >= 3.
+    points - [in/out]
+    bParallel - [in]
+      If true and point_count is large, the list is divided among threads.
+  Returns:
+    True if successful.
+    False if the input is not valid or if a point was mapped to infinity,
+    in which case that point's coordinates are set to the homogeneous
+    numerator, exactly as ON_TransformPointList() does.
+  Remarks:
+    When IsAffine() is true the homogeneous divide is skipped.
+    The results are identical to calling ON_TransformPointList(3,false,...)
+    or applying operator* to each point.
+  */
+  bool TransformPointList(
+    size_t point_count,
+    size_t point_stride,
+    double* points,
+    bool bParallel
+  ) const;
+
+  bool TransformPointList(
+    size_t point_count,
+    size_t point_stride,
+    float* points,
+    bool bParallel
+  ) const;
+
+  bool TransformPointList(
+    size_t point_count,
+    ON_3dPoint* points,
+    bool bParallel
+  ) const;
+
+  bool TransformPointList(
+    size_t point_count,
+    ON_3fPoint* points,
+    bool bParallel
+  ) const;
+
+  /*
+  Description:
+    Apply the upper 3x3 part of this transformation to a list of 3d vectors.
+  Parameters:
+    vector_count - [in]
+    vector_stride - [in] >= 3
+    vectors - [in/out]
+    bParallel - [in]
+      If true and vector_count is large, the list is divided among threads.
+  Returns:
+    True if successful.
+  */
+  bool TransformVectorList(
+    size_t vector_count,
+    size_t vector_stride,
+    double* vectors,
+    bool bParallel
+  ) const;
+
+  bool TransformVectorList(
+    size_t vector_count,
+    size_t vector_stride,
+    float* vectors,
+    bool bParallel
+  ) const;
+
+  /*
+  Description:
+    Transform a list of surface normals with the inverse transpose
+    of this transformation.  See GetSurfaceNormalXform() for details.
+  Parameters:
+    normal_count - [in]
+    normal_stride - [in] >= 3
+    normals - [in/out]
+    bUnitize - [in]
+      If true, the transformed normals are unitized.
+    bParallel - [in]
+      If true and normal_count is large, the list is divided among threads.
+  Returns:
+    The determinant of this transformation.
+    0.0 if this transformation is not invertable, in which
+    case the normals are not changed, or if the normal list
+    is not valid.
+  Remarks:
+    A negative determinant means the transformation reverses orientation.
+    Callers that store face winding, like ON_Mesh, typically flip
+    the normals in that case.
+  */
+  double TransformNormalList(
+    size_t normal_count,
+    size_t normal_stride,
+    double* normals,
+    bool bUnitize,
+    bool bParallel
+  ) const;
+
+  double TransformNormalList(
+    size_t normal_count,
+    size_t normal_stride,
+    float* normals,
+    bool bUnitize,
+    bool bParallel
+  ) const;
+
   ////////////////////////////////////////////////////////////////
   // standard transformations
 